@@ -0,0 +1,69 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#ifndef JSONCONS_BENCHMARKS_BENCHMARK_HPP
+#define JSONCONS_BENCHMARKS_BENCHMARK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace jsoncons_benchmarks {
+
+    // Number of calls to the global operator new so far,
+    // counted by the replacement in benchmark_main.cpp
+    std::size_t allocation_count() noexcept;
+
+    struct benchmark_case
+    {
+        std::string name;
+        // Bytes of input (or output, for encoders) processed by one call of run,
+        // used to report throughput
+        std::size_t bytes;
+        // Number of documents processed by one call of run,
+        // used to report allocations per document
+        std::size_t documents;
+        std::function<void()> run;
+    };
+
+    struct benchmark_result
+    {
+        std::string name;
+        std::size_t bytes;
+        std::size_t iterations;
+        double median_ns;
+        double allocations_per_document;
+    };
+
+    class benchmark_suite
+    {
+        std::vector<benchmark_case> cases_;
+    public:
+        void add(std::string name, std::size_t bytes, std::size_t documents, std::function<void()> run);
+
+        // Runs each case whose name contains filter, repeating it for at least
+        // min_seconds, and reports the median time of one call
+        std::vector<benchmark_result> run(const std::string& filter, double min_seconds, std::ostream& os) const;
+    };
+
+    // Writes the results as a JSON object with the jsoncons version, the corpus scale
+    // and an array with an object for each result
+    void write_json(const std::vector<benchmark_result>& results, std::size_t scale, std::ostream& os);
+
+    // Writes the results as CSV, a header row and a row for each result
+    void write_csv(const std::vector<benchmark_result>& results, std::ostream& os);
+
+    // Prevents the optimizer from discarding a result
+    void do_not_optimize(const void* p);
+
+    template <typename T>
+    void do_not_optimize(const T& value)
+    {
+        do_not_optimize(static_cast<const void*>(&value));
+    }
+
+} // namespace jsoncons_benchmarks
+
+#endif // JSONCONS_BENCHMARKS_BENCHMARK_HPP
@@ -0,0 +1,208 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/config/version.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "corpus.hpp"
+
+namespace {
+
+    std::size_t allocations = 0;
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace jsoncons_benchmarks {
+
+    std::size_t allocation_count() noexcept
+    {
+        return allocations;
+    }
+
+    void do_not_optimize(const void* p)
+    {
+        static std::atomic<const void*> sink{nullptr};
+        sink.store(p, std::memory_order_relaxed);
+    }
+
+    void benchmark_suite::add(std::string name, std::size_t bytes, std::size_t documents, std::function<void()> run)
+    {
+        cases_.push_back(benchmark_case{std::move(name), bytes, documents, std::move(run)});
+    }
+
+    std::vector<benchmark_result> benchmark_suite::run(const std::string& filter, double min_seconds, std::ostream& os) const
+    {
+        using clock = std::chrono::steady_clock;
+
+        os << std::left << std::setw(36) << "benchmark" << std::right
+           << std::setw(10) << "MB/s"
+           << std::setw(14) << "ms/iter"
+           << std::setw(14) << "allocs/doc"
+           << std::setw(8) << "iters" << "\n";
+
+        std::vector<benchmark_result> results;
+        for (const auto& c : cases_)
+        {
+            if (c.name.find(filter) == std::string::npos)
+            {
+                continue;
+            }
+
+            // The first call warms caches and counts allocations
+            std::size_t count = allocation_count();
+            c.run();
+            double allocations_per_document = double(allocation_count() - count) / double(c.documents);
+
+            std::vector<double> times;
+            double total = 0;
+            while (total < min_seconds || times.size() < 3)
+            {
+                auto start = clock::now();
+                c.run();
+                double seconds = std::chrono::duration<double>(clock::now() - start).count();
+                times.push_back(seconds);
+                total += seconds;
+            }
+            std::sort(times.begin(), times.end());
+            double median = times[times.size()/2];
+
+            benchmark_result result{c.name, c.bytes, times.size(), median*1e9, allocations_per_document};
+            os << std::left << std::setw(36) << result.name << std::right << std::fixed
+               << std::setw(10) << std::setprecision(1) << (double(result.bytes) / 1e6) / median
+               << std::setw(14) << std::setprecision(3) << median*1e3
+               << std::setw(14) << std::setprecision(1) << result.allocations_per_document
+               << std::setw(8) << result.iterations << "\n";
+            results.push_back(std::move(result));
+        }
+        return results;
+    }
+
+} // namespace jsoncons_benchmarks
+
+namespace {
+
+    enum class output_format {text, json, csv};
+
+    void usage(std::ostream& os)
+    {
+        os << "Usage: jsoncons_benchmarks [--filter=<text>] [--min-time=<seconds>] [--scale=<n>] [--format=text|json|csv]\n"
+           << "  --filter    run only benchmarks whose name contains text\n"
+           << "  --min-time  minimum time to repeat each benchmark, default 1\n"
+           << "  --scale     multiplies the size of the generated documents, default 1\n"
+           << "  --format    json or csv writes the results to standard output in that format,\n"
+           << "              and the table to standard error, default text\n";
+    }
+
+    bool starts_with(const char* arg, const char* prefix)
+    {
+        return std::strncmp(arg, prefix, std::strlen(prefix)) == 0;
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    using namespace jsoncons_benchmarks;
+
+    std::string filter;
+    double min_seconds = 1.0;
+    std::size_t scale = 1;
+    output_format format = output_format::text;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (starts_with(argv[i], "--filter="))
+        {
+            filter = argv[i] + std::strlen("--filter=");
+        }
+        else if (starts_with(argv[i], "--min-time="))
+        {
+            min_seconds = std::atof(argv[i] + std::strlen("--min-time="));
+        }
+        else if (starts_with(argv[i], "--scale="))
+        {
+            scale = static_cast<std::size_t>(std::atoi(argv[i] + std::strlen("--scale=")));
+        }
+        else if (std::strcmp(argv[i], "--format=text") == 0)
+        {
+            format = output_format::text;
+        }
+        else if (std::strcmp(argv[i], "--format=json") == 0)
+        {
+            format = output_format::json;
+        }
+        else if (std::strcmp(argv[i], "--format=csv") == 0)
+        {
+            format = output_format::csv;
+        }
+        else
+        {
+            usage(std::cerr);
+            return 1;
+        }
+    }
+    if (scale == 0)
+    {
+        usage(std::cerr);
+        return 1;
+    }
+
+    // Only the results go to standard output when they are written as json or csv
+    std::ostream& table = format == output_format::text ? std::cout : std::cerr;
+
+    corpus c(scale);
+    table << "jsoncons " << JSONCONS_VERSION_MAJOR << "." << JSONCONS_VERSION_MINOR << "." << JSONCONS_VERSION_PATCH << "\n"
+              << "twitter " << c.twitter.size() << " bytes, "
+              << "numbers " << c.numbers.size() << " bytes, "
+              << "deep " << c.deep.size() << " bytes, "
+              << "csv " << c.csv.size() << " bytes\n\n";
+
+    benchmark_suite suite;
+    add_json_benchmarks(suite, c);
+    add_query_benchmarks(suite, c);
+    add_csv_benchmarks(suite, c);
+    add_binary_benchmarks(suite, c);
+
+    std::vector<benchmark_result> results = suite.run(filter, min_seconds, table);
+    if (format == output_format::json)
+    {
+        write_json(results, scale, std::cout);
+    }
+    else if (format == output_format::csv)
+    {
+        write_csv(results, std::cout);
+    }
+    return 0;
+}
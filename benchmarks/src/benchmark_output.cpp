@@ -0,0 +1,52 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/config/version.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace jsoncons_benchmarks {
+
+namespace {
+
+    jsoncons::ojson to_rows(const std::vector<benchmark_result>& results)
+    {
+        jsoncons::ojson rows(jsoncons::json_array_arg);
+        rows.reserve(results.size());
+        for (const auto& result : results)
+        {
+            jsoncons::ojson row(jsoncons::json_object_arg);
+            row.insert_or_assign("name", result.name);
+            row.insert_or_assign("bytes", result.bytes);
+            row.insert_or_assign("iterations", result.iterations);
+            row.insert_or_assign("median_ns", result.median_ns);
+            row.insert_or_assign("allocations_per_document", result.allocations_per_document);
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+} // namespace
+
+    void write_json(const std::vector<benchmark_result>& results, std::size_t scale, std::ostream& os)
+    {
+        jsoncons::ojson doc(jsoncons::json_object_arg);
+        doc.insert_or_assign("version", std::to_string(JSONCONS_VERSION_MAJOR) + "." + 
+            std::to_string(JSONCONS_VERSION_MINOR) + "." + std::to_string(JSONCONS_VERSION_PATCH));
+        doc.insert_or_assign("scale", scale);
+        doc.insert_or_assign("benchmarks", to_rows(results));
+        os << jsoncons::pretty_print(doc) << "\n";
+    }
+
+    void write_csv(const std::vector<benchmark_result>& results, std::ostream& os)
+    {
+        jsoncons::csv::encode_csv(to_rows(results), os);
+    }
+
+} // namespace jsoncons_benchmarks
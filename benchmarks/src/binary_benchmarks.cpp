@@ -0,0 +1,71 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "corpus.hpp"
+
+namespace jsoncons_benchmarks {
+
+    void add_binary_benchmarks(benchmark_suite& suite, const corpus& c)
+    {
+        using jsoncons::json;
+        namespace cbor = jsoncons::cbor;
+        namespace msgpack = jsoncons::msgpack;
+
+        suite.add("cbor decode twitter", c.twitter_cbor.size(), 1, [&c]()
+        {
+            json j = cbor::decode_cbor<json>(c.twitter_cbor);
+            do_not_optimize(j);
+        });
+        suite.add("cbor decode numbers", c.numbers_cbor.size(), 1, [&c]()
+        {
+            json j = cbor::decode_cbor<json>(c.numbers_cbor);
+            do_not_optimize(j);
+        });
+        suite.add("msgpack decode twitter", c.twitter_msgpack.size(), 1, [&c]()
+        {
+            json j = msgpack::decode_msgpack<json>(c.twitter_msgpack);
+            do_not_optimize(j);
+        });
+        suite.add("msgpack decode numbers", c.numbers_msgpack.size(), 1, [&c]()
+        {
+            json j = msgpack::decode_msgpack<json>(c.numbers_msgpack);
+            do_not_optimize(j);
+        });
+
+        auto twitter = std::make_shared<json>(json::parse(c.twitter));
+        auto numbers = std::make_shared<json>(json::parse(c.numbers));
+        suite.add("cbor encode twitter", c.twitter_cbor.size(), 1, [twitter]()
+        {
+            std::vector<uint8_t> v;
+            cbor::encode_cbor(*twitter, v);
+            do_not_optimize(v);
+        });
+        suite.add("cbor encode numbers", c.numbers_cbor.size(), 1, [numbers]()
+        {
+            std::vector<uint8_t> v;
+            cbor::encode_cbor(*numbers, v);
+            do_not_optimize(v);
+        });
+        suite.add("msgpack encode twitter", c.twitter_msgpack.size(), 1, [twitter]()
+        {
+            std::vector<uint8_t> v;
+            msgpack::encode_msgpack(*twitter, v);
+            do_not_optimize(v);
+        });
+        suite.add("msgpack encode numbers", c.numbers_msgpack.size(), 1, [numbers]()
+        {
+            std::vector<uint8_t> v;
+            msgpack::encode_msgpack(*numbers, v);
+            do_not_optimize(v);
+        });
+    }
+
+} // namespace jsoncons_benchmarks
@@ -0,0 +1,301 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+
+#include <cstdint>
+#include <string>
+
+#include "corpus.hpp"
+
+namespace jsoncons_benchmarks {
+
+namespace {
+
+    // xorshift64*, so that the documents don't depend on the
+    // standard library's random number distributions
+    class generator
+    {
+        uint64_t state_;
+    public:
+        explicit generator(uint64_t seed)
+            : state_(seed)
+        {
+        }
+
+        uint64_t next()
+        {
+            state_ ^= state_ >> 12;
+            state_ ^= state_ << 25;
+            state_ ^= state_ >> 27;
+            return state_ * 2685821657736338717ULL;
+        }
+
+        std::size_t next(std::size_t n)
+        {
+            return static_cast<std::size_t>(next() % n);
+        }
+
+        bool coin()
+        {
+            return (next() & 1) != 0;
+        }
+    };
+
+    const char* const words[] = {
+        "the", "release", "parser", "benchmark", "weekend", "coffee", "train", "music",
+        "caf\\u00e9", "na\\u00efve", "\\u65e5\\u672c", "\\ud83d\\ude00", "r\xc3\xa9sum\xc3\xa9",
+        "\xe6\x9d\xb1\xe4\xba\xac", "stream", "update", "\\\"quoted\\\"", "line\\nbreak", "tab\\tstop"
+    };
+    const std::size_t word_count = sizeof(words)/sizeof(words[0]);
+
+    const char* const names[] = {
+        "alice", "bob", "carol", "dave", "erin", "frank", "grace", "heidi", "ivan", "judy"
+    };
+    const std::size_t name_count = sizeof(names)/sizeof(names[0]);
+
+    const char* const cities[] = {
+        "Toronto", "Tokyo", "S\xc3\xa3o Paulo", "Z\xc3\xbcrich", "Nairobi", "Reykjav\xc3\xadk", "Auckland", "Lima"
+    };
+    const std::size_t city_count = sizeof(cities)/sizeof(cities[0]);
+
+    void append_uint(std::string& s, uint64_t n)
+    {
+        s.append(std::to_string(n));
+    }
+
+    void append_int(std::string& s, int64_t n)
+    {
+        s.append(std::to_string(n));
+    }
+
+    // A decimal with three fraction digits, formatted without the library
+    void append_decimal(std::string& s, int64_t thousandths)
+    {
+        if (thousandths < 0)
+        {
+            s.push_back('-');
+            thousandths = -thousandths;
+        }
+        append_int(s, thousandths / 1000);
+        s.push_back('.');
+        std::string fraction = std::to_string(thousandths % 1000);
+        s.append(3 - fraction.size(), '0');
+        s.append(fraction);
+    }
+
+    void append_words(std::string& s, generator& gen, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(' ');
+            }
+            s.append(words[gen.next(word_count)]);
+        }
+    }
+
+    std::string make_status(generator& gen, uint64_t id)
+    {
+        std::string s;
+        s.append("{\"created_at\":\"Sun Aug 31 00:29:15 +0000 2014\",\"id\":");
+        append_uint(s, id);
+        s.append(",\"id_str\":\"");
+        append_uint(s, id);
+        s.append("\",\"text\":\"");
+        append_words(s, gen, 6 + gen.next(14));
+        s.append("\",\"source\":\"<a href=\\\"http://twitter.com\\\" rel=\\\"nofollow\\\">Twitter Web Client</a>\"");
+        s.append(",\"truncated\":false,\"in_reply_to_status_id\":null,\"user\":{\"id\":");
+        uint64_t user_id = 1000000 + gen.next(100000);
+        append_uint(s, user_id);
+        s.append(",\"id_str\":\"");
+        append_uint(s, user_id);
+        s.append("\",\"name\":\"");
+        s.append(names[gen.next(name_count)]);
+        s.append("\",\"screen_name\":\"");
+        s.append(names[gen.next(name_count)]);
+        append_uint(s, gen.next(1000));
+        s.append("\",\"location\":\"");
+        s.append(cities[gen.next(city_count)]);
+        s.append("\",\"description\":\"");
+        append_words(s, gen, 3 + gen.next(8));
+        s.append("\",\"followers_count\":");
+        append_uint(s, gen.next(100000));
+        s.append(",\"friends_count\":");
+        append_uint(s, gen.next(5000));
+        s.append(",\"verified\":");
+        s.append(gen.coin() ? "true" : "false");
+        s.append(",\"lang\":\"en\"},\"geo\":null,\"coordinates\":");
+        if (gen.coin())
+        {
+            s.append("{\"type\":\"Point\",\"coordinates\":[");
+            append_decimal(s, static_cast<int64_t>(gen.next(360000)) - 180000);
+            s.push_back(',');
+            append_decimal(s, static_cast<int64_t>(gen.next(180000)) - 90000);
+            s.append("]}");
+        }
+        else
+        {
+            s.append("null");
+        }
+        s.append(",\"retweet_count\":");
+        append_uint(s, gen.next(100));
+        s.append(",\"favorite_count\":");
+        append_uint(s, gen.next(100));
+        s.append(",\"entities\":{\"hashtags\":[");
+        std::size_t hashtags = gen.next(3);
+        for (std::size_t i = 0; i < hashtags; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            std::size_t start = gen.next(100);
+            s.append("{\"text\":\"");
+            s.append(words[gen.next(word_count)]);
+            s.append("\",\"indices\":[");
+            append_uint(s, start);
+            s.push_back(',');
+            append_uint(s, start + 8);
+            s.append("]}");
+        }
+        s.append("],\"urls\":[],\"user_mentions\":[");
+        if (gen.coin())
+        {
+            s.append("{\"screen_name\":\"");
+            s.append(names[gen.next(name_count)]);
+            s.append("\",\"id\":");
+            append_uint(s, 1000000 + gen.next(100000));
+            s.append(",\"indices\":[0,6]}");
+        }
+        s.append("]},\"favorited\":false,\"retweeted\":false,\"lang\":\"en\"}");
+        return s;
+    }
+
+    std::string make_numbers(generator& gen, std::size_t count)
+    {
+        std::string s;
+        s.push_back('[');
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            switch (gen.next(4))
+            {
+                case 0:
+                    append_int(s, static_cast<int64_t>(gen.next(2000000)) - 1000000);
+                    break;
+                case 1:
+                    append_uint(s, gen.next());
+                    break;
+                case 2:
+                    append_decimal(s, static_cast<int64_t>(gen.next(20000000)) - 10000000);
+                    break;
+                default:
+                    append_decimal(s, static_cast<int64_t>(gen.next(10000)));
+                    s.append("e-");
+                    append_uint(s, 1 + gen.next(20));
+                    break;
+            }
+        }
+        s.push_back(']');
+        return s;
+    }
+
+    std::string make_deep(generator& gen, std::size_t count, std::size_t depth)
+    {
+        std::string s;
+        s.push_back('[');
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            for (std::size_t level = 0; level < depth; ++level)
+            {
+                s.append(level % 2 == 0 ? "{\"level\":" : "[");
+                append_uint(s, gen.next(10));
+                s.push_back(',');
+                if (level % 2 == 0)
+                {
+                    s.append("\"next\":");
+                }
+            }
+            s.append("null");
+            for (std::size_t level = depth; level-- > 0; )
+            {
+                s.push_back(level % 2 == 0 ? '}' : ']');
+            }
+        }
+        s.push_back(']');
+        return s;
+    }
+
+    std::string make_csv(generator& gen, std::size_t rows)
+    {
+        std::string s = "id,name,city,quantity,price,date,active,comment\n";
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            append_uint(s, i);
+            s.push_back(',');
+            s.append(names[gen.next(name_count)]);
+            s.push_back(',');
+            s.append(cities[gen.next(city_count)]);
+            s.push_back(',');
+            append_uint(s, gen.next(1000));
+            s.push_back(',');
+            append_decimal(s, static_cast<int64_t>(gen.next(1000000)));
+            s.append(",2024-");
+            append_uint(s, 10 + gen.next(3));
+            s.push_back('-');
+            append_uint(s, 10 + gen.next(19));
+            s.push_back(',');
+            s.append(gen.coin() ? "true" : "false");
+            s.append(",\"");
+            s.append(names[gen.next(name_count)]);
+            s.append(", ");
+            s.append(cities[gen.next(city_count)]);
+            s.append("\"\n");
+        }
+        return s;
+    }
+
+} // namespace
+
+    corpus::corpus(std::size_t scale)
+    {
+        generator gen(0x9E3779B97F4A7C15ULL);
+
+        const std::size_t status_count = 1000 * scale;
+        twitter.push_back('[');
+        for (std::size_t i = 0; i < status_count; ++i)
+        {
+            messages.push_back(make_status(gen, 505874924095815681ULL + i));
+            if (i > 0)
+            {
+                twitter.push_back(',');
+            }
+            twitter.append(messages.back());
+        }
+        twitter.push_back(']');
+
+        numbers = make_numbers(gen, 100000 * scale);
+        deep = make_deep(gen, 500 * scale, 64);
+        csv = make_csv(gen, 20000 * scale);
+
+        jsoncons::json j = jsoncons::json::parse(twitter);
+        jsoncons::cbor::encode_cbor(j, twitter_cbor);
+        jsoncons::msgpack::encode_msgpack(j, twitter_msgpack);
+
+        j = jsoncons::json::parse(numbers);
+        jsoncons::cbor::encode_cbor(j, numbers_cbor);
+        jsoncons::msgpack::encode_msgpack(j, numbers_msgpack);
+    }
+
+} // namespace jsoncons_benchmarks
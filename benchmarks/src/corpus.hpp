@@ -0,0 +1,47 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#ifndef JSONCONS_BENCHMARKS_CORPUS_HPP
+#define JSONCONS_BENCHMARKS_CORPUS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace jsoncons_benchmarks {
+
+    // Documents generated from a fixed seed, so that every platform and
+    // release benchmarks the same bytes
+    struct corpus
+    {
+        // An array of status messages with nested user and entity objects,
+        // modelled on the twitter.json document of the nativejson-benchmark
+        std::string twitter;
+        // The same status messages as separate documents
+        std::vector<std::string> messages;
+        // An array of integers and doubles
+        std::string numbers;
+        // An array of deeply nested arrays and objects
+        std::string deep;
+        // A table of strings and numbers with a header line
+        std::string csv;
+        std::vector<uint8_t> twitter_cbor;
+        std::vector<uint8_t> twitter_msgpack;
+        std::vector<uint8_t> numbers_cbor;
+        std::vector<uint8_t> numbers_msgpack;
+
+        // scale multiplies the number of records in each document
+        explicit corpus(std::size_t scale);
+    };
+
+    void add_json_benchmarks(benchmark_suite& suite, const corpus& c);
+    void add_query_benchmarks(benchmark_suite& suite, const corpus& c);
+    void add_csv_benchmarks(benchmark_suite& suite, const corpus& c);
+    void add_binary_benchmarks(benchmark_suite& suite, const corpus& c);
+
+} // namespace jsoncons_benchmarks
+
+#endif // JSONCONS_BENCHMARKS_CORPUS_HPP
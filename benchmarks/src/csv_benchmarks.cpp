@@ -0,0 +1,39 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+
+#include <memory>
+#include <string>
+
+#include "corpus.hpp"
+
+namespace jsoncons_benchmarks {
+
+    void add_csv_benchmarks(benchmark_suite& suite, const corpus& c)
+    {
+        using jsoncons::json;
+        namespace csv = jsoncons::csv;
+
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        suite.add("csv decode table", c.csv.size(), 1, [&c,options]()
+        {
+            json j = csv::decode_csv<json>(c.csv, options);
+            do_not_optimize(j);
+        });
+
+        auto table = std::make_shared<json>(csv::decode_csv<json>(c.csv, options));
+        std::string encoded;
+        csv::encode_csv(*table, encoded);
+        suite.add("csv encode table", encoded.size(), 1, [table]()
+        {
+            std::string s;
+            csv::encode_csv(*table, s);
+            do_not_optimize(s);
+        });
+    }
+
+} // namespace jsoncons_benchmarks
@@ -0,0 +1,91 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+
+#include <memory>
+#include <string>
+
+#include "corpus.hpp"
+
+namespace jsoncons_benchmarks {
+
+    void add_json_benchmarks(benchmark_suite& suite, const corpus& c)
+    {
+        using jsoncons::json;
+        using jsoncons::ojson;
+
+        suite.add("json parse twitter", c.twitter.size(), 1, [&c]()
+        {
+            json j = json::parse(c.twitter);
+            do_not_optimize(j);
+        });
+        suite.add("ojson parse twitter", c.twitter.size(), 1, [&c]()
+        {
+            ojson j = ojson::parse(c.twitter);
+            do_not_optimize(j);
+        });
+        suite.add("json parse numbers", c.numbers.size(), 1, [&c]()
+        {
+            json j = json::parse(c.numbers);
+            do_not_optimize(j);
+        });
+        suite.add("json parse deep", c.deep.size(), 1, [&c]()
+        {
+            json j = json::parse(c.deep);
+            do_not_optimize(j);
+        });
+
+        std::size_t message_bytes = 0;
+        for (const auto& message : c.messages)
+        {
+            message_bytes += message.size();
+        }
+        suite.add("json parse messages", message_bytes, c.messages.size(), [&c]()
+        {
+            for (const auto& message : c.messages)
+            {
+                json j = json::parse(message);
+                do_not_optimize(j);
+            }
+        });
+        auto context = std::make_shared<jsoncons::json_parse_context<json>>();
+        suite.add("json parse messages with context", message_bytes, c.messages.size(), [&c,context]()
+        {
+            for (const auto& message : c.messages)
+            {
+                json j = json::parse(*context, message);
+                do_not_optimize(j);
+            }
+        });
+
+        auto twitter = std::make_shared<json>(json::parse(c.twitter));
+        std::string compact;
+        twitter->dump(compact);
+        suite.add("json encode twitter", compact.size(), 1, [twitter]()
+        {
+            std::string s;
+            twitter->dump(s);
+            do_not_optimize(s);
+        });
+        std::string pretty;
+        twitter->dump_pretty(pretty);
+        suite.add("json encode pretty twitter", pretty.size(), 1, [twitter]()
+        {
+            std::string s;
+            twitter->dump_pretty(s);
+            do_not_optimize(s);
+        });
+
+        auto numbers = std::make_shared<json>(json::parse(c.numbers));
+        std::string numbers_text;
+        numbers->dump(numbers_text);
+        suite.add("json encode numbers", numbers_text.size(), 1, [numbers]()
+        {
+            std::string s;
+            numbers->dump(s);
+            do_not_optimize(s);
+        });
+    }
+
+} // namespace jsoncons_benchmarks
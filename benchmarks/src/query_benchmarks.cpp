@@ -0,0 +1,115 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jmespath/jmespath.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <jsoncons_ext/jsonschema/jsonschema.hpp>
+
+#include <memory>
+#include <string>
+
+#include "corpus.hpp"
+
+namespace jsoncons_benchmarks {
+
+    namespace {
+
+        const char* const status_schema = R"(
+{
+    "$schema": "https://json-schema.org/draft/2020-12/schema",
+    "type": "array",
+    "items": {
+        "type": "object",
+        "required": ["id", "id_str", "text", "user", "entities"],
+        "properties": {
+            "id": {"type": "integer", "minimum": 0},
+            "id_str": {"type": "string", "pattern": "^[0-9]+$"},
+            "text": {"type": "string", "maxLength": 1000},
+            "retweet_count": {"type": "integer", "minimum": 0},
+            "coordinates": {
+                "oneOf": [
+                    {"type": "null"},
+                    {
+                        "type": "object",
+                        "properties": {
+                            "type": {"const": "Point"},
+                            "coordinates": {"type": "array", "items": {"type": "number"}, "minItems": 2, "maxItems": 2}
+                        }
+                    }
+                ]
+            },
+            "user": {
+                "type": "object",
+                "required": ["id", "screen_name"],
+                "properties": {
+                    "id": {"type": "integer"},
+                    "screen_name": {"type": "string", "minLength": 1},
+                    "verified": {"type": "boolean"}
+                }
+            },
+            "entities": {
+                "type": "object",
+                "properties": {
+                    "hashtags": {
+                        "type": "array",
+                        "items": {
+                            "type": "object",
+                            "properties": {
+                                "text": {"type": "string"},
+                                "indices": {"type": "array", "items": {"type": "integer"}}
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+        )";
+
+    } // namespace
+
+    void add_query_benchmarks(benchmark_suite& suite, const corpus& c)
+    {
+        using jsoncons::json;
+        namespace jsonpath = jsoncons::jsonpath;
+        namespace jmespath = jsoncons::jmespath;
+        namespace jsonschema = jsoncons::jsonschema;
+
+        auto twitter = std::make_shared<json>(json::parse(c.twitter));
+
+        auto descendants = std::make_shared<jsonpath::jsonpath_expression<json>>(
+            jsonpath::make_expression<json>("$..screen_name"));
+        suite.add("jsonpath descendants twitter", c.twitter.size(), 1, [twitter,descendants]()
+        {
+            json result = descendants->evaluate(*twitter);
+            do_not_optimize(result);
+        });
+
+        auto filter = std::make_shared<jsonpath::jsonpath_expression<json>>(
+            jsonpath::make_expression<json>("$[?(@.retweet_count > 50 && @.user.verified == true)].id"));
+        suite.add("jsonpath filter twitter", c.twitter.size(), 1, [twitter,filter]()
+        {
+            json result = filter->evaluate(*twitter);
+            do_not_optimize(result);
+        });
+
+        auto projection = std::make_shared<jmespath::jmespath_expression<json>>(
+            jmespath::make_expression<json>("[?retweet_count > `50`].{id: id, name: user.screen_name, tags: entities.hashtags[].text}"));
+        suite.add("jmespath projection twitter", c.twitter.size(), 1, [twitter,projection]()
+        {
+            json result = projection->evaluate(*twitter);
+            do_not_optimize(result);
+        });
+
+        auto schema = std::make_shared<jsonschema::json_schema<json>>(
+            jsonschema::make_json_schema(json::parse(status_schema)));
+        suite.add("jsonschema validate twitter", c.twitter.size(), 1, [twitter,schema]()
+        {
+            bool valid = schema->is_valid(*twitter);
+            do_not_optimize(valid);
+        });
+    }
+
+} // namespace jsoncons_benchmarks
@@ -8,6 +8,7 @@
 #define JSONCONS_BASIC_JSON_HPP
 
 #include <algorithm> // std::swap
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <functional>
@@ -30,14 +31,17 @@
 #include <jsoncons/config/version.hpp>
 #include <jsoncons/conv_error.hpp>
 #include <jsoncons/conversion_result.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_array.hpp>
 #include <jsoncons/json_decoder.hpp>
 #include <jsoncons/json_encoder.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_fwd.hpp>
+#include <jsoncons/json_memory_usage.hpp>
 #include <jsoncons/json_object.hpp>
 #include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parse_context.hpp>
 #include <jsoncons/json_reader.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/reflect/json_conv_traits.hpp>
@@ -47,6 +51,7 @@
 #include <jsoncons/source.hpp>
 #include <jsoncons/utility/bigint.hpp>
 #include <jsoncons/utility/byte_string.hpp>
+#include <jsoncons/utility/hash.hpp>
 #include <jsoncons/utility/heap_string.hpp>
 #include <jsoncons/utility/more_type_traits.hpp>
 #include <jsoncons/utility/unicode_traits.hpp>
@@ -265,6 +270,24 @@ namespace jsoncons {
                 return has_value_;
             }
         };
+
+        // The node behind json_storage_kind::shared, a value together with
+        // the number of basic_json values that share it. A node becomes unshareable
+        // once non-const access has handed out a reference into its value, and is
+        // then only ever owned by one basic_json value.
+        template <typename Json>
+        struct shared_json_node
+        {
+            std::atomic<std::size_t> count;
+            bool unshareable;
+            Json value;
+
+            template <typename... Args>
+            explicit shared_json_node(Args&&... args)
+                : count(1), unshareable(false), value(std::forward<Args>(args)...)
+            {
+            }
+        };
     } // namespace detail
 
     struct sorted_policy 
@@ -391,6 +414,8 @@ namespace jsoncons {
     template <typename CharT,typename Policy,typename Allocator>
     class basic_json
     {
+        template <typename Json,template <typename,typename> class SequenceContainer>
+        friend class json_array;
     public:
         static_assert(std::allocator_traits<Allocator>::is_always_equal::value || ext_traits::is_propagating_allocator<Allocator>::value,
                       "Regular stateful allocators must be wrapped with std::scoped_allocator_adaptor");
@@ -435,6 +460,8 @@ namespace jsoncons {
 
         static constexpr uint8_t major_type_shift = 0x04;
         static constexpr uint8_t additional_information_mask = (1U << 4) - 1;
+        // Room for elements allocated with an array created by the first insertion into an empty_array
+        static constexpr std::size_t implicit_array_capacity = 4;
 
     public:
         struct common_storage
@@ -468,6 +495,18 @@ namespace jsoncons {
             }
         };  
 
+        struct empty_array_storage
+        {
+            uint8_t storage_kind_:4;
+            uint8_t short_str_length_:4;
+            semantic_tag tag_;
+
+            empty_array_storage(semantic_tag tag)
+                : storage_kind_(static_cast<uint8_t>(json_storage_kind::empty_array)), short_str_length_(0), tag_(tag)
+            {
+            }
+        };  
+
         struct bool_storage
         {
             uint8_t storage_kind_:4;
@@ -861,6 +900,107 @@ namespace jsoncons {
             }
         };
 
+        // Copies share the node, non-const access first gives this value a node
+        // of its own if the node is shared with others (copy on write). The copy gives
+        // the nested arrays and objects of its value shared nodes, so that copies made 
+        // from it later copy only one level.
+        struct shared_storage
+        {
+            using node_type = detail::shared_json_node<basic_json>;
+            using allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type>;
+            using pointer = typename std::allocator_traits<allocator_type>::pointer;
+
+            uint8_t storage_kind_:4;
+            uint8_t short_str_length_:4;
+            semantic_tag tag_;
+            pointer ptr_;
+
+            shared_storage(pointer ptr)
+                : storage_kind_(static_cast<uint8_t>(json_storage_kind::shared)), short_str_length_(0), tag_(ptr->value.tag()), 
+                  ptr_(ptr)
+            {
+            }
+
+            shared_storage(const shared_storage& other)
+                : storage_kind_(other.storage_kind_), short_str_length_(0), tag_(other.tag_), ptr_(other.ptr_)
+            {
+            }
+
+            shared_storage& operator=(const shared_storage& other) = delete;
+
+            template <typename... Args>
+            static pointer create(const Allocator& alloc, Args&& ... args)
+            {
+                allocator_type node_alloc(alloc);
+                auto ptr = std::allocator_traits<allocator_type>::allocate(node_alloc, 1);
+                JSONCONS_TRY
+                {
+                    std::allocator_traits<allocator_type>::construct(node_alloc, ext_traits::to_plain_pointer(ptr), 
+                        std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    std::allocator_traits<allocator_type>::deallocate(node_alloc, ptr, 1);
+                    JSONCONS_RETHROW;
+                }
+                return ptr;
+            }
+
+            void release() noexcept
+            {
+                if (ptr_->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    allocator_type node_alloc(ptr_->value.get_allocator());
+                    std::allocator_traits<allocator_type>::destroy(node_alloc, ext_traits::to_plain_pointer(ptr_));
+                    std::allocator_traits<allocator_type>::deallocate(node_alloc, ptr_, 1);
+                }
+            }
+
+            std::size_t use_count() const noexcept
+            {
+                return ptr_->count.load(std::memory_order_acquire);
+            }
+
+            Allocator get_allocator() const
+            {
+                return ptr_->value.get_allocator();
+            }
+
+            // A node for another value that copies this one: this node, or a copy of it
+            // if it is unshareable
+            pointer share() const
+            {
+                if (ptr_->unshareable)
+                {
+                    auto ptr = create(get_allocator(), ptr_->value, get_allocator());
+                    ptr->value.share_children();
+                    return ptr;
+                }
+                ptr_->count.fetch_add(1, std::memory_order_relaxed);
+                return ptr_;
+            }
+
+            // The caller may keep a reference into the value and change it later, so the
+            // node is made unshareable, as a copy on write string is once it leaks a reference
+            basic_json& value()
+            {
+                if (use_count() != 1)
+                {
+                    auto ptr = create(get_allocator(), ptr_->value, get_allocator());
+                    release();
+                    ptr_ = ptr;
+                    ptr_->value.share_children();
+                }
+                ptr_->unshareable = true;
+                return ptr_->value;
+            }
+
+            const basic_json& value() const
+            {
+                return ptr_->value;
+            }
+        };
+
         union 
         {
             common_storage common_;
@@ -876,8 +1016,10 @@ namespace jsoncons {
             array_storage array_;
             object_storage object_;
             empty_object_storage empty_object_;
+            empty_array_storage empty_array_;
             json_const_reference_storage json_const_pointer_;
             json_reference_storage json_ref_;
+            shared_storage shared_;
         };
 
         void destroy()
@@ -904,8 +1046,9 @@ namespace jsoncons {
                     {
                         auto& stor = cast<array_storage>();
                         typename array_storage::allocator_type alloc{stor.ptr_->get_allocator()};
+                        const std::size_t n = stor.ptr_->allocation_size();
                         std::allocator_traits<typename array_storage::allocator_type>::destroy(alloc, ext_traits::to_plain_pointer(stor.ptr_));
-                        std::allocator_traits<typename array_storage::allocator_type>::deallocate(alloc, stor.ptr_,1);
+                        std::allocator_traits<typename array_storage::allocator_type>::deallocate(alloc, stor.ptr_, n);
                     }
                     break;
                 }
@@ -920,6 +1063,9 @@ namespace jsoncons {
                     }
                     break;
                 }
+                case json_storage_kind::shared:
+                    cast<shared_storage>().release();
+                    break;
                 default:
                     break;
             }
@@ -938,25 +1084,45 @@ namespace jsoncons {
             return heap_string_factory_type::create(data, length, ext_tag, alloc); 
         }
         
+        // The array and room for its first capacity elements share one allocation
         template <typename... Args>
-        typename array_storage::pointer create_array(const allocator_type& alloc, Args&& ... args)
+        typename array_storage::pointer create_array(const allocator_type& alloc, std::size_t capacity, Args&& ... args)
         {
             using stor_allocator_type = typename array_storage::allocator_type;
             stor_allocator_type stor_alloc(alloc);
-            auto ptr = std::allocator_traits<stor_allocator_type>::allocate(stor_alloc, 1);
+            const std::size_t n = array::allocation_size(capacity);
+            auto ptr = std::allocator_traits<stor_allocator_type>::allocate(stor_alloc, n);
             JSONCONS_TRY
             {
                 std::allocator_traits<stor_allocator_type>::construct(stor_alloc, ext_traits::to_plain_pointer(ptr), 
-                    std::forward<Args>(args)...);
+                    detail::inline_capacity_arg, capacity, std::forward<Args>(args)...);
             }
             JSONCONS_CATCH(...)
             {
-                std::allocator_traits<stor_allocator_type>::deallocate(stor_alloc, ptr,1);
+                std::allocator_traits<stor_allocator_type>::deallocate(stor_alloc, ptr, n);
                 JSONCONS_RETHROW;
             }
             return ptr;
         }
 
+        template <typename InputIt>
+        static std::size_t range_capacity(InputIt first, InputIt last, std::forward_iterator_tag)
+        {
+            return static_cast<std::size_t>(std::distance(first, last));
+        }
+
+        template <typename InputIt>
+        static std::size_t range_capacity(InputIt, InputIt, std::input_iterator_tag)
+        {
+            return 0;
+        }
+
+        template <typename InputIt>
+        static std::size_t range_capacity(InputIt first, InputIt last)
+        {
+            return range_capacity(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+        }
+
         template <typename... Args>
         typename object_storage::pointer create_object(const allocator_type& alloc, Args&& ... args)
         {
@@ -976,6 +1142,73 @@ namespace jsoncons {
             return ptr;
         }
 
+        void add_memory_usage(json_memory_usage& usage) const
+        {
+            switch (storage_kind())
+            {
+                case json_storage_kind::long_str:
+                    if (cast<long_string_storage>().ptr_ != nullptr)
+                    {
+                        usage.strings += long_string_storage::heap_string_factory_type::allocated_size(cast<long_string_storage>().ptr_);
+                    }
+                    break;
+                case json_storage_kind::byte_str:
+                    if (cast<byte_string_storage>().ptr_ != nullptr)
+                    {
+                        usage.byte_strings += byte_string_storage::heap_string_factory_type::allocated_size(cast<byte_string_storage>().ptr_);
+                    }
+                    break;
+                case json_storage_kind::array:
+                {
+                    const auto& arr = cast<array_storage>().value();
+                    const std::size_t unused = arr.unused_bytes();
+                    usage.arrays += arr.allocated_bytes() - unused;
+                    usage.slack += unused;
+                    for (const auto& item : arr)
+                    {
+                        item.add_memory_usage(usage);
+                    }
+                    break;
+                }
+                case json_storage_kind::object:
+                {
+                    using key_value_type = typename object::key_value_type;
+
+                    const auto& obj = cast<object_storage>().value();
+                    usage.objects += sizeof(object) + obj.size()*sizeof(key_value_type);
+                    usage.slack += (obj.capacity() - obj.size())*sizeof(key_value_type);
+                    for (const auto& member : obj)
+                    {
+                        add_key_memory_usage(member.key(), usage);
+                        member.value().add_memory_usage(usage);
+                    }
+                    break;
+                }
+                default: // references and shared values are not owned
+                    break;
+            }
+        }
+
+        // A std::basic_string owns its characters unless they are stored in the string object
+        template <typename Traits,typename CharAllocator>
+        static void add_key_memory_usage(const std::basic_string<char_type,Traits,CharAllocator>& key, json_memory_usage& usage)
+        {
+            const char* first = reinterpret_cast<const char*>(std::addressof(key));
+            const char* p = reinterpret_cast<const char*>(key.data());
+            std::less<const char*> less;
+            if (less(p, first) || !less(p, first + sizeof(key)))
+            {
+                usage.strings += (key.size() + 1)*sizeof(char_type);
+                usage.slack += (key.capacity() - key.size())*sizeof(char_type);
+            }
+        }
+
+        // Other key types, such as interned keys, do not belong to a single value
+        template <typename Key>
+        static void add_key_memory_usage(const Key&, json_memory_usage&)
+        {
+        }
+
         template <typename StorageType,typename... Args>
         void construct(Args&&... args)
         {
@@ -1017,6 +1250,16 @@ namespace jsoncons {
             return empty_object_;
         }
 
+        empty_array_storage& cast(identity<empty_array_storage>) 
+        {
+            return empty_array_;
+        }
+
+        const empty_array_storage& cast(identity<empty_array_storage>) const
+        {
+            return empty_array_;
+        }
+
         bool_storage& cast(identity<bool_storage>) 
         {
             return boolean_;
@@ -1137,6 +1380,16 @@ namespace jsoncons {
             return json_ref_;
         }
 
+        shared_storage& cast(identity<shared_storage>) 
+        {
+            return shared_;
+        }
+
+        const shared_storage& cast(identity<shared_storage>) const
+        {
+            return shared_;
+        }
+
         template <typename TypeL,typename TypeR>
         void swap_l_r(basic_json& other) noexcept
         {
@@ -1158,6 +1411,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::null         : swap_l_r<TypeL, null_storage>(other); break;
                 case json_storage_kind::empty_object : swap_l_r<TypeL, empty_object_storage>(other); break;
+                case json_storage_kind::empty_array : swap_l_r<TypeL, empty_array_storage>(other); break;
                 case json_storage_kind::boolean         : swap_l_r<TypeL, bool_storage>(other); break;
                 case json_storage_kind::int64        : swap_l_r<TypeL, int64_storage>(other); break;
                 case json_storage_kind::uint64       : swap_l_r<TypeL, uint64_storage>(other); break;
@@ -1170,6 +1424,7 @@ namespace jsoncons {
                 case json_storage_kind::object       : swap_l_r<TypeL, object_storage>(other); break;
                 case json_storage_kind::json_const_ref : swap_l_r<TypeL, json_const_reference_storage>(other); break;
                 case json_storage_kind::json_ref : swap_l_r<TypeL, json_reference_storage>(other); break;
+                case json_storage_kind::shared : swap_l_r<TypeL, shared_storage>(other); break;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -1204,9 +1459,10 @@ namespace jsoncons {
                     }
                     case json_storage_kind::array:
                     {
+                        const auto& val = other.cast<array_storage>().value();
                         auto ptr = create_array(
                             std::allocator_traits<Allocator>::select_on_container_copy_construction(other.cast<array_storage>().get_allocator()), 
-                            other.cast<array_storage>().value());
+                            val.size(), val.begin(), val.end());
                         construct<array_storage>(ptr, other.tag());
                         break;
                     }
@@ -1218,6 +1474,9 @@ namespace jsoncons {
                         construct<object_storage>(ptr, other.tag());
                         break;
                     }
+                    case json_storage_kind::shared:
+                        construct<shared_storage>(other.cast<shared_storage>().share());
+                        break;
                     default:
                         JSONCONS_UNREACHABLE();
                         break;
@@ -1251,7 +1510,8 @@ namespace jsoncons {
                     }
                     case json_storage_kind::array:
                     {
-                        auto ptr = create_array(alloc, other.cast<array_storage>().value());
+                        const auto& val = other.cast<array_storage>().value();
+                        auto ptr = create_array(alloc, val.size(), val.begin(), val.end());
                         construct<array_storage>(ptr, other.tag());
                         break;
                     }
@@ -1261,6 +1521,17 @@ namespace jsoncons {
                         construct<object_storage>(ptr, other.tag());
                         break;
                     }
+                    case json_storage_kind::shared:
+                        // Share the node only if it was allocated with an equal allocator
+                        if (other.cast<shared_storage>().get_allocator() == alloc)
+                        {
+                            construct<shared_storage>(other.cast<shared_storage>().share());
+                        }
+                        else
+                        {
+                            uninitialized_copy_a(other.cast<shared_storage>().value(), alloc);
+                        }
+                        break;
                     default:
                         JSONCONS_UNREACHABLE();
                         break;
@@ -1268,6 +1539,73 @@ namespace jsoncons {
             }
         }
 
+        // Moves the elements and member values that are arrays or objects into nodes of 
+        // their own, one level only, so that copying this value later copies only this level
+        void share_children()
+        {
+            switch (storage_kind())
+            {
+                case json_storage_kind::array:
+                    for (auto& item : cast<array_storage>().value())
+                    {
+                        if (item.storage_kind() == json_storage_kind::array || item.storage_kind() == json_storage_kind::object)
+                        {
+                            item = basic_json(json_shared_arg, std::move(item));
+                        }
+                    }
+                    break;
+                case json_storage_kind::object:
+                    for (auto& member : cast<object_storage>().value())
+                    {
+                        basic_json& item = member.value();
+                        if (item.storage_kind() == json_storage_kind::array || item.storage_kind() == json_storage_kind::object)
+                        {
+                            item = basic_json(json_shared_arg, std::move(item));
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // If this value is the only owner of its shared node, replaces it with the node's value,
+        // so that json_array::flatten_and_destroy releases nested nodes without recursion
+        void take_shared_value() noexcept
+        {
+            if (cast<shared_storage>().use_count() == 1)
+            {
+                basic_json val(std::move(cast<shared_storage>().ptr_->value));
+                move_assignment(std::move(val));
+            }
+        }
+
+        // Values that don't allocate are copied, values that are already shared gain an owner
+        void uninitialized_share(const basic_json& other)
+        {
+            switch (other.storage_kind())
+            {
+                case json_storage_kind::long_str:
+                case json_storage_kind::byte_str:
+                case json_storage_kind::array:
+                case json_storage_kind::object:
+                {
+                    auto alloc = std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator());
+                    construct<shared_storage>(shared_storage::create(alloc, other, alloc));
+                    break;
+                }
+                case json_storage_kind::json_const_ref:
+                    uninitialized_share(other.cast<json_const_reference_storage>().value());
+                    break;
+                case json_storage_kind::json_ref:
+                    uninitialized_share(other.cast<json_reference_storage>().value());
+                    break;
+                default:
+                    uninitialized_copy(other);
+                    break;
+            }
+        }
+
         void uninitialized_move(basic_json&& other) noexcept
         {
             if (is_trivial_storage(other.storage_kind()))
@@ -1294,6 +1632,10 @@ namespace jsoncons {
                         construct<object_storage>(other.cast<object_storage>());
                         other.construct<null_storage>();
                         break;
+                    case json_storage_kind::shared:
+                        construct<shared_storage>(other.cast<shared_storage>());
+                        other.construct<null_storage>();
+                        break;
                     default:
                         JSONCONS_UNREACHABLE();
                         break;
@@ -1351,6 +1693,13 @@ namespace jsoncons {
                     case json_storage_kind::object:
                         cast<object_storage>().assign(other.cast<object_storage>());
                         break;
+                    case json_storage_kind::shared:
+                    {
+                        shared_storage stor(other.cast<shared_storage>().share());
+                        destroy();
+                        construct<shared_storage>(stor);
+                        break;
+                    }
                     default:
                         JSONCONS_UNREACHABLE();
                         break;
@@ -1396,6 +1745,82 @@ namespace jsoncons {
             return at(name);
         }
 
+        uint64_t structural_hash() const noexcept
+        {
+            // Distinct seeds per kind of value, so that e.g. null, false, 0, "" and [] differ
+            constexpr uint64_t null_seed{0x6a09e667f3bcc908ULL};
+            constexpr uint64_t bool_seed{0xbb67ae8584caa73bULL};
+            constexpr uint64_t number_seed{0x3c6ef372fe94f82bULL};
+            constexpr uint64_t string_seed{0xa54ff53a5f1d36f1ULL};
+            constexpr uint64_t byte_string_seed{0x510e527fade682d1ULL};
+
+            switch (storage_kind())
+            {
+                case json_storage_kind::null:
+                    return null_seed;
+                case json_storage_kind::boolean:
+                    return utility::hash_combine(bool_seed, cast<bool_storage>().value() ? 1 : 0);
+                case json_storage_kind::int64:
+                    return utility::hash_combine(number_seed, utility::hash_double(static_cast<double>(cast<int64_storage>().value())));
+                case json_storage_kind::uint64:
+                    return utility::hash_combine(number_seed, utility::hash_double(static_cast<double>(cast<uint64_storage>().value())));
+                case json_storage_kind::half_float:
+                    return utility::hash_combine(number_seed, utility::hash_double(binary::decode_half(cast<half_storage>().value())));
+                case json_storage_kind::float64:
+                    return utility::hash_combine(number_seed, utility::hash_double(cast<double_storage>().value()));
+                case json_storage_kind::short_str:
+                case json_storage_kind::long_str:
+                {
+                    if (is_number_tag(tag()))
+                    {
+                        auto result = try_as_double();
+                        if (result)
+                        {
+                            return utility::hash_combine(number_seed, utility::hash_double(*result));
+                        }
+                    }
+                    auto sv = as_string_view();
+                    return utility::hash_combine(string_seed, utility::hash_chars(sv.data(), sv.size()));
+                }
+                case json_storage_kind::byte_str:
+                {
+                    const auto& stor = cast<byte_string_storage>();
+                    return utility::hash_combine(byte_string_seed, utility::hash_chars(stor.data(), stor.length()));
+                }
+                case json_storage_kind::array:
+                {
+                    utility::array_hasher hasher;
+                    for (const auto& item : cast<array_storage>().value())
+                    {
+                        hasher.add(item.structural_hash());
+                    }
+                    return hasher.hash();
+                }
+                case json_storage_kind::empty_array:
+                    return utility::array_hasher().hash();
+                case json_storage_kind::empty_object:
+                    return utility::object_hasher().hash();
+                case json_storage_kind::object:
+                {
+                    utility::object_hasher hasher;
+                    for (const auto& member : cast<object_storage>().value())
+                    {
+                        hasher.add(member.key().data(), member.key().size(), member.value().structural_hash());
+                    }
+                    return hasher.hash();
+                }
+                case json_storage_kind::json_const_ref:
+                    return cast<json_const_reference_storage>().value().structural_hash();
+                case json_storage_kind::json_ref:
+                    return cast<json_reference_storage>().value().structural_hash();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().structural_hash();
+                default:
+                    JSONCONS_UNREACHABLE();
+                    break;
+            }
+        }
+
     public:
 
         basic_json& evaluate() 
@@ -1456,6 +1881,7 @@ namespace jsoncons {
                     return json_type::string_value;
                 case json_storage_kind::byte_str:
                     return json_type::byte_string_value;
+                case json_storage_kind::empty_array:
                 case json_storage_kind::array:
                     return json_type::array_value;
                 case json_storage_kind::empty_object:
@@ -1465,6 +1891,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().type();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().type();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().type();
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -1483,6 +1911,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().tag();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().tag();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().tag();
                 default:
                     return common_.tag_;
             }
@@ -1494,6 +1924,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::array:
                     return cast<array_storage>().value().size();
+                case json_storage_kind::empty_array:
                 case json_storage_kind::empty_object:
                     return 0;
                 case json_storage_kind::object:
@@ -1502,6 +1933,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().size();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().size();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().size();
                 default:
                     return 0;
             }
@@ -1531,6 +1964,8 @@ namespace jsoncons {
                     return result_type(cast<json_const_reference_storage>().value().as_string_view());
                 case json_storage_kind::json_ref:
                     return result_type(cast<json_reference_storage>().value().as_string_view());
+                case json_storage_kind::shared:
+                    return result_type(cast<shared_storage>().value().as_string_view());
                 default:
                    return result_type(jsoncons::unexpect, conv_errc::not_string);
             }
@@ -1578,6 +2013,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template try_as_byte_string<T>(aset);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template try_as_byte_string<T>(aset);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template try_as_byte_string<T>(aset);
                 default:
                     return result_type(jsoncons::unexpect, conv_errc::not_byte_string);
             }
@@ -1606,6 +2043,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().try_as_byte_string_view();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().try_as_byte_string_view();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().try_as_byte_string_view();
                 default:
                     return result_type(jsoncons::unexpect, conv_errc::not_byte_string);
             }
@@ -1621,6 +2060,12 @@ namespace jsoncons {
             return *result;
         }
 
+        // Values of different kinds are ordered by kind, with an empty_array ordered as an array
+        static int storage_kind_order(json_storage_kind kind) noexcept
+        {
+            return static_cast<int>(kind == json_storage_kind::empty_array ? json_storage_kind::array : kind);
+        }
+
         int compare(const basic_json& rhs) const noexcept
         {
             if (this == &rhs)
@@ -1647,8 +2092,21 @@ namespace jsoncons {
                             return cast<json_reference_storage>().value().compare(rhs);
                     }
                     break;
+                case json_storage_kind::shared:
+                    switch (rhs.storage_kind())
+                    {
+                        case json_storage_kind::shared:
+                            if (cast<shared_storage>().ptr_ == rhs.cast<shared_storage>().ptr_)
+                            {
+                                return 0;
+                            }
+                            return cast<shared_storage>().value().compare(rhs.cast<shared_storage>().value());
+                        default:
+                            return cast<shared_storage>().value().compare(rhs);
+                    }
+                    break;
                 case json_storage_kind::null:
-                    return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                    return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                 case json_storage_kind::empty_object:
                     switch (rhs.storage_kind())
                     {
@@ -1660,8 +2118,10 @@ namespace jsoncons {
                             return compare(rhs.cast<json_const_reference_storage>().value());
                         case json_storage_kind::json_ref:
                             return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
                         default:
-                            return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                            return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                     }
                     break;
                 case json_storage_kind::boolean:
@@ -1673,8 +2133,10 @@ namespace jsoncons {
                             return compare(rhs.cast<json_const_reference_storage>().value());
                         case json_storage_kind::json_ref:
                             return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
                         default:
-                            return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                            return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                     }
                     break;
                 case json_storage_kind::int64:
@@ -1702,8 +2164,10 @@ namespace jsoncons {
                             return compare(rhs.cast<json_const_reference_storage>().value());
                         case json_storage_kind::json_ref:
                             return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
                         default:
-                            return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                            return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                     }
                     break;
                 case json_storage_kind::uint64:
@@ -1730,8 +2194,10 @@ namespace jsoncons {
                             return compare(rhs.cast<json_const_reference_storage>().value());
                         case json_storage_kind::json_ref:
                             return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
                         default:
-                            return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                            return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                     }
                     break;
                 case json_storage_kind::float64:
@@ -1756,6 +2222,8 @@ namespace jsoncons {
                             return compare(rhs.cast<json_const_reference_storage>().value());
                         case json_storage_kind::json_ref:
                             return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
                         default:
                             if (is_string_storage(rhs.storage_kind()) && is_number_tag(rhs.tag()))
                             {
@@ -1766,7 +2234,7 @@ namespace jsoncons {
                             }
                             else
                             {
-                                return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                                return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                             }
                     }
                     break;
@@ -1796,6 +2264,8 @@ namespace jsoncons {
                                 return compare(rhs.cast<json_const_reference_storage>().value());
                             case json_storage_kind::json_ref:
                                 return compare(rhs.cast<json_reference_storage>().value());
+                            case json_storage_kind::shared:
+                                return compare(rhs.cast<shared_storage>().value());
                             default:
                                 if (is_string_storage(rhs.storage_kind()))
                                 {
@@ -1805,7 +2275,7 @@ namespace jsoncons {
                                 }
                                 else
                                 {
-                                    return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                                    return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                                 }
                         }
                     }
@@ -1822,8 +2292,10 @@ namespace jsoncons {
                                 return compare(rhs.cast<json_const_reference_storage>().value());
                             case json_storage_kind::json_ref:
                                 return compare(rhs.cast<json_reference_storage>().value());
+                            case json_storage_kind::shared:
+                                return compare(rhs.cast<shared_storage>().value());
                             default:
-                                return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                                return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                         }
                     }
                     break;
@@ -1838,13 +2310,34 @@ namespace jsoncons {
                             return compare(rhs.cast<json_const_reference_storage>().value());
                         case json_storage_kind::json_ref:
                             return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
                         default:
-                            return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                            return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
+                    }
+                    break;
+                case json_storage_kind::empty_array:
+                    switch (rhs.storage_kind())
+                    {
+                        case json_storage_kind::empty_array:
+                            return 0;
+                        case json_storage_kind::array:
+                            return rhs.empty() ? 0 : -1;
+                        case json_storage_kind::json_const_ref:
+                            return compare(rhs.cast<json_const_reference_storage>().value());
+                        case json_storage_kind::json_ref:
+                            return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
+                        default:
+                            return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                     }
                     break;
                 case json_storage_kind::array:
                     switch (rhs.storage_kind())
                     {
+                        case json_storage_kind::empty_array:
+                            return empty() ? 0 : 1;
                         case json_storage_kind::array:
                         {
                             if (cast<array_storage>().value() == rhs.cast<array_storage>().value())
@@ -1856,8 +2349,10 @@ namespace jsoncons {
                             return compare(rhs.cast<json_const_reference_storage>().value());
                         case json_storage_kind::json_ref:
                             return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
                         default:
-                            return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                            return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                     }
                     break;
                 case json_storage_kind::object:
@@ -1876,8 +2371,10 @@ namespace jsoncons {
                             return compare(rhs.cast<json_const_reference_storage>().value());
                         case json_storage_kind::json_ref:
                             return compare(rhs.cast<json_reference_storage>().value());
+                        case json_storage_kind::shared:
+                            return compare(rhs.cast<shared_storage>().value());
                         default:
-                            return static_cast<int>(storage_kind()) - static_cast<int>(rhs.storage_kind());
+                            return storage_kind_order(storage_kind()) - storage_kind_order(rhs.storage_kind());
                     }
                     break;
                 default:
@@ -1886,6 +2383,14 @@ namespace jsoncons {
             }
         }
 
+        // Structural hash, stable across runs. Values that compare equal hash equal:
+        // numbers (and strings tagged as numbers) hash by their double value,
+        // and object members are combined independently of their order.
+        std::size_t hash() const noexcept
+        {
+            return static_cast<std::size_t>(structural_hash());
+        }
+
         void swap(basic_json& other) noexcept
         {
             if (this == &other)
@@ -1905,6 +2410,7 @@ namespace jsoncons {
                 {
                     case json_storage_kind::null: swap_l<null_storage>(other); break;
                     case json_storage_kind::empty_object : swap_l<empty_object_storage>(other); break;
+                    case json_storage_kind::empty_array : swap_l<empty_array_storage>(other); break;
                     case json_storage_kind::boolean: swap_l<bool_storage>(other); break;
                     case json_storage_kind::int64: swap_l<int64_storage>(other); break;
                     case json_storage_kind::uint64: swap_l<uint64_storage>(other); break;
@@ -1917,6 +2423,7 @@ namespace jsoncons {
                     case json_storage_kind::object: swap_l<object_storage>(other); break;
                     case json_storage_kind::json_const_ref: swap_l<json_const_reference_storage>(other); break;
                     case json_storage_kind::json_ref: swap_l<json_reference_storage>(other); break;
+                    case json_storage_kind::shared: swap_l<shared_storage>(other); break;
                     default:
                         JSONCONS_UNREACHABLE();
                         break;
@@ -1931,6 +2438,7 @@ namespace jsoncons {
         parse(const Source& source, 
               const basic_json_decode_options<char_type>& options = basic_json_options<char_type>())
         {
+            JSONCONS_INSTRUMENT_TIMER(parse);
             json_decoder<basic_json> decoder;
             basic_json_parser<char_type> parser(options);
 
@@ -1957,6 +2465,7 @@ namespace jsoncons {
             parse(const allocator_set<allocator_type,TempAlloc>& aset, const Source& source, 
               const basic_json_decode_options<char_type>& options = basic_json_options<char_type>())
         {
+            JSONCONS_INSTRUMENT_TIMER(parse);
             json_decoder<basic_json> decoder(aset.get_allocator(), aset.get_temp_allocator());
             basic_json_parser<char_type,TempAlloc> parser(options, aset.get_temp_allocator());
 
@@ -1977,6 +2486,26 @@ namespace jsoncons {
             return decoder.get_result();
         }
 
+        template <typename Source,typename TempAlloc>
+        static
+        typename std::enable_if<ext_traits::is_sequence_of<Source,char_type>::value,basic_json>::type
+        parse(json_parse_context<basic_json,TempAlloc>& context, const Source& source)
+        {
+            std::error_code ec;
+            context.parse(string_view_type(source.data(), source.size()), ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(ser_error(ec, context.line(), context.column()));
+            }
+            return context.get_result();
+        }
+
+        template <typename TempAlloc>
+        static basic_json parse(json_parse_context<basic_json,TempAlloc>& context, const char_type* source)
+        {
+            return parse(context, string_view_type(source));
+        }
+
         static basic_json parse(const char_type* str, std::size_t length, 
             const basic_json_decode_options<char_type>& options = basic_json_options<char_type>())
         {
@@ -2128,6 +2657,7 @@ namespace jsoncons {
               const basic_json_decode_options<char_type>& options, 
               std::function<bool(json_errc,const ser_context&)> err_handler)
         {
+            JSONCONS_INSTRUMENT_TIMER(parse);
             json_decoder<basic_json> decoder;
             basic_json_parser<char_type> parser(options,err_handler);
 
@@ -2328,42 +2858,40 @@ namespace jsoncons {
 
         explicit basic_json(json_array_arg_t) 
         {
-            auto ptr = create_array(Allocator{});
-            construct<array_storage>(ptr, semantic_tag::none);
+            construct_empty_array(semantic_tag::none);
         }
 
         basic_json(json_array_arg_t, const Allocator& alloc) 
         {
-            auto ptr = create_array(alloc);
+            auto ptr = create_array(alloc, 0);
             construct<array_storage>(ptr, semantic_tag::none);
         }
 
         basic_json(json_array_arg_t, std::size_t count, const basic_json& value,
             semantic_tag tag = semantic_tag::none) 
         {
-            auto ptr = create_array(Allocator(), count, value);
+            auto ptr = create_array(Allocator(), count, count, value);
             construct<array_storage>(ptr, tag);
         }
 
         basic_json(json_array_arg_t, std::size_t count, const basic_json& value,
             semantic_tag tag, const Allocator& alloc) 
         {
-            auto ptr = create_array(alloc, count, value);
+            auto ptr = create_array(alloc, count, count, value);
             construct<array_storage>(ptr, tag);
         }
 
         basic_json(json_array_arg_t, 
             semantic_tag tag) 
         {
-            auto ptr = create_array(Allocator());
-            construct<array_storage>(ptr, tag);
+            construct_empty_array(tag);
         }
 
         basic_json(json_array_arg_t, 
             semantic_tag tag, 
             const Allocator& alloc) 
         {
-            auto ptr = create_array(alloc);
+            auto ptr = create_array(alloc, 0);
             construct<array_storage>(ptr, tag);
         }
 
@@ -2372,7 +2900,7 @@ namespace jsoncons {
                    InputIt first, InputIt last, 
                    semantic_tag tag = semantic_tag::none) 
         {
-            auto ptr = create_array(Allocator(), first, last);
+            auto ptr = create_array(Allocator(), range_capacity(first, last), first, last);
             construct<array_storage>(ptr, tag);
         }
 
@@ -2382,7 +2910,7 @@ namespace jsoncons {
                    semantic_tag tag, 
                    const Allocator& alloc) 
         {
-            auto ptr = create_array(alloc, first, last);
+            auto ptr = create_array(alloc, range_capacity(first, last), first, last);
             construct<array_storage>(ptr, tag);
         }
 
@@ -2390,7 +2918,7 @@ namespace jsoncons {
                    std::initializer_list<basic_json> init, 
                    semantic_tag tag = semantic_tag::none) 
         {
-            auto ptr = create_array(Allocator(), init);
+            auto ptr = create_array(Allocator(), init.size(), init.begin(), init.end());
             construct<array_storage>(ptr, tag);
         }
 
@@ -2399,7 +2927,7 @@ namespace jsoncons {
                    semantic_tag tag, 
                    const Allocator& alloc) 
         {
-            auto ptr = create_array(alloc, init);
+            auto ptr = create_array(alloc, init.size(), init.begin(), init.end());
             construct<array_storage>(ptr, tag);
         }
 
@@ -2427,25 +2955,47 @@ namespace jsoncons {
             }
         }
 
+        basic_json(json_shared_arg_t, const basic_json& val) 
+        {
+            uninitialized_share(val);
+        }
+
+        basic_json(json_shared_arg_t, basic_json&& val) 
+        {
+            switch (val.storage_kind())
+            {
+                case json_storage_kind::long_str:
+                case json_storage_kind::byte_str:
+                case json_storage_kind::array:
+                case json_storage_kind::object:
+                    construct<shared_storage>(shared_storage::create(val.get_allocator(), std::move(val)));
+                    break;
+                default:
+                    uninitialized_share(val);
+                    break;
+            }
+        }
+
         basic_json(const array& val, semantic_tag tag = semantic_tag::none)
         {
             auto ptr = create_array(
                 std::allocator_traits<Allocator>::select_on_container_copy_construction(val.get_allocator()), 
-                val);
+                val.size(), val.begin(), val.end());
             construct<array_storage>(ptr, tag);
         }
 
         basic_json(const array& val, semantic_tag tag, allocator_type alloc)
         {
-            auto ptr = create_array(alloc, val);
+            auto ptr = create_array(alloc, val.size(), val.begin(), val.end());
             construct<array_storage>(ptr, tag);
         }
 
         basic_json(array&& val, semantic_tag tag = semantic_tag::none)
         {
             auto alloc = val.get_allocator();
-            auto ptr = create_array(alloc, std::move(val));
+            auto ptr = create_array(alloc, val.size(), std::make_move_iterator(val.begin()), std::make_move_iterator(val.end()));
             construct<array_storage>(ptr, tag);
+            val.clear();
         }
 
         basic_json(const object& val, semantic_tag tag = semantic_tag::none)
@@ -2776,6 +3326,8 @@ namespace jsoncons {
                 }
                 case json_storage_kind::json_ref: 
                     return cast<json_reference_storage>().value()[key];
+                case json_storage_kind::shared: 
+                    return cast<shared_storage>().value()[key];
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }               
@@ -2806,6 +3358,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().at(key);
                 case json_storage_kind::json_ref: 
                     return cast<json_reference_storage>().value()[key];
+                case json_storage_kind::shared: 
+                    return cast<shared_storage>().value()[key];
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -3053,6 +3607,7 @@ namespace jsoncons {
         void dump(basic_json_visitor<char_type>& visitor, 
                   std::error_code& ec) const
         {
+            JSONCONS_INSTRUMENT_TIMER(encode);
             dump_noflush(visitor, ec);
             if (JSONCONS_UNLIKELY(ec))
             {
@@ -3063,6 +3618,7 @@ namespace jsoncons {
 
         write_result try_dump(basic_json_visitor<char_type>& visitor) const
         {
+            JSONCONS_INSTRUMENT_TIMER(encode);
             auto r = try_dump_noflush(visitor);
             visitor.flush();
             return r;
@@ -3078,6 +3634,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_null();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_null();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_null();
                 default:
                     return false;
             }
@@ -3108,6 +3666,8 @@ namespace jsoncons {
                     return cast<object_storage>().get_allocator();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().get_allocator();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().get_allocator();
                 default:
                     return get_default_allocator(typename std::allocator_traits<U>::is_always_equal());
             }
@@ -3125,6 +3685,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().ext_tag();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().ext_tag();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().ext_tag();
                 default:
                     return 0;
             }
@@ -3143,6 +3705,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().contains(key);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().contains(key);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().contains(key);
                 default:
                     return false;
             }
@@ -3171,6 +3735,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().count(key);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().count(key);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().count(key);
                 default:
                     return 0;
             }
@@ -3196,6 +3762,10 @@ namespace jsoncons {
             {
                 return cast<json_const_reference_storage>().value().is_string();
             }
+            if (storage_kind() == json_storage_kind::shared)
+            {
+                return cast<shared_storage>().value().is_string();
+            }
             return false;
         }
 
@@ -3214,6 +3784,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_byte_string();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_byte_string();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_byte_string();
                 default:
                     return false;
             }
@@ -3236,6 +3808,8 @@ namespace jsoncons {
                     return true;
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_bignum();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_bignum();
                 default:
                     return false;
             }
@@ -3251,6 +3825,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_bool();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_bool();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_bool();
                 default:
                     return false;
             }
@@ -3267,6 +3843,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_object();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_object();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_object();
                 default:
                     return false;
             }
@@ -3276,12 +3854,15 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
                 case json_storage_kind::array:
                     return true;
                 case json_storage_kind::json_const_ref:
                     return cast<json_const_reference_storage>().value().is_array();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_array();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_array();
                 default:
                     return false;
             }
@@ -3299,6 +3880,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_int64();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_int64();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_int64();
                 default:
                     return false;
             }
@@ -3316,6 +3899,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_uint64();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_uint64();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_uint64();
                 default:
                     return false;
             }
@@ -3331,6 +3916,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_half();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_half();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_half();
                 default:
                     return false;
             }
@@ -3346,6 +3933,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_double();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_double();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_double();
                 default:
                     return false;
             }
@@ -3369,6 +3958,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().is_number();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().is_number();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().is_number();
                 default:
                     return false;
             }
@@ -3387,6 +3978,7 @@ namespace jsoncons {
                     return cast<long_string_storage>().length() == 0;
                 case json_storage_kind::array:
                     return cast<array_storage>().value().empty();
+                case json_storage_kind::empty_array:
                 case json_storage_kind::empty_object:
                     return true;
                 case json_storage_kind::object:
@@ -3395,6 +3987,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().empty();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().empty();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().empty();
                 default:
                     return false;
             }
@@ -3412,6 +4006,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().capacity();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().capacity();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().capacity();
                 default:
                     return 0;
             }
@@ -3433,6 +4029,41 @@ namespace jsoncons {
             *this = basic_json(json_object_arg, tag());
         }
 
+        template <typename U=Allocator>
+        void construct_empty_array(semantic_tag tag)
+        {
+            construct_empty_array(tag, typename std::allocator_traits<U>::is_always_equal());
+        }
+
+        void construct_empty_array(semantic_tag tag, std::false_type)
+        {
+            auto ptr = create_array(Allocator(), 0);
+            construct<array_storage>(ptr, tag);
+        }
+
+        void construct_empty_array(semantic_tag tag, std::true_type)
+        {
+            construct<empty_array_storage>(tag);
+        }
+
+        // Replaces an empty_array with an array that has room for capacity elements in its own allocation 
+        template <typename U=Allocator>
+        void create_array_implicitly(std::size_t capacity)
+        {
+            create_array_implicitly(capacity, typename std::allocator_traits<U>::is_always_equal());
+        }
+
+        void create_array_implicitly(std::size_t, std::false_type)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Cannot create array implicitly - allocator is stateful."));
+        }
+
+        void create_array_implicitly(std::size_t capacity, std::true_type)
+        {
+            auto ptr = create_array(Allocator(), capacity);
+            construct<array_storage>(ptr, tag());
+        }
+
         void reserve(std::size_t n)
         {
             if (n > 0)
@@ -3442,6 +4073,9 @@ namespace jsoncons {
                     case json_storage_kind::array:
                         cast<array_storage>().value().reserve(n);
                         break;
+                    case json_storage_kind::empty_array:
+                        create_array_implicitly(n);
+                        break;
                     case json_storage_kind::empty_object:
                         create_object_implicitly();
                         cast<object_storage>().value().reserve(n);
@@ -3452,6 +4086,9 @@ namespace jsoncons {
                     case json_storage_kind::json_ref:
                         cast<json_reference_storage>().value().reserve(n);
                         break;
+                    case json_storage_kind::shared:
+                        cast<shared_storage>().value().reserve(n);
+                        break;
                     default:
                         break;
                 }
@@ -3465,9 +4102,19 @@ namespace jsoncons {
                 case json_storage_kind::array:
                     cast<array_storage>().value().resize(n);
                     break;
+                case json_storage_kind::empty_array:
+                    if (n > 0)
+                    {
+                        create_array_implicitly(n);
+                        cast<array_storage>().value().resize(n);
+                    }
+                    break;
                 case json_storage_kind::json_ref:
                     cast<json_reference_storage>().value().resize(n);
                     break;
+                case json_storage_kind::shared:
+                    cast<shared_storage>().value().resize(n);
+                    break;
                 default:
                     break;
             }
@@ -3481,9 +4128,19 @@ namespace jsoncons {
                 case json_storage_kind::array:
                     cast<array_storage>().value().resize(n, val);
                     break;
+                case json_storage_kind::empty_array:
+                    if (n > 0)
+                    {
+                        create_array_implicitly(n);
+                        cast<array_storage>().value().resize(n, val);
+                    }
+                    break;
                 case json_storage_kind::json_ref:
                     cast<json_reference_storage>().value().resize(n, val);
                     break;
+                case json_storage_kind::shared:
+                    cast<shared_storage>().value().resize(n, val);
+                    break;
                 default:
                     break;
             }
@@ -3575,6 +4232,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template as<T>(byte_string_arg, hint);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template as<T>(byte_string_arg, hint);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template as<T>(byte_string_arg, hint);
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
             }
@@ -3594,6 +4253,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().as_bool();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().as_bool();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().as_bool();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a bool"));
             }
@@ -3631,6 +4292,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template try_as_integer<T>();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template try_as_integer<T>();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template try_as_integer<T>();
                 default:
                     return result_type(jsoncons::unexpect, conv_errc::not_integer);
             }
@@ -3661,6 +4324,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template is_integer<T>();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template is_integer<T>();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template is_integer<T>();
                 default:
                     return false;
             }
@@ -3687,6 +4352,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template is_integer<T>();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template is_integer<T>();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template is_integer<T>();
                 default:
                     return false;
             }
@@ -3706,6 +4373,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template is_integer<IntegerType>();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template is_integer<IntegerType>();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template is_integer<IntegerType>();
                 default:
                     return false;
             }
@@ -3732,6 +4401,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template is_integer<IntegerType>();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template is_integer<IntegerType>();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template is_integer<IntegerType>();
                 default:
                     return false;
             }
@@ -3788,6 +4459,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().try_as_double();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().try_as_double();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().try_as_double();
                 default:
                     return result_type(jsoncons::unexpect, conv_errc::not_double);
             }
@@ -3834,6 +4507,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template try_as_string<T>(aset);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template try_as_string<T>(aset);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template try_as_string<T>(aset);
                 default:
                 {
                     value_type s = jsoncons::make_obj_using_allocator<value_type>(aset.get_allocator());
@@ -3884,6 +4559,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().as_cstring();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().as_cstring();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().as_cstring();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a cstring"));
             }
@@ -3906,6 +4583,8 @@ namespace jsoncons {
                 }
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().at(key);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().at(key);
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -3930,6 +4609,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().at(key);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().at(key);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().at(key);
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -3945,10 +4626,14 @@ namespace jsoncons {
                         JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
                     }
                     return cast<array_storage>().value().operator[](i);
+                case json_storage_kind::empty_array:
+                    JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
                 case json_storage_kind::object:
                     return cast<object_storage>().value().at(i);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().at(i);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().at(i);
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
             }
@@ -3964,12 +4649,16 @@ namespace jsoncons {
                         JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
                     }
                     return cast<array_storage>().value().operator[](i);
+                case json_storage_kind::empty_array:
+                    JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
                 case json_storage_kind::object:
                     return cast<object_storage>().value().at(i);
                 case json_storage_kind::json_const_ref:
                     return cast<json_const_reference_storage>().value().at(i);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().at(i);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().at(i);
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
             }
@@ -3985,6 +4674,8 @@ namespace jsoncons {
                     return object_iterator(cast<object_storage>().value().find(key));
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().find(key);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().find(key);
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -4002,6 +4693,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().find(key);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().find(key);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().find(key);
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -4032,6 +4725,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().at_or_null(key);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().at_or_null(key);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().at_or_null(key);
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -4065,13 +4760,36 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().template get_value_or<T,U>(key,std::forward<U>(default_value));
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().template get_value_or<T,U>(key,std::forward<U>(default_value));
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().template get_value_or<T,U>(key,std::forward<U>(default_value));
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
         }
 
+        // The heap bytes owned by this value and the values it contains
+        json_memory_usage memory_usage() const
+        {
+            json_memory_usage usage;
+            add_memory_usage(usage);
+            return usage;
+        }
+
         // Modifiers
 
+        // Rebuilds this value depth first, each array and object with exactly the room
+        // for its elements, and each array's elements in the same allocation as the array
+        void repack()
+        {
+            repack(get_allocator());
+        }
+
+        void repack(const allocator_type& alloc)
+        {
+            basic_json temp(*this, alloc);
+            swap(temp);
+        }
+
         void shrink_to_fit()
         {
             switch (storage_kind())
@@ -4085,6 +4803,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     cast<json_reference_storage>().value().shrink_to_fit();
                     break;
+                case json_storage_kind::shared:
+                    cast<shared_storage>().value().shrink_to_fit();
+                    break;
                 default:
                     break;
             }
@@ -4103,6 +4824,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     cast<json_reference_storage>().value().clear();
                     break;
+                case json_storage_kind::shared:
+                    cast<shared_storage>().value().clear();
+                    break;
                 default:
                     break;
             }
@@ -4118,6 +4842,8 @@ namespace jsoncons {
                     return object_iterator(cast<object_storage>().value().erase(pos));
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().erase(pos);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().erase(pos);
             default:
                 JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
             }
@@ -4133,6 +4859,8 @@ namespace jsoncons {
                     return object_iterator(cast<object_storage>().value().erase(first, last));
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().erase(first, last);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().erase(first, last);
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
             }
@@ -4142,10 +4870,14 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    return array_range().end();
                 case json_storage_kind::array:
                     return cast<array_storage>().value().erase(pos);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().erase(pos);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().erase(pos);
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
             }
@@ -4155,10 +4887,14 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    return array_range().end();
                 case json_storage_kind::array:
                     return cast<array_storage>().value().erase(first, last);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().erase(first, last);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().erase(first, last);
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
             }
@@ -4177,6 +4913,8 @@ namespace jsoncons {
                     break;
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().erase(key);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().erase(key);
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -4200,6 +4938,8 @@ namespace jsoncons {
                 }
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().insert_or_assign(key, std::forward<T>(val));
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().insert_or_assign(key, std::forward<T>(val));
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -4223,6 +4963,8 @@ namespace jsoncons {
                 }
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().try_emplace(key, std::forward<Args>(args)...);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().try_emplace(key, std::forward<Args>(args)...);
                 default:
                     JSONCONS_THROW(not_an_object(key.data(),key.length()));
             }
@@ -4249,6 +4991,9 @@ namespace jsoncons {
                         case json_storage_kind::json_ref:
                             cast<json_reference_storage>().value().merge(source);
                             break;
+                        case json_storage_kind::shared:
+                            cast<shared_storage>().value().merge(source);
+                            break;
                         default:
                             JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
                     }
@@ -4256,6 +5001,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     merge(source.cast<json_reference_storage>().value());
                     break;
+                case json_storage_kind::shared:
+                    merge(source.cast<shared_storage>().value());
+                    break;
                default:
                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
            }
@@ -4280,6 +5028,9 @@ namespace jsoncons {
                         case json_storage_kind::json_ref:
                             cast<json_reference_storage>().value().merge(std::move(source));
                             break;
+                        case json_storage_kind::shared:
+                            cast<shared_storage>().value().merge(std::move(source));
+                            break;
                         default:
                             JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
                     }
@@ -4287,6 +5038,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     merge(std::move(source.cast<json_reference_storage>().value()));
                     break;
+                case json_storage_kind::shared:
+                    merge(std::move(source.cast<shared_storage>().value()));
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
            }
@@ -4311,6 +5065,9 @@ namespace jsoncons {
                         case json_storage_kind::json_ref:
                             cast<json_reference_storage>().value().merge(hint, source);
                             break;
+                        case json_storage_kind::shared:
+                            cast<shared_storage>().value().merge(hint, source);
+                            break;
                         default:
                             JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
                     }
@@ -4318,6 +5075,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     merge(hint, source.cast<json_reference_storage>().value());
                     break;
+                case json_storage_kind::shared:
+                    merge(hint, source.cast<shared_storage>().value());
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
             }
@@ -4342,6 +5102,9 @@ namespace jsoncons {
                         case json_storage_kind::json_ref:
                             cast<json_reference_storage>().value().merge(hint, std::move(source));
                             break;
+                        case json_storage_kind::shared:
+                            cast<shared_storage>().value().merge(hint, std::move(source));
+                            break;
                         default:
                             JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
                     }
@@ -4349,6 +5112,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     merge(hint, std::move(source.cast<json_reference_storage>().value()));
                     break;
+                case json_storage_kind::shared:
+                    merge(hint, std::move(source.cast<shared_storage>().value()));
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
             }
@@ -4375,6 +5141,9 @@ namespace jsoncons {
                         case json_storage_kind::json_ref:
                             cast<json_reference_storage>().value().merge_or_update(source);
                             break;
+                        case json_storage_kind::shared:
+                            cast<shared_storage>().value().merge_or_update(source);
+                            break;
                         default:
                             JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge or update a value that is not an object"));
                     }
@@ -4382,6 +5151,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     merge_or_update(source.cast<json_reference_storage>().value());
                     break;
+                case json_storage_kind::shared:
+                    merge_or_update(source.cast<shared_storage>().value());
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
             }
@@ -4406,6 +5178,9 @@ namespace jsoncons {
                         case json_storage_kind::json_ref:
                             cast<json_reference_storage>().value().merge_or_update(std::move(source));
                             break;
+                        case json_storage_kind::shared:
+                            cast<shared_storage>().value().merge_or_update(std::move(source));
+                            break;
                         default:
                             JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge or update a value that is not an object"));
                     }
@@ -4413,6 +5188,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     merge_or_update(std::move(source.cast<json_reference_storage>().value()));
                     break;
+                case json_storage_kind::shared:
+                    merge_or_update(std::move(source.cast<shared_storage>().value()));
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
             }
@@ -4437,6 +5215,9 @@ namespace jsoncons {
                         case json_storage_kind::json_ref:
                             cast<json_reference_storage>().value().merge_or_update(hint, source);
                             break;
+                        case json_storage_kind::shared:
+                            cast<shared_storage>().value().merge_or_update(hint, source);
+                            break;
                         default:
                             JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge or update a value that is not an object"));
                     }
@@ -4444,6 +5225,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     merge_or_update(hint, source.cast<json_reference_storage>().value());
                     break;
+                case json_storage_kind::shared:
+                    merge_or_update(hint, source.cast<shared_storage>().value());
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
             }
@@ -4468,6 +5252,9 @@ namespace jsoncons {
                         case json_storage_kind::json_ref:
                             cast<json_reference_storage>().value().merge_or_update(hint, std::move(source));
                             break;
+                        case json_storage_kind::shared:
+                            cast<shared_storage>().value().merge_or_update(hint, std::move(source));
+                            break;
                         default:
                             JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge or update a value that is not an object"));
                     }
@@ -4475,6 +5262,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     merge_or_update(hint, std::move(source.cast<json_reference_storage>().value()));
                     break;
+                case json_storage_kind::shared:
+                    merge_or_update(hint, std::move(source.cast<shared_storage>().value()));
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to merge a value that is not an object"));
             }
@@ -4492,6 +5282,8 @@ namespace jsoncons {
                     return object_iterator(cast<object_storage>().value().insert_or_assign(hint, name, std::forward<T>(val)));
                 case json_storage_kind::json_ref:
                     return object_iterator(cast<json_reference_storage>().value().insert_or_assign(hint, name, std::forward<T>(val)));
+                case json_storage_kind::shared:
+                    return object_iterator(cast<shared_storage>().value().insert_or_assign(hint, name, std::forward<T>(val)));
                 default:
                     JSONCONS_THROW(not_an_object(name.data(),name.length()));
             }
@@ -4509,6 +5301,8 @@ namespace jsoncons {
                     return object_iterator(cast<object_storage>().value().try_emplace(hint, name, std::forward<Args>(args)...));
                 case json_storage_kind::json_ref:
                     return object_iterator(cast<json_reference_storage>().value().try_emplace(hint, name, std::forward<Args>(args)...));
+                case json_storage_kind::shared:
+                    return object_iterator(cast<shared_storage>().value().try_emplace(hint, name, std::forward<Args>(args)...));
                 default:
                     JSONCONS_THROW(not_an_object(name.data(),name.length()));
             }
@@ -4519,12 +5313,18 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    create_array_implicitly(implicit_array_capacity);
+                    return cast<array_storage>().value().insert(cast<array_storage>().value().begin(), std::forward<T>(val));
                 case json_storage_kind::array:
                     return cast<array_storage>().value().insert(pos, std::forward<T>(val));
                     break;
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().insert(pos, std::forward<T>(val));
                     break;
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().insert(pos, std::forward<T>(val));
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
             }
@@ -4535,12 +5335,18 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    create_array_implicitly(0);
+                    return cast<array_storage>().value().insert(cast<array_storage>().value().begin(), first, last);
                 case json_storage_kind::array:
                     return cast<array_storage>().value().insert(pos, first, last);
                     break;
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().insert(pos, first, last);
                     break;
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().insert(pos, first, last);
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
             }
@@ -4561,6 +5367,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     cast<json_reference_storage>().value().insert(first, last);
                     break;
+                case json_storage_kind::shared:
+                    cast<shared_storage>().value().insert(first, last);
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an object"));
             }
@@ -4581,6 +5390,9 @@ namespace jsoncons {
                 case json_storage_kind::json_ref:
                     cast<json_reference_storage>().value().insert(tag, first, last);
                     break;
+                case json_storage_kind::shared:
+                    cast<shared_storage>().value().insert(tag, first, last);
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an object"));
             }
@@ -4591,11 +5403,16 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    create_array_implicitly(implicit_array_capacity);
+                    return cast<array_storage>().value().emplace(cast<array_storage>().value().begin(), std::forward<Args>(args)...);
                 case json_storage_kind::array:
                     return cast<array_storage>().value().emplace(pos, std::forward<Args>(args)...);
                     break;
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().emplace(pos, std::forward<Args>(args)...);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().emplace(pos, std::forward<Args>(args)...);
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
             }
@@ -4606,10 +5423,15 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    create_array_implicitly(implicit_array_capacity);
+                    return cast<array_storage>().value().emplace_back(std::forward<Args>(args)...);
                 case json_storage_kind::array:
                     return cast<array_storage>().value().emplace_back(std::forward<Args>(args)...);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().emplace_back(std::forward<Args>(args)...);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().emplace_back(std::forward<Args>(args)...);
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
             }
@@ -4625,12 +5447,19 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    create_array_implicitly(implicit_array_capacity);
+                    cast<array_storage>().value().push_back(std::forward<T>(val));
+                    break;
                 case json_storage_kind::array:
                     cast<array_storage>().value().push_back(std::forward<T>(val));
                     break;
                 case json_storage_kind::json_ref:
                     cast<json_reference_storage>().value().push_back(std::forward<T>(val));
                     break;
+                case json_storage_kind::shared:
+                    cast<shared_storage>().value().push_back(std::forward<T>(val));
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
             }
@@ -4640,12 +5469,19 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    create_array_implicitly(implicit_array_capacity);
+                    cast<array_storage>().value().push_back(std::move(val));
+                    break;
                 case json_storage_kind::array:
                     cast<array_storage>().value().push_back(std::move(val));
                     break;
                 case json_storage_kind::json_ref:
                     cast<json_reference_storage>().value().push_back(std::move(val));
                     break;
+                case json_storage_kind::shared:
+                    cast<shared_storage>().value().push_back(std::move(val));
+                    break;
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
             }
@@ -4671,6 +5507,8 @@ namespace jsoncons {
                                                   object_iterator(cast<object_storage>().value().end()));
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().object_range();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().object_range();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
             }
@@ -4689,6 +5527,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().object_range();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().object_range();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().object_range();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
             }
@@ -4698,11 +5538,15 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    return array_range_type(array_iterator(), array_iterator());
                 case json_storage_kind::array:
                     return array_range_type(cast<array_storage>().value().begin(),
                         cast<array_storage>().value().end());
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().array_range();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().array_range();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
             }
@@ -4712,6 +5556,8 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::empty_array:
+                    return const_array_range_type(const_array_iterator(), const_array_iterator());
                 case json_storage_kind::array:
                     return const_array_range_type(cast<array_storage>().value().begin(),
                         cast<array_storage>().value().end());
@@ -4719,6 +5565,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().array_range();
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().array_range();
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().array_range();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
             }
@@ -4768,6 +5616,10 @@ namespace jsoncons {
                     visitor.begin_object(0, tag(), context, ec);
                     visitor.end_object(context, ec);
                     break;
+                case json_storage_kind::empty_array:
+                    visitor.begin_array(0, tag(), context, ec);
+                    visitor.end_array(context, ec);
+                    break;
                 case json_storage_kind::object:
                 {
                     visitor.begin_object(size(), tag(), context, ec);
@@ -4795,6 +5647,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().dump_noflush(visitor, ec);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().dump_noflush(visitor, ec);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().dump_noflush(visitor, ec);
                 default:
                     break;
             }
@@ -4843,6 +5697,10 @@ namespace jsoncons {
                     visitor.begin_object(0, tag(), context, ec);
                     visitor.end_object(context, ec);
                     return ec ? write_result{unexpect, ec} : write_result{};
+                case json_storage_kind::empty_array:
+                    visitor.begin_array(0, tag(), context, ec);
+                    visitor.end_array(context, ec);
+                    return ec ? write_result{unexpect, ec} : write_result{};
                 case json_storage_kind::object:
                 {
                     visitor.begin_object(size(), tag(), context, ec);
@@ -4886,6 +5744,8 @@ namespace jsoncons {
                     return cast<json_const_reference_storage>().value().try_dump_noflush(visitor);
                 case json_storage_kind::json_ref:
                     return cast<json_reference_storage>().value().try_dump_noflush(visitor);
+                case json_storage_kind::shared:
+                    return cast<shared_storage>().value().try_dump_noflush(visitor);
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -4942,6 +5802,8 @@ namespace jsoncons {
                     return deep_copy(other.cast<json_const_reference_storage>().value());
                 case json_storage_kind::json_ref:
                     return deep_copy(other.cast<json_reference_storage>().value());
+                case json_storage_kind::shared:
+                    return deep_copy(other.cast<shared_storage>().value());
                 default:
                     return other;
             }
@@ -5140,4 +6002,16 @@ namespace jsoncons {
 
 } // namespace jsoncons
 
+namespace std {
+    template <typename CharT,typename Policy,typename Allocator>
+    struct hash<jsoncons::basic_json<CharT,Policy,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_json<CharT,Policy,Allocator>& val) const noexcept
+        {
+            return val.hash();
+        }
+    };
+
+} // namespace std
+
 #endif // JSONCONS_BASIC_JSON_HPP
@@ -410,6 +410,16 @@
 #   endif
 #endif
 
+// SIMD instruction sets, define JSONCONS_NO_SIMD to use portable code only
+#if !defined(JSONCONS_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define JSONCONS_HAS_SSE2
+#endif
+#if defined(__AVX2__)
+#  define JSONCONS_HAS_AVX2
+#endif
+#endif // !defined(JSONCONS_NO_SIMD)
+
 // Follows boost config/detail/suffix.hpp
 #if defined(JSONCONS_HAS_INT128) && defined(__cplusplus)
 namespace jsoncons{
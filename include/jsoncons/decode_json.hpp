@@ -15,6 +15,7 @@
 #include <jsoncons/allocator_set.hpp>
 #include <jsoncons/conv_error.hpp>
 #include <jsoncons/json_cursor.hpp>
+#include <jsoncons/json_parse_context.hpp>
 #include <jsoncons/basic_json.hpp>
 #include <jsoncons/source.hpp>
 #include <jsoncons/ser_util.hpp>
@@ -49,6 +50,24 @@ try_decode_json(const CharsLike& s,
     return result_type{decoder.get_result()};
 }
 
+template <typename T,typename CharsLike,typename TempAlloc>
+typename std::enable_if<ext_traits::is_basic_json<T>::value &&
+                        ext_traits::is_sequence_of<CharsLike,typename T::char_type>::value,read_result<T>>::type
+try_decode_json(json_parse_context<T,TempAlloc>& context, const CharsLike& s)
+{
+    using value_type = T;
+    using result_type = read_result<value_type>;
+    using char_type = typename CharsLike::value_type;
+
+    std::error_code ec;   
+    context.parse(jsoncons::basic_string_view<char_type>(s.data(), s.size()), ec);
+    if (JSONCONS_UNLIKELY(ec))
+    {
+        return result_type{jsoncons::unexpect, ec, context.line(), context.column()};
+    }
+    return result_type{context.get_result()};
+}
+
 template <typename T,typename CharsLike>
 typename std::enable_if<!ext_traits::is_basic_json<T>::value &&
                         ext_traits::is_char_sequence<CharsLike>::value,read_result<T>>::type
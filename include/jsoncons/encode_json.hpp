@@ -10,6 +10,7 @@
 #include <ostream>
 
 #include <jsoncons/basic_json.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/reflect/encode_traits.hpp>
@@ -31,6 +32,7 @@ template <typename T,typename CharT>
 typename std::enable_if<!ext_traits::is_basic_json<T>::value,write_result>::type
     try_encode_json(const T& val, basic_json_visitor<CharT>& encoder)
 {
+    JSONCONS_INSTRUMENT_TIMER(encode);
     auto r = reflect::encode_traits<T>::try_encode(make_alloc_set(), val, encoder);
     encoder.flush();
     return r;
@@ -49,6 +51,7 @@ typename std::enable_if<!ext_traits::is_basic_json<T>::value, write_result>::typ
     try_encode_json(const allocator_set<Alloc, TempAlloc>& aset,
     const T& val, basic_json_visitor<CharT>& encoder)
 {
+    JSONCONS_INSTRUMENT_TIMER(encode);
     auto r = reflect::encode_traits<T>::try_encode(aset, val, encoder);
     encoder.flush();
     return r;
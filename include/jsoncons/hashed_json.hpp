@@ -0,0 +1,79 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_HASHED_JSON_HPP
+#define JSONCONS_HASHED_JSON_HPP
+
+#include <cstddef>
+#include <functional> // std::hash
+#include <utility> // std::move
+
+#include <jsoncons/basic_json.hpp>
+
+namespace jsoncons {
+
+    // An immutable basic_json value together with its structural hash, computed once.
+    // Comparing two hashed_json values rejects on a hash mismatch before comparing
+    // the documents themselves.
+    template <typename Json>
+    class hashed_json
+    {
+        Json value_;
+        std::size_t hash_;
+    public:
+        using value_type = Json;
+
+        explicit hashed_json(const Json& value)
+            : value_(value), hash_(value_.hash())
+        {
+        }
+
+        explicit hashed_json(Json&& value)
+            : value_(std::move(value)), hash_(value_.hash())
+        {
+        }
+
+        hashed_json(const hashed_json&) = default;
+        hashed_json(hashed_json&&) = default;
+        hashed_json& operator=(const hashed_json&) = default;
+        hashed_json& operator=(hashed_json&&) = default;
+
+        const Json& value() const noexcept
+        {
+            return value_;
+        }
+
+        std::size_t hash() const noexcept
+        {
+            return hash_;
+        }
+
+        friend bool operator==(const hashed_json& lhs, const hashed_json& rhs) noexcept
+        {
+            return lhs.hash_ == rhs.hash_ && lhs.value_ == rhs.value_;
+        }
+
+        friend bool operator!=(const hashed_json& lhs, const hashed_json& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+} // namespace jsoncons
+
+namespace std {
+    template <typename Json>
+    struct hash<jsoncons::hashed_json<Json>>
+    {
+        std::size_t operator()(const jsoncons::hashed_json<Json>& val) const noexcept
+        {
+            return val.hash();
+        }
+    };
+
+} // namespace std
+
+#endif // JSONCONS_HASHED_JSON_HPP
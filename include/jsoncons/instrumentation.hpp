@@ -0,0 +1,286 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INSTRUMENTATION_HPP
+#define JSONCONS_INSTRUMENTATION_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory> // std::allocator_traits
+#include <type_traits>
+
+#include <jsoncons/config/jsoncons_config.hpp>
+
+// Define JSONCONS_INSTRUMENTATION in every translation unit of a program to record
+// counters and timings. Otherwise the hooks expand to nothing and the statistics stay zero.
+
+#if defined(JSONCONS_INSTRUMENTATION)
+#define JSONCONS_INSTRUMENT_COUNT(Counter, N) \
+    ::jsoncons::instrumentation::thread_statistics().add(::jsoncons::instrumentation::counter::Counter, (N))
+#define JSONCONS_INSTRUMENT_TIMER(Timer) \
+    ::jsoncons::instrumentation::timed_scope jsoncons_timed_scope_(::jsoncons::instrumentation::timer::Timer)
+#else
+#define JSONCONS_INSTRUMENT_COUNT(Counter, N) ((void)0)
+#define JSONCONS_INSTRUMENT_TIMER(Timer) ((void)0)
+#endif
+
+namespace jsoncons {
+namespace instrumentation {
+
+#if defined(JSONCONS_INSTRUMENTATION)
+    constexpr bool enabled = true;
+#else
+    constexpr bool enabled = false;
+#endif
+
+    enum class counter : uint8_t
+    {
+        allocations,        // allocations through an instrumented_allocator
+        deallocations,      // deallocations through an instrumented_allocator
+        allocated_bytes,    // bytes allocated through an instrumented_allocator
+        buffer_refills,     // reads from an input stream into a source buffer
+        escapes,            // escape sequences decoded by parsers or written by encoders
+        number_conversions  // conversions between number text and binary values
+    };
+
+    enum class timer : uint8_t
+    {
+        parse,              // readers and basic_json::parse
+        encode,             // basic_json::dump and encode_json
+        query,              // JSONPath and JMESPath evaluation
+        validate            // JSON Schema validation
+    };
+
+    struct timer_statistics
+    {
+        uint64_t count;
+        uint64_t nanoseconds;
+    };
+
+    class statistics
+    {
+    public:
+        static constexpr std::size_t counter_count = 6;
+        static constexpr std::size_t timer_count = 4;
+    private:
+        uint64_t counters_[counter_count];
+        timer_statistics timers_[timer_count];
+    public:
+        statistics() noexcept
+        {
+            reset();
+        }
+
+        uint64_t get(counter c) const noexcept
+        {
+            return counters_[static_cast<std::size_t>(c)];
+        }
+
+        const timer_statistics& get(timer t) const noexcept
+        {
+            return timers_[static_cast<std::size_t>(t)];
+        }
+
+        void add(counter c, uint64_t n) noexcept
+        {
+            counters_[static_cast<std::size_t>(c)] += n;
+        }
+
+        void add(timer t, uint64_t nanoseconds) noexcept
+        {
+            timer_statistics& stats = timers_[static_cast<std::size_t>(t)];
+            ++stats.count;
+            stats.nanoseconds += nanoseconds;
+        }
+
+        void reset() noexcept
+        {
+            for (std::size_t i = 0; i < counter_count; ++i)
+            {
+                counters_[i] = 0;
+            }
+            for (std::size_t i = 0; i < timer_count; ++i)
+            {
+                timers_[i] = timer_statistics{0, 0};
+            }
+        }
+
+        statistics& operator+=(const statistics& other) noexcept
+        {
+            for (std::size_t i = 0; i < counter_count; ++i)
+            {
+                counters_[i] += other.counters_[i];
+            }
+            for (std::size_t i = 0; i < timer_count; ++i)
+            {
+                timers_[i].count += other.timers_[i].count;
+                timers_[i].nanoseconds += other.timers_[i].nanoseconds;
+            }
+            return *this;
+        }
+
+        statistics& operator-=(const statistics& other) noexcept
+        {
+            for (std::size_t i = 0; i < counter_count; ++i)
+            {
+                counters_[i] -= other.counters_[i];
+            }
+            for (std::size_t i = 0; i < timer_count; ++i)
+            {
+                timers_[i].count -= other.timers_[i].count;
+                timers_[i].nanoseconds -= other.timers_[i].nanoseconds;
+            }
+            return *this;
+        }
+
+        friend statistics operator+(statistics lhs, const statistics& rhs) noexcept
+        {
+            lhs += rhs;
+            return lhs;
+        }
+
+        friend statistics operator-(statistics lhs, const statistics& rhs) noexcept
+        {
+            lhs -= rhs;
+            return lhs;
+        }
+    };
+
+    // The statistics recorded on the calling thread since it started, or since the last reset
+
+    inline
+    statistics& thread_statistics() noexcept
+    {
+        static thread_local statistics stats;
+        return stats;
+    }
+
+    // The statistics recorded on the calling thread during the lifetime of the scope
+
+    class operation_scope
+    {
+        statistics start_;
+    public:
+        operation_scope() noexcept
+            : start_(thread_statistics())
+        {
+        }
+
+        operation_scope(const operation_scope&) = delete;
+        operation_scope& operator=(const operation_scope&) = delete;
+
+        statistics current() const noexcept
+        {
+            return thread_statistics() - start_;
+        }
+    };
+
+    // Adds the time elapsed during its lifetime to a timer of the calling thread
+
+    class timed_scope
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        timer timer_;
+        clock_type::time_point start_;
+    public:
+        explicit timed_scope(timer t) noexcept
+            : timer_(t), start_(clock_type::now())
+        {
+        }
+
+        timed_scope(const timed_scope&) = delete;
+        timed_scope& operator=(const timed_scope&) = delete;
+
+        ~timed_scope() noexcept
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start_);
+            thread_statistics().add(timer_, static_cast<uint64_t>(elapsed.count()));
+        }
+    };
+
+} // namespace instrumentation
+
+    // An allocator adaptor that counts the allocations made through it
+
+    template <typename T,typename Allocator = std::allocator<T>>
+    class instrumented_allocator
+    {
+        using traits_type = std::allocator_traits<Allocator>;
+
+        Allocator alloc_;
+    public:
+        using value_type = T;
+        using pointer = typename traits_type::pointer;
+        using const_pointer = typename traits_type::const_pointer;
+        using size_type = typename traits_type::size_type;
+        using difference_type = typename traits_type::difference_type;
+        using inner_allocator_type = Allocator;
+
+        using propagate_on_container_copy_assignment = typename traits_type::propagate_on_container_copy_assignment;
+        using propagate_on_container_move_assignment = typename traits_type::propagate_on_container_move_assignment;
+        using propagate_on_container_swap = typename traits_type::propagate_on_container_swap;
+        using is_always_equal = typename traits_type::is_always_equal;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = instrumented_allocator<U,typename traits_type::template rebind_alloc<U>>;
+        };
+
+        instrumented_allocator() = default;
+
+        explicit instrumented_allocator(const Allocator& alloc) noexcept
+            : alloc_(alloc)
+        {
+        }
+
+        template <typename U,typename OtherAllocator>
+        instrumented_allocator(const instrumented_allocator<U,OtherAllocator>& other) noexcept
+            : alloc_(other.inner_allocator())
+        {
+        }
+
+        pointer allocate(size_type n)
+        {
+            JSONCONS_INSTRUMENT_COUNT(allocations, 1);
+            JSONCONS_INSTRUMENT_COUNT(allocated_bytes, n*sizeof(T));
+            return traits_type::allocate(alloc_, n);
+        }
+
+        void deallocate(pointer p, size_type n) noexcept
+        {
+            JSONCONS_INSTRUMENT_COUNT(deallocations, 1);
+            traits_type::deallocate(alloc_, p, n);
+        }
+
+        instrumented_allocator select_on_container_copy_construction() const
+        {
+            return instrumented_allocator(traits_type::select_on_container_copy_construction(alloc_));
+        }
+
+        const inner_allocator_type& inner_allocator() const noexcept
+        {
+            return alloc_;
+        }
+
+        template <typename U,typename OtherAllocator>
+        friend bool operator==(const instrumented_allocator& lhs, const instrumented_allocator<U,OtherAllocator>& rhs) noexcept
+        {
+            return lhs.alloc_ == rhs.inner_allocator();
+        }
+
+        template <typename U,typename OtherAllocator>
+        friend bool operator!=(const instrumented_allocator& lhs, const instrumented_allocator<U,OtherAllocator>& rhs) noexcept
+        {
+            return !(lhs.alloc_ == rhs.inner_allocator());
+        }
+    };
+
+} // namespace jsoncons
+
+#endif // JSONCONS_INSTRUMENTATION_HPP
@@ -0,0 +1,629 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INTERNED_KEY_HPP
+#define JSONCONS_INTERNED_KEY_HPP
+
+#include <algorithm> // std::min
+#include <atomic>
+#include <cstddef>
+#include <cstring> // std::memcmp
+#include <functional> // std::hash
+#include <iterator>
+#include <memory> // std::allocator
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility> // std::swap
+#include <vector>
+
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/utility/hash.hpp>
+#include <jsoncons/utility/heap_string.hpp>
+
+namespace jsoncons {
+
+    namespace detail {
+
+        // Stored with each pooled string, the number of keys and pools that hold it
+        // and its hash
+        struct interned_key_extra
+        {
+            std::atomic<std::size_t> count;
+            std::size_t hash;
+
+            interned_key_extra(std::size_t n, std::size_t h) noexcept
+                : count(n), hash(h)
+            {
+            }
+
+            interned_key_extra(const interned_key_extra& other) noexcept
+                : count(other.count.load(std::memory_order_relaxed)), hash(other.hash)
+            {
+            }
+
+            interned_key_extra& operator=(const interned_key_extra&) = delete;
+        };
+
+    } // namespace detail
+
+    // A set of immutable, reference counted strings. Interning a string that is
+    // already in the pool returns the existing string.
+    template <typename CharT,typename Allocator = std::allocator<CharT>>
+    class basic_key_pool
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+    private:
+        using heap_string_factory_type = utility::heap_string_factory<char_type,detail::interned_key_extra,Allocator>;
+    public:
+        using pointer = typename heap_string_factory_type::pointer;
+    private:
+        using pointer_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<pointer>;
+
+        static constexpr std::size_t min_capacity = 64;
+
+        allocator_type alloc_;
+        std::vector<pointer,pointer_allocator_type> slots_;
+        std::size_t size_;
+    public:
+        explicit basic_key_pool(const Allocator& alloc = Allocator())
+            : alloc_(alloc), slots_(pointer_allocator_type(alloc)), size_(0)
+        {
+        }
+
+        basic_key_pool(const basic_key_pool&) = delete;
+        basic_key_pool& operator=(const basic_key_pool&) = delete;
+
+        ~basic_key_pool() noexcept
+        {
+            for (auto p : slots_)
+            {
+                if (p != nullptr)
+                {
+                    release(p);
+                }
+            }
+        }
+
+        // The thread's default pool, used by basic_interned_key
+        static basic_key_pool& thread_instance()
+        {
+            static thread_local basic_key_pool pool;
+            return pool;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        // The number of slots in the hash table
+        std::size_t capacity() const noexcept
+        {
+            return slots_.size();
+        }
+
+        // Returns the pooled string equal to [s, s+length), with a reference for the caller
+        pointer intern(const char_type* s, std::size_t length)
+        {
+            if ((size_ + 1)*4 > slots_.size()*3)
+            {
+                grow();
+            }
+            const std::size_t hash = static_cast<std::size_t>(utility::hash_chars(s, length));
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t i = hash & mask;
+            while (slots_[i] != nullptr)
+            {
+                pointer p = slots_[i];
+                if (p->extra_.hash == hash && p->length() == length &&
+                    std::memcmp(p->data(), s, length*sizeof(char_type)) == 0)
+                {
+                    add_ref(p);
+                    return p;
+                }
+                i = (i + 1) & mask;
+            }
+            // One reference for the pool, one for the caller
+            pointer p = heap_string_factory_type::create(s, length, detail::interned_key_extra(2, hash), alloc_);
+            slots_[i] = p;
+            ++size_;
+            return p;
+        }
+
+        // Drops the strings that no key refers to
+        void purge()
+        {
+            pointer_allocator_type ptr_alloc(alloc_);
+            std::vector<pointer,pointer_allocator_type> live(ptr_alloc);
+            live.reserve(size_);
+            for (auto p : slots_)
+            {
+                if (p != nullptr)
+                {
+                    if (p->extra_.count.load(std::memory_order_acquire) == 1)
+                    {
+                        release(p);
+                    }
+                    else
+                    {
+                        live.push_back(p);
+                    }
+                }
+            }
+            rehash(slots_.size(), live);
+        }
+
+        static void add_ref(pointer p) noexcept
+        {
+            p->extra_.count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void release(pointer p) noexcept
+        {
+            if (p->extra_.count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                heap_string_factory_type::destroy(p);
+            }
+        }
+
+    private:
+        // Strings no longer in use are dropped before the table doubles. The table doubles
+        // anyway unless that frees at least a quarter of the slots, so that at least
+        // capacity/4 strings can be added before the next purge, and a table that stays
+        // near the load limit is not scanned on every insert.
+        void grow()
+        {
+            const std::size_t old_size = size_;
+            if (size_ > 0)
+            {
+                purge();
+            }
+            if (slots_.empty() || (old_size - size_)*4 < slots_.size())
+            {
+                pointer_allocator_type ptr_alloc(alloc_);
+                std::vector<pointer,pointer_allocator_type> live(ptr_alloc);
+                live.reserve(size_);
+                for (auto p : slots_)
+                {
+                    if (p != nullptr)
+                    {
+                        live.push_back(p);
+                    }
+                }
+                rehash(slots_.empty() ? min_capacity : 2*slots_.size(), live);
+            }
+        }
+
+        void rehash(std::size_t capacity, const std::vector<pointer,pointer_allocator_type>& live)
+        {
+            slots_.assign(capacity, pointer());
+            const std::size_t mask = capacity - 1;
+            for (auto p : live)
+            {
+                std::size_t i = p->extra_.hash & mask;
+                while (slots_[i] != nullptr)
+                {
+                    i = (i + 1) & mask;
+                }
+                slots_[i] = p;
+            }
+            size_ = live.size();
+        }
+    };
+
+    // An immutable string held in a basic_key_pool. Keys with equal text made on the
+    // same thread share one allocation, and copying a key only increments a count.
+    // Use as the member key of basic_json through interned_key_policy.
+    template <typename CharT,typename Traits = std::char_traits<CharT>,typename Allocator = std::allocator<CharT>>
+    class basic_interned_key
+    {
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_reference = const CharT&;
+        using reference = const_reference;
+        using const_pointer = const CharT*;
+        using const_iterator = const CharT*;
+        using iterator = const_iterator;
+        using string_view_type = jsoncons::basic_string_view<CharT,Traits>;
+        using pool_type = basic_key_pool<CharT,Allocator>;
+
+        // Keys come from the thread's pool, which holds a default constructed Allocator,
+        // so an allocator passed to a constructor could not be honored
+        static_assert(std::allocator_traits<Allocator>::is_always_equal::value,
+            "basic_interned_key requires an Allocator whose instances are always equal");
+    private:
+        // null for the empty string
+        typename pool_type::pointer ptr_;
+    public:
+        basic_interned_key() noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        explicit basic_interned_key(const Allocator&) noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        // The allocator arguments are accepted for compatibility with std::basic_string.
+        // Since all instances of Allocator are equal, the thread's pool allocating with 
+        // its own is the same as allocating with them
+        basic_interned_key(const CharT* s, std::size_t length, const Allocator& = Allocator())
+            : ptr_(length == 0 ? nullptr : pool_type::thread_instance().intern(s, length))
+        {
+        }
+
+        basic_interned_key(const CharT* s, const Allocator& alloc = Allocator())
+            : basic_interned_key(s, Traits::length(s), alloc)
+        {
+        }
+
+        template <typename InputIt>
+        basic_interned_key(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+            : basic_interned_key(first, last, alloc,
+                  std::is_convertible<InputIt,const CharT*>())
+        {
+        }
+
+        template <typename A2>
+        basic_interned_key(const std::basic_string<CharT,Traits,A2>& s, const Allocator& alloc = Allocator())
+            : basic_interned_key(s.data(), s.size(), alloc)
+        {
+        }
+
+        explicit basic_interned_key(const string_view_type& s, const Allocator& alloc = Allocator())
+            : basic_interned_key(s.data(), s.size(), alloc)
+        {
+        }
+
+        basic_interned_key(const basic_interned_key& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            if (ptr_ != nullptr)
+            {
+                pool_type::add_ref(ptr_);
+            }
+        }
+
+        basic_interned_key(const basic_interned_key& other, const Allocator&) noexcept
+            : basic_interned_key(other)
+        {
+        }
+
+        basic_interned_key(basic_interned_key&& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            other.ptr_ = nullptr;
+        }
+
+        basic_interned_key(basic_interned_key&& other, const Allocator&) noexcept
+            : basic_interned_key(std::move(other))
+        {
+        }
+
+        ~basic_interned_key() noexcept
+        {
+            if (ptr_ != nullptr)
+            {
+                pool_type::release(ptr_);
+            }
+        }
+
+        basic_interned_key& operator=(const basic_interned_key& other) noexcept
+        {
+            basic_interned_key temp(other);
+            swap(temp);
+            return *this;
+        }
+
+        basic_interned_key& operator=(basic_interned_key&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(basic_interned_key& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type();
+        }
+
+        const CharT* data() const noexcept
+        {
+            return ptr_ == nullptr ? empty_string() : ptr_->data();
+        }
+
+        const CharT* c_str() const noexcept
+        {
+            return data();
+        }
+
+        size_type size() const noexcept
+        {
+            return ptr_ == nullptr ? 0 : ptr_->length();
+        }
+
+        size_type length() const noexcept
+        {
+            return size();
+        }
+
+        bool empty() const noexcept
+        {
+            return ptr_ == nullptr;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        const CharT& operator[](size_type i) const noexcept
+        {
+            return data()[i];
+        }
+
+        operator string_view_type() const noexcept
+        {
+            return string_view_type(data(), size());
+        }
+
+        template <typename A2>
+        explicit operator std::basic_string<CharT,Traits,A2>() const
+        {
+            return std::basic_string<CharT,Traits,A2>(data(), size());
+        }
+
+        int compare(const basic_interned_key& other) const noexcept
+        {
+            return ptr_ == other.ptr_ ? 0 : compare(other.data(), other.size());
+        }
+
+        // Pointer equality is tested first, a view of another key from the same pool
+        // compares without reading the characters
+        int compare(const string_view_type& s) const noexcept
+        {
+            return compare(s.data(), s.size());
+        }
+
+        int compare(const CharT* s) const noexcept
+        {
+            return compare(s, Traits::length(s));
+        }
+
+        template <typename A2>
+        int compare(const std::basic_string<CharT,Traits,A2>& s) const noexcept
+        {
+            return compare(s.data(), s.size());
+        }
+
+        friend bool operator==(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.ptr_ == rhs.ptr_ || lhs.compare(rhs) == 0;
+        }
+
+        friend bool operator!=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+        friend bool operator<=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) <= 0;
+        }
+
+        friend bool operator>(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) > 0;
+        }
+
+        friend bool operator>=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) >= 0;
+        }
+
+        friend bool operator==(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) == 0;
+        }
+
+        friend bool operator==(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) == 0;
+        }
+
+        friend bool operator!=(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) != 0;
+        }
+
+        friend bool operator!=(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) != 0;
+        }
+
+        friend bool operator<(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+        friend bool operator<(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) > 0;
+        }
+
+        friend bool operator<=(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) <= 0;
+        }
+
+        friend bool operator<=(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) >= 0;
+        }
+
+        friend bool operator>(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) > 0;
+        }
+
+        friend bool operator>(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) < 0;
+        }
+
+        friend bool operator>=(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) >= 0;
+        }
+
+        friend bool operator>=(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) <= 0;
+        }
+
+        friend bool operator==(const basic_interned_key& lhs, const CharT* rhs) noexcept
+        {
+            return lhs.compare(rhs) == 0;
+        }
+
+        friend bool operator==(const CharT* lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) == 0;
+        }
+
+        friend bool operator!=(const basic_interned_key& lhs, const CharT* rhs) noexcept
+        {
+            return lhs.compare(rhs) != 0;
+        }
+
+        friend bool operator!=(const CharT* lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) != 0;
+        }
+
+        template <typename A2>
+        friend bool operator==(const basic_interned_key& lhs, const std::basic_string<CharT,Traits,A2>& rhs) noexcept
+        {
+            return lhs.compare(rhs) == 0;
+        }
+
+        template <typename A2>
+        friend bool operator==(const std::basic_string<CharT,Traits,A2>& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) == 0;
+        }
+
+        template <typename A2>
+        friend bool operator!=(const basic_interned_key& lhs, const std::basic_string<CharT,Traits,A2>& rhs) noexcept
+        {
+            return lhs.compare(rhs) != 0;
+        }
+
+        template <typename A2>
+        friend bool operator!=(const std::basic_string<CharT,Traits,A2>& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) != 0;
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_interned_key& key)
+        {
+            os.write(key.data(), static_cast<std::streamsize>(key.size()));
+            return os;
+        }
+
+    private:
+        static const CharT* empty_string() noexcept
+        {
+            static const CharT s[1] = {0};
+            return s;
+        }
+
+        int compare(const CharT* s, std::size_t length) const noexcept
+        {
+            const std::size_t n = size();
+            if (data() == s && n == length)
+            {
+                return 0;
+            }
+            const int diff = Traits::compare(data(), s, (std::min)(n, length));
+            if (diff != 0)
+            {
+                return diff;
+            }
+            return n == length ? 0 : (n < length ? -1 : 1);
+        }
+
+        template <typename InputIt>
+        basic_interned_key(InputIt first, InputIt last, const Allocator& alloc, std::true_type)
+            : basic_interned_key(static_cast<const CharT*>(first), static_cast<std::size_t>(last - first), alloc)
+        {
+        }
+
+        template <typename InputIt>
+        basic_interned_key(InputIt first, InputIt last, const Allocator& alloc, std::false_type)
+            : basic_interned_key(std::basic_string<CharT,Traits>(first, last), alloc)
+        {
+        }
+    };
+
+    // A basic_json policy that stores object member keys as basic_interned_key
+    template <typename Policy>
+    struct interned_key_policy : public Policy
+    {
+        template <typename CharT,typename CharTraits,typename Allocator>
+        using member_key = basic_interned_key<CharT,CharTraits,Allocator>;
+    };
+
+    using key_pool = basic_key_pool<char>;
+    using interned_key = basic_interned_key<char>;
+
+} // namespace jsoncons
+
+namespace std {
+    template <typename CharT,typename Traits,typename Allocator>
+    struct hash<jsoncons::basic_interned_key<CharT,Traits,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_interned_key<CharT,Traits,Allocator>& key) const noexcept
+        {
+            return static_cast<std::size_t>(jsoncons::utility::hash_chars(key.data(), key.size()));
+        }
+    };
+
+} // namespace std
+
+#endif // JSONCONS_INTERNED_KEY_HPP
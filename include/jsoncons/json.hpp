@@ -10,6 +10,7 @@
 #include <jsoncons/basic_json.hpp>
 #include <jsoncons/decode_json.hpp>
 #include <jsoncons/encode_json.hpp>
+#include <jsoncons/hashed_json.hpp>
 #include <jsoncons/reflect/reflect_traits_gen.hpp>
 #include <jsoncons/staj_iterator.hpp>
 
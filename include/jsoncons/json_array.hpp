@@ -20,11 +20,33 @@
 
 #include <jsoncons/allocator_holder.hpp>
 #include <jsoncons/json_type.hpp>
+#include <jsoncons/utility/more_type_traits.hpp>
 
 namespace jsoncons {
 
+namespace detail {
+
+    struct inline_capacity_arg_t
+    {
+        explicit inline_capacity_arg_t() = default; 
+    };
+
+    JSONCONS_INLINE_CONSTEXPR inline_capacity_arg_t inline_capacity_arg{};
+
+} // namespace detail
+
     // json_array
 
+    // A json_array created with detail::inline_capacity_arg lives at the start of an
+    // allocation of allocation_size(capacity) json_array sized units, and keeps its 
+    // first capacity elements in the rest of that allocation. Elements move to the 
+    // SequenceContainer only when the array outgrows that room.
+    //
+    // Elements kept inline are reached through SequenceContainer's own iterator types,
+    // so this applies only when SequenceContainer is contiguous and its iterators can
+    // be constructed from element pointers. Otherwise, e.g. for std::deque, the 
+    // capacity is ignored and all elements are kept in the SequenceContainer.
+
     template <typename Json,template <typename,typename> class SequenceContainer = std::vector>
     class json_array : public allocator_holder<typename Json::allocator_type>
     {
@@ -33,14 +55,53 @@ namespace jsoncons {
         using value_type = Json;
     private:
         using value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<value_type>;                   
+        using value_allocator_traits = std::allocator_traits<value_allocator_type>;
         using value_container_type = SequenceContainer<value_type,value_allocator_type>;
-        value_container_type elements_;
+
     public:
         using iterator = typename value_container_type::iterator;
         using const_iterator = typename value_container_type::const_iterator;
         using reference = typename std::iterator_traits<iterator>::reference;
         using const_reference = typename std::iterator_traits<const_iterator>::reference;
+    private:
+        using inline_support = std::integral_constant<bool,
+            ext_traits::has_data_exact<value_type*,value_container_type>::value &&
+            std::is_constructible<iterator,value_type*>::value &&
+            std::is_constructible<const_iterator,const value_type*>::value>;
+
+        value_container_type elements_;
+        std::size_t inline_capacity_{0};
+        std::size_t inline_size_{0};
+        bool is_inline_{false};
+
+        // An element constructed with the array's allocator, as the elements are, 
+        // for when the arguments may refer to an element that is about to move
+        class temp_element
+        {
+            value_allocator_type alloc_;
+            alignas(Json) unsigned char storage_[sizeof(Json)];
+        public:
+            template <typename... Args>
+            explicit temp_element(const allocator_type& alloc, Args&&... args)
+                : alloc_(alloc)
+            {
+                value_allocator_traits::construct(alloc_, get(), std::forward<Args>(args)...);
+            }
 
+            temp_element(const temp_element&) = delete;
+            temp_element& operator=(const temp_element&) = delete;
+
+            ~temp_element() noexcept
+            {
+                value_allocator_traits::destroy(alloc_, get());
+            }
+
+            Json* get() noexcept
+            {
+                return reinterpret_cast<Json*>(storage_);
+            }
+        };
+    public:
         using allocator_holder<allocator_type>::get_allocator;
 
         json_array()
@@ -75,26 +136,64 @@ namespace jsoncons {
         {
         }
 
+        json_array(detail::inline_capacity_arg_t, std::size_t capacity, 
+                   const allocator_type& alloc = allocator_type())
+            : allocator_holder<allocator_type>(alloc), 
+              elements_(value_allocator_type(alloc)),
+              inline_capacity_(inline_support::value ? capacity : 0), is_inline_(inline_capacity_ > 0)
+        {
+        }
+
+        json_array(detail::inline_capacity_arg_t, std::size_t capacity, 
+                   std::size_t n, const Json& value, 
+                   const allocator_type& alloc = allocator_type())
+            : json_array(detail::inline_capacity_arg, capacity, alloc)
+        {
+            reserve(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                emplace_back(value);
+            }
+        }
+
+        template <typename InputIterator>
+        json_array(detail::inline_capacity_arg_t, std::size_t capacity, 
+                   InputIterator first, InputIterator last, 
+                   const allocator_type& alloc = allocator_type())
+            : json_array(detail::inline_capacity_arg, capacity, alloc)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                emplace_back(*it);
+            }
+        }
+
         json_array(const json_array& other)
             : allocator_holder<allocator_type>(other.get_allocator()),
               elements_(other.elements_)
         {
+            append_inline_copy(other);
         }
         json_array(const json_array& other, const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
               elements_(other.elements_,value_allocator_type(alloc))
         {
+            append_inline_copy(other);
         }
 
+        // Only an array that keeps its elements inline, which a basic_json allocates 
+        // itself, has its elements moved one by one into the SequenceContainer
         json_array(json_array&& other) noexcept
             : allocator_holder<allocator_type>(other.get_allocator()), 
               elements_(std::move(other.elements_))
         {
+            append_inline_move(other);
         }
         json_array(json_array&& other, const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
               elements_(std::move(other.elements_),value_allocator_type(alloc))
         {
+            append_inline_move(other);
         }
 
         json_array(const std::initializer_list<Json>& init, 
@@ -108,65 +207,221 @@ namespace jsoncons {
             flatten_and_destroy();
         }
 
+        // The number of json_array sized units in an allocation that holds a json_array
+        // followed by room for n elements
+        static std::size_t allocation_size(std::size_t n) noexcept
+        {
+            static_assert(alignof(Json) <= alignof(json_array), "Elements must not need stricter alignment than json_array");
+            const std::size_t capacity = inline_support::value ? n : 0;
+            return (inline_offset() + capacity*sizeof(Json) + sizeof(json_array) - 1) / sizeof(json_array);
+        }
+
+        std::size_t allocation_size() const noexcept
+        {
+            return allocation_size(inline_capacity_);
+        }
+
+        // The bytes allocated for the array and for room for its elements
+        std::size_t allocated_bytes() const noexcept
+        {
+            return allocation_size()*sizeof(json_array) + (is_inline_ ? 0 : elements_.capacity()*sizeof(Json));
+        }
+
+        // The bytes of room for elements that no element occupies
+        std::size_t unused_bytes() const noexcept
+        {
+            return is_inline_ ? (inline_capacity_ - inline_size_)*sizeof(Json) 
+                : (inline_capacity_ + elements_.capacity() - elements_.size())*sizeof(Json);
+        }
+
         reference back()
         {
-            return elements_.back();
+            return is_inline_ ? inline_data()[inline_size_ - 1] : elements_.back();
         }
 
         const_reference back() const
         {
-            return elements_.back();
+            return is_inline_ ? inline_data()[inline_size_ - 1] : elements_.back();
         }
 
         void pop_back()
         {
-            elements_.pop_back();
+            if (is_inline_)
+            {
+                --inline_size_;
+                destroy_inline(inline_size_, inline_size_ + 1);
+            }
+            else
+            {
+                elements_.pop_back();
+            }
         }
 
         bool empty() const
         {
-            return elements_.empty();
+            return size() == 0;
         }
 
+        // Inline elements are exchanged in place, and don't allocate unless they 
+        // outnumber the room for them in the other array
         void swap(json_array& other) noexcept
         {
-            elements_.swap(other.elements_);
+            if (this == &other)
+            {
+                return;
+            }
+            if (!is_inline_ && !other.is_inline_)
+            {
+                elements_.swap(other.elements_);
+            }
+            else if (is_inline_ && other.is_inline_)
+            {
+                json_array& larger = inline_size_ >= other.inline_size_ ? *this : other;
+                json_array& smaller = inline_size_ >= other.inline_size_ ? other : *this;
+                Json* p = larger.inline_data();
+                Json* q = smaller.inline_data();
+                const std::size_t n = smaller.inline_size_;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    p[i].swap(q[i]);
+                }
+                smaller.take_inline(larger, n);
+            }
+            else
+            {
+                json_array& in = is_inline_ ? *this : other;
+                json_array& out = is_inline_ ? other : *this;
+                in.elements_.swap(out.elements_);
+                out.is_inline_ = out.inline_capacity_ > 0;
+                out.take_inline(in, 0);
+                in.is_inline_ = false;
+            }
         }
 
-        std::size_t size() const {return elements_.size();}
+        std::size_t size() const {return is_inline_ ? inline_size_ : elements_.size();}
 
-        std::size_t capacity() const {return elements_.capacity();}
+        std::size_t capacity() const {return is_inline_ ? inline_capacity_ : elements_.capacity();}
 
-        void clear() {elements_.clear();}
+        void clear() 
+        {
+            if (is_inline_)
+            {
+                destroy_inline(0, inline_size_);
+                inline_size_ = 0;
+            }
+            else
+            {
+                elements_.clear();
+            }
+        }
 
         void shrink_to_fit() 
         {
-            for (std::size_t i = 0; i < elements_.size(); ++i)
+            for (auto& item : *this)
             {
-                elements_[i].shrink_to_fit();
+                item.shrink_to_fit();
+            }
+            if (!is_inline_)
+            {
+                if (inline_capacity_ > 0 && elements_.size() <= inline_capacity_)
+                {
+                    unspill();
+                }
+                else
+                {
+                    elements_.shrink_to_fit();
+                }
             }
-            elements_.shrink_to_fit();
         }
 
-        void reserve(std::size_t n) {elements_.reserve(n);}
+        void reserve(std::size_t n) 
+        {
+            if (is_inline_)
+            {
+                if (n > inline_capacity_)
+                {
+                    spill(n);
+                }
+            }
+            else
+            {
+                elements_.reserve(n);
+            }
+        }
 
-        void resize(std::size_t n) {elements_.resize(n);}
+        void resize(std::size_t n) 
+        {
+            if (is_inline_ && n > inline_capacity_)
+            {
+                spill(n);
+            }
+            if (is_inline_)
+            {
+                if (n < inline_size_)
+                {
+                    destroy_inline(n, inline_size_);
+                    inline_size_ = n;
+                }
+                while (inline_size_ < n)
+                {
+                    emplace_back();
+                }
+            }
+            else
+            {
+                elements_.resize(n);
+            }
+        }
 
-        void resize(std::size_t n, const Json& val) {elements_.resize(n,val);}
+        void resize(std::size_t n, const Json& val) 
+        {
+            if (is_inline_ && n > inline_capacity_)
+            {
+                temp_element temp(get_allocator(), val);
+                spill(n);
+                elements_.resize(n, *temp.get());
+            }
+            else if (is_inline_)
+            {
+                if (n < inline_size_)
+                {
+                    destroy_inline(n, inline_size_);
+                    inline_size_ = n;
+                }
+                while (inline_size_ < n)
+                {
+                    emplace_back(val);
+                }
+            }
+            else
+            {
+                elements_.resize(n,val);
+            }
+        }
 
         iterator erase(const_iterator pos) 
         {
-            return elements_.erase(pos);
+            return erase(pos, pos + 1);
         }
 
         iterator erase(const_iterator first, const_iterator last) 
         {
-            return elements_.erase(first,last);
+            if (!is_inline_)
+            {
+                return elements_.erase(first, last);
+            }
+            const std::size_t index = index_of(first);
+            const std::size_t count = static_cast<std::size_t>(last - first);
+            Json* p = inline_data();
+            std::move(p + index + count, p + inline_size_, p + index);
+            destroy_inline(inline_size_ - count, inline_size_);
+            inline_size_ -= count;
+            return begin() + index;
         }
 
-        Json& operator[](std::size_t i) {return elements_[i];}
+        Json& operator[](std::size_t i) {return is_inline_ ? inline_data()[i] : elements_[i];}
 
-        const Json& operator[](std::size_t i) const {return elements_[i];}
+        const Json& operator[](std::size_t i) const {return is_inline_ ? inline_data()[i] : elements_[i];}
 
         // push_back
 
@@ -174,90 +429,311 @@ namespace jsoncons {
         typename std::enable_if<std::allocator_traits<A>::is_always_equal::value,void>::type 
         push_back(T&& value)
         {
-            elements_.emplace_back(std::forward<T>(value));
+            emplace_back(std::forward<T>(value));
         }
 
         template <typename T,typename A=allocator_type>
         typename std::enable_if<!std::allocator_traits<A>::is_always_equal::value,void>::type 
         push_back(T&& value)
         {
-            elements_.emplace_back(std::forward<T>(value));
+            emplace_back(std::forward<T>(value));
         }
 
         template <typename T,typename A=allocator_type>
         typename std::enable_if<std::allocator_traits<A>::is_always_equal::value,iterator>::type 
         insert(const_iterator pos, T&& value)
         {
-            return elements_.emplace(pos, std::forward<T>(value));
+            return emplace(pos, std::forward<T>(value));
         }
         template <typename T,typename A=allocator_type>
         typename std::enable_if<!std::allocator_traits<A>::is_always_equal::value,iterator>::type 
         insert(const_iterator pos, T&& value)
         {
-            return elements_.emplace(pos, std::forward<T>(value));
+            return emplace(pos, std::forward<T>(value));
         }
 
         template <typename InputIt>
         iterator insert(const_iterator pos, InputIt first, InputIt last)
         {
-            return elements_.insert(pos, first, last);
+            if (!is_inline_)
+            {
+                return elements_.insert(pos, first, last);
+            }
+            const std::size_t index = index_of(pos);
+            spill(inline_size_);
+            return elements_.insert(elements_.begin() + index, first, last);
         }
 
-        template <typename A=allocator_type,typename... Args>
-        typename std::enable_if<std::allocator_traits<A>::is_always_equal::value,iterator>::type 
-        emplace(const_iterator pos, Args&&... args)
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
         {
-            return elements_.emplace(pos, std::forward<Args>(args)...);
+            if (!is_inline_)
+            {
+                return elements_.emplace(pos, std::forward<Args>(args)...);
+            }
+            const std::size_t index = index_of(pos);
+            if (index == inline_size_)
+            {
+                emplace_back(std::forward<Args>(args)...);
+            }
+            else if (inline_size_ < inline_capacity_)
+            {
+                temp_element temp(get_allocator(), std::forward<Args>(args)...);
+                Json* p = inline_data();
+                construct_inline(p + inline_size_, std::move(p[inline_size_ - 1]));
+                std::move_backward(p + index, p + (inline_size_ - 1), p + inline_size_);
+                ++inline_size_;
+                p[index] = std::move(*temp.get());
+            }
+            else
+            {
+                temp_element temp(get_allocator(), std::forward<Args>(args)...);
+                spill(next_capacity());
+                return elements_.emplace(elements_.begin() + index, std::move(*temp.get()));
+            }
+            return begin() + index;
         }
 
         template <typename... Args>
         Json& emplace_back(Args&&... args)
         {
+            if (is_inline_)
+            {
+                if (inline_size_ < inline_capacity_)
+                {
+                    Json* p = inline_data() + inline_size_;
+                    construct_inline(p, std::forward<Args>(args)...);
+                    ++inline_size_;
+                    return *p;
+                }
+                temp_element temp(get_allocator(), std::forward<Args>(args)...);
+                spill(next_capacity());
+                elements_.emplace_back(std::move(*temp.get()));
+                return elements_.back();
+            }
             elements_.emplace_back(std::forward<Args>(args)...);
             return elements_.back();
         }
 
-        iterator begin() {return elements_.begin();}
+        iterator begin() {return is_inline_ ? to_iterator(inline_data(), inline_support()) : elements_.begin();}
 
-        iterator end() {return elements_.end();}
+        iterator end() {return is_inline_ ? to_iterator(inline_data() + inline_size_, inline_support()) : elements_.end();}
 
-        const_iterator begin() const {return elements_.begin();}
+        const_iterator begin() const {return is_inline_ ? to_iterator(inline_data(), inline_support()) : elements_.begin();}
 
-        const_iterator end() const {return elements_.end();}
+        const_iterator end() const {return is_inline_ ? to_iterator(inline_data() + inline_size_, inline_support()) : elements_.end();}
 
         bool operator==(const json_array& rhs) const noexcept
         {
-            return elements_ == rhs.elements_;
+            return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
         }
 
         bool operator<(const json_array& rhs) const noexcept
         {
-            return elements_ < rhs.elements_;
+            return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
         }
 
         json_array& operator=(const json_array& other)
         {
-            elements_ = other.elements_;
+            if (this == &other)
+            {
+                return *this;
+            }
+            if (is_inline_)
+            {
+                clear();
+                if (other.size() > inline_capacity_)
+                {
+                    spill(other.size());
+                }
+            }
+            if (is_inline_)
+            {
+                for (const auto& item : other)
+                {
+                    emplace_back(item);
+                }
+            }
+            else if (other.is_inline_)
+            {
+                elements_.assign(other.begin(), other.end());
+            }
+            else
+            {
+                elements_ = other.elements_;
+            }
             return *this;
         }
     private:
 
+        static constexpr std::size_t inline_offset() noexcept
+        {
+            return (sizeof(json_array) + alignof(Json) - 1) / alignof(Json) * alignof(Json);
+        }
+
+        Json* inline_data() noexcept
+        {
+            return reinterpret_cast<Json*>(reinterpret_cast<char*>(this) + inline_offset());
+        }
+
+        const Json* inline_data() const noexcept
+        {
+            return reinterpret_cast<const Json*>(reinterpret_cast<const char*>(this) + inline_offset());
+        }
+
+        static iterator to_iterator(Json* p, std::true_type)
+        {
+            return iterator(p);
+        }
+
+        // Never called, no element is kept inline
+        static iterator to_iterator(Json*, std::false_type)
+        {
+            return iterator();
+        }
+
+        static const_iterator to_iterator(const Json* p, std::true_type)
+        {
+            return const_iterator(p);
+        }
+
+        static const_iterator to_iterator(const Json*, std::false_type)
+        {
+            return const_iterator();
+        }
+
+        std::size_t index_of(const_iterator pos) const
+        {
+            return static_cast<std::size_t>(pos - begin());
+        }
+
+        template <typename... Args>
+        void construct_inline(Json* p, Args&&... args)
+        {
+            value_allocator_type alloc(get_allocator());
+            value_allocator_traits::construct(alloc, p, std::forward<Args>(args)...);
+        }
+
+        void destroy_inline(std::size_t first, std::size_t last) noexcept
+        {
+            value_allocator_type alloc(get_allocator());
+            Json* p = inline_data();
+            for (std::size_t i = first; i < last; ++i)
+            {
+                value_allocator_traits::destroy(alloc, p + i);
+            }
+        }
+
+        std::size_t next_capacity() const noexcept
+        {
+            return inline_size_ == 0 ? 1 : 2*inline_size_;
+        }
+
+        // Moves the inline elements to elements_, which holds all elements from then on
+        void spill(std::size_t n)
+        {
+            elements_.reserve(n < inline_size_ ? inline_size_ : n);
+            Json* p = inline_data();
+            for (std::size_t i = 0; i < inline_size_; ++i)
+            {
+                elements_.emplace_back(std::move(p[i]));
+            }
+            destroy_inline(0, inline_size_);
+            inline_size_ = 0;
+            is_inline_ = false;
+        }
+
+        // Moves the inline elements of other from index first on to the end of this 
+        // array, which keeps them inline if there is room and spills otherwise
+        void take_inline(json_array& other, std::size_t first)
+        {
+            const std::size_t n = inline_size_ + (other.inline_size_ - first);
+            if (!is_inline_ || n > inline_capacity_)
+            {
+                if (is_inline_)
+                {
+                    spill(n);
+                }
+                Json* p = other.inline_data();
+                for (std::size_t i = first; i < other.inline_size_; ++i)
+                {
+                    elements_.emplace_back(std::move(p[i]));
+                }
+            }
+            else
+            {
+                Json* p = other.inline_data();
+                Json* q = inline_data();
+                for (std::size_t i = first; i < other.inline_size_; ++i)
+                {
+                    construct_inline(q + inline_size_, std::move(p[i]));
+                    ++inline_size_;
+                }
+            }
+            other.destroy_inline(first, other.inline_size_);
+            other.inline_size_ = first;
+        }
+
+        // Moves the elements back after this array and releases the buffer of elements_
+        void unspill() noexcept
+        {
+            Json* p = inline_data();
+            for (std::size_t i = 0; i < elements_.size(); ++i)
+            {
+                construct_inline(p + i, std::move(elements_[i]));
+            }
+            inline_size_ = elements_.size();
+            is_inline_ = true;
+            value_allocator_type alloc(get_allocator());
+            value_container_type temp(alloc);
+            elements_.swap(temp);
+        }
+
+        void append_inline_copy(const json_array& other)
+        {
+            if (other.is_inline_)
+            {
+                elements_.reserve(other.inline_size_);
+                for (const auto& item : other)
+                {
+                    elements_.emplace_back(item);
+                }
+            }
+        }
+
+        void append_inline_move(json_array& other)
+        {
+            if (other.is_inline_)
+            {
+                elements_.reserve(other.inline_size_);
+                for (auto& item : other)
+                {
+                    elements_.emplace_back(std::move(item));
+                }
+                other.clear();
+            }
+        }
+
         void flatten_and_destroy() noexcept
         {
-            while (!elements_.empty())
+            while (!empty())
             {
-                value_type current = std::move(elements_.back());
-                elements_.pop_back();
+                value_type current = std::move(back());
+                pop_back();
+                if (current.storage_kind() == json_storage_kind::shared)
+                {
+                    current.take_shared_value();
+                }
                 switch (current.storage_kind())
                 {
                     case json_storage_kind::array:
                     {
                         for (auto&& item : current.array_range())
                         {
-                            if ((item.storage_kind() == json_storage_kind::array || item.storage_kind() == json_storage_kind::object)
-                                && !item.empty()) // non-empty object or array
+                            if (((item.storage_kind() == json_storage_kind::array || item.storage_kind() == json_storage_kind::object)
+                                && !item.empty()) || item.storage_kind() == json_storage_kind::shared) // non-empty object or array, or shared node
                             {
-                                elements_.push_back(std::move(item));
+                                emplace_back(std::move(item));
                             }
                         }
                         current.clear();                           
@@ -267,10 +743,10 @@ namespace jsoncons {
                     {
                         for (auto&& kv : current.object_range())
                         {
-                            if ((kv.value().storage_kind() == json_storage_kind::array || kv.value().storage_kind() == json_storage_kind::object)
-                                && !kv.value().empty()) // non-empty object or array
+                            if (((kv.value().storage_kind() == json_storage_kind::array || kv.value().storage_kind() == json_storage_kind::object)
+                                && !kv.value().empty()) || kv.value().storage_kind() == json_storage_kind::shared) // non-empty object or array, or shared node
                             {
-                                elements_.push_back(std::move(kv.value()));
+                                emplace_back(std::move(kv.value()));
                             }
                         }
                         current.clear();                           
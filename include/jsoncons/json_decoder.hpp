@@ -40,20 +40,28 @@ public:
     using json_byte_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t>;
 private:
 
-    enum class structure_type {root_t, array_t, object_t};
+    // sized_array_t is an array whose length was reported by the parser,
+    // its elements are emplaced directly into the container
+    enum class structure_type {root_t, array_t, object_t, sized_array_t};
 
     struct structure_info
     {
         structure_type type_;
         std::size_t container_index_{0};
+        std::size_t length_{0};
 
-        structure_info(structure_type type, std::size_t offset) noexcept
-            : type_(type), container_index_(offset)
+        structure_info(structure_type type, std::size_t offset, std::size_t length = 0) noexcept
+            : type_(type), container_index_(offset), length_(length)
         {
         }
         ~structure_info() = default;
     };
 
+    // Largest capacity reserved for a sized array before its elements arrive.
+    // After that the capacity at most doubles as elements are added, so that
+    // a corrupt length cannot reserve much more than the decoded elements need
+    static constexpr std::size_t max_initial_capacity = 4096;
+
     using temp_allocator_type = TempAlloc;
     using stack_item_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<index_key_value<Json>>;
     using structure_info_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<structure_info>;
@@ -151,18 +159,24 @@ private:
         }
 
         item_stack_.erase(first, item_stack_.end());
-        structure_stack_.pop_back();
+        end_structure();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+    {
         if (structure_stack_.back().type_ == structure_type::root_t)
         {
-            result_.swap(item_stack_.front().value);
-            item_stack_.pop_back();
-            is_valid_ = true;
-            JSONCONS_VISITOR_RETURN;
+            index_ = 0;
+            item_stack_.clear();
+            is_valid_ = false;
         }
+        item_stack_.emplace_back(std::move(name_), index_++, json_array_arg, tag);
+        structure_stack_.emplace_back(structure_type::array_t, item_stack_.size()-1);
         JSONCONS_VISITOR_RETURN;
     }
 
-    JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+    JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(std::size_t length, semantic_tag tag, const ser_context&, std::error_code&) override
     {
         if (structure_stack_.back().type_ == structure_type::root_t)
         {
@@ -171,13 +185,19 @@ private:
             is_valid_ = false;
         }
         item_stack_.emplace_back(std::move(name_), index_++, json_array_arg, tag);
-        structure_stack_.emplace_back(structure_type::array_t, item_stack_.size()-1);
+        structure_stack_.emplace_back(structure_type::sized_array_t, item_stack_.size()-1, length);
         JSONCONS_VISITOR_RETURN;
     }
 
     JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context&, std::error_code&) override
     {
         JSONCONS_ASSERT(structure_stack_.size() > 1);
+        if (structure_stack_.back().type_ == structure_type::sized_array_t)
+        {
+            JSONCONS_ASSERT(item_stack_.size() == structure_stack_.back().container_index_ + 1);
+            end_structure();
+            JSONCONS_VISITOR_RETURN;
+        }
         JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::array_t);
         const size_t container_index = structure_stack_.back().container_index_;
         JSONCONS_ASSERT(item_stack_.size() > container_index);
@@ -199,15 +219,42 @@ private:
             item_stack_.erase(first, item_stack_.end());
         }
 
+        end_structure();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    // Pops a completed container, which is the last item on the item stack
+    void end_structure()
+    {
         structure_stack_.pop_back();
-        if (structure_stack_.back().type_ == structure_type::root_t)
+        switch (structure_stack_.back().type_)
         {
-            result_.swap(item_stack_.front().value);
-            item_stack_.pop_back();
-            is_valid_ = true;
-            JSONCONS_VISITOR_RETURN;
+            case structure_type::root_t:
+                result_.swap(item_stack_.front().value);
+                item_stack_.pop_back();
+                is_valid_ = true;
+                break;
+            case structure_type::sized_array_t:
+                emplace_sized(std::move(item_stack_.back().value));
+                item_stack_.pop_back();
+                break;
+            default:
+                break;
         }
-        JSONCONS_VISITOR_RETURN;
+    }
+
+    template <typename... Args>
+    void emplace_sized(Args&&... args)
+    {
+        const auto& info = structure_stack_.back();
+        Json& container = item_stack_[info.container_index_].value;
+        const std::size_t capacity = container.capacity();
+        if (container.size() == capacity && capacity < info.length_)
+        {
+            std::size_t n = capacity < max_initial_capacity/2 ? std::size_t(max_initial_capacity) : 2*capacity;
+            container.reserve(n < info.length_ ? n : info.length_);
+        }
+        container.emplace_back(std::forward<Args>(args)...);
     }
 
     JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
@@ -224,6 +271,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, sv, tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(sv, tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(sv, tag, allocator_);
                 is_valid_ = true;
@@ -243,6 +293,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, byte_string_arg, b, tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(byte_string_arg, b, tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(byte_string_arg, b, tag, allocator_);
                 is_valid_ = true;
@@ -262,6 +315,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, byte_string_arg, b, ext_tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(byte_string_arg, b, ext_tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(byte_string_arg, b, ext_tag, allocator_);
                 is_valid_ = true;
@@ -281,6 +337,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, value, tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(value, tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(value,tag);
                 is_valid_ = true;
@@ -300,6 +359,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, value, tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(value, tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(value,tag);
                 is_valid_ = true;
@@ -319,6 +381,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, half_arg, value, tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(half_arg, value, tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(half_arg, value, tag);
                 is_valid_ = true;
@@ -338,6 +403,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, value, tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(value, tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(value, tag);
                 is_valid_ = true;
@@ -354,6 +422,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, value, tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(value, tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(value, tag);
                 is_valid_ = true;
@@ -370,6 +441,9 @@ private:
             case structure_type::array_t:
                 item_stack_.emplace_back(std::move(name_), index_++, null_type(), tag);
                 break;
+            case structure_type::sized_array_t:
+                emplace_sized(null_type(), tag);
+                break;
             case structure_type::root_t:
                 result_ = Json(null_type(), tag);
                 is_valid_ = true;
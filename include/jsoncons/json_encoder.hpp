@@ -20,6 +20,7 @@
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/utility/write_number.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_options.hpp>
@@ -64,36 +65,43 @@ namespace detail {
                     sink.push_back('\\');
                     sink.push_back('\\');
                     count += 2;
+                    JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     break;
                 case '"':
                     sink.push_back('\\');
                     sink.push_back('\"');
                     count += 2;
+                    JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     break;
                 case '\b':
                     sink.push_back('\\');
                     sink.push_back('b');
                     count += 2;
+                    JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     break;
                 case '\f':
                     sink.push_back('\\');
                     sink.push_back('f');
                     count += 2;
+                    JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     break;
                 case '\n':
                     sink.push_back('\\');
                     sink.push_back('n');
                     count += 2;
+                    JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     break;
                 case '\r':
                     sink.push_back('\\');
                     sink.push_back('r');
                     count += 2;
+                    JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     break;
                 case '\t':
                     sink.push_back('\\');
                     sink.push_back('t');
                     count += 2;
+                    JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     break;
                 default:
                     if (escape_solidus && c == '/')
@@ -101,6 +109,7 @@ namespace detail {
                         sink.push_back('\\');
                         sink.push_back('/');
                         count += 2;
+                        JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     }
                     else if (is_control_character(c) || escape_all_non_ascii)
                     {
@@ -133,6 +142,7 @@ namespace detail {
                                 sink.push_back(jsoncons::utility::to_hex_character(second >> 4 & 0x000F));
                                 sink.push_back(jsoncons::utility::to_hex_character(second & 0x000F));
                                 count += 12;
+                                JSONCONS_INSTRUMENT_COUNT(escapes, 2);
                             }
                             else
                             {
@@ -143,6 +153,7 @@ namespace detail {
                                 sink.push_back(jsoncons::utility::to_hex_character(cp >> 4 & 0x000F));
                                 sink.push_back(jsoncons::utility::to_hex_character(cp & 0x000F));
                                 count += 6;
+                                JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                             }
                         }
                         else
@@ -871,6 +882,7 @@ namespace detail {
             }
             else
             {
+                JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
                 std::size_t length = fp_(value, sink_);
                 column_ += length;
             }
@@ -895,6 +907,7 @@ namespace detail {
                     break_line();
                 }
             }
+            JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
             std::size_t length = jsoncons::utility::from_integer(value, sink_);
             column_ += length;
             end_value();
@@ -917,6 +930,7 @@ namespace detail {
                     break_line();
                 }
             }
+            JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
             std::size_t length = jsoncons::utility::from_integer(value, sink_);
             column_ += length;
             end_value();
@@ -1525,6 +1539,7 @@ namespace detail {
             }
             else
             {
+                JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
                 fp_(value, sink_);
             }
 
@@ -1544,6 +1559,7 @@ namespace detail {
             {
                 sink_.push_back(',');
             }
+            JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
             jsoncons::utility::from_integer(value, sink_);
             if (!stack_.empty())
             {
@@ -1561,6 +1577,7 @@ namespace detail {
             {
                 sink_.push_back(',');
             }
+            JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
             jsoncons::utility::from_integer(value, sink_);
             if (!stack_.empty())
             {
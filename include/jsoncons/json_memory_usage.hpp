@@ -0,0 +1,42 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_MEMORY_USAGE_HPP
+#define JSONCONS_JSON_MEMORY_USAGE_HPP
+
+#include <cstddef>
+
+namespace jsoncons {
+
+    // The heap bytes owned by a basic_json value, as requested from its allocator
+
+    struct json_memory_usage
+    {
+        std::size_t strings{0};         // long strings and object member names
+        std::size_t byte_strings{0};
+        std::size_t arrays{0};          // arrays and the element slots in use
+        std::size_t objects{0};         // objects and the member slots in use
+        std::size_t slack{0};           // reserved element, member and name capacity not in use
+
+        std::size_t total() const noexcept
+        {
+            return strings + byte_strings + arrays + objects + slack;
+        }
+
+        json_memory_usage& operator+=(const json_memory_usage& other) noexcept
+        {
+            strings += other.strings;
+            byte_strings += other.byte_strings;
+            arrays += other.arrays;
+            objects += other.objects;
+            slack += other.slack;
+            return *this;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif // JSONCONS_JSON_MEMORY_USAGE_HPP
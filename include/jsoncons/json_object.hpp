@@ -315,6 +315,31 @@ namespace jsoncons {
             bool operator() (string_view_type k, const key_value_type& kv) const { return k < kv.key(); }
         };
 
+        // Objects with at most this many members are searched linearly, 
+        // rejecting members by length before comparing characters
+        static constexpr std::size_t linear_search_max_size = 16;
+
+        template <typename Iterator>
+        static Iterator find_member(Iterator first, Iterator last, const string_view_type& name) noexcept
+        {
+            if (static_cast<std::size_t>(last - first) <= linear_search_max_size)
+            {
+                const std::size_t length = name.size();
+                for (; first != last; ++first)
+                {
+                    const auto& key = first->key();
+                    if (key.size() == length && 
+                        std::char_traits<char_type>::compare(key.data(), name.data(), length) == 0)
+                    {
+                        return first;
+                    }
+                }
+                return last;
+            }
+            auto it = std::lower_bound(first, last, name, Comp());
+            return (it == last || name < it->key()) ? last : it;
+        }
+
         using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;
         using key_value_container_type = SequenceContainer<key_value_type,key_value_allocator_type>;
 
@@ -490,16 +515,12 @@ namespace jsoncons {
 
         iterator find(const string_view_type& name) noexcept
         {
-            auto p = std::equal_range(members_.begin(),members_.end(), name, 
-                                       Comp());        
-            return p.first == p.second ? members_.end() : p.first;
+            return find_member(members_.begin(), members_.end(), name);
         }
 
         const_iterator find(const string_view_type& name) const noexcept
         {
-            auto p = std::equal_range(members_.begin(),members_.end(), name, 
-                                       Comp());        
-            return p.first == p.second ? members_.end() : p.first;
+            return find_member(members_.begin(), members_.end(), name);
         }
 
         iterator erase(const_iterator pos) 
@@ -567,22 +588,22 @@ namespace jsoncons {
         template <typename InputIt>
         void insert(sorted_unique_range_tag, InputIt first, InputIt last)
         {
-            if (first != last)
+            // The range is sorted, so each search starts after the previous member,
+            // and appending to an empty object compares no keys
+            auto it = members_.begin();
+            for (auto s = first; s != last; ++s)
             {
-                auto it = find(convert(*first).key());
-                if (it != members_.end())
+                key_value_type member(make_key_value<KeyT,Json>()(*s));
+                string_view_type key(member.key().data(), member.key().size());
+                it = std::lower_bound(it, members_.end(), key, Comp());
+                if (it != members_.end() && (*it).key() == key)
                 {
-                    for (auto s = first; s != last; ++s)
-                    {
-                        it = members_.emplace(it, key_type(s->first, get_allocator()), s->second);
-                    }
+                    ++it;
                 }
                 else
                 {
-                    for (auto s = first; s != last; ++s)
-                    {
-                        members_.emplace_back(convert(*s));
-                    }
+                    it = members_.emplace(it, std::move(member));
+                    ++it;
                 }
             }
         }
@@ -994,6 +1015,9 @@ namespace jsoncons {
                                 temp.emplace_back(std::move(kv.value()));
                             }
                             break;
+                        case json_storage_kind::shared:
+                            temp.emplace_back(std::move(kv.value()));
+                            break;
                         default:
                             break;
                     }
@@ -1717,6 +1741,9 @@ namespace jsoncons {
                                 temp.emplace_back(std::move(kv.value()));
                             }
                             break;
+                        case json_storage_kind::shared:
+                            temp.emplace_back(std::move(kv.value()));
+                            break;
                         default:
                             break;
                     }
@@ -0,0 +1,822 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_PARALLEL_PARSE_CONTEXT_HPP
+#define JSONCONS_JSON_PARALLEL_PARSE_CONTEXT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional> // std::ref
+#include <iterator> // std::make_move_iterator
+#include <memory> // std::allocator
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/allocator_set.hpp>
+#include <jsoncons/instrumentation.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/utility/unicode_traits.hpp>
+
+namespace jsoncons {
+
+// Parses a JSON text whose root, or the value at a JSON Pointer, is a large array,
+// by dividing the array at top level commas and parsing the pieces on several threads.
+// The first piece carries the text before and after the array, the others are parsed
+// as arrays of their own, and their elements are appended in order.
+
+template <typename Json,typename TempAlloc =std::allocator<char>>
+class json_parallel_parse_context
+{
+public:
+    using value_type = Json;
+    using char_type = typename Json::char_type;
+    using allocator_type = typename Json::allocator_type;
+    using temp_allocator_type = TempAlloc;
+    using string_view_type = jsoncons::basic_string_view<char_type>;
+
+    // The least number of characters given to a thread
+    static constexpr std::size_t min_chunk_length = 65536;
+private:
+    using string_type = std::basic_string<char_type>;
+
+    // A span of text fed to a parser, and the offset in the text of its first character
+    struct piece
+    {
+        const char_type* data;
+        std::size_t length;
+        std::size_t origin;
+    };
+
+    struct chunk_result
+    {
+        Json value;
+        std::error_code ec;
+        std::size_t piece_index{0};
+        std::size_t line{1};
+        std::size_t column{1};
+        std::size_t piece_line{1};
+        std::size_t piece_column{1};
+        std::exception_ptr exception;
+    };
+
+    struct worker
+    {
+        json_decoder<Json,TempAlloc> decoder;
+        basic_json_parser<char_type,TempAlloc> parser;
+
+        worker(const allocator_type& alloc, const TempAlloc& temp_alloc,
+            const basic_json_decode_options<char_type>& options)
+            : decoder(alloc, temp_alloc), parser(options, temp_alloc)
+        {
+        }
+
+        void parse(const piece* pieces, std::size_t count, chunk_result& result)
+        {
+            parser.reinitialize();
+            decoder.reset();
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                result.piece_index = i;
+                result.piece_line = parser.line();
+                result.piece_column = parser.column();
+                parser.update(pieces[i].data, pieces[i].length);
+                parser.parse_some(decoder, result.ec);
+                if (JSONCONS_UNLIKELY(result.ec))
+                {
+                    break;
+                }
+            }
+            if (!result.ec)
+            {
+                parser.finish_parse(decoder, result.ec);
+            }
+            if (!result.ec)
+            {
+                parser.check_done(result.ec);
+            }
+            if (JSONCONS_UNLIKELY(result.ec))
+            {
+                result.line = parser.line();
+                result.column = parser.column();
+                return;
+            }
+            if (JSONCONS_UNLIKELY(!decoder.is_valid()))
+            {
+                result.ec = json_errc::source_error;
+                return;
+            }
+            result.value = decoder.get_result();
+        }
+    };
+
+    allocator_type alloc_;
+    temp_allocator_type temp_alloc_;
+    basic_json_decode_options<char_type> options_;
+    std::size_t thread_count_;
+    std::vector<std::unique_ptr<worker>> workers_;
+    Json result_;
+    std::size_t line_{1};
+    std::size_t column_{1};
+    std::size_t chunk_count_{0};
+
+public:
+    explicit json_parallel_parse_context(std::size_t thread_count = 0,
+        const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        : alloc_(), temp_alloc_(), options_(options), thread_count_(resolve_thread_count(thread_count))
+    {
+    }
+
+    json_parallel_parse_context(const allocator_set<allocator_type,TempAlloc>& aset, std::size_t thread_count = 0,
+        const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        : alloc_(aset.get_allocator()), temp_alloc_(aset.get_temp_allocator()), options_(options),
+          thread_count_(resolve_thread_count(thread_count)), result_(aset.get_allocator())
+    {
+    }
+
+    json_parallel_parse_context(const json_parallel_parse_context&) = delete;
+    json_parallel_parse_context& operator=(const json_parallel_parse_context&) = delete;
+
+    std::size_t thread_count() const
+    {
+        return thread_count_;
+    }
+
+    // The position in the original text of the error reported by the last parse
+    std::size_t line() const
+    {
+        return line_;
+    }
+
+    std::size_t column() const
+    {
+        return column_;
+    }
+
+    // The number of pieces the last parse was divided into, 1 if it was parsed on the calling thread only
+    std::size_t chunk_count() const
+    {
+        return chunk_count_;
+    }
+
+    // Parses a complete JSON text whose root is expected to be an array, the result is taken with get_result
+    void parse(const string_view_type& source, std::error_code& ec)
+    {
+        parse(source, string_view_type(), ec);
+    }
+
+    // Parses a complete JSON text, dividing the array at the JSON Pointer `pointer`
+    void parse(const string_view_type& source, const string_view_type& pointer, std::error_code& ec)
+    {
+        JSONCONS_INSTRUMENT_TIMER(parse);
+        line_ = 1;
+        column_ = 1;
+        chunk_count_ = 0;
+
+        auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
+        if (!(r.encoding == unicode_traits::encoding_kind::utf8 || r.encoding == unicode_traits::encoding_kind::undetected))
+        {
+            ec = json_errc::illegal_unicode_character;
+            return;
+        }
+        std::size_t offset = (r.ptr - source.data());
+        string_view_type text(source.data() + offset, source.size() - offset);
+
+        if (workers_.empty())
+        {
+            add_worker();
+        }
+
+        std::vector<string_type> tokens;
+        std::vector<std::size_t> splits;
+        std::size_t array_end = 0;
+        if (thread_count_ > 1 && split_pointer(pointer, tokens))
+        {
+            if (!find_splits(text, tokens, splits, array_end))
+            {
+                splits.clear();
+            }
+        }
+
+        std::vector<Json> chunks;
+        parse_chunks(text, splits, array_end, chunks, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return;
+        }
+        if (chunk_count_ > 1 && !stitch(tokens, chunks))
+        {
+            // The decoded document does not have the array that was divided, for example
+            // because of duplicate member names, so it is parsed again in one piece
+            splits.clear();
+            chunks.clear();
+            parse_chunks(text, splits, array_end, chunks, ec);
+        }
+    }
+
+    Json get_result()
+    {
+        return std::move(result_);
+    }
+
+    Json parse(const string_view_type& source)
+    {
+        return parse(source, string_view_type());
+    }
+
+    Json parse(const string_view_type& source, const string_view_type& pointer)
+    {
+        std::error_code ec;
+        parse(source, pointer, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            JSONCONS_THROW(ser_error(ec, line_, column_));
+        }
+        return get_result();
+    }
+
+private:
+    static std::size_t resolve_thread_count(std::size_t thread_count)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = std::thread::hardware_concurrency();
+        }
+        return thread_count == 0 ? 1 : thread_count;
+    }
+
+    void add_worker()
+    {
+        workers_.emplace_back(new worker(alloc_, temp_alloc_, options_));
+    }
+
+    void parse_chunks(const string_view_type& text, const std::vector<std::size_t>& splits,
+        std::size_t array_end, std::vector<Json>& chunks, std::error_code& ec)
+    {
+        const std::size_t count = splits.size() + 1;
+        chunk_count_ = count;
+
+        std::vector<chunk_result> results(count);
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> first_failed{count};
+
+        auto work = [&](worker& w)
+        {
+            for (std::size_t k = next++; k < count; k = next++)
+            {
+                if (k > first_failed.load())
+                {
+                    continue;
+                }
+                piece pieces[3];
+                std::size_t n = make_pieces(text, splits, array_end, k, pieces);
+                chunk_result& result = results[k];
+                JSONCONS_TRY
+                {
+                    w.parse(pieces, n, result);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    result.exception = std::current_exception();
+                }
+                if ((result.ec || result.exception) && !is_suffix_error(result, k, count))
+                {
+                    std::size_t failed = first_failed.load();
+                    while (k < failed && !first_failed.compare_exchange_weak(failed, k))
+                    {
+                    }
+                }
+            }
+        };
+
+        const std::size_t thread_count = (std::min)(thread_count_, count);
+        while (workers_.size() < thread_count)
+        {
+            add_worker();
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count - 1);
+        for (std::size_t i = 1; i < thread_count; ++i)
+        {
+            JSONCONS_TRY
+            {
+                threads.emplace_back(work, std::ref(*workers_[i]));
+            }
+            JSONCONS_CATCH(const std::system_error&)
+            {
+                break; // the threads already started, and this one, parse the rest
+            }
+        }
+        work(*workers_[0]);
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        for (auto& result : results)
+        {
+            if (result.exception)
+            {
+                std::rethrow_exception(result.exception);
+            }
+        }
+
+        // Report the first error in document order, errors in the text after the array come last
+        std::size_t first = count;
+        for (std::size_t k = 0; k < count && first == count; ++k)
+        {
+            if (results[k].ec && !is_suffix_error(results[k], k, count))
+            {
+                first = k;
+            }
+        }
+        if (first == count && results[0].ec)
+        {
+            first = 0;
+        }
+        if (first < count)
+        {
+            piece pieces[3];
+            make_pieces(text, splits, array_end, first, pieces);
+            const chunk_result& result = results[first];
+            set_error_position(text, pieces[result.piece_index].origin, result);
+            ec = result.ec;
+            return;
+        }
+
+        result_ = std::move(results[0].value);
+        for (std::size_t k = 1; k < count; ++k)
+        {
+            chunks.push_back(std::move(results[k].value));
+        }
+    }
+
+    // Appends the elements of the other chunks to the array in the first
+    bool stitch(const std::vector<string_type>& tokens, std::vector<Json>& chunks)
+    {
+        Json* target = std::addressof(result_);
+        for (const auto& token : tokens)
+        {
+            if (target->is_object())
+            {
+                auto it = target->find(string_view_type(token));
+                if (it == target->object_range().end())
+                {
+                    return false;
+                }
+                target = std::addressof(it->value());
+            }
+            else if (target->is_array())
+            {
+                std::size_t index = 0;
+                if (!to_index(token, index) || index >= target->size())
+                {
+                    return false;
+                }
+                target = std::addressof((*target)[index]);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        if (!target->is_array())
+        {
+            return false;
+        }
+
+        std::size_t size = target->size();
+        for (const auto& chunk : chunks)
+        {
+            size += chunk.size();
+        }
+        target->reserve(size);
+        for (auto& chunk : chunks)
+        {
+            auto elements = chunk.array_range();
+            target->insert(target->array_range().end(),
+                std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+        }
+        return true;
+    }
+
+    // The first chunk is the text up to the first split followed by the text from the end of the array,
+    // the others are the elements between splits, enclosed in brackets
+    static std::size_t make_pieces(const string_view_type& text, const std::vector<std::size_t>& splits,
+        std::size_t array_end, std::size_t k, piece* pieces)
+    {
+        static const char_type open_bracket[1] = {'['};
+        static const char_type close_bracket[1] = {']'};
+
+        if (splits.empty())
+        {
+            pieces[0] = piece{text.data(), text.size(), 0};
+            return 1;
+        }
+        if (k == 0)
+        {
+            pieces[0] = piece{text.data(), splits[0], 0};
+            pieces[1] = piece{text.data() + (array_end - 1), text.size() - (array_end - 1), array_end - 1};
+            return 2;
+        }
+        std::size_t first = splits[k-1] + 1;
+        pieces[0] = piece{open_bracket, 1, splits[k-1]};
+        if (k < splits.size())
+        {
+            pieces[1] = piece{text.data() + first, splits[k] - first, first};
+            pieces[2] = piece{close_bracket, 1, splits[k]};
+            return 3;
+        }
+        pieces[1] = piece{text.data() + first, array_end - first, first};
+        return 2;
+    }
+
+    // An error in the text after the array of the first chunk
+    static bool is_suffix_error(const chunk_result& result, std::size_t k, std::size_t count)
+    {
+        return k == 0 && count > 1 && result.piece_index == 1;
+    }
+
+    // Translates the position reported by the parser of a chunk to the position in the original text
+    void set_error_position(const string_view_type& text, std::size_t origin, const chunk_result& result)
+    {
+        std::size_t line = 1;
+        std::size_t column = 1;
+        for (std::size_t i = 0; i < origin; ++i)
+        {
+            switch (text[i])
+            {
+                case '\r':
+                    ++line;
+                    column = 1;
+                    if (i + 1 < origin && text[i+1] == '\n')
+                    {
+                        ++i;
+                    }
+                    break;
+                case '\n':
+                    ++line;
+                    column = 1;
+                    break;
+                default:
+                    ++column;
+                    break;
+            }
+        }
+        if (result.line == result.piece_line)
+        {
+            line_ = line;
+            column_ = column + (result.column - result.piece_column);
+        }
+        else
+        {
+            line_ = line + (result.line - result.piece_line);
+            column_ = result.column;
+        }
+    }
+
+    static bool split_pointer(const string_view_type& pointer, std::vector<string_type>& tokens)
+    {
+        if (pointer.empty())
+        {
+            return true;
+        }
+        if (pointer[0] != '/')
+        {
+            return false;
+        }
+        string_type token;
+        for (std::size_t i = 1; i < pointer.size(); ++i)
+        {
+            switch (pointer[i])
+            {
+                case '/':
+                    tokens.push_back(token);
+                    token.clear();
+                    break;
+                case '~':
+                    if (i + 1 < pointer.size() && (pointer[i+1] == '0' || pointer[i+1] == '1'))
+                    {
+                        token.push_back(pointer[i+1] == '0' ? '~' : '/');
+                        ++i;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                    break;
+                default:
+                    token.push_back(pointer[i]);
+                    break;
+            }
+        }
+        tokens.push_back(token);
+        return true;
+    }
+
+    static bool to_index(const string_type& token, std::size_t& index)
+    {
+        if (token.empty() || (token.size() > 1 && token[0] == '0'))
+        {
+            return false;
+        }
+        index = 0;
+        for (auto c : token)
+        {
+            if (c < '0' || c > '9')
+            {
+                return false;
+            }
+            std::size_t n = index*10 + static_cast<std::size_t>(c - '0');
+            if (n / 10 != index)
+            {
+                return false;
+            }
+            index = n;
+        }
+        return true;
+    }
+
+    // Structural scan
+
+    // Finds the array designated by tokens, and the top level commas at which it may be divided.
+    // Returns false if there is no such array, or the text is not well formed enough to tell.
+    bool find_splits(const string_view_type& text, const std::vector<string_type>& tokens,
+        std::vector<std::size_t>& splits, std::size_t& array_end)
+    {
+        std::size_t pos = 0;
+        int level = 0;
+        for (const auto& token : tokens)
+        {
+            if (!skip_space(text, pos))
+            {
+                return false;
+            }
+            if (text[pos] == '{')
+            {
+                ++level;
+                ++pos;
+                bool found = false;
+                while (!found)
+                {
+                    if (!skip_space(text, pos) || text[pos] != '"')
+                    {
+                        return false;
+                    }
+                    std::size_t key_begin = pos;
+                    if (!skip_string(text, pos))
+                    {
+                        return false;
+                    }
+                    found = key_equals(string_view_type(text.data() + key_begin, pos - key_begin), token);
+                    if (!skip_space(text, pos) || text[pos] != ':')
+                    {
+                        return false;
+                    }
+                    ++pos;
+                    if (!found)
+                    {
+                        if (!skip_space(text, pos) || !skip_value(text, pos, level) ||
+                            !skip_space(text, pos) || text[pos] != ',')
+                        {
+                            return false;
+                        }
+                        ++pos;
+                    }
+                }
+            }
+            else if (text[pos] == '[')
+            {
+                std::size_t index = 0;
+                if (!to_index(token, index))
+                {
+                    return false;
+                }
+                ++level;
+                ++pos;
+                for (std::size_t i = 0; i < index; ++i)
+                {
+                    if (!skip_space(text, pos) || text[pos] == ']' || !skip_value(text, pos, level) ||
+                        !skip_space(text, pos) || text[pos] != ',')
+                    {
+                        return false;
+                    }
+                    ++pos;
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+        if (!skip_space(text, pos) || text[pos] != '[')
+        {
+            return false;
+        }
+
+        std::size_t chunk_length = (text.size() - pos) / (thread_count_*4);
+        if (chunk_length < min_chunk_length)
+        {
+            chunk_length = min_chunk_length;
+        }
+        if (!scan_structure(text, pos, level, chunk_length, &splits))
+        {
+            return false;
+        }
+        array_end = pos;
+        return true;
+    }
+
+    bool key_equals(const string_view_type& quoted, const string_type& token)
+    {
+        string_view_type key(quoted.data() + 1, quoted.size() - 2);
+        if (std::find(key.begin(), key.end(), '\\') == key.end())
+        {
+            return key == string_view_type(token);
+        }
+        chunk_result result;
+        piece p{quoted.data(), quoted.size(), 0};
+        workers_[0]->parse(&p, 1, result);
+        return !result.ec && result.value.is_string() && result.value.as_string_view() == string_view_type(token);
+    }
+
+    bool skip_value(const string_view_type& text, std::size_t& pos, int level) const
+    {
+        switch (text[pos])
+        {
+            case '"':
+                return skip_string(text, pos);
+            case '[':
+            case '{':
+                return scan_structure(text, pos, level, 0, nullptr);
+            default:
+            {
+                std::size_t first = pos;
+                while (pos < text.size())
+                {
+                    switch (text[pos])
+                    {
+                        case ',': case ']': case '}': case ' ': case '\t': case '\n': case '\r': case '/':
+                            return pos > first;
+                        default:
+                            ++pos;
+                            break;
+                    }
+                }
+                return false;
+            }
+        }
+    }
+
+    // Skips the array or object at pos. If splits is not null, records the commas of the
+    // array at least chunk_length apart that are followed by another element.
+    bool scan_structure(const string_view_type& text, std::size_t& pos, int level,
+        std::size_t chunk_length, std::vector<std::size_t>* splits) const
+    {
+        const int max_nesting_depth = options_.max_nesting_depth();
+        std::size_t depth = 0;
+        std::size_t last = pos;
+        while (pos < text.size())
+        {
+            switch (text[pos])
+            {
+                case '"':
+                    if (!skip_string(text, pos))
+                    {
+                        return false;
+                    }
+                    break;
+                case '[':
+                case '{':
+                    if (++level > max_nesting_depth)
+                    {
+                        return false;
+                    }
+                    ++depth;
+                    ++pos;
+                    break;
+                case ']':
+                case '}':
+                    --level;
+                    ++pos;
+                    if (--depth == 0)
+                    {
+                        return true;
+                    }
+                    break;
+                case ',':
+                    if (splits != nullptr && depth == 1 && pos - last >= chunk_length && text[pos-1] != '\r')
+                    {
+                        std::size_t next = pos + 1;
+                        if (skip_space(text, next) && text[next] != ']')
+                        {
+                            splits->push_back(pos);
+                            last = pos;
+                        }
+                    }
+                    ++pos;
+                    break;
+                case '/':
+                    if (!skip_comment(text, pos))
+                    {
+                        return false;
+                    }
+                    break;
+                default:
+                    ++pos;
+                    break;
+            }
+        }
+        return false;
+    }
+
+    // Skips whitespace and comments, returns false at the end of the text
+    static bool skip_space(const string_view_type& text, std::size_t& pos)
+    {
+        while (pos < text.size())
+        {
+            switch (text[pos])
+            {
+                case ' ': case '\t': case '\n': case '\r':
+                    ++pos;
+                    break;
+                case '/':
+                    if (!skip_comment(text, pos))
+                    {
+                        return false;
+                    }
+                    break;
+                default:
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    static bool skip_comment(const string_view_type& text, std::size_t& pos)
+    {
+        if (pos + 1 >= text.size())
+        {
+            return false;
+        }
+        if (text[pos+1] == '*')
+        {
+            for (std::size_t i = pos + 2; i + 1 < text.size(); ++i)
+            {
+                if (text[i] == '*' && text[i+1] == '/')
+                {
+                    pos = i + 2;
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (text[pos+1] == '/')
+        {
+            pos += 2;
+            while (pos < text.size() && text[pos] != '\n' && text[pos] != '\r')
+            {
+                ++pos;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    static bool skip_string(const string_view_type& text, std::size_t& pos)
+    {
+        ++pos;
+        while (pos < text.size())
+        {
+            switch (text[pos])
+            {
+                case '"':
+                    ++pos;
+                    return true;
+                case '\\':
+                    pos += 2;
+                    break;
+                default:
+                    ++pos;
+                    break;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace jsoncons
+
+#endif // JSONCONS_JSON_PARALLEL_PARSE_CONTEXT_HPP
@@ -0,0 +1,111 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_PARSE_CONTEXT_HPP
+#define JSONCONS_JSON_PARSE_CONTEXT_HPP
+
+#include <cstddef>
+#include <memory> // std::allocator
+#include <system_error>
+
+#include <jsoncons/allocator_set.hpp>
+#include <jsoncons/instrumentation.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/utility/unicode_traits.hpp>
+
+namespace jsoncons {
+
+// A parser and decoder that are kept between parses, so that their buffers
+// and stacks are allocated once rather than for every text
+
+template <typename Json,typename TempAlloc =std::allocator<char>>
+class json_parse_context
+{
+public:
+    using value_type = Json;
+    using char_type = typename Json::char_type;
+    using allocator_type = typename Json::allocator_type;
+    using temp_allocator_type = TempAlloc;
+    using string_view_type = jsoncons::basic_string_view<char_type>;
+private:
+    json_decoder<Json,TempAlloc> decoder_;
+    basic_json_parser<char_type,TempAlloc> parser_;
+
+public:
+    explicit json_parse_context(const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        : decoder_(),
+          parser_(options)
+    {
+    }
+
+    json_parse_context(const allocator_set<allocator_type,TempAlloc>& aset,
+        const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        : decoder_(aset.get_allocator(), aset.get_temp_allocator()),
+          parser_(options, aset.get_temp_allocator())
+    {
+    }
+
+    json_parse_context(const json_parse_context&) = delete;
+    json_parse_context& operator=(const json_parse_context&) = delete;
+
+    std::size_t line() const
+    {
+        return parser_.line();
+    }
+
+    std::size_t column() const
+    {
+        return parser_.column();
+    }
+
+    // Parses a complete JSON text, the result is taken with get_result
+    void parse(const string_view_type& source, std::error_code& ec)
+    {
+        JSONCONS_INSTRUMENT_TIMER(parse);
+        parser_.reinitialize();
+        decoder_.reset();
+
+        auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
+        if (!(r.encoding == unicode_traits::encoding_kind::utf8 || r.encoding == unicode_traits::encoding_kind::undetected))
+        {
+            ec = json_errc::illegal_unicode_character;
+            return;
+        }
+        std::size_t offset = (r.ptr - source.data());
+        parser_.update(source.data()+offset,source.size()-offset);
+        parser_.parse_some(decoder_, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return;
+        }
+        parser_.finish_parse(decoder_, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return;
+        }
+        parser_.check_done(ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return;
+        }
+        if (JSONCONS_UNLIKELY(!decoder_.is_valid()))
+        {
+            ec = json_errc::source_error;
+        }
+    }
+
+    Json get_result()
+    {
+        return decoder_.get_result();
+    }
+};
+
+} // namespace jsoncons
+
+#endif // JSONCONS_JSON_PARSE_CONTEXT_HPP
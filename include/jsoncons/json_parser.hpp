@@ -20,6 +20,7 @@
 
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/utility/read_number.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_filter.hpp>
@@ -1992,6 +1993,7 @@ text:
                 }
                 case '\\': 
                 {
+                    JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                     buffer_.append(sb,cur-sb);
                     position_ += (cur - sb + 1);
                     ++cur;
@@ -2183,6 +2185,7 @@ escape_expect_surrogate_pair1:
             switch (*cur)
             {
             case '\\': 
+                JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                 cp2_ = 0;
                 ++cur;
                 ++position_;
@@ -2439,6 +2442,7 @@ private:
     void end_negative_value(basic_json_visitor<char_type>& visitor, std::error_code& ec)
     {
         int64_t val;
+        JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
         auto result = jsoncons::utility::dec_to_integer(buffer_.data(), buffer_.length(), val);
         if (result)
         {
@@ -2456,6 +2460,7 @@ private:
     void end_positive_value(basic_json_visitor<char_type>& visitor, std::error_code& ec)
     {
         uint64_t val;
+        JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
         auto result = jsoncons::utility::dec_to_integer(buffer_.data(), buffer_.length(), val);
         if (result)
         {
@@ -2480,6 +2485,7 @@ private:
         else
         {
             double d{0};
+            JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
             auto result = jsoncons::utility::decstr_to_double(&buffer_[0], buffer_.length(), d);
             if (JSONCONS_LIKELY(result))
             {
@@ -16,6 +16,7 @@
 #include <utility> // std::move
 
 #include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_parser.hpp>
 #include <jsoncons/json_type.hpp>
@@ -419,6 +420,7 @@ namespace jsoncons {
 
         void read(std::error_code& ec)
         {
+            JSONCONS_INSTRUMENT_TIMER(parse);
             read_next(ec);
             if (!ec)
             {
@@ -158,6 +158,13 @@ namespace jsoncons {
     
     JSONCONS_INLINE_CONSTEXPR json_pointer_arg_t json_pointer_arg{};
 
+    struct json_shared_arg_t
+    {
+        explicit json_shared_arg_t() = default; 
+    };
+    
+    JSONCONS_INLINE_CONSTEXPR json_shared_arg_t json_shared_arg{};
+
     struct raw_json_arg_t
     {
         explicit raw_json_arg_t() = default; 
@@ -182,6 +189,8 @@ namespace jsoncons {
         short_str = 7,            // 0111
         json_const_ref = 8, // 1000    
         json_ref = 9,       // 1001    
+        empty_array = 10,         // 1010
+        shared = 11,              // 1011
         byte_str = 12,            // 1100  
         object = 13,              // 1101
         array = 14,               // 1110
@@ -198,7 +207,7 @@ namespace jsoncons {
     {
         static const uint8_t mask{ uint8_t(json_storage_kind::long_str) & uint8_t(json_storage_kind::byte_str) 
             & uint8_t(json_storage_kind::array) & uint8_t(json_storage_kind::object) };
-        return (uint8_t(storage_kind) & mask) != mask;
+        return (uint8_t(storage_kind) & mask) != mask && storage_kind != json_storage_kind::shared;
     }
 
     template <typename CharT>
@@ -214,10 +223,12 @@ namespace jsoncons {
         static constexpr const CharT* long_string_value = JSONCONS_CSTRING_CONSTANT(CharT, "string");
         static constexpr const CharT* byte_string_value = JSONCONS_CSTRING_CONSTANT(CharT, "byte_string");
         static constexpr const CharT* array_value = JSONCONS_CSTRING_CONSTANT(CharT, "array");
+        static constexpr const CharT* empty_array_value = JSONCONS_CSTRING_CONSTANT(CharT, "empty_array");
         static constexpr const CharT* empty_object_value = JSONCONS_CSTRING_CONSTANT(CharT, "empty_object");
         static constexpr const CharT* object_value = JSONCONS_CSTRING_CONSTANT(CharT, "object");
         static constexpr const CharT* json_const_ref = JSONCONS_CSTRING_CONSTANT(CharT, "json_const_ref");
         static constexpr const CharT* json_ref = JSONCONS_CSTRING_CONSTANT(CharT, "json_ref");
+        static constexpr const CharT* shared_value = JSONCONS_CSTRING_CONSTANT(CharT, "shared");
 
         switch (storage)
         {
@@ -271,6 +282,11 @@ namespace jsoncons {
                 os << array_value;
                 break;
             }
+            case json_storage_kind::empty_array:
+            {
+                os << empty_array_value;
+                break;
+            }
             case json_storage_kind::empty_object:
             {
                 os << empty_object_value;
@@ -291,6 +307,11 @@ namespace jsoncons {
                 os << json_ref;
                 break;
             }
+            case json_storage_kind::shared:
+            {
+                os << shared_value;
+                break;
+            }
         }
         return os;
     }
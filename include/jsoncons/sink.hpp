@@ -12,6 +12,8 @@
 #include <cstring> // std::memcpy
 #include <memory> // std::addressof
 #include <ostream>
+#include <type_traits>
+#include <utility> // std::declval
 #include <vector>
 
 #include <jsoncons/config/jsoncons_config.hpp>
@@ -284,12 +286,44 @@ namespace jsoncons {
         {
         }
 
+        void append(const uint8_t* s, std::size_t length)
+        {
+            buf_ptr->insert(buf_ptr->end(), s, s + length);
+        }
+
         void push_back(uint8_t ch)
         {
             buf_ptr->push_back(static_cast<value_type>(ch));
         }
     };
 
+namespace detail {
+
+    template <typename Sink>
+    using sink_append_t = decltype(std::declval<Sink&>().append(std::declval<const uint8_t*>(), std::size_t()));
+
+    // Writes a block of bytes to a binary sink, in a single call if the sink supports append 
+
+    template <typename Sink>
+    typename std::enable_if<ext_traits::is_detected<sink_append_t,Sink>::value>::type
+    append_bytes(Sink& sink, const uint8_t* s, std::size_t length)
+    {
+        sink.append(s, length);
+    }
+
+    template <typename Sink>
+    typename std::enable_if<!ext_traits::is_detected<sink_append_t,Sink>::value>::type
+    append_bytes(Sink& sink, const uint8_t* s, std::size_t length)
+    {
+        const uint8_t* end = s + length;
+        for (const uint8_t* p = s; p != end; ++p)
+        {
+            sink.push_back(*p);
+        }
+    }
+
+} // namespace detail
+
 } // namespace jsoncons
 
 #endif // JSONCONS_SINK_HPP
@@ -16,11 +16,13 @@
 #include <memory> // std::addressof
 #include <string>
 #include <type_traits> // std::enable_if
+#include <utility> // std::declval
 #include <vector>
 
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/utility/byte_string.hpp> // jsoncons::byte_traits
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/utility/more_type_traits.hpp>
 
 namespace jsoncons { 
@@ -260,6 +262,7 @@ namespace jsoncons {
                 {
                     std::streamsize count = sbuf_->sgetn(reinterpret_cast<char_type*>(p+len), length-len);
                     std::size_t len2 = static_cast<std::size_t>(count);
+                    JSONCONS_INSTRUMENT_COUNT(buffer_refills, 1);
                     if (len2 < length-len)
                     {
                         stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
@@ -289,6 +292,7 @@ namespace jsoncons {
             {
                 std::streamsize count = sbuf_->sgetn(reinterpret_cast<char_type*>(buffer_.data()), buffer_.size());
                 buffer_length_ = static_cast<std::size_t>(count);
+                JSONCONS_INSTRUMENT_COUNT(buffer_refills, 1);
 
                 if (buffer_length_ < buffer_.size())
                 {
@@ -590,6 +594,17 @@ namespace jsoncons {
             return span<const value_type>(data, length);
         }
 
+        // Returns a view of the next length bytes (or fewer at end of input) 
+        // without copying, and advances past them
+        span<const value_type> read_span(std::size_t length)
+        {
+            const value_type* data = current_;
+            std::size_t len = (std::min)(std::size_t(end_ - current_), length);
+            current_ += len;
+
+            return span<const value_type>(data, len);
+        }
+
         std::size_t read(value_type* p, std::size_t length)
         {
             std::size_t len;
@@ -789,6 +804,17 @@ namespace jsoncons {
     constexpr std::size_t source_reader<Source>::max_buffer_length;
 #endif
 
+namespace detail {
+
+    template <typename Source>
+    using source_read_span_t = decltype(std::declval<Source&>().read_span(std::size_t()));
+
+    // A contiguous source can hand out views of its input with read_span
+    template <typename Source>
+    using is_contiguous_source = ext_traits::is_detected<source_read_span_t,Source>;
+
+} // namespace detail
+
 } // namespace jsoncons
 
 #endif // JSONCONS_SOURCE_HPP
@@ -0,0 +1,109 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_UTILITY_HASH_HPP
+#define JSONCONS_UTILITY_HASH_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <type_traits>
+
+namespace jsoncons {
+namespace utility {
+
+    // Hash helpers that give the same result on every run and every platform,
+    // unlike std::hash, whose results are implementation defined.
+
+    // Finalizer from splitmix64
+    inline uint64_t hash_mix(uint64_t x) noexcept
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    inline uint64_t hash_combine(uint64_t seed, uint64_t value) noexcept
+    {
+        return hash_mix(seed + 0x9e3779b97f4a7c15ULL + value);
+    }
+
+    // FNV-1a over code units
+    template <typename CharT>
+    uint64_t hash_chars(const CharT* s, std::size_t length) noexcept
+    {
+        using unsigned_type = typename std::make_unsigned<CharT>::type;
+
+        uint64_t result{0xcbf29ce484222325ULL};
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            result = (result ^ static_cast<unsigned_type>(s[i])) * 0x100000001b3ULL;
+        }
+        return result;
+    }
+
+    // Equal values give equal hashes, in particular 0.0 and -0.0
+    inline uint64_t hash_double(double val) noexcept
+    {
+        if (val == 0.0)
+        {
+            return 0;
+        }
+        if (std::isnan(val))
+        {
+            return 0x7ff8000000000000ULL;
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &val, sizeof(bits));
+        return bits;
+    }
+
+    // Accumulates the hash of an array from the hashes of its elements, in order.
+    // basic_json::structural_hash uses this, as does code that hashes a document
+    // bottom up and needs the same result for each array.
+    class array_hasher
+    {
+        uint64_t hash_{0x9b05688c2b3e6c1fULL};
+        std::size_t size_{0};
+    public:
+        void add(uint64_t element_hash) noexcept
+        {
+            hash_ = hash_combine(hash_, element_hash);
+            ++size_;
+        }
+
+        uint64_t hash() const noexcept
+        {
+            return hash_combine(hash_, size_);
+        }
+    };
+
+    // Accumulates the hash of an object from its member names and the hashes of their values.
+    // Summing the mixed member hashes makes the result independent of member order.
+    class object_hasher
+    {
+        uint64_t sum_{0};
+    public:
+        template <typename CharT>
+        void add(const CharT* name, std::size_t length, uint64_t value_hash) noexcept
+        {
+            sum_ += hash_combine(hash_chars(name, length), value_hash);
+        }
+
+        uint64_t hash() const noexcept
+        {
+            return hash_combine(0x1f83d9abfb41bd6bULL, sum_);
+        }
+    };
+
+} // namespace utility
+} // namespace jsoncons
+
+#endif // JSONCONS_UTILITY_HASH_HPP
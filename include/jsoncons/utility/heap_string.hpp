@@ -165,6 +165,12 @@ namespace utility {
             return std::pointer_traits<pointer>::pointer_to(*ps);
         }
 
+        // The number of bytes allocated for the string
+        static std::size_t allocated_size(pointer ptr) noexcept
+        {
+            return ptr->align_pad_ + aligned_size(ptr->length_*sizeof(char_type));
+        }
+
         static void destroy(pointer ptr)
         {
             if (ptr != nullptr)
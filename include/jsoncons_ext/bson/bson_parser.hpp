@@ -17,6 +17,7 @@
 
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/semantic_tag.hpp>
@@ -608,6 +609,7 @@ private:
                 dec.low = binary::little_to_native<uint64_t>(buf, sizeof(uint64_t));
                 dec.high = binary::little_to_native<uint64_t>(buf+sizeof(uint64_t), sizeof(uint64_t));
 
+                JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
                 text_buffer_.clear();
                 text_buffer_.resize(bson::decimal128_limits::buf_size);
                 auto r = bson::decimal128_to_chars(&text_buffer_[0], &text_buffer_[0]+text_buffer_.size(), dec);
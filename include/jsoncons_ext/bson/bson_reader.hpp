@@ -13,6 +13,7 @@
 #include <utility> // std::move
 
 #include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/source.hpp>
@@ -60,6 +61,7 @@ public:
 
     void read(std::error_code& ec)
     {
+        JSONCONS_INSTRUMENT_TIMER(parse);
         parser_.reset();
         parser_.parse(visitor_, ec);
         if (JSONCONS_UNLIKELY(ec))
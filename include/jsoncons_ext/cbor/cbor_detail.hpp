@@ -7,11 +7,17 @@
 #ifndef JSONCONS_EXT_CBOR_CBOR_DETAIL_HPP
 #define JSONCONS_EXT_CBOR_CBOR_DETAIL_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/utility/byte_string.hpp>
 
 // 0x00..0x17 (0..23)
 #define JSONCONS_EXT_CBOR_0x00_0x17 \
@@ -80,6 +86,217 @@ size_t min_length_for_stringref(uint64_t index)
     return n;
 }
 
+// The strings of a stringref namespace, in index order. The contents are 
+// appended to a single arena, so adding a string costs no allocation of its own.
+
+template <typename Allocator>
+class stringref_list
+{
+public:
+    using allocator_type = Allocator;
+private:
+    struct entry
+    {
+        cbor_major_type type;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    using byte_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t>;
+    using entry_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<entry>;
+
+    std::vector<uint8_t,byte_allocator_type> arena_;
+    std::vector<entry,entry_allocator_type> entries_;
+public:
+    explicit stringref_list(const allocator_type& alloc = allocator_type())
+        : arena_(alloc), entries_(alloc)
+    {
+    }
+
+    stringref_list(const stringref_list&) = default;
+    stringref_list(stringref_list&&) = default;
+
+    stringref_list(const stringref_list& other, const allocator_type& alloc)
+        : arena_(other.arena_, alloc), entries_(other.entries_, alloc)
+    {
+    }
+
+    stringref_list(stringref_list&& other, const allocator_type& alloc)
+        : arena_(std::move(other.arena_), alloc), entries_(std::move(other.entries_), alloc)
+    {
+    }
+
+    stringref_list& operator=(const stringref_list&) = default;
+    stringref_list& operator=(stringref_list&&) = default;
+
+    std::size_t size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    cbor_major_type type(std::size_t index) const
+    {
+        return entries_[index].type;
+    }
+
+    byte_string_view bytes(std::size_t index) const
+    {
+        const entry& e = entries_[index];
+        return byte_string_view(arena_.data() + e.offset, e.length);
+    }
+
+    // Adds a string and returns its index
+    std::size_t push_back(cbor_major_type type, const uint8_t* data, std::size_t length)
+    {
+        std::size_t offset = arena_.size();
+        arena_.insert(arena_.end(), data, data + length);
+        entries_.push_back(entry{type, offset, length});
+        return entries_.size() - 1;
+    }
+
+    void reserve(std::size_t count, std::size_t length)
+    {
+        entries_.reserve(count);
+        arena_.reserve(length);
+    }
+
+    void clear() noexcept
+    {
+        arena_.clear();
+        entries_.clear();
+    }
+};
+
+// A stringref_list with a hash index for finding the index of a string, 
+// open addressing with linear probing over a power of two number of slots.
+// Text and byte strings with the same bytes are distinct keys.
+
+template <typename Allocator>
+class stringref_map
+{
+public:
+    using allocator_type = Allocator;
+private:
+    struct slot
+    {
+        std::size_t hash;
+        std::size_t index; // index + 1, 0 if empty
+    };
+
+    using slot_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<slot>;
+
+    stringref_list<Allocator> strings_;
+    std::vector<slot,slot_allocator_type> slots_;
+public:
+    explicit stringref_map(const allocator_type& alloc = allocator_type())
+        : strings_(alloc), slots_(alloc)
+    {
+    }
+
+    std::size_t size() const noexcept
+    {
+        return strings_.size();
+    }
+
+    // Returns the index of an equal string, or adds the string and returns its new index.
+    // The second member is true if the string was added.
+    std::pair<std::size_t,bool> try_emplace(cbor_major_type type, const uint8_t* data, std::size_t length)
+    {
+        std::size_t hash = hash_bytes(type, data, length);
+        if (!slots_.empty())
+        {
+            std::size_t mask = slots_.size() - 1;
+            for (std::size_t i = hash & mask; slots_[i].index != 0; i = (i + 1) & mask)
+            {
+                const slot& s = slots_[i];
+                if (s.hash == hash && strings_.type(s.index-1) == type)
+                {
+                    auto b = strings_.bytes(s.index-1);
+                    if (b.size() == length && (length == 0 || std::memcmp(b.data(), data, length) == 0))
+                    {
+                        return std::make_pair(s.index-1, false);
+                    }
+                }
+            }
+        }
+        return std::make_pair(insert(hash, type, data, length), true);
+    }
+
+    // Adds a string even if an equal one is present, lookups find the first
+    std::size_t push_back(cbor_major_type type, const uint8_t* data, std::size_t length)
+    {
+        return insert(hash_bytes(type, data, length), type, data, length);
+    }
+
+    void reserve(std::size_t count, std::size_t length = 0)
+    {
+        strings_.reserve(count, length);
+        if (count*2 > slots_.size())
+        {
+            rehash(count*2);
+        }
+    }
+
+    void clear() noexcept
+    {
+        strings_.clear();
+        std::fill(slots_.begin(), slots_.end(), slot{0,0});
+    }
+private:
+    std::size_t insert(std::size_t hash, cbor_major_type type, const uint8_t* data, std::size_t length)
+    {
+        // Keep the load factor at or below one half
+        if ((strings_.size() + 1)*2 > slots_.size())
+        {
+            rehash((strings_.size() + 1)*2);
+        }
+        std::size_t index = strings_.push_back(type, data, length);
+        place(slot{hash, index+1});
+        return index;
+    }
+
+    void place(const slot& s)
+    {
+        std::size_t mask = slots_.size() - 1;
+        std::size_t i = s.hash & mask;
+        while (slots_[i].index != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = s;
+    }
+
+    void rehash(std::size_t min_slots)
+    {
+        std::size_t n = 16;
+        while (n < min_slots)
+        {
+            n *= 2;
+        }
+        std::vector<slot,slot_allocator_type> old(n, slot{0,0}, slots_.get_allocator());
+        old.swap(slots_);
+        for (const auto& s : old)
+        {
+            if (s.index != 0)
+            {
+                place(s);
+            }
+        }
+    }
+
+    // FNV-1a
+    static std::size_t hash_bytes(cbor_major_type type, const uint8_t* data, std::size_t length)
+    {
+        uint64_t h = 14695981039346656037ULL;
+        h = (h ^ static_cast<uint8_t>(type)) * 1099511628211ULL;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            h = (h ^ data[i]) * 1099511628211ULL;
+        }
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+};
+
 } // namespace detail 
 } // namespace cbor
 } // namespace jsoncons
@@ -11,7 +11,6 @@
 #include <cstdint>
 #include <cstring>
 #include <limits> // std::numeric_limits
-#include <map>
 #include <memory>
 #include <string>
 #include <system_error>
@@ -98,8 +97,6 @@ private:
 
     };
 
-    using string_size_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const string_type,size_t>>;
-    using byte_string_size_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const byte_string_type,size_t>>;
     using stack_item_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<stack_item>;
 
     Sink sink_;
@@ -107,9 +104,7 @@ private:
     allocator_type alloc_;
 
     std::vector<stack_item,stack_item_allocator_type> stack_;
-    std::map<string_type,size_t,std::less<string_type>,string_size_allocator_type> stringref_map_;
-    std::map<byte_string_type,size_t,std::less<byte_string_type>,byte_string_size_allocator_type> bytestringref_map_;
-    std::size_t next_stringref_ = 0;
+    jsoncons::cbor::detail::stringref_map<allocator_type> stringref_map_;
     int nesting_depth_{0};
 public:
 
@@ -129,12 +124,12 @@ public:
          options_(options), 
          alloc_(alloc),
          stack_(alloc),
-         stringref_map_(alloc),
-         bytestringref_map_(alloc)
+         stringref_map_(alloc)
     {
         if (options.pack_strings())
         {
             write_tag(256);
+            add_preset_stringrefs();
         }
     }
 
@@ -156,8 +151,10 @@ public:
     {
         stack_.clear();
         stringref_map_.clear();
-        bytestringref_map_.clear();
-        next_stringref_ = 0;
+        if (options_.pack_strings())
+        {
+            add_preset_stringrefs();
+        }
         nesting_depth_ = 0;
     }
 
@@ -459,19 +456,18 @@ private:
             JSONCONS_THROW(ser_error(cbor_errc::invalid_utf8_text_string));
         }
 
-        if (options_.pack_strings() && sv.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
+        if (options_.pack_strings() && sv.size() >= jsoncons::cbor::detail::min_length_for_stringref(stringref_map_.size()))
         {
-            string_type s(sv.data(), sv.size(), alloc_);
-            auto it = stringref_map_.find(s);
-            if (it == stringref_map_.end())
+            auto r = stringref_map_.try_emplace(jsoncons::cbor::detail::cbor_major_type::text_string,
+                reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
+            if (r.second)
             {
-                stringref_map_.emplace(std::make_pair(std::move(s), next_stringref_++));
                 write_utf8_string(sv);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value((*it).second);
+                write_uint64_value(r.first);
             }
         }
         else
@@ -480,6 +476,26 @@ private:
         }
     }
 
+    void add_preset_stringrefs()
+    {
+        const auto& presets = options_.preset_stringrefs();
+        if (presets.empty())
+        {
+            return;
+        }
+        std::size_t length = 0;
+        for (const auto& s : presets)
+        {
+            length += s.size();
+        }
+        stringref_map_.reserve(presets.size(), length);
+        for (const auto& s : presets)
+        {
+            stringref_map_.push_back(jsoncons::cbor::detail::cbor_major_type::text_string,
+                reinterpret_cast<const uint8_t*>(s.data()), s.size());
+        }
+    }
+
     void write_utf8_string(const string_view& sv)
     {
         const size_t length = sv.size();
@@ -519,10 +535,7 @@ private:
                                             std::back_inserter(sink_));
         }
 
-        for (auto c : sv)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::append_bytes(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
     }
 
     void write_bignum(bigint& n)
@@ -998,19 +1011,17 @@ private:
             default:
                 break;
         }
-        if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
+        if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(stringref_map_.size()))
         {
-            byte_string_type bs(b.data(), b.size(), alloc_);
-            auto it = bytestringref_map_.find(bs);
-            if (it == bytestringref_map_.end())
+            auto r = stringref_map_.try_emplace(jsoncons::cbor::detail::cbor_major_type::byte_string, b.data(), b.size());
+            if (r.second)
             {
-                bytestringref_map_.emplace(std::make_pair(bs, next_stringref_++));
-                write_byte_string(bs);
+                write_byte_string(b);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value((*it).second);
+                write_uint64_value(r.first);
             }
         }
         else
@@ -1027,20 +1038,18 @@ private:
                            const ser_context&,
                            std::error_code&) override
     {
-        if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
+        if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(stringref_map_.size()))
         {
-            byte_string_type bs(b.data(), b.size(), alloc_);
-            auto it = bytestringref_map_.find(bs);
-            if (it == bytestringref_map_.end())
+            auto r = stringref_map_.try_emplace(jsoncons::cbor::detail::cbor_major_type::byte_string, b.data(), b.size());
+            if (r.second)
             {
-                bytestringref_map_.emplace(std::make_pair(bs, next_stringref_++));
                 write_tag(ext_tag);
-                write_byte_string(bs);
+                write_byte_string(b);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value((*it).second);
+                write_uint64_value(r.first);
             }
         }
         else
@@ -1090,10 +1099,7 @@ private:
                                             std::back_inserter(sink_));
         }
 
-        for (auto c : b)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::append_bytes(sink_, b.data(), b.size());
     }
 
     JSONCONS_VISITOR_RETURN_TYPE visit_double(double val, 
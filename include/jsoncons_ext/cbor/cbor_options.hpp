@@ -8,6 +8,9 @@
 #define JSONCONS_EXT_CBOR_CBOR_OPTIONS_HPP
 
 #include <cwchar>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <jsoncons_ext/cbor/cbor_detail.hpp>
 
@@ -21,6 +24,8 @@ class cbor_options_common
     friend class cbor_options;
 
     int max_nesting_depth_;
+    // Shared, options are copied into every encoder and parser
+    std::shared_ptr<const std::vector<std::string>> preset_stringrefs_;
 protected:
     virtual ~cbor_options_common() = default;
 
@@ -38,6 +43,12 @@ public:
     {
         return max_nesting_depth_;
     }
+
+    const std::vector<std::string>& preset_stringrefs() const 
+    {
+        static const std::vector<std::string> empty;
+        return preset_stringrefs_ ? *preset_stringrefs_ : empty;
+    }
 };
 
 class cbor_decode_options : public virtual cbor_options_common
@@ -77,6 +88,7 @@ class cbor_options final : public cbor_decode_options, public cbor_encode_option
 {
 public:
     using cbor_options_common::max_nesting_depth;
+    using cbor_options_common::preset_stringrefs;
     using cbor_encode_options::pack_strings;
     using cbor_encode_options::use_typed_arrays;
 
@@ -86,6 +98,12 @@ public:
         return *this;
     }
 
+    cbor_options& preset_stringrefs(const std::vector<std::string>& value)
+    {
+        this->preset_stringrefs_ = std::make_shared<const std::vector<std::string>>(value);
+        return *this;
+    }
+
     cbor_options& pack_strings(bool value)
     {
         this->use_stringref_ = value;
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/item_event_visitor.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/json_visitor.hpp>
@@ -68,58 +69,8 @@ class basic_cbor_parser : public ser_context
     using string_type = std::basic_string<char_type,char_traits_type,char_allocator_type>;
     using byte_string_type = std::vector<uint8_t,byte_allocator_type>;
 
-    struct mapped_string
-    {
-        using allocator_type = Allocator;
-
-        jsoncons::cbor::detail::cbor_major_type type;
-        string_type str;
-        byte_string_type bytes;
-
-        mapped_string(const string_type& str, const allocator_type& alloc = allocator_type())
-            : type(jsoncons::cbor::detail::cbor_major_type::text_string), str(str.c_str(), str.size(), alloc), bytes(alloc)
-        {
-        }
-
-        mapped_string(string_type&& str, const allocator_type& alloc = allocator_type())
-            : type(jsoncons::cbor::detail::cbor_major_type::text_string), str(std::move(str), alloc), bytes(alloc)
-        {
-        }
-
-        mapped_string(const byte_string_type& bytes, 
-            const allocator_type& alloc = allocator_type())
-            : type(jsoncons::cbor::detail::cbor_major_type::byte_string), str(alloc), bytes(bytes,alloc)
-        {
-        }
-
-        mapped_string(byte_string_type&& bytes, 
-            const allocator_type& alloc = allocator_type())
-            : type(jsoncons::cbor::detail::cbor_major_type::byte_string), str(alloc), bytes(std::move(bytes),alloc)
-        {
-        }
-
-        mapped_string(const mapped_string&) = default;
-        mapped_string(mapped_string&&) = default;
-
-        mapped_string& operator=(const mapped_string&) = default;
-        mapped_string& operator=(mapped_string&&) = default;
-
-        mapped_string(const mapped_string& other, const allocator_type& alloc) 
-            :  type(other.type), str(other.str,alloc), bytes(other.bytes,alloc)
-        {
-        }
-
-        mapped_string(mapped_string&& other, const allocator_type& alloc) noexcept
-            : type(other.type), str(std::move(other.str), alloc), bytes(std::move(other.bytes), alloc)
-        {
-        }
-
-        ~mapped_string() = default;
-    };
-
-    using mapped_string_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<mapped_string>;                           
-    using stringref_map = std::vector<mapped_string, mapped_string_allocator_type>;
-    using stringref_map_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<stringref_map>;                           
+    using stringref_list = jsoncons::cbor::detail::stringref_list<allocator_type>;
+    using stringref_list_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<stringref_list>;                           
 
     enum {stringref_tag, // 25
           stringref_namespace_tag, // 256
@@ -142,7 +93,10 @@ class basic_cbor_parser : public ser_context
     std::vector<parse_state,parse_state_allocator_type> state_stack_;
     byte_string_type typed_array_;
     std::vector<std::size_t> shape_;
-    std::vector<stringref_map,stringref_map_allocator_type> stringref_map_stack_;
+    // Namespaces are reused rather than destroyed when they close, so that
+    // their storage is reused by later namespaces
+    std::vector<stringref_list,stringref_list_allocator_type> stringref_lists_;
+    std::size_t stringref_depth_{0};
 
     struct read_byte_string_from_buffer
     {
@@ -152,15 +106,9 @@ class basic_cbor_parser : public ser_context
             : bytes(b)
         {
         }
-        template <typename Container>
-        void operator()(Container& c, std::error_code&)
+        byte_string_view operator()(std::error_code&)
         {
-            c.clear();
-            c.reserve(bytes.size());
-            for (auto b : bytes)
-            {
-                c.push_back(b);
-            }
+            return bytes;
         }
     };
 
@@ -172,10 +120,9 @@ class basic_cbor_parser : public ser_context
             : source(source)
         {
         }
-        template <typename Container>
-        void operator()(Container& cont, std::error_code& ec)
+        byte_string_view operator()(std::error_code& ec)
         {
-            source->read_byte_string(cont,ec);
+            return source->read_byte_string_view(std::integral_constant<bool,jsoncons::detail::is_contiguous_source<Source>::value>(), ec);
         }
     };
 
@@ -191,7 +138,7 @@ public:
          bytes_buffer_(alloc),
          state_stack_(alloc),
          typed_array_(alloc),
-         stringref_map_stack_(alloc)
+         stringref_lists_(alloc)
     {
         state_stack_.emplace_back(parse_mode::root,0);
     }
@@ -218,7 +165,7 @@ public:
         state_stack_.clear();
         state_stack_.emplace_back(parse_mode::root,0);
         typed_array_.clear();
-        stringref_map_stack_.clear();
+        stringref_depth_ = 0;
         nesting_depth_ = 0;
     }
 
@@ -389,6 +336,11 @@ public:
                     break;
                 }
             }
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                more_ = false;
+                return;
+            }
         }
     }
 private:
@@ -409,6 +361,19 @@ private:
         jsoncons::cbor::detail::cbor_major_type major_type = get_major_type(c.value);
         uint8_t info = get_additional_information_value(c.value);
 
+        // A stringref namespace around a single data item other than an array or map,
+        // such as a string that refers to a preset stringref
+        if (other_tags_[stringref_namespace_tag] &&
+            major_type != jsoncons::cbor::detail::cbor_major_type::array &&
+            major_type != jsoncons::cbor::detail::cbor_major_type::map)
+        {
+            other_tags_[stringref_namespace_tag] = false;
+            push_stringref_namespace();
+            read_item(visitor, ec);
+            --stringref_depth_;
+            return;
+        }
+
         switch (major_type)
         {
             case jsoncons::cbor::detail::cbor_major_type::unsigned_integer:
@@ -418,28 +383,29 @@ private:
                 {
                     return;
                 }
-                if (!stringref_map_stack_.empty() && other_tags_[stringref_tag])
+                if (stringref_depth_ > 0 && other_tags_[stringref_tag])
                 {
                     other_tags_[stringref_tag] = false;
-                    if (val >= stringref_map_stack_.back().size())
+                    const stringref_list& strings = stringref_lists_[stringref_depth_-1];
+                    if (val >= strings.size())
                     {
                         ec = cbor_errc::stringref_too_large;
                         more_ = false;
                         return;
                     }
-                    auto index = static_cast<typename stringref_map::size_type>(val);
+                    auto index = static_cast<std::size_t>(val);
                     if (index != val)
                     {
                         ec = cbor_errc::number_too_large;
                         more_ = false;
                         return;
                     }
-                    auto& str = stringref_map_stack_.back().at(index);
-                    switch (str.type)
+                    byte_string_view str = strings.bytes(index);
+                    switch (strings.type(index))
                     {
                         case jsoncons::cbor::detail::cbor_major_type::text_string:
                         {
-                            handle_string(visitor, jsoncons::basic_string_view<char>(str.str.data(),str.str.length()),ec);
+                            handle_string(visitor, jsoncons::basic_string_view<char>(reinterpret_cast<const char*>(str.data()),str.size()),ec);
                             if (JSONCONS_UNLIKELY(ec))
                             {
                                 return;
@@ -448,7 +414,7 @@ private:
                         }
                         case jsoncons::cbor::detail::cbor_major_type::byte_string:
                         {
-                            read_byte_string_from_buffer read(byte_string_view(str.bytes));
+                            read_byte_string_from_buffer read(str);
                             write_byte_string(read, visitor, ec);
                             if (JSONCONS_UNLIKELY(ec))
                             {
@@ -667,7 +633,7 @@ private:
         bool pop_stringref_map_stack = false;
         if (other_tags_[stringref_namespace_tag])
         {
-            stringref_map_stack_.emplace_back();
+            push_stringref_namespace();
             other_tags_[stringref_namespace_tag] = false;
             pop_stringref_map_stack = true;
         }
@@ -708,7 +674,7 @@ private:
         }
         if (state_stack_.back().pop_stringref_map_stack)
         {
-            stringref_map_stack_.pop_back();
+            --stringref_depth_;
         }
         state_stack_.pop_back();
     }
@@ -724,7 +690,7 @@ private:
         bool pop_stringref_map_stack = false;
         if (other_tags_[stringref_namespace_tag])
         {
-            stringref_map_stack_.emplace_back();
+            push_stringref_namespace();
             other_tags_[stringref_namespace_tag] = false;
             pop_stringref_map_stack = true;
         }
@@ -764,7 +730,7 @@ private:
         more_ = !cursor_mode_;
         if (state_stack_.back().pop_stringref_map_stack)
         {
-            stringref_map_stack_.pop_back();
+            --stringref_depth_;
         }
         state_stack_.pop_back();
     }
@@ -793,11 +759,10 @@ private:
         };
         iterate_string_chunks(func, major_type, ec);
 
-        if (!stringref_map_stack_.empty() && 
-            info != jsoncons::cbor::detail::additional_info::indefinite_length &&
-            str.length() >= jsoncons::cbor::detail::min_length_for_stringref(stringref_map_stack_.back().size()))
+        if (info != jsoncons::cbor::detail::additional_info::indefinite_length)
         {
-            stringref_map_stack_.back().emplace_back(mapped_string(str,alloc_));
+            add_stringref(jsoncons::cbor::detail::cbor_major_type::text_string, 
+                reinterpret_cast<const uint8_t*>(str.data()), str.size());
         }
 
     }
@@ -860,17 +825,79 @@ private:
                     ec = cbor_errc::unexpected_eof;
                     return;
                 }
-                if (!stringref_map_stack_.empty() &&
-                    v.size() >= jsoncons::cbor::detail::min_length_for_stringref(stringref_map_stack_.back().size()))
-                {
-                    stringref_map_stack_.back().emplace_back(mapped_string(v, alloc_));
-                }
+                add_stringref(jsoncons::cbor::detail::cbor_major_type::byte_string, v.data(), v.size());
                 break;
             }
 
         }
     }
 
+    void push_stringref_namespace()
+    {
+        if (stringref_depth_ < stringref_lists_.size())
+        {
+            stringref_lists_[stringref_depth_].clear();
+        }
+        else
+        {
+            stringref_lists_.emplace_back();
+        }
+        stringref_list& strings = stringref_lists_[stringref_depth_++];
+        for (const auto& s : options_.preset_stringrefs())
+        {
+            strings.push_back(jsoncons::cbor::detail::cbor_major_type::text_string, 
+                reinterpret_cast<const uint8_t*>(s.data()), s.size());
+        }
+    }
+
+    void add_stringref(jsoncons::cbor::detail::cbor_major_type type, const uint8_t* data, std::size_t length)
+    {
+        if (stringref_depth_ > 0)
+        {
+            stringref_list& strings = stringref_lists_[stringref_depth_-1];
+            if (length >= jsoncons::cbor::detail::min_length_for_stringref(strings.size()))
+            {
+                strings.push_back(type, data, length);
+            }
+        }
+    }
+
+    byte_string_view read_byte_string_view(std::false_type, std::error_code& ec)
+    {
+        read_byte_string(bytes_buffer_, ec);
+        return byte_string_view(bytes_buffer_.data(), bytes_buffer_.size());
+    }
+
+    // Contiguous input, a definite length byte string is returned as a view 
+    // of the input without copying
+    byte_string_view read_byte_string_view(std::true_type, std::error_code& ec)
+    {
+        auto c = source_.peek();
+        if (JSONCONS_UNLIKELY(c.eof))
+        {
+            ec = cbor_errc::unexpected_eof;
+            return byte_string_view();
+        }
+        if (get_additional_information_value(c.value) == jsoncons::cbor::detail::additional_info::indefinite_length)
+        {
+            return read_byte_string_view(std::false_type(), ec);
+        }
+
+        std::size_t length = get_size(ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return byte_string_view();
+        }
+        auto s = source_.read_span(length);
+        if (s.size() != length)
+        {
+            ec = cbor_errc::unexpected_eof;
+            return byte_string_view();
+        }
+        add_stringref(jsoncons::cbor::detail::cbor_major_type::byte_string, s.data(), s.size());
+        return byte_string_view(s.data(), s.size());
+    }
+
     template <typename Function>
     void iterate_string_chunks(Function& func, jsoncons::cbor::detail::cbor_major_type type, std::error_code& ec)
     {
@@ -1159,6 +1186,7 @@ private:
         {
             return;
         }
+        JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
         if (size != 2)
         {
             ec = cbor_errc::invalid_decimal_fraction;
@@ -1318,6 +1346,7 @@ private:
         {
             return;
         }
+        JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
         if (size != 2)
         {
             ec = cbor_errc::invalid_bigfloat;
@@ -1562,379 +1591,122 @@ private:
     template <typename Read>
     void write_byte_string(Read read, item_event_visitor& visitor, std::error_code& ec)
     {
+        byte_string_view b = read(ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            more_ = false;
+            return;
+        }
         if (other_tags_[item_tag])
         {
             switch (raw_tag_)
             {
                 case 0x2:
                 {
-                    bytes_buffer_.clear();
-                    read(bytes_buffer_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    bigint n = bigint::from_bytes_be(1, bytes_buffer_.data(), bytes_buffer_.size());
+                    JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
+                    bigint n = bigint::from_bytes_be(1, b.data(), b.size());
                     text_buffer_.clear();
                     n.write_string(text_buffer_);
                     visitor.string_value(text_buffer_, semantic_tag::bigint, *this, ec);
-                    more_ = !cursor_mode_;
                     break;
                 }
                 case 0x3:
                 {
-                    bytes_buffer_.clear();
-                    read(bytes_buffer_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    bigint n = bigint::from_bytes_be(1, bytes_buffer_.data(), bytes_buffer_.size());
+                    JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
+                    bigint n = bigint::from_bytes_be(1, b.data(), b.size());
                     n = -1 - n;
                     text_buffer_.clear();
                     n.write_string(text_buffer_);
                     visitor.string_value(text_buffer_, semantic_tag::bigint, *this, ec);
-                    more_ = !cursor_mode_;
                     break;
                 }
                 case 0x15:
                 {
-                    read(bytes_buffer_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    visitor.byte_string_value(bytes_buffer_, semantic_tag::base64url, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.byte_string_value(b, semantic_tag::base64url, *this, ec);
                     break;
                 }
                 case 0x16:
                 {
-                    read(bytes_buffer_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    visitor.byte_string_value(bytes_buffer_, semantic_tag::base64, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.byte_string_value(b, semantic_tag::base64, *this, ec);
                     break;
                 }
                 case 0x17:
                 {
-                    read(bytes_buffer_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    visitor.byte_string_value(bytes_buffer_, semantic_tag::base16, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.byte_string_value(b, semantic_tag::base16, *this, ec);
                     break;
                 }
                 case 0x40:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    uint8_t* data = reinterpret_cast<uint8_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size();
-                    visitor.typed_array(jsoncons::span<const uint8_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(jsoncons::span<const uint8_t>(b.data(), b.size()), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x44:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    uint8_t* data = reinterpret_cast<uint8_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size();
-                    visitor.typed_array(jsoncons::span<const uint8_t>(data,size), semantic_tag::clamped, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(jsoncons::span<const uint8_t>(b.data(), b.size()), semantic_tag::clamped, *this, ec);
                     break;
                 }
                 case 0x41:
                 case 0x45:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    uint16_t* data = reinterpret_cast<uint16_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<uint16_t>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(jsoncons::span<const uint16_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(get_typed_array<uint16_t>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x42:
                 case 0x46:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag);
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    uint32_t* data = reinterpret_cast<uint32_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<uint32_t>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(jsoncons::span<const uint32_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(get_typed_array<uint32_t>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x43:
                 case 0x47:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    uint64_t* data = reinterpret_cast<uint64_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<uint64_t>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(jsoncons::span<const uint64_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(get_typed_array<uint64_t>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x48:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    int8_t* data = reinterpret_cast<int8_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size();
-                    visitor.typed_array(jsoncons::span<const int8_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(jsoncons::span<const int8_t>(reinterpret_cast<const int8_t*>(b.data()), b.size()), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x49:
                 case 0x4d:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    int16_t* data = reinterpret_cast<int16_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<int16_t>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(jsoncons::span<const int16_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(get_typed_array<int16_t>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x4a:
                 case 0x4e:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    int32_t* data = reinterpret_cast<int32_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<int32_t>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(jsoncons::span<const int32_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(get_typed_array<int32_t>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x4b:
                 case 0x4f:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    int64_t* data = reinterpret_cast<int64_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<int64_t>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(jsoncons::span<const int64_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(get_typed_array<int64_t>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x50:
                 case 0x54:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    uint16_t* data = reinterpret_cast<uint16_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<uint16_t>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(half_arg, jsoncons::span<const uint16_t>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(half_arg, get_typed_array<uint16_t>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x51:
                 case 0x55:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    float* data = reinterpret_cast<float*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<float>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(jsoncons::span<const float>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(get_typed_array<float>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x52:
                 case 0x56:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    const uint8_t tag = (uint8_t)raw_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    double* data = reinterpret_cast<double*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<double>(data[i]);
-                        }
-                    }
-                    visitor.typed_array(jsoncons::span<const double>(data,size), semantic_tag::none, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.typed_array(get_typed_array<double>(b, (uint8_t)raw_tag_), semantic_tag::none, *this, ec);
                     break;
                 }
                 default:
                 {
-                    read(bytes_buffer_,ec);
-                    if (JSONCONS_UNLIKELY(ec))
-                    {
-                        more_ = false;
-                        return;
-                    }
-                    visitor.byte_string_value(bytes_buffer_, raw_tag_, *this, ec);
-                    more_ = !cursor_mode_;
+                    visitor.byte_string_value(b, raw_tag_, *this, ec);
                     break;
                 }
             }
@@ -1942,14 +1714,42 @@ private:
         }
         else
         {
-            read(bytes_buffer_,ec);
-            if (JSONCONS_UNLIKELY(ec))
+            visitor.byte_string_value(b, semantic_tag::none, *this, ec);
+        }
+        more_ = !cursor_mode_;
+    }
+
+    // Returns the elements of a typed array in native byte order. The elements alias
+    // the byte string when it is suitably aligned and in native byte order, 
+    // otherwise they are copied to typed_array_ and swapped there.
+    template <typename T>
+    jsoncons::span<const T> get_typed_array(const byte_string_view& b, uint8_t tag)
+    {
+        const std::size_t size = b.size()/sizeof(T);
+        const jsoncons::endian e = get_typed_array_endianness(tag);
+
+        if (e == jsoncons::endian::native && reinterpret_cast<std::uintptr_t>(b.data()) % alignof(T) == 0)
+        {
+            return jsoncons::span<const T>(reinterpret_cast<const T*>(b.data()), size);
+        }
+
+        if (b.data() == bytes_buffer_.data())
+        {
+            typed_array_.swap(bytes_buffer_);
+        }
+        else
+        {
+            typed_array_.assign(b.begin(), b.end());
+        }
+        T* data = reinterpret_cast<T*>(typed_array_.data());
+        if (e != jsoncons::endian::native)
+        {
+            for (std::size_t i = 0; i < size; ++i)
             {
-                return;
+                data[i] = binary::byte_swap<T>(data[i]);
             }
-            visitor.byte_string_value(bytes_buffer_, semantic_tag::none, *this, ec);
-            more_ = !cursor_mode_;
         }
+        return jsoncons::span<const T>(data, size);
     }
 
     void produce_begin_multi_dim(item_event_visitor& visitor, 
@@ -7,6 +7,8 @@
 #ifndef JSONCONS_EXT_CSV_CSV_HPP
 #define JSONCONS_EXT_CSV_CSV_HPP
 
+#include <jsoncons_ext/csv/csv_batch_reader.hpp>
+#include <jsoncons_ext/csv/csv_column_reader.hpp>
 #include <jsoncons_ext/csv/csv_cursor.hpp>
 #include <jsoncons_ext/csv/csv_encoder.hpp>
 #include <jsoncons_ext/csv/csv_options.hpp>
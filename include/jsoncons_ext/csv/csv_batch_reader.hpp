@@ -0,0 +1,834 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CSV_CSV_BATCH_READER_HPP
+#define JSONCONS_CSV_CSV_BATCH_READER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory> // std::allocator
+#include <string>
+#include <system_error>
+#include <utility> // std::move
+#include <vector>
+
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/ser_util.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/source_adaptor.hpp>
+#include <jsoncons/utility/read_number.hpp>
+#include <jsoncons/utility/write_number.hpp>
+
+#include <jsoncons_ext/csv/csv_error.hpp>
+#include <jsoncons_ext/csv/csv_options.hpp>
+#include <jsoncons_ext/csv/csv_parser.hpp>
+
+namespace jsoncons {
+namespace csv {
+
+namespace detail {
+
+    template <typename CharT>
+    class csv_batch_builder;
+
+} // namespace detail
+
+    // The values of one column of a record batch, stored contiguously by type. Integers,
+    // floating point numbers and booleans have one slot per row in int64_values(), double_values()
+    // or bool_values(). Strings are stored back to back in string_data(), and the characters
+    // of row i are at [offsets()[i], offsets()[i+1]). Bit i of validity() is clear when row i is null.
+    template <typename CharT>
+    class basic_csv_column_buffer
+    {
+        friend class detail::csv_batch_builder<CharT>;
+    public:
+        using char_type = CharT;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using string_type = std::basic_string<CharT>;
+    private:
+        string_type name_;
+        csv_column_type type_{csv_column_type::string_t};
+        bool declared_{false};
+        bool typed_{false};
+        std::size_t size_{0};
+        std::size_t null_count_{0};
+        std::vector<uint8_t> validity_;
+        std::vector<int64_t> int64_values_;
+        std::vector<double> double_values_;
+        std::vector<uint8_t> bool_values_;
+        std::vector<std::size_t> offsets_;
+        string_type string_data_;
+    public:
+        basic_csv_column_buffer()
+            : offsets_(1, 0)
+        {
+        }
+
+        basic_csv_column_buffer(const basic_csv_column_buffer&) = default;
+        basic_csv_column_buffer(basic_csv_column_buffer&&) = default;
+        basic_csv_column_buffer& operator=(const basic_csv_column_buffer&) = default;
+        basic_csv_column_buffer& operator=(basic_csv_column_buffer&&) = default;
+
+        const string_type& name() const
+        {
+            return name_;
+        }
+
+        // One of string_t, integer_t, float_t or boolean_t. An inferred type carries over
+        // to later batches, where it may widen further
+        csv_column_type type() const
+        {
+            return type_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        std::size_t null_count() const
+        {
+            return null_count_;
+        }
+
+        bool is_null(std::size_t index) const
+        {
+            return (validity_[index >> 3] & (1u << (index & 7))) == 0;
+        }
+
+        const std::vector<uint8_t>& validity() const
+        {
+            return validity_;
+        }
+
+        const std::vector<int64_t>& int64_values() const
+        {
+            return int64_values_;
+        }
+
+        const std::vector<double>& double_values() const
+        {
+            return double_values_;
+        }
+
+        const std::vector<uint8_t>& bool_values() const
+        {
+            return bool_values_;
+        }
+
+        const std::vector<std::size_t>& offsets() const
+        {
+            return offsets_;
+        }
+
+        const string_type& string_data() const
+        {
+            return string_data_;
+        }
+
+        string_view_type string_value(std::size_t index) const
+        {
+            return string_view_type(string_data_.data() + offsets_[index], offsets_[index+1] - offsets_[index]);
+        }
+
+    private:
+        void clear()
+        {
+            size_ = 0;
+            null_count_ = 0;
+            validity_.clear();
+            int64_values_.clear();
+            double_values_.clear();
+            bool_values_.clear();
+            offsets_.resize(1);
+            string_data_.clear();
+        }
+
+        void set_valid(bool valid)
+        {
+            if ((size_ & 7) == 0)
+            {
+                validity_.push_back(0);
+            }
+            if (valid)
+            {
+                validity_.back() |= static_cast<uint8_t>(1u << (size_ & 7));
+            }
+            else
+            {
+                ++null_count_;
+            }
+            ++size_;
+        }
+
+        void append_null()
+        {
+            switch (type_)
+            {
+                case csv_column_type::integer_t:
+                    int64_values_.push_back(0);
+                    break;
+                case csv_column_type::float_t:
+                    double_values_.push_back(0.0);
+                    break;
+                case csv_column_type::boolean_t:
+                    bool_values_.push_back(0);
+                    break;
+                default:
+                    offsets_.push_back(string_data_.size());
+                    break;
+            }
+            set_valid(false);
+        }
+
+        void append_int64(int64_t value)
+        {
+            int64_values_.push_back(value);
+            set_valid(true);
+        }
+
+        void append_double(double value)
+        {
+            double_values_.push_back(value);
+            set_valid(true);
+        }
+
+        void append_bool(bool value)
+        {
+            bool_values_.push_back(value ? 1 : 0);
+            set_valid(true);
+        }
+
+        void append_string(const string_view_type& value)
+        {
+            string_data_.append(value.data(), value.size());
+            offsets_.push_back(string_data_.size());
+            set_valid(true);
+        }
+
+        void append_text(int64_t value)
+        {
+            jsoncons::utility::from_integer(value, string_data_);
+            offsets_.push_back(string_data_.size());
+            set_valid(true);
+        }
+
+        void append_text(double value)
+        {
+            if (std::isnan(value))
+            {
+                auto s = JSONCONS_STRING_VIEW_CONSTANT(CharT, "NaN");
+                string_data_.append(s.data(), s.size());
+            }
+            else if (std::isinf(value))
+            {
+                auto s = value > 0 ? JSONCONS_STRING_VIEW_CONSTANT(CharT, "Infinity") : JSONCONS_STRING_VIEW_CONSTANT(CharT, "-Infinity");
+                string_data_.append(s.data(), s.size());
+            }
+            else
+            {
+                jsoncons::utility::write_double f{float_chars_format::general,0};
+                f(value, string_data_);
+            }
+            offsets_.push_back(string_data_.size());
+            set_valid(true);
+        }
+
+        void append_text(bool value)
+        {
+            auto s = value ? JSONCONS_STRING_VIEW_CONSTANT(CharT, "true") : JSONCONS_STRING_VIEW_CONSTANT(CharT, "false");
+            append_string(s);
+        }
+
+        // A column without a type holds only nulls, which are stored as empty strings.
+        // When it gets its first value, the nulls are given slots in the values of that type.
+        void assign_type(csv_column_type type)
+        {
+            type_ = type;
+            typed_ = true;
+            switch (type)
+            {
+                case csv_column_type::integer_t:
+                    int64_values_.assign(size_, 0);
+                    offsets_.resize(1);
+                    break;
+                case csv_column_type::float_t:
+                    double_values_.assign(size_, 0.0);
+                    offsets_.resize(1);
+                    break;
+                case csv_column_type::boolean_t:
+                    bool_values_.assign(size_, 0);
+                    offsets_.resize(1);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Integers become floating point numbers when a column has both
+        void widen_to_float()
+        {
+            double_values_.reserve(int64_values_.size());
+            for (auto value : int64_values_)
+            {
+                double_values_.push_back(static_cast<double>(value));
+            }
+            int64_values_.clear();
+            type_ = csv_column_type::float_t;
+        }
+
+        // Other values are written as text when a column also has strings
+        void widen_to_string()
+        {
+            basic_csv_column_buffer<CharT> text;
+            text.type_ = csv_column_type::string_t;
+            for (std::size_t i = 0; i < size_; ++i)
+            {
+                if (is_null(i))
+                {
+                    text.append_null();
+                }
+                else
+                {
+                    switch (type_)
+                    {
+                        case csv_column_type::integer_t:
+                            text.append_text(int64_values_[i]);
+                            break;
+                        case csv_column_type::float_t:
+                            text.append_text(double_values_[i]);
+                            break;
+                        case csv_column_type::boolean_t:
+                            text.append_text(bool_values_[i] != 0);
+                            break;
+                        default:
+                            text.append_string(string_value(i));
+                            break;
+                    }
+                }
+            }
+            validity_ = std::move(text.validity_);
+            offsets_ = std::move(text.offsets_);
+            string_data_ = std::move(text.string_data_);
+            int64_values_.clear();
+            double_values_.clear();
+            bool_values_.clear();
+            type_ = csv_column_type::string_t;
+        }
+    };
+
+    // A group of consecutive records, stored as one column buffer per column
+    template <typename CharT>
+    class basic_csv_record_batch
+    {
+        friend class detail::csv_batch_builder<CharT>;
+
+        std::vector<basic_csv_column_buffer<CharT>> columns_;
+        std::size_t first_row_{0};
+        std::size_t row_count_{0};
+    public:
+        using char_type = CharT;
+        using column_type = basic_csv_column_buffer<CharT>;
+
+        // The number of data rows that precede this batch
+        std::size_t first_row() const
+        {
+            return first_row_;
+        }
+
+        std::size_t row_count() const
+        {
+            return row_count_;
+        }
+
+        std::size_t column_count() const
+        {
+            return columns_.size();
+        }
+
+        const column_type& column(std::size_t index) const
+        {
+            return columns_[index];
+        }
+    };
+
+namespace detail {
+
+    // Receives csv_mapping_kind::n_rows events and appends the values of each record to the
+    // column buffers of a batch, which is delivered every batch_size records
+    template <typename CharT>
+    class csv_batch_builder : public basic_json_visitor<CharT>
+    {
+    public:
+        using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+        using batch_type = basic_csv_record_batch<CharT>;
+        using column_type = basic_csv_column_buffer<CharT>;
+        using batch_handler = std::function<void(const batch_type&)>;
+    private:
+        std::vector<csv_type_info> column_types_;
+        std::vector<std::basic_string<CharT>> column_names_;
+        bool header_pending_;
+        std::size_t batch_size_;
+        const batch_handler* handler_{nullptr};
+        batch_type batch_;
+        std::size_t column_index_{0};
+        int level_{0};
+    public:
+        csv_batch_builder(const basic_csv_decode_options<CharT>& options, std::size_t batch_size)
+            : header_pending_(options.assume_header()),
+              batch_size_(batch_size == 0 ? 1 : batch_size)
+        {
+            jsoncons::csv::detail::parse_column_types(options.column_types(), column_types_);
+            jsoncons::csv::detail::parse_column_names(options.column_names(), column_names_);
+        }
+
+        void handler(const batch_handler& handler)
+        {
+            handler_ = &handler;
+        }
+
+        // Delivers the remaining records
+        void flush_batch()
+        {
+            if (batch_.row_count_ > 0)
+            {
+                (*handler_)(batch_);
+                batch_.first_row_ += batch_.row_count_;
+                batch_.row_count_ = 0;
+                for (auto& column : batch_.columns_)
+                {
+                    column.clear();
+                }
+            }
+        }
+
+    private:
+        void declare(column_type& column, std::size_t index)
+        {
+            if (index < column_names_.size())
+            {
+                column.name_ = column_names_[index];
+            }
+            if (column_types_.empty())
+            {
+                return;
+            }
+            // A trailing repeat_t entry repeats the preceding rep_count types
+            const std::size_t n = column_types_.size();
+            if (column_types_.back().col_type == csv_column_type::repeat_t)
+            {
+                const std::size_t repeat_index = n - 1;
+                const std::size_t rep_count = column_types_.back().rep_count;
+                if (index >= repeat_index && rep_count > 0 && rep_count <= repeat_index)
+                {
+                    index = repeat_index - rep_count + (index - repeat_index) % rep_count;
+                }
+            }
+            if (index < n && column_types_[index].col_type != csv_column_type::repeat_t)
+            {
+                column.type_ = column_types_[index].col_type;
+                column.declared_ = true;
+                column.typed_ = true;
+            }
+        }
+
+        column_type& current_column()
+        {
+            auto& columns = batch_.columns_;
+            while (column_index_ >= columns.size())
+            {
+                columns.emplace_back();
+                auto& column = columns.back();
+                declare(column, columns.size() - 1);
+                for (std::size_t i = 0; i < batch_.row_count_; ++i)
+                {
+                    column.append_null();
+                }
+            }
+            return columns[column_index_++];
+        }
+
+        void begin_record()
+        {
+            column_index_ = 0;
+        }
+
+        void end_record()
+        {
+            if (header_pending_)
+            {
+                header_pending_ = false;
+                return;
+            }
+            for (std::size_t i = column_index_; i < batch_.columns_.size(); ++i)
+            {
+                batch_.columns_[i].append_null();
+            }
+            if (++batch_.row_count_ == batch_size_)
+            {
+                flush_batch();
+            }
+        }
+
+        void append_int64(int64_t value, std::error_code& ec)
+        {
+            column_type& column = current_column();
+            if (!column.typed_)
+            {
+                column.assign_type(csv_column_type::integer_t);
+            }
+            switch (column.type_)
+            {
+                case csv_column_type::integer_t:
+                    column.append_int64(value);
+                    break;
+                case csv_column_type::float_t:
+                    column.append_double(static_cast<double>(value));
+                    break;
+                case csv_column_type::string_t:
+                    column.append_text(value);
+                    break;
+                default:
+                    if (column.declared_)
+                    {
+                        ec = csv_errc::column_type_mismatch;
+                        return;
+                    }
+                    column.widen_to_string();
+                    column.append_text(value);
+                    break;
+            }
+        }
+
+        void append_double(double value, std::error_code& ec)
+        {
+            column_type& column = current_column();
+            if (!column.typed_)
+            {
+                column.assign_type(csv_column_type::float_t);
+            }
+            switch (column.type_)
+            {
+                case csv_column_type::float_t:
+                    column.append_double(value);
+                    break;
+                case csv_column_type::string_t:
+                    column.append_text(value);
+                    break;
+                case csv_column_type::integer_t:
+                    if (!column.declared_)
+                    {
+                        column.widen_to_float();
+                        column.append_double(value);
+                        break;
+                    }
+                    ec = csv_errc::column_type_mismatch;
+                    return;
+                default:
+                    if (column.declared_)
+                    {
+                        ec = csv_errc::column_type_mismatch;
+                        return;
+                    }
+                    column.widen_to_string();
+                    column.append_text(value);
+                    break;
+            }
+        }
+
+        void append_bool(bool value, std::error_code& ec)
+        {
+            column_type& column = current_column();
+            if (!column.typed_)
+            {
+                column.assign_type(csv_column_type::boolean_t);
+            }
+            switch (column.type_)
+            {
+                case csv_column_type::boolean_t:
+                    column.append_bool(value);
+                    break;
+                case csv_column_type::string_t:
+                    column.append_text(value);
+                    break;
+                default:
+                    if (column.declared_)
+                    {
+                        ec = csv_errc::column_type_mismatch;
+                        return;
+                    }
+                    column.widen_to_string();
+                    column.append_text(value);
+                    break;
+            }
+        }
+
+        void append_string(const string_view_type& value, semantic_tag tag, std::error_code& ec)
+        {
+            if (value.empty())
+            {
+                current_column().append_null();
+                return;
+            }
+            // Numbers kept as text with lossless_number
+            if (tag == semantic_tag::bigint || tag == semantic_tag::bigdec)
+            {
+                int64_t n{0};
+                if (tag == semantic_tag::bigint && jsoncons::utility::dec_to_integer(value.data(), value.size(), n))
+                {
+                    append_int64(n, ec);
+                    return;
+                }
+                double x{0};
+                if (jsoncons::utility::decstr_to_double(value.data(), value.size(), x))
+                {
+                    append_double(x, ec);
+                    return;
+                }
+            }
+            column_type& column = current_column();
+            if (!column.typed_)
+            {
+                column.assign_type(csv_column_type::string_t);
+            }
+            if (column.type_ != csv_column_type::string_t)
+            {
+                if (column.declared_)
+                {
+                    ec = csv_errc::column_type_mismatch;
+                    return;
+                }
+                column.widen_to_string();
+            }
+            column.append_string(value);
+        }
+
+        void visit_flush() override
+        {
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            ec = csv_errc::nested_column_value;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context&, std::error_code&) override
+        {
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type&, const ser_context&, std::error_code&) override
+        {
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (level_ == 1)
+            {
+                begin_record();
+            }
+            else if (level_ > 1)
+            {
+                ec = csv_errc::nested_column_value;
+                JSONCONS_VISITOR_RETURN;
+            }
+            ++level_;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context&, std::error_code&) override
+        {
+            --level_;
+            if (level_ == 1)
+            {
+                end_record();
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            if (!header_pending_)
+            {
+                current_column().append_null();
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!header_pending_)
+            {
+                append_bool(value, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!header_pending_)
+            {
+                append_int64(value, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!header_pending_)
+            {
+                if (value <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+                {
+                    append_int64(static_cast<int64_t>(value), ec);
+                }
+                else
+                {
+                    append_double(static_cast<double>(value), ec);
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!header_pending_)
+            {
+                append_double(value, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag tag, const ser_context&, std::error_code& ec) override
+        {
+            if (header_pending_)
+            {
+                column_names_.emplace_back(value.data(), value.size());
+                auto& columns = batch_.columns_;
+                if (column_names_.size() <= columns.size())
+                {
+                    columns[column_names_.size()-1].name_ = column_names_.back();
+                }
+            }
+            else
+            {
+                append_string(value, tag, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view&, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            ec = csv_errc::column_type_mismatch;
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+} // namespace detail
+
+    // Reads CSV text into batches of typed column buffers, without building a basic_json value
+    // for each cell. Columns take the type given by the column_types option, if any, otherwise the
+    // type of their values. Batches of up to batch_size records are passed to a handler as they fill.
+    template <typename CharT,typename Source=jsoncons::stream_source<CharT>,typename TempAlloc=std::allocator<char>>
+    class basic_csv_batch_reader
+    {
+    public:
+        using char_type = CharT;
+        using batch_type = basic_csv_record_batch<CharT>;
+        using batch_handler = std::function<void(const batch_type&)>;
+        using temp_allocator_type = TempAlloc;
+
+        static constexpr std::size_t default_batch_size = 65536;
+    private:
+        basic_csv_batch_reader(const basic_csv_batch_reader&) = delete;
+        basic_csv_batch_reader& operator = (const basic_csv_batch_reader&) = delete;
+
+        text_source_adaptor<Source> source_;
+        detail::csv_batch_builder<CharT> builder_;
+        basic_csv_parser<CharT,TempAlloc> parser_;
+    public:
+        template <typename Sourceable>
+        basic_csv_batch_reader(Sourceable&& source,
+                               const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>(),
+                               std::size_t batch_size = default_batch_size,
+                               const TempAlloc& alloc = TempAlloc())
+           : source_(std::forward<Sourceable>(source)),
+             builder_(options, batch_size),
+             parser_(options, alloc)
+        {
+            parser_.mapping_kind(csv_mapping_kind::n_rows);
+        }
+
+        void read(const batch_handler& handler)
+        {
+            std::error_code ec;
+            read(handler, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+            }
+        }
+
+        void read(const batch_handler& handler, std::error_code& ec)
+        {
+            if (source_.is_error())
+            {
+                ec = csv_errc::source_error;
+                return;
+            }
+            builder_.handler(handler);
+            while (!parser_.stopped())
+            {
+                if (parser_.source_exhausted())
+                {
+                    auto s = source_.read_buffer(ec);
+                    if (JSONCONS_UNLIKELY(ec)) return;
+                    if (s.size() > 0)
+                    {
+                        parser_.update(s.data(),s.size());
+                    }
+                }
+                parser_.parse_some(builder_, ec);
+                if (JSONCONS_UNLIKELY(ec)) return;
+            }
+            builder_.flush_batch();
+        }
+
+        std::size_t line() const
+        {
+            return parser_.line();
+        }
+
+        std::size_t column() const
+        {
+            return parser_.column();
+        }
+    };
+
+    template <typename CharT,typename Source,typename TempAlloc>
+    constexpr std::size_t basic_csv_batch_reader<CharT,Source,TempAlloc>::default_batch_size;
+
+    using csv_column_buffer = basic_csv_column_buffer<char>;
+    using wcsv_column_buffer = basic_csv_column_buffer<wchar_t>;
+    using csv_record_batch = basic_csv_record_batch<char>;
+    using wcsv_record_batch = basic_csv_record_batch<wchar_t>;
+    using csv_batch_reader = basic_csv_batch_reader<char,stream_source<char>>;
+    using wcsv_batch_reader = basic_csv_batch_reader<wchar_t,stream_source<wchar_t>>;
+    using csv_string_batch_reader = basic_csv_batch_reader<char,string_source<char>>;
+    using wcsv_string_batch_reader = basic_csv_batch_reader<wchar_t,string_source<wchar_t>>;
+
+} // namespace csv
+} // namespace jsoncons
+
+#endif // JSONCONS_CSV_CSV_BATCH_READER_HPP
@@ -0,0 +1,395 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CSV_CSV_COLUMN_READER_HPP
+#define JSONCONS_CSV_CSV_COLUMN_READER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory> // std::allocator
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/conv_error.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/ser_util.hpp>
+#include <jsoncons/utility/read_number.hpp>
+
+#include <jsoncons_ext/csv/csv_error.hpp>
+#include <jsoncons_ext/csv/csv_options.hpp>
+#include <jsoncons_ext/csv/csv_parser.hpp>
+
+namespace jsoncons {
+namespace csv {
+
+namespace detail {
+
+    // Converts CSV values to an integer or floating point type T and appends them to a vector
+    template <typename CharT,typename T>
+    struct numeric_appender
+    {
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+
+        static void append_null(std::vector<T>& values, std::error_code& ec)
+        {
+            append_null(values, std::is_floating_point<T>(), ec);
+        }
+
+        static void append_bool(std::vector<T>& values, bool value)
+        {
+            values.push_back(value ? T(1) : T(0));
+        }
+
+        static void append_int64(std::vector<T>& values, int64_t value, std::error_code& ec)
+        {
+            append_int64(values, value, std::is_floating_point<T>(), ec);
+        }
+
+        static void append_uint64(std::vector<T>& values, uint64_t value, std::error_code& ec)
+        {
+            append_uint64(values, value, std::is_floating_point<T>(), ec);
+        }
+
+        static void append_double(std::vector<T>& values, double value, std::error_code& ec)
+        {
+            append_double(values, value, std::is_floating_point<T>(), ec);
+        }
+
+        static void append_string(std::vector<T>& values, const string_view_type& value, std::error_code& ec)
+        {
+            if (value.empty())
+            {
+                append_null(values, std::is_floating_point<T>(), ec);
+            }
+            else
+            {
+                append_string(values, value, std::is_floating_point<T>(), ec);
+            }
+        }
+
+        static std::error_code not_a_number()
+        {
+            return std::is_floating_point<T>::value ? conv_errc::not_double : conv_errc::not_integer;
+        }
+
+    private:
+        static void append_null(std::vector<T>& values, std::true_type, std::error_code&)
+        {
+            values.push_back(std::numeric_limits<T>::quiet_NaN());
+        }
+
+        static void append_null(std::vector<T>&, std::false_type, std::error_code& ec)
+        {
+            ec = conv_errc::not_integer;
+        }
+
+        static void append_int64(std::vector<T>& values, int64_t value, std::true_type, std::error_code&)
+        {
+            values.push_back(static_cast<T>(value));
+        }
+
+        static void append_int64(std::vector<T>& values, int64_t value, std::false_type, std::error_code& ec)
+        {
+            if (value < 0 ? (std::is_unsigned<T>::value || value < static_cast<int64_t>((std::numeric_limits<T>::lowest)()))
+                          : static_cast<uint64_t>(value) > static_cast<uint64_t>((std::numeric_limits<T>::max)()))
+            {
+                ec = conv_errc::not_integer;
+                return;
+            }
+            values.push_back(static_cast<T>(value));
+        }
+
+        static void append_uint64(std::vector<T>& values, uint64_t value, std::true_type, std::error_code&)
+        {
+            values.push_back(static_cast<T>(value));
+        }
+
+        static void append_uint64(std::vector<T>& values, uint64_t value, std::false_type, std::error_code& ec)
+        {
+            if (value > static_cast<uint64_t>((std::numeric_limits<T>::max)()))
+            {
+                ec = conv_errc::not_integer;
+                return;
+            }
+            values.push_back(static_cast<T>(value));
+        }
+
+        static void append_double(std::vector<T>& values, double value, std::true_type, std::error_code&)
+        {
+            values.push_back(static_cast<T>(value));
+        }
+
+        static void append_double(std::vector<T>&, double, std::false_type, std::error_code& ec)
+        {
+            ec = conv_errc::not_integer;
+        }
+
+        static void append_string(std::vector<T>& values, const string_view_type& value, std::true_type, std::error_code& ec)
+        {
+            double d{0};
+            auto result = jsoncons::utility::decstr_to_double(value.data(), value.length(), d);
+            if (result.ec == std::errc::result_out_of_range)
+            {
+                d = (!value.empty() && value[0] == '-') ? -HUGE_VAL : HUGE_VAL;
+            }
+            else if (result.ec != std::errc{})
+            {
+                ec = conv_errc::not_double;
+                return;
+            }
+            values.push_back(static_cast<T>(d));
+        }
+
+        static void append_string(std::vector<T>& values, const string_view_type& value, std::false_type, std::error_code& ec)
+        {
+            T n{0};
+            auto result = jsoncons::utility::dec_to_integer(value.data(), value.length(), n);
+            if (!result)
+            {
+                ec = conv_errc::not_integer;
+                return;
+            }
+            values.push_back(n);
+        }
+    };
+
+    // Receives the events of a single m_columns column, {"name":[v1,v2,...]},
+    // and stores the values in a vector of integer or floating point type T
+    template <typename CharT,typename T>
+    class numeric_column_visitor : public basic_json_visitor<CharT>
+    {
+    public:
+        using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+    private:
+        using appender = numeric_appender<CharT,T>;
+
+        std::vector<T>& values_;
+        int level_{0};
+    public:
+        numeric_column_visitor(std::vector<T>& values)
+            : values_(values)
+        {
+        }
+
+    private:
+        void visit_flush() override
+        {
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            ++level_;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context&, std::error_code&) override
+        {
+            --level_;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type&, const ser_context&, std::error_code&) override
+        {
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (level_ > 1)
+            {
+                ec = conv_errc::not_vector;
+            }
+            ++level_;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context&, std::error_code&) override
+        {
+            --level_;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            appender::append_null(values_, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            appender::append_bool(values_, value);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            appender::append_int64(values_, value, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            appender::append_uint64(values_, value, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            appender::append_double(values_, value, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            appender::append_string(values_, value, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view&, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            ec = appender::not_a_number();
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+} // namespace detail
+
+    // Produces the same events as basic_csv_reader with csv_mapping_kind::m_columns,
+    // but instead of caching every value of every column until the end of the input,
+    // it makes one pass over a contiguous input (a string or a memory mapped file) for
+    // each group of columns_per_pass columns. With the default of one column per pass,
+    // values are forwarded to the visitor as they are parsed.
+    template <typename CharT,typename TempAlloc=std::allocator<char>>
+    class basic_csv_column_reader
+    {
+    public:
+        using char_type = CharT;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using temp_allocator_type = TempAlloc;
+    private:
+        basic_csv_column_reader(const basic_csv_column_reader&) = delete;
+        basic_csv_column_reader& operator = (const basic_csv_column_reader&) = delete;
+
+        string_view_type input_;
+        std::size_t columns_per_pass_;
+        bool m_columns_;
+        basic_csv_parser<CharT,TempAlloc> parser_;
+    public:
+        basic_csv_column_reader(string_view_type input,
+                                const basic_csv_decode_options<CharT>& options,
+                                std::size_t columns_per_pass = 1,
+                                const TempAlloc& alloc = TempAlloc())
+           : input_(input),
+             columns_per_pass_(columns_per_pass > 0 ? columns_per_pass : 1),
+             m_columns_(options.mapping_kind() == csv_mapping_kind::m_columns),
+             parser_(options, alloc)
+        {
+        }
+
+        ~basic_csv_column_reader() noexcept = default;
+
+        void read(basic_json_visitor<CharT>& visitor)
+        {
+            std::error_code ec;
+            read(visitor, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+            }
+        }
+
+        void read(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+        {
+            std::size_t first = 0;
+            do
+            {
+                read_columns(first, columns_per_pass_, visitor, ec);
+                if (JSONCONS_UNLIKELY(ec)) return;
+                first += columns_per_pass_;
+            }
+            while (first < parser_.column_labels().size());
+        }
+
+        // Reads the column at index into values, replacing their contents. Numbers,
+        // booleans and numeric text are converted to T. An empty value or null
+        // becomes NaN if T is a floating point type, and is an error otherwise.
+        template <typename T>
+        typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T,bool>::value>::type
+        read_column(std::size_t index, std::vector<T>& values)
+        {
+            std::error_code ec;
+            read_column(index, values, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+            }
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T,bool>::value>::type
+        read_column(std::size_t index, std::vector<T>& values, std::error_code& ec)
+        {
+            values.clear();
+            jsoncons::csv::detail::numeric_column_visitor<CharT,T> visitor(values);
+            read_columns(index, 1, visitor, ec);
+        }
+
+        // The column names of the input, available after a read
+        std::size_t column_count() const
+        {
+            return parser_.column_labels().size();
+        }
+
+        std::basic_string<CharT> column_name(std::size_t index) const
+        {
+            const auto& name = parser_.column_labels()[index];
+            return std::basic_string<CharT>(name.data(), name.size());
+        }
+
+        std::size_t line() const
+        {
+            return parser_.line();
+        }
+
+        std::size_t column() const
+        {
+            return parser_.column();
+        }
+
+    private:
+
+        void read_columns(std::size_t first, std::size_t count,
+                          basic_json_visitor<CharT>& visitor, std::error_code& ec)
+        {
+            if (!m_columns_)
+            {
+                ec = csv_errc::m_columns_required;
+                return;
+            }
+            parser_.reinitialize();
+            parser_.select_columns(first, count);
+            parser_.update(input_.data(), input_.size());
+            while (!parser_.stopped())
+            {
+                parser_.parse_some(visitor, ec);
+                if (JSONCONS_UNLIKELY(ec)) return;
+            }
+        }
+    };
+
+    using csv_column_reader = basic_csv_column_reader<char>;
+    using wcsv_column_reader = basic_csv_column_reader<wchar_t>;
+
+} // namespace csv
+} // namespace jsoncons
+
+#endif
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include <jsoncons/utility/write_number.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_encoder.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
@@ -43,6 +44,11 @@ public:
     using column_type = std::vector<string_type, string_allocator_type>;
     using column_path_column_map_type = std::unordered_map<string_type, column_type, std::hash<string_type>,std::equal_to<string_type>,string_vector_allocator_type>;
 private:
+    using string_index_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const string_type,std::size_t>>;
+    using key_slot_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<string_type,std::size_t>>;
+
+    static constexpr std::size_t no_slot = (std::numeric_limits<std::size_t>::max)();
+
     static jsoncons::basic_string_view<CharT> null_constant()
     {
         static jsoncons::basic_string_view<CharT> k = JSONCONS_STRING_VIEW_CONSTANT(CharT,"null");
@@ -81,6 +87,7 @@ private:
         stack_item_kind item_kind_;
         std::size_t count_{0};
         string_type column_path_;
+        std::size_t slot_{no_slot};
 
         stack_item(stack_item_kind item_kind) noexcept
            : item_kind_(item_kind)
@@ -135,6 +142,14 @@ private:
     std::unordered_map<string_type,string_type, std::hash<string_type>,std::equal_to<string_type>,string_string_allocator_type> column_path_value_map_;
     column_path_column_map_type column_path_column_map_;
 
+    // Flat objects write their values into a row buffer slot for each column. Rows usually
+    // repeat the keys of the previous row, so the keys and slots of the previous row are kept
+    // and a key that matches takes its slot without building its column path.
+    std::unordered_map<string_type,std::size_t, std::hash<string_type>,std::equal_to<string_type>,string_index_allocator_type> column_path_index_map_;
+    std::size_t indexed_column_count_{0};
+    std::vector<string_type,string_allocator_type> row_values_;
+    std::vector<std::pair<string_type,std::size_t>,key_slot_allocator_type> key_slots_;
+
     std::size_t column_index_{0};
     string_type value_buffer_;
     typename column_path_column_map_type::iterator column_it_;
@@ -182,6 +197,9 @@ public:
         column_path_name_map_(alloc),
         column_path_value_map_(alloc),
         column_path_column_map_(alloc),
+        column_path_index_map_(alloc),
+        row_values_(alloc),
+        key_slots_(alloc),
         value_buffer_(alloc),
         column_it_(column_path_column_map_.end())
     {
@@ -219,6 +237,10 @@ public:
             column_paths_.clear();
             column_path_value_map_.clear();
         }
+        column_path_index_map_.clear();
+        indexed_column_count_ = 0;
+        row_values_.clear();
+        key_slots_.clear();
         column_index_ = 0;
     }
 
@@ -242,6 +264,7 @@ private:
             CharT c = *it;
             if (c == quote_char)
             {
+                JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                 sink.push_back(quote_escape_char); 
                 sink.push_back(quote_char);
             }
@@ -343,29 +366,28 @@ private:
         switch (stack_.back().item_kind_)
         {
             case stack_item_kind::flat_object:
+                if (stack_[0].count_ == 0)
+                {
+                    write_object_header();
+                }
+                index_columns();
+                for (std::size_t i = 0; i < column_paths_.size(); ++i)
+                {
+                    if (i > 0)
+                    {
+                        sink_.push_back(field_delimiter_);
+                    }
+                    sink_.append(row_values_[i].data(), row_values_[i].length());
+                    row_values_[i].clear();
+                }
+                sink_.append(line_delimiter_.data(), line_delimiter_.length());
+                break;
             case stack_item_kind::object:
                 if (parent(stack_).item_kind_ == stack_item_kind::row_mapping || parent(stack_).item_kind_ == stack_item_kind::flat_row_mapping)
                 {
                     if (stack_[0].count_ == 0)
                     {
-                        bool first = true;
-                        for (std::size_t i = 0; i < column_paths_.size(); ++i)
-                        {
-                            auto it = column_path_name_map_.find(column_paths_[i]);
-                            if (it != column_path_name_map_.end())
-                            {
-                                if (!first)
-                                {
-                                    sink_.push_back(field_delimiter_);
-                                }
-                                else
-                                {
-                                    first = false;
-                                }
-                                sink_.append(it->second.data(), it->second.length());
-                            }
-                        }
-                        sink_.append(line_delimiter_.data(), line_delimiter_.length());
+                        write_object_header();
                     }
                     for (std::size_t i = 0; i < column_paths_.size(); ++i)
                     {
@@ -577,16 +599,7 @@ private:
                 }
                 else
                 {
-                    if (stack_[0].count_ == 0)
-                    {
-                        if (!has_column_mapping_)
-                        {
-                            string_type str = stack_.back().column_path_;
-                            column_paths_.emplace_back(str);
-                            column_path_value_map_.emplace(std::move(str), string_type{alloc_});
-                        }
-                    }
-                    
+                    flat_object_slot();
                     value_buffer_.clear();
                     stack_.emplace_back(stack_item_kind::multivalued_field);
                 }
@@ -673,6 +686,14 @@ private:
                 break;
             case stack_item_kind::multivalued_field:
             {
+                if (parent(stack_).item_kind_ == stack_item_kind::flat_object)
+                {
+                    if (parent(stack_).slot_ != no_slot)
+                    {
+                        row_values_[parent(stack_).slot_] = value_buffer_;
+                    }
+                    break;
+                }
                 auto it = column_path_value_map_.find(parent(stack_).column_path_);
                 if (it != column_path_value_map_.end())
                 {
@@ -757,13 +778,32 @@ private:
         {
             case stack_item_kind::flat_object:
             {
-                stack_.back().column_path_ = parent(stack_).column_path_;
-                stack_.back().column_path_.push_back('/');
-                stack_.back().column_path_.append(jsonpointer::escape<char_type,char_allocator_type>(name, alloc_));
+                auto& item = stack_.back();
+                const std::size_t ordinal = item.count_;
+                // Columns are only added in the first row
+                if (ordinal < key_slots_.size() && 
+                    (key_slots_[ordinal].second != no_slot || stack_[0].count_ > 0) &&
+                    string_view_type(key_slots_[ordinal].first.data(), key_slots_[ordinal].first.size()) == name)
+                {
+                    item.slot_ = key_slots_[ordinal].second;
+                    break;
+                }
+                item.column_path_ = parent(stack_).column_path_;
+                item.column_path_.push_back('/');
+                item.column_path_.append(jsonpointer::escape<char_type,char_allocator_type>(name, alloc_));
                 if (!has_column_mapping_)
                 {
-                    column_path_name_map_.emplace(stack_.back().column_path_, name);
+                    column_path_name_map_.emplace(item.column_path_, name);
+                }
+                index_columns();
+                auto it = column_path_index_map_.find(item.column_path_);
+                item.slot_ = it != column_path_index_map_.end() ? it->second : no_slot;
+                if (ordinal >= key_slots_.size())
+                {
+                    key_slots_.resize(ordinal + 1, std::make_pair(string_type{alloc_}, no_slot));
                 }
+                key_slots_[ordinal].first.assign(name.data(), name.size());
+                key_slots_[ordinal].second = item.slot_;
                 break;
             }
             case stack_item_kind::object:
@@ -798,6 +838,56 @@ private:
         JSONCONS_VISITOR_RETURN;
     }
     
+    void write_object_header()
+    {
+        bool first = true;
+        for (std::size_t i = 0; i < column_paths_.size(); ++i)
+        {
+            auto it = column_path_name_map_.find(column_paths_[i]);
+            if (it != column_path_name_map_.end())
+            {
+                if (!first)
+                {
+                    sink_.push_back(field_delimiter_);
+                }
+                else
+                {
+                    first = false;
+                }
+                sink_.append(it->second.data(), it->second.length());
+            }
+        }
+        sink_.append(line_delimiter_.data(), line_delimiter_.length());
+    }
+
+    // Gives column paths added since the last call a row buffer slot
+    void index_columns()
+    {
+        for (; indexed_column_count_ < column_paths_.size(); ++indexed_column_count_)
+        {
+            column_path_index_map_.emplace(column_paths_[indexed_column_count_], indexed_column_count_);
+        }
+        if (row_values_.size() < column_paths_.size())
+        {
+            row_values_.resize(column_paths_.size(), string_type{alloc_});
+        }
+    }
+
+    // Returns the row buffer slot for the current value of a flat object, 
+    // adding a column for its key in the first row
+    std::size_t flat_object_slot()
+    {
+        auto& item = stack_.back();
+        if (item.slot_ == no_slot && stack_[0].count_ == 0 && !has_column_mapping_)
+        {
+            column_paths_.emplace_back(item.column_path_);
+            index_columns();
+            item.slot_ = column_path_index_map_.find(item.column_path_)->second;
+            key_slots_[item.count_].second = item.slot_;
+        }
+        return item.slot_;
+    }
+
     void append_array_path_component()
     {
         stack_.back().column_path_ = parent(stack_).column_path_;
@@ -824,6 +914,14 @@ private:
         switch (stack_.back().item_kind_)
         {
             case stack_item_kind::flat_object:
+            {
+                std::size_t slot = flat_object_slot();
+                if (slot != no_slot)
+                {
+                    write_null_value(row_values_[slot]);
+                }
+                break;
+            }
             case stack_item_kind::object:
             {
                 if (stack_[0].count_ == 0)
@@ -894,6 +992,14 @@ private:
         switch (stack_.back().item_kind_)
         {
             case stack_item_kind::flat_object:
+            {
+                std::size_t slot = flat_object_slot();
+                if (slot != no_slot)
+                {
+                    write_string_value(sv, row_values_[slot]);
+                }
+                break;
+            }
             case stack_item_kind::object:
             {
                 if (stack_[0].count_ == 0)
@@ -1023,6 +1129,14 @@ private:
         switch (stack_.back().item_kind_)
         {
             case stack_item_kind::flat_object:
+            {
+                std::size_t slot = flat_object_slot();
+                if (slot != no_slot)
+                {
+                    write_double_value(val, context, row_values_[slot], ec);
+                }
+                break;
+            }
             case stack_item_kind::object:
             {
                 if (stack_[0].count_ == 0)
@@ -1100,6 +1214,14 @@ private:
         switch (stack_.back().item_kind_)
         {
             case stack_item_kind::flat_object:
+            {
+                std::size_t slot = flat_object_slot();
+                if (slot != no_slot)
+                {
+                    write_int64_value(val, row_values_[slot]);
+                }
+                break;
+            }
             case stack_item_kind::object:
             {
                 if (stack_[0].count_ == 0)
@@ -1173,6 +1295,14 @@ private:
         switch (stack_.back().item_kind_)
         {
             case stack_item_kind::flat_object:
+            {
+                std::size_t slot = flat_object_slot();
+                if (slot != no_slot)
+                {
+                    write_uint64_value(val, row_values_[slot]);
+                }
+                break;
+            }
             case stack_item_kind::object:
             {
                 if (stack_[0].count_ == 0)
@@ -1243,6 +1373,14 @@ private:
         switch (stack_.back().item_kind_)
         {
             case stack_item_kind::flat_object:
+            {
+                std::size_t slot = flat_object_slot();
+                if (slot != no_slot)
+                {
+                    write_bool_value(val, row_values_[slot]);
+                }
+                break;
+            }
             case stack_item_kind::object:
             {
                 if (stack_[0].count_ == 0)
@@ -1379,17 +1517,20 @@ private:
         }
         else
         {
+            JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
             fp_(val, str);
         }
     }
 
     void write_int64_value(int64_t val, string_type& str)
     {
+        JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
         jsoncons::utility::from_integer(val,str);
     }
 
     void write_uint64_value(uint64_t val, string_type& str)
     {
+        JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
         jsoncons::utility::from_integer(val,str);
     }
 
@@ -1411,6 +1552,9 @@ private:
     }
 };
 
+template <typename CharT,typename Sink,typename Allocator>
+constexpr std::size_t basic_csv_encoder<CharT,Sink,Allocator>::no_slot;
+
 using csv_stream_encoder = basic_csv_encoder<char>;
 using csv_string_encoder = basic_csv_encoder<char,jsoncons::string_sink<std::string>>;
 using csv_wstream_encoder = basic_csv_encoder<wchar_t>;
@@ -25,7 +25,10 @@ namespace csv {
         invalid_escaped_char,
         unexpected_char_between_fields,
         max_nesting_depth_exceeded,
-        invalid_number
+        invalid_number,
+        m_columns_required,
+        nested_column_value,
+        column_type_mismatch
     };
 
 class csv_error_category_impl
@@ -58,6 +61,12 @@ public:
                 return "Data item nesting exceeds limit in options";
             case csv_errc::invalid_number:
                 return "Invalid number";
+            case csv_errc::m_columns_required:
+                return "Column-major reading requires csv_mapping_kind::m_columns";
+            case csv_errc::nested_column_value:
+                return "A column buffer cannot hold nested values";
+            case csv_errc::column_type_mismatch:
+                return "Value does not match the column type";
             default:
                 return "Unknown CSV parser error";
         }
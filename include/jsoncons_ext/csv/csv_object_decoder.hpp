@@ -0,0 +1,503 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_EXT_CSV_CSV_OBJECT_DECODER_HPP
+#define JSONCONS_EXT_CSV_CSV_OBJECT_DECODER_HPP
+
+#include <algorithm> // std::sort, std::lower_bound
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator> // std::make_move_iterator
+#include <memory> // std::allocator
+#include <system_error>
+#include <utility> // std::move
+#include <vector>
+
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_object.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/semantic_tag.hpp>
+#include <jsoncons/ser_util.hpp>
+
+namespace jsoncons {
+namespace csv {
+namespace detail {
+
+    // Builds basic_json values from the events of csv_mapping_kind::n_objects. Every row
+    // repeats the same keys, so the member order of a row object is worked out once, from the
+    // first row with a given sequence of columns, and kept as a layout. Later rows with the same
+    // columns are created with reserved member storage and their members appended in layout
+    // order, without sorting or comparing keys. Values nested in a row, and structures other than
+    // an array of objects, are built by a json_decoder.
+    //
+    // If a row handler is given, each element of the top level array is passed to it
+    // instead of being appended to the result, and a handler that returns false ends decoding.
+
+    template <typename Json,typename TempAlloc=std::allocator<char>>
+    class csv_object_decoder final : public basic_json_visitor<typename Json::char_type>
+    {
+    public:
+        using char_type = typename Json::char_type;
+        using typename basic_json_visitor<char_type>::string_view_type;
+
+        using key_type = typename Json::key_type;
+        using key_value_type = typename Json::key_value_type;
+        using allocator_type = typename Json::allocator_type;
+        using row_handler_type = std::function<bool(Json&&,const ser_context&)>;
+    private:
+        using temp_allocator_type = TempAlloc;
+
+        struct column_info
+        {
+            key_type name;
+            std::size_t row;   // the last row that has this column
+            Json value;
+
+            column_info(key_type&& name, std::size_t row)
+                : name(std::move(name)), row(row)
+            {
+            }
+        };
+
+        using column_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<column_info>;
+        using size_t_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<std::size_t>;
+        using member_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<key_value_type>;
+
+        allocator_type allocator_;
+        row_handler_type row_handler_;
+        json_decoder<Json,TempAlloc> nested_;
+
+        Json result_;
+        int level_{0};
+        std::size_t nested_level_{0};
+        semantic_tag row_tag_{semantic_tag::none};
+        bool is_valid_{false};
+        bool done_{false};
+
+        std::size_t row_{0};
+        std::size_t current_{0};
+        std::size_t next_{0};
+        bool has_key_{false};
+        std::vector<column_info,column_allocator_type> columns_;
+        std::vector<std::size_t,size_t_allocator_type> row_columns_;
+        std::vector<std::size_t,size_t_allocator_type> layout_columns_;
+        std::vector<std::size_t,size_t_allocator_type> layout_;
+        std::vector<key_value_type,member_allocator_type> members_;
+
+    public:
+        csv_object_decoder(const allocator_type& alloc = allocator_type(),
+            const temp_allocator_type& temp_alloc = temp_allocator_type())
+            : csv_object_decoder(row_handler_type(), alloc, temp_alloc)
+        {
+        }
+
+        csv_object_decoder(row_handler_type row_handler,
+            const allocator_type& alloc = allocator_type(),
+            const temp_allocator_type& temp_alloc = temp_allocator_type())
+            : allocator_(alloc),
+              row_handler_(std::move(row_handler)),
+              nested_(alloc, temp_alloc),
+              columns_(temp_alloc),
+              row_columns_(temp_alloc),
+              layout_columns_(temp_alloc),
+              layout_(temp_alloc),
+              members_(temp_alloc)
+        {
+        }
+
+        bool is_valid() const
+        {
+            return is_valid_;
+        }
+
+        Json get_result()
+        {
+            JSONCONS_ASSERT(is_valid_);
+            is_valid_ = false;
+            return std::move(result_);
+        }
+
+    private:
+        void visit_flush() override
+        {
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ == 0 && level_ == 1)
+            {
+                ++row_;
+                row_tag_ = tag;
+                row_columns_.clear();
+                next_ = 0;
+                has_key_ = false;
+                level_ = 2;
+                JSONCONS_VISITOR_RETURN;
+            }
+            ++nested_level_;
+            nested_.begin_object(tag, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context& context, std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.end_object(context, ec);
+                end_nested(context);
+                JSONCONS_VISITOR_RETURN;
+            }
+            JSONCONS_ASSERT(level_ == 2);
+            level_ = 1;
+            add_item(make_row(), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ == 0 && level_ == 0)
+            {
+                result_ = Json(json_array_arg, tag, allocator_);
+                is_valid_ = false;
+                level_ = 1;
+                JSONCONS_VISITOR_RETURN;
+            }
+            ++nested_level_;
+            nested_.begin_array(tag, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context& context, std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.end_array(context, ec);
+                end_nested(context);
+                JSONCONS_VISITOR_RETURN;
+            }
+            JSONCONS_ASSERT(level_ == 1);
+            level_ = 0;
+            is_valid_ = true;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type& name, const ser_context& context, std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.key(name, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            current_ = find_column(name);
+            has_key_ = true;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& sv, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.string_value(sv, tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(sv, tag, allocator_), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& b,
+            semantic_tag tag,
+            const ser_context& context,
+            std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.byte_string_value(b, tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(byte_string_arg, b, tag, allocator_), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& b,
+            uint64_t ext_tag,
+            const ser_context& context,
+            std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.byte_string_value(b, ext_tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(byte_string_arg, b, ext_tag, allocator_), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value,
+            semantic_tag tag,
+            const ser_context& context,
+            std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.int64_value(value, tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(value, tag), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value,
+            semantic_tag tag,
+            const ser_context& context,
+            std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.uint64_value(value, tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(value, tag), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_half(uint16_t value,
+            semantic_tag tag,
+            const ser_context& context,
+            std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.half_value(value, tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(half_arg, value, tag), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value,
+            semantic_tag tag,
+            const ser_context& context,
+            std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.double_value(value, tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(value, tag), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.bool_value(value, tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(value, tag), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (done_)
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (nested_level_ > 0)
+            {
+                nested_.null_value(tag, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            add_value(Json(null_type(), tag), context);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        void end_nested(const ser_context& context)
+        {
+            if (--nested_level_ == 0 && nested_.is_valid())
+            {
+                add_value(nested_.get_result(), context);
+            }
+        }
+
+        void add_value(Json&& value, const ser_context& context)
+        {
+            switch (level_)
+            {
+                case 0:
+                    result_ = std::move(value);
+                    is_valid_ = true;
+                    break;
+                case 1:
+                    add_item(std::move(value), context);
+                    break;
+                default:
+                    if (!has_key_)
+                    {
+                        current_ = find_column(string_view_type());
+                    }
+                    columns_[current_].value = std::move(value);
+                    has_key_ = false;
+                    break;
+            }
+        }
+
+        void add_item(Json&& item, const ser_context& context)
+        {
+            if (row_handler_)
+            {
+                if (!row_handler_(std::move(item), context))
+                {
+                    done_ = true;
+                }
+            }
+            else
+            {
+                result_.push_back(std::move(item));
+            }
+        }
+
+        // Returns the column for a key. The parser gives the keys of a row in column order,
+        // so the column after the previous one is tried first.
+        std::size_t find_column(const string_view_type& name)
+        {
+            std::size_t index = columns_.size();
+            if (next_ < columns_.size() && columns_[next_].row != row_ && name_of(columns_[next_]) == name)
+            {
+                index = next_;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < columns_.size(); ++i)
+                {
+                    if (columns_[i].row != row_ && name_of(columns_[i]) == name)
+                    {
+                        index = i;
+                        break;
+                    }
+                }
+                if (index == columns_.size())
+                {
+                    columns_.emplace_back(key_type(name.data(), name.length(), allocator_), 0);
+                }
+            }
+            columns_[index].row = row_;
+            row_columns_.push_back(index);
+            next_ = index + 1;
+            return index;
+        }
+
+        static string_view_type name_of(const column_info& column)
+        {
+            return string_view_type(column.name.data(), column.name.size());
+        }
+
+        Json make_row()
+        {
+            Json row(json_object_arg, row_tag_, allocator_);
+            if (row_columns_ == layout_columns_)
+            {
+                row.reserve(layout_.size());
+                members_.clear();
+                for (auto index : layout_)
+                {
+                    auto& column = columns_[index];
+                    members_.emplace_back(key_type(column.name.data(), column.name.size(), allocator_), std::move(column.value));
+                }
+                row.insert(sorted_unique_range_tag(), std::make_move_iterator(members_.begin()), std::make_move_iterator(members_.end()));
+                return row;
+            }
+
+            // New sequence of columns: the first of several equal keys is kept, and the
+            // object decides the member order, which becomes the layout for later rows
+            row.reserve(row_columns_.size());
+            layout_.clear();
+            for (auto index : row_columns_)
+            {
+                auto& column = columns_[index];
+                if (row.try_emplace(name_of(column), std::move(column.value)).second)
+                {
+                    layout_.push_back(index);
+                }
+            }
+            std::sort(layout_.begin(), layout_.end(),
+                [this](std::size_t a, std::size_t b) {return name_of(columns_[a]).compare(name_of(columns_[b])) < 0;});
+            std::vector<std::size_t,size_t_allocator_type> order(layout_.get_allocator());
+            order.reserve(layout_.size());
+            for (const auto& member : row.object_range())
+            {
+                string_view_type key(member.key().data(), member.key().size());
+                auto it = std::lower_bound(layout_.begin(), layout_.end(), key,
+                    [this](std::size_t a, const string_view_type& k) {return name_of(columns_[a]).compare(k) < 0;});
+                JSONCONS_ASSERT(it != layout_.end());
+                order.push_back(*it);
+            }
+            layout_.swap(order);
+            layout_columns_ = row_columns_;
+            return row;
+        }
+    };
+
+} // namespace detail
+} // namespace csv
+} // namespace jsoncons
+
+#endif // JSONCONS_EXT_CSV_CSV_OBJECT_DECODER_HPP
@@ -0,0 +1,1046 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CSV_CSV_PARALLEL_READER_HPP
+#define JSONCONS_CSV_CSV_PARALLEL_READER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <memory> // std::allocator
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/conv_error.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/ser_util.hpp>
+
+#include <jsoncons_ext/csv/csv_column_reader.hpp>
+#include <jsoncons_ext/csv/csv_error.hpp>
+#include <jsoncons_ext/csv/csv_options.hpp>
+#include <jsoncons_ext/csv/csv_parser.hpp>
+
+namespace jsoncons {
+namespace csv {
+
+namespace detail {
+
+    struct csv_chunk
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t line; // line number of the first character
+    };
+
+    // Splits the input at record boundaries into chunks of at least chunk_size characters,
+    // and returns the end of the header lines. The scan follows the quote rules of
+    // basic_csv_parser, so that line breaks within quotes do not end a record, and skips
+    // comment lines. As in the parser, a quote outside a quoted value starts one, even in
+    // the middle of a field, while a quote after a closing quote is an error and is not
+    // treated as the start of another quoted value.
+    template <typename CharT>
+    std::size_t split_csv_records(const CharT* data, std::size_t length,
+                                  const basic_csv_decode_options<CharT>& options,
+                                  std::size_t chunk_size,
+                                  std::vector<csv_chunk>& chunks)
+    {
+        const CharT quote_char = options.quote_char();
+        const CharT quote_escape_char = options.quote_escape_char();
+        const CharT comment_starter = options.comment_starter();
+        const CharT field_delimiter = options.field_delimiter();
+        const CharT subfield_delimiter = options.subfield_delimiter();
+        const std::size_t header_lines = options.header_lines();
+
+        std::size_t header_end = 0;
+        std::size_t header_count = 0;
+        std::size_t line = 1;
+        std::size_t chunk_begin = 0;
+        std::size_t chunk_line = 1;
+        bool quoted = false;
+        bool after_quote = false;
+        bool record_start = true;
+        bool comment = false;
+
+        std::size_t i = 0;
+        while (i < length)
+        {
+            CharT c = data[i];
+            if (quoted)
+            {
+                if (c == quote_escape_char && i + 1 < length && data[i+1] == quote_char)
+                {
+                    i += 2;
+                    continue;
+                }
+                if (c == quote_char)
+                {
+                    quoted = false;
+                    after_quote = true;
+                }
+                ++i;
+                continue;
+            }
+            if (c == '\n' || c == '\r')
+            {
+                ++i;
+                if (c == '\r' && i < length && data[i] == '\n')
+                {
+                    ++i;
+                }
+                ++line;
+                if (header_count < header_lines)
+                {
+                    if (!comment)
+                    {
+                        ++header_count;
+                    }
+                    header_end = i;
+                }
+                else if (i - chunk_begin >= chunk_size && i < length)
+                {
+                    chunks.push_back(csv_chunk{chunk_begin, i, chunk_line});
+                    chunk_begin = i;
+                    chunk_line = line;
+                }
+                record_start = true;
+                after_quote = false;
+                comment = false;
+                continue;
+            }
+            if (record_start && comment_starter != CharT() && c == comment_starter)
+            {
+                comment = true;
+            }
+            record_start = false;
+            if (c == field_delimiter || (subfield_delimiter != CharT() && c == subfield_delimiter))
+            {
+                after_quote = false;
+            }
+            else if (!comment && !after_quote && c == quote_char)
+            {
+                quoted = true;
+            }
+            ++i;
+        }
+        chunks.push_back(csv_chunk{chunk_begin, length, chunk_line});
+        return header_end;
+    }
+
+    // Forwards the events of one chunk, except the outermost array, and nothing
+    // until activated
+    template <typename CharT>
+    class csv_chunk_filter : public basic_json_visitor<CharT>
+    {
+    public:
+        using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+    private:
+        basic_json_visitor<CharT>& destination_;
+        bool active_{false};
+        int level_{0};
+    public:
+        csv_chunk_filter(basic_json_visitor<CharT>& destination)
+            : destination_(destination)
+        {
+        }
+
+        void activate()
+        {
+            active_ = true;
+        }
+
+    private:
+        bool forward() const
+        {
+            return active_ && level_ > 0;
+        }
+
+        void visit_flush() override
+        {
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (forward())
+            {
+                destination_.begin_object(tag, context, ec);
+            }
+            ++level_;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context& context, std::error_code& ec) override
+        {
+            --level_;
+            if (forward())
+            {
+                destination_.end_object(context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (forward())
+            {
+                destination_.begin_array(tag, context, ec);
+            }
+            ++level_;
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context& context, std::error_code& ec) override
+        {
+            --level_;
+            if (forward())
+            {
+                destination_.end_array(context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type& name, const ser_context& context, std::error_code& ec) override
+        {
+            if (active_)
+            {
+                destination_.key(name, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (active_)
+            {
+                destination_.null_value(tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (active_)
+            {
+                destination_.string_value(value, tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (active_)
+            {
+                destination_.byte_string_value(value, tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (active_)
+            {
+                destination_.double_value(value, tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (active_)
+            {
+                destination_.int64_value(value, tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (active_)
+            {
+                destination_.uint64_value(value, tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (active_)
+            {
+                destination_.bool_value(value, tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+    // Records the events of one chunk so that they can be replayed in input order
+    template <typename CharT,typename TempAlloc>
+    class csv_event_recorder : public basic_json_visitor<CharT>
+    {
+    public:
+        using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+    private:
+        using event_type = parse_event<CharT,TempAlloc>;
+        using event_allocator_type = typename std::allocator_traits<TempAlloc>:: template rebind_alloc<event_type>;
+
+        TempAlloc alloc_;
+        std::vector<event_type,event_allocator_type> events_;
+    public:
+        csv_event_recorder(const TempAlloc& alloc)
+            : alloc_(alloc), events_(alloc)
+        {
+        }
+
+        void replay(basic_json_visitor<CharT>& visitor) const
+        {
+            for (const auto& event : events_)
+            {
+                event.replay(visitor);
+            }
+        }
+
+    private:
+        void visit_flush() override
+        {
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(staj_event_type::begin_object, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(staj_event_type::end_object, semantic_tag::none, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(staj_event_type::begin_array, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(staj_event_type::end_array, semantic_tag::none, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(staj_event_type::key, name, semantic_tag::none, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(staj_event_type::null_value, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(value, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(value, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(value, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(value, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(value, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(value, tag, alloc_);
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+    // Stores the records of one chunk, with the outermost array removed, in one
+    // vector of integer or floating point type T per column. Records are arrays
+    // (n_rows) or objects (n_objects), or, for m_columns, each member is a column.
+    // A value missing from a record becomes null.
+    template <typename CharT,typename T>
+    class numeric_columns_visitor : public basic_json_visitor<CharT>
+    {
+    public:
+        using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+    private:
+        using appender = numeric_appender<CharT,T>;
+
+        const std::vector<std::basic_string<CharT>>& names_;
+        std::vector<std::vector<T>> columns_;
+        std::size_t rows_{0};
+        std::size_t index_{0};
+        int level_{0};
+        bool by_column_{false};
+        bool skip_{false};
+    public:
+        numeric_columns_visitor(const std::vector<std::basic_string<CharT>>& names)
+            : names_(names), columns_(names.size())
+        {
+        }
+
+        std::vector<std::vector<T>>& columns()
+        {
+            return columns_;
+        }
+
+        std::size_t rows() const
+        {
+            return rows_;
+        }
+
+        bool by_column() const
+        {
+            return by_column_;
+        }
+
+        static void fill(std::vector<T>& values, std::size_t rows, std::error_code& ec)
+        {
+            while (values.size() < rows && !ec)
+            {
+                appender::append_null(values, ec);
+            }
+        }
+
+    private:
+        std::vector<T>* target(std::error_code& ec)
+        {
+            if (level_ != 1)
+            {
+                ec = conv_errc::not_vector;
+                return nullptr;
+            }
+            if (skip_)
+            {
+                return nullptr;
+            }
+            if (index_ >= columns_.size())
+            {
+                columns_.resize(index_ + 1);
+                fill(columns_[index_], rows_, ec);
+            }
+            return &columns_[index_];
+        }
+
+        void next_value()
+        {
+            if (!by_column_)
+            {
+                ++index_;
+            }
+        }
+
+        std::size_t find_name(const string_view_type& name) const
+        {
+            for (std::size_t k = 0; k < names_.size(); ++k)
+            {
+                std::size_t j = (index_ + k) % names_.size();
+                if (name == string_view_type(names_[j].data(), names_[j].size()))
+                {
+                    return j;
+                }
+            }
+            return (std::numeric_limits<std::size_t>::max)();
+        }
+
+        void begin_container(std::error_code& ec)
+        {
+            if (level_ > 0)
+            {
+                ec = conv_errc::not_vector;
+                return;
+            }
+            if (!by_column_)
+            {
+                index_ = 0;
+                skip_ = false;
+            }
+            ++level_;
+        }
+
+        void end_container(std::error_code& ec)
+        {
+            --level_;
+            if (level_ == 0 && !by_column_)
+            {
+                ++rows_;
+                for (auto& column : columns_)
+                {
+                    fill(column, rows_, ec);
+                }
+            }
+        }
+
+        void visit_flush() override
+        {
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            begin_container(ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context&, std::error_code& ec) override
+        {
+            end_container(ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            begin_container(ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context&, std::error_code& ec) override
+        {
+            end_container(ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            if (level_ == 0)
+            {
+                by_column_ = true;
+            }
+            std::size_t index = find_name(name);
+            skip_ = index == (std::numeric_limits<std::size_t>::max)();
+            if (!skip_)
+            {
+                index_ = index;
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            std::vector<T>* values = target(ec);
+            if (values != nullptr)
+            {
+                appender::append_null(*values, ec);
+            }
+            next_value();
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            std::vector<T>* values = target(ec);
+            if (values != nullptr)
+            {
+                appender::append_bool(*values, value);
+            }
+            next_value();
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            std::vector<T>* values = target(ec);
+            if (values != nullptr)
+            {
+                appender::append_int64(*values, value, ec);
+            }
+            next_value();
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            std::vector<T>* values = target(ec);
+            if (values != nullptr)
+            {
+                appender::append_uint64(*values, value, ec);
+            }
+            next_value();
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            std::vector<T>* values = target(ec);
+            if (values != nullptr)
+            {
+                appender::append_double(*values, value, ec);
+            }
+            next_value();
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            std::vector<T>* values = target(ec);
+            if (values != nullptr)
+            {
+                appender::append_string(*values, value, ec);
+            }
+            next_value();
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view&, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            ec = appender::not_a_number();
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+} // namespace detail
+
+    // Parses a contiguous CSV input (a string or a memory mapped file) on several threads.
+    // The input is split at record boundaries into chunks, each chunk is parsed by its own
+    // basic_csv_parser that first reads the header lines, and the results are merged in
+    // input order.
+    template <typename CharT,typename TempAlloc=std::allocator<char>>
+    class basic_csv_parallel_reader
+    {
+    public:
+        using char_type = CharT;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using temp_allocator_type = TempAlloc;
+
+        static constexpr std::size_t default_chunk_size = 4194304;
+    private:
+        struct chunk_status
+        {
+            std::error_code ec;
+            std::size_t line{0};
+            std::size_t column{0};
+        };
+
+        struct event_sink
+        {
+            detail::csv_event_recorder<CharT,TempAlloc> recorder;
+
+            event_sink(const TempAlloc& alloc)
+                : recorder(alloc)
+            {
+            }
+
+            basic_json_visitor<CharT>& visitor()
+            {
+                return recorder;
+            }
+        };
+
+        template <typename Json>
+        struct json_sink
+        {
+            json_decoder<Json,TempAlloc> decoder;
+
+            json_sink(const TempAlloc& alloc)
+                : decoder(typename Json::allocator_type(), alloc)
+            {
+                decoder.begin_array(semantic_tag::none, ser_context());
+            }
+
+            basic_json_visitor<CharT>& visitor()
+            {
+                return decoder;
+            }
+        };
+
+        template <typename T>
+        struct columns_sink
+        {
+            detail::numeric_columns_visitor<CharT,T> columns;
+
+            columns_sink(const std::vector<std::basic_string<CharT>>& names)
+                : columns(names)
+            {
+            }
+
+            basic_json_visitor<CharT>& visitor()
+            {
+                return columns;
+            }
+        };
+
+        basic_csv_parallel_reader(const basic_csv_parallel_reader&) = delete;
+        basic_csv_parallel_reader& operator = (const basic_csv_parallel_reader&) = delete;
+
+        string_view_type input_;
+        basic_csv_decode_options<CharT> options_;
+        std::size_t max_threads_;
+        TempAlloc alloc_;
+        std::vector<detail::csv_chunk> chunks_;
+        std::size_t header_end_;
+        std::vector<std::basic_string<CharT>> column_names_;
+        std::size_t line_{0};
+        std::size_t column_{0};
+    public:
+        // max_threads of 0 means std::thread::hardware_concurrency()
+        basic_csv_parallel_reader(string_view_type input,
+                                  const basic_csv_decode_options<CharT>& options,
+                                  std::size_t max_threads = 0,
+                                  std::size_t chunk_size = default_chunk_size,
+                                  const TempAlloc& alloc = TempAlloc())
+           : input_(input),
+             options_(options),
+             max_threads_(max_threads > 0 ? max_threads : (std::max)(std::size_t(1), std::size_t(std::thread::hardware_concurrency()))),
+             alloc_(alloc),
+             header_end_(0)
+        {
+            header_end_ = detail::split_csv_records(input_.data(), input_.size(), options_,
+                (std::max)(std::size_t(1), chunk_size), chunks_);
+            // m_columns output and a limit on lines need the whole input in one parser
+            if (options_.mapping_kind() == csv_mapping_kind::m_columns ||
+                options_.max_lines() != (std::numeric_limits<std::size_t>::max)())
+            {
+                chunks_.clear();
+                chunks_.push_back(detail::csv_chunk{0, input_.size(), 1});
+            }
+        }
+
+        ~basic_csv_parallel_reader() noexcept = default;
+
+        std::size_t chunk_count() const
+        {
+            return chunks_.size();
+        }
+
+        void read(basic_json_visitor<CharT>& visitor)
+        {
+            std::error_code ec;
+            read(visitor, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(ser_error(ec,line_,column_));
+            }
+        }
+
+        void read(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+        {
+            ec.clear();
+            if (chunks_.size() == 1)
+            {
+                read_sequential(visitor, ec);
+                return;
+            }
+            visitor.begin_array(semantic_tag::none, ser_context(), ec);
+            if (JSONCONS_UNLIKELY(ec)) return;
+
+            auto make_sink = [this]() -> std::unique_ptr<event_sink>
+            {
+                return std::unique_ptr<event_sink>(new event_sink(alloc_));
+            };
+            auto consume = [&visitor](event_sink& sink, std::error_code&)
+            {
+                sink.recorder.replay(visitor);
+            };
+            parse_chunks<event_sink>(make_sink, consume, false, ec);
+            if (JSONCONS_UNLIKELY(ec)) return;
+
+            visitor.end_array(ser_context(), ec);
+            if (JSONCONS_UNLIKELY(ec)) return;
+            visitor.flush();
+        }
+
+        template <typename Json>
+        typename std::enable_if<ext_traits::is_basic_json<Json>::value>::type
+        read(Json& result)
+        {
+            std::error_code ec;
+            read(result, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(ser_error(ec,line_,column_));
+            }
+        }
+
+        template <typename Json>
+        typename std::enable_if<ext_traits::is_basic_json<Json>::value>::type
+        read(Json& result, std::error_code& ec)
+        {
+            ec.clear();
+            if (chunks_.size() == 1)
+            {
+                json_decoder<Json,TempAlloc> decoder(typename Json::allocator_type(), alloc_);
+                read_sequential(decoder, ec);
+                if (JSONCONS_UNLIKELY(ec)) return;
+                if (JSONCONS_UNLIKELY(!decoder.is_valid()))
+                {
+                    ec = conv_errc::conversion_failed;
+                    return;
+                }
+                result = decoder.get_result();
+                return;
+            }
+
+            Json merged(json_array_arg);
+            auto make_sink = [this]() -> std::unique_ptr<json_sink<Json>>
+            {
+                return std::unique_ptr<json_sink<Json>>(new json_sink<Json>(alloc_));
+            };
+            auto consume = [&merged](json_sink<Json>& sink, std::error_code& ec)
+            {
+                sink.decoder.end_array(ser_context(), ec);
+                if (JSONCONS_UNLIKELY(ec)) return;
+                if (JSONCONS_UNLIKELY(!sink.decoder.is_valid()))
+                {
+                    ec = conv_errc::conversion_failed;
+                    return;
+                }
+                Json records = sink.decoder.get_result();
+                merged.reserve(merged.size() + records.size());
+                for (auto& record : records.array_range())
+                {
+                    merged.push_back(std::move(record));
+                }
+            };
+            parse_chunks<json_sink<Json>>(make_sink, consume, false, ec);
+            if (JSONCONS_UNLIKELY(ec)) return;
+            result = std::move(merged);
+        }
+
+        // Reads the values of every column into a vector of integer or floating point type T,
+        // replacing the contents of columns. The header lines are not part of the values.
+        // An empty value, null or a value missing from a record becomes NaN if T is a
+        // floating point type, and is an error otherwise.
+        template <typename T>
+        typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T,bool>::value>::type
+        read_columns(std::vector<std::vector<T>>& columns)
+        {
+            std::error_code ec;
+            read_columns(columns, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(ser_error(ec,line_,column_));
+            }
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T,bool>::value>::type
+        read_columns(std::vector<std::vector<T>>& columns, std::error_code& ec)
+        {
+            using columns_visitor = detail::numeric_columns_visitor<CharT,T>;
+
+            ec.clear();
+            read_column_names(ec);
+            if (JSONCONS_UNLIKELY(ec)) return;
+
+            columns.clear();
+            std::size_t rows = 0;
+            auto make_sink = [this]() -> std::unique_ptr<columns_sink<T>>
+            {
+                return std::unique_ptr<columns_sink<T>>(new columns_sink<T>(column_names_));
+            };
+            auto consume = [&columns,&rows](columns_sink<T>& sink, std::error_code& ec)
+            {
+                auto& chunk_columns = sink.columns.columns();
+                if (chunk_columns.size() > columns.size())
+                {
+                    columns.resize(chunk_columns.size());
+                }
+                for (std::size_t i = 0; i < columns.size() && !ec; ++i)
+                {
+                    columns_visitor::fill(columns[i], rows, ec);
+                    if (i < chunk_columns.size())
+                    {
+                        columns[i].insert(columns[i].end(), chunk_columns[i].begin(), chunk_columns[i].end());
+                    }
+                    else if (!sink.columns.by_column())
+                    {
+                        columns_visitor::fill(columns[i], rows + sink.columns.rows(), ec);
+                    }
+                }
+                rows += sink.columns.rows();
+            };
+            parse_chunks<columns_sink<T>>(make_sink, consume, true, ec);
+        }
+
+        // The column names from the header or options, available after read_columns
+        std::size_t column_count() const
+        {
+            return column_names_.size();
+        }
+
+        const std::basic_string<CharT>& column_name(std::size_t index) const
+        {
+            return column_names_[index];
+        }
+
+        std::size_t line() const
+        {
+            return line_;
+        }
+
+        std::size_t column() const
+        {
+            return column_;
+        }
+
+    private:
+
+        void read_sequential(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+        {
+            basic_csv_parser<CharT,TempAlloc> parser(options_, alloc_);
+            parser.update(input_.data(), input_.size());
+            while (!parser.stopped())
+            {
+                parser.parse_some(visitor, ec);
+                if (JSONCONS_UNLIKELY(ec)) break;
+            }
+            line_ = parser.line();
+            column_ = parser.column();
+        }
+
+        void read_column_names(std::error_code& ec)
+        {
+            basic_csv_parser<CharT,TempAlloc> parser(options_, alloc_);
+            if (header_end_ > 0)
+            {
+                basic_default_json_visitor<CharT> visitor;
+                parser.update(input_.data(), header_end_);
+                parser.parse_some(visitor, ec);
+                if (JSONCONS_UNLIKELY(ec))
+                {
+                    line_ = parser.line();
+                    column_ = parser.column();
+                    return;
+                }
+            }
+            column_names_.clear();
+            for (const auto& name : parser.column_labels())
+            {
+                column_names_.emplace_back(name.data(), name.size());
+            }
+        }
+
+        // Parses the chunks with up to max_threads_ chunks in flight, passing the
+        // results to consume in input order
+        template <typename Sink,typename MakeSink,typename Consume>
+        void parse_chunks(MakeSink& make_sink, Consume& consume, bool skip_header, std::error_code& ec)
+        {
+            struct pending
+            {
+                std::unique_ptr<Sink> sink;
+                std::future<chunk_status> status;
+            };
+
+            std::deque<pending> in_flight;
+            std::size_t next = 0;
+
+            auto launch = [&]()
+            {
+                pending p;
+                p.sink = make_sink();
+                Sink* sink = p.sink.get();
+                const detail::csv_chunk* chunk = &chunks_[next++];
+                auto policy = (max_threads_ > 1 && chunks_.size() > 1) ? std::launch::async : std::launch::deferred;
+                p.status = std::async(policy, [this,chunk,skip_header,sink]()
+                {
+                    return parse_chunk(*chunk, skip_header, sink->visitor());
+                });
+                in_flight.push_back(std::move(p));
+            };
+
+            while (next < chunks_.size() && in_flight.size() < max_threads_)
+            {
+                launch();
+            }
+            while (!in_flight.empty())
+            {
+                chunk_status status = in_flight.front().status.get();
+                if (JSONCONS_UNLIKELY(status.ec))
+                {
+                    ec = status.ec;
+                    line_ = status.line;
+                    column_ = status.column;
+                    return;
+                }
+                consume(*in_flight.front().sink, ec);
+                if (JSONCONS_UNLIKELY(ec)) return;
+                in_flight.pop_front();
+                if (next < chunks_.size())
+                {
+                    launch();
+                }
+            }
+        }
+
+        chunk_status parse_chunk(const detail::csv_chunk& chunk, bool skip_header,
+                                 basic_json_visitor<CharT>& destination) const
+        {
+            chunk_status status;
+            detail::csv_chunk_filter<CharT> filter(destination);
+            basic_csv_parser<CharT,TempAlloc> parser(options_, alloc_);
+
+            // Every parser reads the header lines, their events are not forwarded
+            std::size_t begin = chunk.begin;
+            if (header_end_ > 0 && (skip_header || begin > 0))
+            {
+                parser.update(input_.data(), header_end_);
+                parser.parse_some(filter, status.ec);
+                if (JSONCONS_UNLIKELY(status.ec))
+                {
+                    status.line = parser.line();
+                    status.column = parser.column();
+                    return status;
+                }
+                begin = (std::max)(begin, header_end_);
+            }
+            const std::size_t first_line = begin == chunk.begin ? chunk.line : parser.line();
+            const std::size_t parser_line = parser.line();
+
+            filter.activate();
+            parser.update(input_.data() + begin, chunk.end - begin);
+            while (!parser.stopped())
+            {
+                parser.parse_some(filter, status.ec);
+                if (JSONCONS_UNLIKELY(status.ec)) break;
+            }
+            status.line = first_line + (parser.line() - parser_line);
+            status.column = parser.column();
+            return status;
+        }
+    };
+
+    template <typename CharT,typename TempAlloc>
+    constexpr std::size_t basic_csv_parallel_reader<CharT,TempAlloc>::default_chunk_size;
+
+    using csv_parallel_reader = basic_csv_parallel_reader<char>;
+    using wcsv_parallel_reader = basic_csv_parallel_reader<wchar_t>;
+
+} // namespace csv
+} // namespace jsoncons
+
+#endif
@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory> // std::allocator
 #include <sstream>
 #include <string>
@@ -20,6 +21,7 @@
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/utility/read_number.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_filter.hpp>
 #include <jsoncons/json_reader.hpp>
@@ -31,6 +33,7 @@
 
 #include <jsoncons_ext/csv/csv_error.hpp>
 #include <jsoncons_ext/csv/csv_options.hpp>
+#include <jsoncons_ext/csv/csv_scanner.hpp>
 
 namespace jsoncons { 
 namespace csv {
@@ -140,6 +143,14 @@ namespace detail {
         {
         }
 
+        parse_event(staj_event_type event_type, const string_view_type& value, semantic_tag tag, const TempAlloc& alloc)
+            : event_type(event_type), 
+              string_value(value.data(),value.length(),alloc), 
+              byte_string_value(alloc),
+              tag(tag)
+        {
+        }
+
         parse_event(const byte_string_view& value, semantic_tag tag, const TempAlloc& alloc)
             : event_type(staj_event_type::byte_string_value), 
               string_value(alloc),
@@ -199,6 +210,15 @@ namespace detail {
                 case staj_event_type::end_array:
                     visitor.end_array(ser_context());
                     break;
+                case staj_event_type::begin_object:
+                    visitor.begin_object(tag, ser_context());
+                    break;
+                case staj_event_type::end_object:
+                    visitor.end_object(ser_context());
+                    break;
+                case staj_event_type::key:
+                    visitor.key(string_value, ser_context());
+                    break;
                 case staj_event_type::string_value:
                     visitor.string_value(string_value, tag, ser_context());
                     break;
@@ -249,6 +269,9 @@ namespace detail {
         cached_state state_{cached_state::begin_object};
         std::size_t column_index_{0};
         std::size_t row_index_{0};
+        std::size_t first_column_{0};
+        std::size_t last_column_{(std::numeric_limits<std::size_t>::max)()};
+        basic_json_visitor<CharT>* destination_{nullptr};
 
         std::vector<string_type, string_allocator_type> column_names_;
         std::vector<parse_event_vector_type,parse_event_vector_allocator_type> cached_events_;
@@ -269,6 +292,9 @@ namespace detail {
             state_ = cached_state::begin_object;
             column_index_ = 0;
             row_index_ = 0;
+            first_column_ = 0;
+            last_column_ = (std::numeric_limits<std::size_t>::max)();
+            destination_ = nullptr;
             column_names_.clear();
             cached_events_.clear();
         }
@@ -278,6 +304,25 @@ namespace detail {
             return state_ == cached_state::done;
         }
 
+        // Restricts the output to the columns [first, last). Only the events of those
+        // columns are cached, and a single column is not cached at all when a
+        // destination is set, its values are forwarded as they are parsed.
+        void select_columns(std::size_t first, std::size_t last)
+        {
+            first_column_ = first;
+            last_column_ = last;
+        }
+
+        bool streaming() const
+        {
+            return last_column_ - first_column_ == 1;
+        }
+
+        void destination(basic_json_visitor<CharT>* visitor)
+        {
+            destination_ = streaming() ? visitor : nullptr;
+        }
+
         void initialize(const std::vector<string_type, string_allocator_type>& column_names)
         {
             for (const auto& name : column_names)
@@ -291,6 +336,27 @@ namespace detail {
             column_index_ = 0;
             row_index_ = 0;
             state_ = cached_state::begin_object;
+
+            if (destination_ != nullptr)
+            {
+                if (first_column_ == 0)
+                {
+                    destination_->begin_object(semantic_tag::none, ser_context());
+                    ++level_;
+                }
+                column_index_ = first_column_;
+                if (first_column_ < column_names_.size())
+                {
+                    destination_->key(column_names_[first_column_], ser_context());
+                    destination_->begin_array(semantic_tag::none, ser_context());
+                    ++level_;
+                    state_ = cached_state::end_array;
+                }
+                else
+                {
+                    state_ = cached_state::end_object;
+                }
+            }
         }
 
         void skip_column()
@@ -311,24 +377,30 @@ namespace detail {
                 switch (state_)
                 {
                     case cached_state::begin_object:
-                        visitor.begin_object(semantic_tag::none, ser_context());
-                        ++level_;
-                        more = !cursor_mode;
-                        column_index_ = 0;
+                        if (first_column_ == 0)
+                        {
+                            visitor.begin_object(semantic_tag::none, ser_context());
+                            ++level_;
+                            more = !cursor_mode;
+                        }
+                        column_index_ = first_column_;
                         state_ = cached_state::name;
                         break;
                     case cached_state::end_object:
-                        visitor.end_object(ser_context());
-                        more = !cursor_mode;
-                        if (level_ == mark_level)
+                        if (last_column_ >= column_names_.size() && (first_column_ == 0 || first_column_ < column_names_.size()))
                         {
-                            more = false;
+                            visitor.end_object(ser_context());
+                            more = !cursor_mode;
+                            if (level_ == mark_level)
+                            {
+                                more = false;
+                            }
+                            --level_;
                         }
-                        --level_;
                         state_ = cached_state::done;
                         break;
                     case cached_state::name:
-                        if (column_index_ < column_names_.size())
+                        if (column_index_ < column_names_.size() && column_index_ < last_column_)
                         {
                             visitor.key(column_names_[column_index_], ser_context());
                             more = !cursor_mode;
@@ -377,6 +449,12 @@ namespace detail {
             return more;
         }
 
+    private:
+        bool selected() const
+        {
+            return name_index_ >= first_column_ && name_index_ < last_column_;
+        }
+
         void visit_flush() override
         {
         }
@@ -393,22 +471,41 @@ namespace detail {
             JSONCONS_VISITOR_RETURN;
         }
 
-        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context& context, std::error_code& ec) override
         {
             if (name_index_ < column_names_.size())
             {
-                cached_events_[name_index_].emplace_back(staj_event_type::begin_array, tag, alloc_);
-                
+                if (destination_ != nullptr)
+                {
+                    if (selected())
+                    {
+                        destination_->begin_array(tag, context, ec);
+                    }
+                }
+                else if (selected())
+                {
+                    cached_events_[name_index_].emplace_back(staj_event_type::begin_array, tag, alloc_);
+                }
                 ++level2_;
             }
             JSONCONS_VISITOR_RETURN;
         }
 
-        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context&, std::error_code&) override
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context& context, std::error_code& ec) override
         {
             if (level2_ > 0)
             {
-                cached_events_[name_index_].emplace_back(staj_event_type::end_array, semantic_tag::none, alloc_);
+                if (destination_ != nullptr)
+                {
+                    if (selected())
+                    {
+                        destination_->end_array(context, ec);
+                    }
+                }
+                else if (selected())
+                {
+                    cached_events_[name_index_].emplace_back(staj_event_type::end_array, semantic_tag::none, alloc_);
+                }
                 ++name_index_;
                 --level2_;
             }
@@ -425,11 +522,21 @@ namespace detail {
             JSONCONS_VISITOR_RETURN;
         }
 
-        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag tag, const ser_context& context, std::error_code& ec) override
         {
             if (name_index_ < column_names_.size())
             {
-                cached_events_[name_index_].emplace_back(staj_event_type::null_value, tag, alloc_);
+                if (selected())
+                {
+                    if (destination_ != nullptr)
+                    {
+                        destination_->null_value(tag, context, ec);
+                    }
+                    else
+                    {
+                        cached_events_[name_index_].emplace_back(staj_event_type::null_value, tag, alloc_);
+                    }
+                }
                 if (level2_ == 0)
                 {
                     ++name_index_;
@@ -438,12 +545,21 @@ namespace detail {
             JSONCONS_VISITOR_RETURN;
         }
 
-        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
         {
             if (name_index_ < column_names_.size())
             {
-                cached_events_[name_index_].emplace_back(value, tag, alloc_);
-
+                if (selected())
+                {
+                    if (destination_ != nullptr)
+                    {
+                        destination_->string_value(value, tag, context, ec);
+                    }
+                    else
+                    {
+                        cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                    }
+                }
                 if (level2_ == 0)
                 {
                     ++name_index_;
@@ -454,12 +570,22 @@ namespace detail {
 
         JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value,
                                   semantic_tag tag,
-                                  const ser_context&,
-                                  std::error_code&) override
+                                  const ser_context& context,
+                                  std::error_code& ec) override
         {
             if (name_index_ < column_names_.size())
             {
-                cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                if (selected())
+                {
+                    if (destination_ != nullptr)
+                    {
+                        destination_->byte_string_value(value, tag, context, ec);
+                    }
+                    else
+                    {
+                        cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                    }
+                }
                 if (level2_ == 0)
                 {
                     ++name_index_;
@@ -470,12 +596,22 @@ namespace detail {
 
         JSONCONS_VISITOR_RETURN_TYPE visit_double(double value,
                              semantic_tag tag, 
-                             const ser_context&,
-                             std::error_code&) override
+                             const ser_context& context,
+                             std::error_code& ec) override
         {
             if (name_index_ < column_names_.size())
             {
-                cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                if (selected())
+                {
+                    if (destination_ != nullptr)
+                    {
+                        destination_->double_value(value, tag, context, ec);
+                    }
+                    else
+                    {
+                        cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                    }
+                }
                 if (level2_ == 0)
                 {
                     ++name_index_;
@@ -486,12 +622,22 @@ namespace detail {
 
         JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value,
                             semantic_tag tag,
-                            const ser_context&,
-                            std::error_code&) override
+                            const ser_context& context,
+                            std::error_code& ec) override
         {
             if (name_index_ < column_names_.size())
             {
-                cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                if (selected())
+                {
+                    if (destination_ != nullptr)
+                    {
+                        destination_->int64_value(value, tag, context, ec);
+                    }
+                    else
+                    {
+                        cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                    }
+                }
                 if (level2_ == 0)
                 {
                     ++name_index_;
@@ -502,12 +648,22 @@ namespace detail {
 
         JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value,
                              semantic_tag tag,
-                             const ser_context&,
-                             std::error_code&) override
+                             const ser_context& context,
+                             std::error_code& ec) override
         {
             if (name_index_ < column_names_.size())
             {
-                cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                if (selected())
+                {
+                    if (destination_ != nullptr)
+                    {
+                        destination_->uint64_value(value, tag, context, ec);
+                    }
+                    else
+                    {
+                        cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                    }
+                }
                 if (level2_ == 0)
                 {
                     ++name_index_;
@@ -516,11 +672,21 @@ namespace detail {
             JSONCONS_VISITOR_RETURN;
         }
 
-        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
         {
             if (name_index_ < column_names_.size())
             {
-                cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                if (selected())
+                {
+                    if (destination_ != nullptr)
+                    {
+                        destination_->bool_value(value, tag, context, ec);
+                    }
+                    else
+                    {
+                        cached_events_[name_index_].emplace_back(value, tag, alloc_);
+                    }
+                }
                 if (level2_ == 0)
                 {
                     ++name_index_;
@@ -607,6 +773,9 @@ private:
     std::vector<csv_parse_state,csv_parse_state_allocator_type> state_stack_;
     string_type buffer_;
     std::vector<std::pair<std::basic_string<char_type>,double>> string_double_map_;
+    detail::char_scanner<CharT,5> unquoted_scanner_;
+    detail::char_scanner<CharT,2> quoted_scanner_;
+    detail::char_scanner<CharT,2> comment_scanner_;
 
 public:
     basic_csv_parser(const TempAlloc& alloc = TempAlloc())
@@ -662,7 +831,10 @@ public:
          column_types_(alloc),
          column_defaults_(alloc),
          state_stack_(alloc),
-         buffer_(alloc)
+         buffer_(alloc),
+         unquoted_scanner_{'\n', '\r', options.field_delimiter(), options.subfield_delimiter(), options.quote_char()},
+         quoted_scanner_{options.quote_char(), options.quote_escape_char()},
+         comment_scanner_{'\n', '\r'}
     {
         if (options.enable_str_to_nan())
         {
@@ -734,6 +906,22 @@ public:
         return column_names_;
     }
 
+    // Overrides the mapping kind given in the options, before parsing begins
+    void mapping_kind(csv_mapping_kind value)
+    {
+        mapping_kind_ = value;
+    }
+
+    // With csv_mapping_kind::m_columns, restricts the output to count columns starting
+    // at first. A caller can then make one pass over the input per column (or per
+    // group of columns) instead of caching every value of every column. The
+    // selection is cleared by reinitialize().
+    void select_columns(std::size_t first, std::size_t count)
+    {
+        std::size_t last = count <= (std::numeric_limits<std::size_t>::max)() - first ? first + count : (std::numeric_limits<std::size_t>::max)();
+        m_columns_filter_.select_columns(first, last);
+    }
+
     void reinitialize()
     {
         state_ = csv_parse_state::start;
@@ -749,6 +937,7 @@ public:
         input_ptr_ = nullptr;
         more_ = true;
         header_line_ = 1;
+        header_line_offset_ = 0;
         m_columns_filter_.reset();
         stack_.clear();
         column_names_.erase(column_names_.begin() + min_column_names_, column_names_.end());
@@ -782,6 +971,7 @@ public:
         {
             case csv_mapping_kind::m_columns:
                 cursor_mode_ = false;
+                m_columns_filter_.destination(actual_cursor_mode_ ? nullptr : &visitor);
                 break;
             default:
                 break;
@@ -995,8 +1185,13 @@ public:
                             state_ = csv_parse_state::cr;
                             break;
                         default:
-                            ++column_;
-                            break;
+                        {
+                            // Skip to the end of the line
+                            const CharT* next = comment_scanner_.find(input_ptr_ + 1, local_input_end);
+                            column_ += static_cast<std::size_t>(next - input_ptr_);
+                            input_ptr_ = next;
+                            continue;
+                        }
                     }
                     ++input_ptr_;
                     break;
@@ -1026,7 +1221,12 @@ public:
                         }
                         else
                         {
-                            buffer_.push_back(static_cast<CharT>(curr_char));
+                            // Consume the quoted text up to the next quote or escape character
+                            const CharT* next = quoted_scanner_.find(input_ptr_ + 1, local_input_end);
+                            buffer_.append(input_ptr_, static_cast<std::size_t>(next - input_ptr_));
+                            column_ += static_cast<std::size_t>(next - input_ptr_);
+                            input_ptr_ = next;
+                            continue;
                         }
                     }
                     ++column_;
@@ -1036,6 +1236,7 @@ public:
                     {
                         if (curr_char == quote_char_)
                         {
+                            JSONCONS_INSTRUMENT_COUNT(escapes, 1);
                             buffer_.push_back(static_cast<CharT>(curr_char));
                             state_ = csv_parse_state::quoted_string;
                             ++column_;
@@ -1293,9 +1494,11 @@ public:
                             }
                             else
                             {
-                                buffer_.push_back(static_cast<CharT>(curr_char));
-                                ++column_;
-                                ++input_ptr_;
+                                // Consume the field up to the next delimiter, quote or line break
+                                const CharT* next = unquoted_scanner_.find(input_ptr_ + 1, local_input_end);
+                                buffer_.append(input_ptr_, static_cast<std::size_t>(next - input_ptr_));
+                                column_ += static_cast<std::size_t>(next - input_ptr_);
+                                input_ptr_ = next;
                             }
                             break;
                     }
@@ -2261,6 +2464,7 @@ private:
                 if (is_negative)
                 {
                     int64_t val{ 0 };
+                    JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
                     auto result = jsoncons::utility::dec_to_integer(buffer_.data(), buffer_.length(), val);
                     if (result)
                     {
@@ -2276,6 +2480,7 @@ private:
                 else
                 {
                     uint64_t val{ 0 };
+                    JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
                     auto result = jsoncons::utility::dec_to_integer(buffer_.data(), buffer_.length(), val);
                     if (result)
                     {
@@ -2307,6 +2512,7 @@ private:
                 else
                 {
                     double d{0};
+                    JSONCONS_INSTRUMENT_COUNT(number_conversions, 1);
                     auto result = jsoncons::utility::decstr_to_double(buffer.c_str(), buffer.length(), d);
                     if (result.ec == std::errc::result_out_of_range)
                     {
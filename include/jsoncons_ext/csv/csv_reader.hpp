@@ -14,6 +14,7 @@
 #include <utility> // std::move
 
 #include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_decoder.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_reader.hpp>
@@ -128,6 +129,7 @@ namespace csv {
 
         void read(std::error_code& ec)
         {
+            JSONCONS_INSTRUMENT_TIMER(parse);
             read_internal(ec);
         }
 
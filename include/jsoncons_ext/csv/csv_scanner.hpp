@@ -0,0 +1,247 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CSV_CSV_SCANNER_HPP
+#define JSONCONS_CSV_CSV_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+#include <jsoncons/config/compiler_support.hpp>
+
+#if defined(JSONCONS_HAS_AVX2)
+#include <immintrin.h>
+#elif defined(JSONCONS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER) && (defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2))
+#include <intrin.h>
+#endif
+
+namespace jsoncons {
+namespace csv {
+namespace detail {
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2)
+    inline
+    std::size_t trailing_zeros(uint64_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(mask));
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<std::size_t>(index);
+    #else
+        std::size_t n = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+#endif
+
+    // Finds the first of up to N stop characters in a range. For single byte characters
+    // the range is examined in 64, 32 or 16 byte blocks with SSE2 or AVX2, or 8 bytes at
+    // a time with portable word operations, before the remaining characters one by one.
+    // Repeated stop characters are allowed.
+
+    template <typename CharT,std::size_t N>
+    class char_scanner
+    {
+        CharT stops_[N];
+    #if !defined(JSONCONS_HAS_AVX2) && !defined(JSONCONS_HAS_SSE2)
+        uint64_t wstops_[N];
+    #endif
+    public:
+        char_scanner(std::initializer_list<CharT> stops)
+        {
+            std::size_t i = 0;
+            for (auto c : stops)
+            {
+                if (i < N)
+                {
+                    stops_[i++] = c;
+                }
+            }
+            for (; i < N; ++i)
+            {
+                stops_[i] = stops_[0];
+            }
+        #if !defined(JSONCONS_HAS_AVX2) && !defined(JSONCONS_HAS_SSE2)
+            for (i = 0; i < N; ++i)
+            {
+                wstops_[i] = static_cast<uint64_t>(static_cast<unsigned char>(stops_[i])) * 0x0101010101010101ull;
+            }
+        #endif
+        }
+
+        // Returns a pointer to the first stop character in [first,last), or last if there is none
+        const CharT* find(const CharT* first, const CharT* last) const
+        {
+            return find(first, last, std::integral_constant<bool,sizeof(CharT) == 1>());
+        }
+
+    private:
+        bool is_stop(CharT c) const
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                if (c == stops_[i])
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const CharT* find_tail(const CharT* first, const CharT* last) const
+        {
+            while (first < last && !is_stop(*first))
+            {
+                ++first;
+            }
+            return first;
+        }
+
+        const CharT* find(const CharT* first, const CharT* last, std::false_type) const
+        {
+            return find_tail(first, last);
+        }
+
+    #if defined(JSONCONS_HAS_AVX2)
+        static uint32_t match32(const CharT* p, const __m256i* stops)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            __m256i matches = _mm256_cmpeq_epi8(block, stops[0]);
+            for (std::size_t i = 1; i < N; ++i)
+            {
+                matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, stops[i]));
+            }
+            return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+        }
+
+        const CharT* find(const CharT* first, const CharT* last, std::true_type) const
+        {
+            if (last - first < 32)
+            {
+                return find_tail(first, last);
+            }
+            __m256i stops[N];
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                stops[i] = _mm256_set1_epi8(static_cast<char>(stops_[i]));
+            }
+            while (last - first >= 64)
+            {
+                uint64_t mask = static_cast<uint64_t>(match32(first, stops)) | (static_cast<uint64_t>(match32(first+32, stops)) << 32);
+                if (mask != 0)
+                {
+                    return first + trailing_zeros(mask);
+                }
+                first += 64;
+            }
+            if (last - first >= 32)
+            {
+                uint32_t mask = match32(first, stops);
+                if (mask != 0)
+                {
+                    return first + trailing_zeros(mask);
+                }
+                first += 32;
+            }
+            return find_tail(first, last);
+        }
+    #elif defined(JSONCONS_HAS_SSE2)
+        static uint32_t match16(const CharT* p, const __m128i* stops)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i matches = _mm_cmpeq_epi8(block, stops[0]);
+            for (std::size_t i = 1; i < N; ++i)
+            {
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, stops[i]));
+            }
+            return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+        }
+
+        const CharT* find(const CharT* first, const CharT* last, std::true_type) const
+        {
+            if (last - first < 16)
+            {
+                return find_tail(first, last);
+            }
+            __m128i stops[N];
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                stops[i] = _mm_set1_epi8(static_cast<char>(stops_[i]));
+            }
+            // Short fields are common, probe one block before the 64 byte loop
+            {
+                uint32_t mask = match16(first, stops);
+                if (mask != 0)
+                {
+                    return first + trailing_zeros(mask);
+                }
+                first += 16;
+            }
+            while (last - first >= 64)
+            {
+                uint64_t mask = static_cast<uint64_t>(match16(first, stops))
+                    | (static_cast<uint64_t>(match16(first+16, stops)) << 16)
+                    | (static_cast<uint64_t>(match16(first+32, stops)) << 32)
+                    | (static_cast<uint64_t>(match16(first+48, stops)) << 48);
+                if (mask != 0)
+                {
+                    return first + trailing_zeros(mask);
+                }
+                first += 64;
+            }
+            while (last - first >= 16)
+            {
+                uint32_t mask = match16(first, stops);
+                if (mask != 0)
+                {
+                    return first + trailing_zeros(mask);
+                }
+                first += 16;
+            }
+            return find_tail(first, last);
+        }
+    #else
+        const CharT* find(const CharT* first, const CharT* last, std::true_type) const
+        {
+            while (last - first >= 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, first, sizeof(word));
+                uint64_t found = 0;
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    uint64_t x = word ^ wstops_[i];
+                    found |= (x - 0x0101010101010101ull) & ~x & 0x8080808080808080ull;
+                }
+                if (found != 0)
+                {
+                    break;
+                }
+                first += 8;
+            }
+            return find_tail(first, last);
+        }
+    #endif
+    };
+
+} // namespace detail
+} // namespace csv
+} // namespace jsoncons
+
+#endif // JSONCONS_CSV_CSV_SCANNER_HPP
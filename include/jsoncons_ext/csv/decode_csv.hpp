@@ -8,6 +8,8 @@
 #define JSONCONS_EXT_CSV_DECODE_CSV_HPP
 
 #include <istream>
+#include <memory>
+#include <string>
 #include <type_traits>
 
 #include <jsoncons/allocator_set.hpp>
@@ -20,36 +22,149 @@
 
 #include <jsoncons_ext/csv/csv_cursor.hpp>
 #include <jsoncons_ext/csv/csv_encoder.hpp>
+#include <jsoncons_ext/csv/csv_object_decoder.hpp>
 #include <jsoncons_ext/csv/csv_options.hpp>
 #include <jsoncons_ext/csv/csv_reader.hpp>
 
 namespace jsoncons { 
 namespace csv {
 
-template <typename T,typename CharsLike>
-typename std::enable_if<ext_traits::is_basic_json<T>::value &&
-                        ext_traits::is_sequence_of<CharsLike,typename T::char_type>::value,read_result<T>>::type 
-try_decode_csv(const CharsLike& s, const basic_csv_decode_options<typename CharsLike::value_type>& options = basic_csv_decode_options<typename CharsLike::value_type>())
-{
-    using char_type = typename CharsLike::value_type;
-    using value_type = T;
-    using result_type = read_result<value_type>;
+namespace detail {
+
+    // A sequence of types with declared conversion traits, such as std::vector<MyRow>.
+    // n_objects rows are converted to elements one at a time as they are read.
+    template <typename T,typename Enable=void>
+    struct is_csv_record_sequence : std::false_type {};
 
-    std::error_code ec;   
+    template <typename T>
+    struct is_csv_record_sequence<T,
+        typename std::enable_if<!reflect::is_json_conv_traits_declared<T>::value &&
+                                ext_traits::is_array_like<T>::value &&
+                                ext_traits::is_back_insertable<T>::value &&
+                                reflect::is_json_conv_traits_declared<typename T::value_type>::value
+    >::type> : std::true_type {};
+
+    template <typename T,typename Decoder,typename Reader>
+    read_result<T> read_csv_json(Decoder& decoder, Reader& reader)
+    {
+        using result_type = read_result<T>;
+
+        std::error_code ec;
+        reader.read(ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return result_type{jsoncons::unexpect, ec, reader.line(), reader.column()};
+        }
+        if (JSONCONS_UNLIKELY(!decoder.is_valid()))
+        {
+            return result_type{jsoncons::unexpect, conv_errc::conversion_failed, reader.line(), reader.column()};
+        }
+        return result_type{decoder.get_result()};
+    }
 
-    json_decoder<T> decoder;
+    template <typename T,typename Source,typename CharT,typename Sourceable,typename TempAlloc>
+    read_result<T> try_decode_csv_json(Sourceable&& source,
+        const basic_csv_decode_options<CharT>& options,
+        const typename T::allocator_type& alloc,
+        const TempAlloc& temp_alloc)
+    {
+        if (options.mapping_kind() == csv_mapping_kind::n_objects)
+        {
+            csv_object_decoder<T,TempAlloc> decoder(alloc, temp_alloc);
+            basic_csv_reader<CharT,Source,TempAlloc> reader(std::forward<Sourceable>(source), decoder, options, temp_alloc);
+            return read_csv_json<T>(decoder, reader);
+        }
+        json_decoder<T,TempAlloc> decoder(alloc, temp_alloc);
+        basic_csv_reader<CharT,Source,TempAlloc> reader(std::forward<Sourceable>(source), decoder, options, temp_alloc);
+        return read_csv_json<T>(decoder, reader);
+    }
 
-    basic_csv_reader<char_type,jsoncons::string_source<char_type>> reader(s,decoder,options);
-    reader.read(ec);
-    if (JSONCONS_UNLIKELY(ec))
+    template <typename T,typename CursorSource,typename ReaderSource,typename CharT,typename Sourceable,typename Alloc,typename TempAlloc>
+    read_result<T> try_decode_csv_reflect(std::false_type, 
+        const allocator_set<Alloc,TempAlloc>& aset,
+        Sourceable&& source,
+        const basic_csv_decode_options<CharT>& options)
     {
-        return result_type{jsoncons::unexpect, ec, reader.line(), reader.column()};
+        using result_type = read_result<T>;
+
+        std::error_code ec;   
+        basic_csv_cursor<CharT,CursorSource,TempAlloc> cursor(std::allocator_arg, aset.get_temp_allocator(), 
+            std::forward<Sourceable>(source), options, default_csv_parsing(), ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return result_type{jsoncons::unexpect, ec, cursor.line(), cursor.column()};
+        }
+
+        return reflect::decode_traits<T>::try_decode(aset, cursor);
     }
-    if (JSONCONS_UNLIKELY(!decoder.is_valid()))
+
+    template <typename T,typename CursorSource,typename ReaderSource,typename CharT,typename Sourceable,typename Alloc,typename TempAlloc>
+    read_result<T> try_decode_csv_reflect(std::true_type, 
+        const allocator_set<Alloc,TempAlloc>& aset,
+        Sourceable&& source,
+        const basic_csv_decode_options<CharT>& options)
     {
-        return result_type{jsoncons::unexpect, conv_errc::conversion_failed, reader.line(), reader.column()};
+        using element_type = typename T::value_type;
+        using json_type = basic_json<CharT,sorted_policy,TempAlloc>;
+        using result_type = read_result<T>;
+
+        if (options.mapping_kind() != csv_mapping_kind::n_objects)
+        {
+            return try_decode_csv_reflect<T,CursorSource,ReaderSource>(std::false_type(), aset, std::forward<Sourceable>(source), options);
+        }
+
+        T result = jsoncons::make_obj_using_allocator<T>(aset.get_allocator());
+        std::error_code conv_ec;
+        std::string message_arg;
+        std::size_t line = 0;
+        std::size_t column = 0;
+
+        csv_object_decoder<json_type,TempAlloc> decoder(
+            [&](json_type&& row, const ser_context& context) -> bool
+            {
+                auto r = row.template try_as<element_type>(aset);
+                if (JSONCONS_UNLIKELY(!r))
+                {
+                    conv_ec = r.error().code();
+                    message_arg = r.error().message_arg();
+                    line = context.line();
+                    column = context.column();
+                    return false;
+                }
+                result.push_back(std::move(*r));
+                return true;
+            }, 
+            aset.get_temp_allocator(), aset.get_temp_allocator());
+
+        basic_csv_reader<CharT,ReaderSource,TempAlloc> reader(std::forward<Sourceable>(source), decoder, options, aset.get_temp_allocator());
+        std::error_code ec;
+        reader.read(ec);
+        if (JSONCONS_UNLIKELY(conv_ec))
+        {
+            return result_type{jsoncons::unexpect, conv_ec, message_arg, line, column};
+        }
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return result_type{jsoncons::unexpect, ec, reader.line(), reader.column()};
+        }
+        if (JSONCONS_UNLIKELY(!decoder.is_valid()))
+        {
+            return result_type{jsoncons::unexpect, conv_errc::not_vector, reader.line(), reader.column()};
+        }
+        return result_type{std::move(result)};
     }
-    return result_type{decoder.get_result()};
+
+} // namespace detail
+
+template <typename T,typename CharsLike>
+typename std::enable_if<ext_traits::is_basic_json<T>::value &&
+                        ext_traits::is_sequence_of<CharsLike,typename T::char_type>::value,read_result<T>>::type 
+try_decode_csv(const CharsLike& s, const basic_csv_decode_options<typename CharsLike::value_type>& options = basic_csv_decode_options<typename CharsLike::value_type>())
+{
+    using char_type = typename CharsLike::value_type;
+
+    return detail::try_decode_csv_json<T,jsoncons::string_source<char_type>>(s, options,
+        typename T::allocator_type(), std::allocator<char>());
 }
 
 template <typename T,typename CharsLike>
@@ -58,60 +173,25 @@ typename std::enable_if<!ext_traits::is_basic_json<T>::value &&
 try_decode_csv(const CharsLike& s, const basic_csv_decode_options<typename CharsLike::value_type>& options = basic_csv_decode_options<typename CharsLike::value_type>())
 {
     using char_type = typename CharsLike::value_type;
-    using value_type = T;
-    using result_type = read_result<value_type>;
-
-    std::error_code ec;   
-
-    basic_csv_cursor<char_type> cursor(s, options, ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, cursor.line(), cursor.column()};
-    }
 
-    return reflect::decode_traits<T>::try_decode(make_alloc_set(), cursor);
+    return detail::try_decode_csv_reflect<T,jsoncons::stream_source<char_type>,jsoncons::string_source<char_type>>(
+        detail::is_csv_record_sequence<T>(), make_alloc_set(), s, options);
 }
 
 template <typename T,typename CharT>
 typename std::enable_if<ext_traits::is_basic_json<T>::value,read_result<T>>::type 
 try_decode_csv(std::basic_istream<CharT>& is, const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>())
 {
-    using char_type = CharT;
-    using value_type = T;
-    using result_type = read_result<value_type>;
-
-    std::error_code ec;   
-
-    json_decoder<T> decoder;
-
-    basic_csv_reader<char_type,jsoncons::stream_source<char_type>> reader(is,decoder,options);
-    reader.read(ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, reader.line(), reader.column()};
-    }
-    if (JSONCONS_UNLIKELY(!decoder.is_valid()))
-    {
-        return result_type{jsoncons::unexpect, conv_errc::conversion_failed, reader.line(), reader.column()};
-    }
-    return result_type{decoder.get_result()};
+    return detail::try_decode_csv_json<T,jsoncons::stream_source<CharT>>(is, options,
+        typename T::allocator_type(), std::allocator<char>());
 }
 
 template <typename T,typename CharT>
 typename std::enable_if<!ext_traits::is_basic_json<T>::value,read_result<T>>::type 
 try_decode_csv(std::basic_istream<CharT>& is, const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>())
 {
-    using value_type = T;
-    using result_type = read_result<value_type>;
-
-    std::error_code ec;   
-    basic_csv_cursor<CharT> cursor(is, options, ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, cursor.line(), cursor.column()};
-    }
-
-    return reflect::decode_traits<T>::try_decode(make_alloc_set(), cursor);
+    return detail::try_decode_csv_reflect<T,jsoncons::stream_source<CharT>,jsoncons::stream_source<CharT>>(
+        detail::is_csv_record_sequence<T>(), make_alloc_set(), is, options);
 }
 
 template <typename T,typename InputIt>
@@ -120,24 +200,8 @@ try_decode_csv(InputIt first, InputIt last,
             const basic_csv_decode_options<typename std::iterator_traits<InputIt>::value_type>& options = 
                 basic_csv_decode_options<typename std::iterator_traits<InputIt>::value_type>())
 {
-    using char_type = typename std::iterator_traits<InputIt>::value_type;
-    using value_type = T;
-    using result_type = read_result<value_type>;
-
-    std::error_code ec;   
-
-    jsoncons::json_decoder<T> decoder;
-    basic_csv_reader<char_type, iterator_source<InputIt>> reader(iterator_source<InputIt>(first,last), decoder, options);
-    reader.read(ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, reader.line(), reader.column()};
-    }
-    if (JSONCONS_UNLIKELY(!decoder.is_valid()))
-    {
-        return result_type{jsoncons::unexpect, conv_errc::conversion_failed, reader.line(), reader.column()};
-    }
-    return result_type{decoder.get_result()};
+    return detail::try_decode_csv_json<T,iterator_source<InputIt>>(iterator_source<InputIt>(first,last), options,
+        typename T::allocator_type(), std::allocator<char>());
 }
 
 template <typename T,typename InputIt>
@@ -146,19 +210,8 @@ try_decode_csv(InputIt first, InputIt last,
            const basic_csv_decode_options<typename std::iterator_traits<InputIt>::value_type>& options = 
                 basic_csv_decode_options<typename std::iterator_traits<InputIt>::value_type>())
 {
-    using char_type = typename std::iterator_traits<InputIt>::value_type;
-    using value_type = T;
-    using result_type = read_result<value_type>;
-
-    std::error_code ec;   
-
-    basic_csv_cursor<char_type,iterator_source<InputIt>> cursor(iterator_source<InputIt>(first, last), options, ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, cursor.line(), cursor.column()};
-    }
-
-    return reflect::decode_traits<T>::try_decode(make_alloc_set(), cursor);
+    return detail::try_decode_csv_reflect<T,iterator_source<InputIt>,iterator_source<InputIt>>(
+        detail::is_csv_record_sequence<T>(), make_alloc_set(), iterator_source<InputIt>(first, last), options);
 }
 
 // With leading allocator_set parameter
@@ -171,24 +224,9 @@ try_decode_csv(const allocator_set<Alloc,TempAlloc>& aset,
            const basic_csv_decode_options<typename CharsLike::value_type>& options = basic_csv_decode_options<typename CharsLike::value_type>())
 {
     using char_type = typename CharsLike::value_type;
-    using value_type = T;
-    using result_type = read_result<value_type>;
 
-    std::error_code ec;   
-
-    json_decoder<T,TempAlloc> decoder(aset.get_allocator(), aset.get_temp_allocator());
-
-    basic_csv_reader<char_type,jsoncons::string_source<char_type>,TempAlloc> reader(s,decoder,options,aset.get_temp_allocator());
-    reader.read(ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, reader.line(), reader.column()};
-    }
-    if (JSONCONS_UNLIKELY(!decoder.is_valid()))
-    {
-        return result_type{jsoncons::unexpect, conv_errc::conversion_failed, reader.line(), reader.column()};
-    }
-    return result_type{decoder.get_result()};
+    return detail::try_decode_csv_json<T,jsoncons::string_source<char_type>>(s, options,
+        aset.get_allocator(), aset.get_temp_allocator());
 }
 
 template <typename T,typename CharsLike,typename Alloc,typename TempAlloc >
@@ -199,19 +237,9 @@ try_decode_csv(const allocator_set<Alloc,TempAlloc>& aset,
            const basic_csv_decode_options<typename CharsLike::value_type>& options = basic_csv_decode_options<typename CharsLike::value_type>())
 {
     using char_type = typename CharsLike::value_type;
-    using value_type = T;
-    using result_type = read_result<value_type>;
-
-    std::error_code ec;   
 
-    basic_csv_cursor<char_type,stream_source<char_type>,TempAlloc> cursor(
-        std::allocator_arg, aset.get_temp_allocator(), s, options, ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, cursor.line(), cursor.column()};
-    }
-
-    return reflect::decode_traits<T>::try_decode(aset, cursor);
+    return detail::try_decode_csv_reflect<T,jsoncons::stream_source<char_type>,jsoncons::string_source<char_type>>(
+        detail::is_csv_record_sequence<T>(), aset, s, options);
 }
 
 template <typename T,typename CharT,typename Alloc,typename TempAlloc >
@@ -220,25 +248,8 @@ try_decode_csv(const allocator_set<Alloc,TempAlloc>& aset,
            std::basic_istream<CharT>& is, 
            const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>())
 {
-    using char_type = CharT;
-    using value_type = T;
-    using result_type = read_result<value_type>;
-
-    std::error_code ec;   
-
-    json_decoder<T,TempAlloc> decoder(aset.get_allocator(), aset.get_temp_allocator());
-
-    basic_csv_reader<char_type,jsoncons::string_source<char_type>,TempAlloc> reader(is,decoder,options,aset.get_temp_allocator());
-    reader.read(ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, reader.line(), reader.column()};
-    }
-    if (JSONCONS_UNLIKELY(!decoder.is_valid()))
-    {
-        return result_type{jsoncons::unexpect, conv_errc::conversion_failed, reader.line(), reader.column()};
-    }
-    return result_type{decoder.get_result()};
+    return detail::try_decode_csv_json<T,jsoncons::stream_source<CharT>>(is, options,
+        aset.get_allocator(), aset.get_temp_allocator());
 }
 
 template <typename T,typename CharT,typename Alloc,typename TempAlloc >
@@ -247,18 +258,8 @@ try_decode_csv(const allocator_set<Alloc,TempAlloc>& aset,
            std::basic_istream<CharT>& is, 
            const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>())
 {
-    using value_type = T;
-    using result_type = read_result<value_type>;
-
-    std::error_code ec;   
-    basic_csv_cursor<CharT,stream_source<CharT>,TempAlloc> cursor(
-        std::allocator_arg, aset.get_temp_allocator(), is, options, ec);
-    if (JSONCONS_UNLIKELY(ec))
-    {
-        return result_type{jsoncons::unexpect, ec, cursor.line(), cursor.column()};
-    }
-
-    return reflect::decode_traits<T>::try_decode(aset, cursor);
+    return detail::try_decode_csv_reflect<T,jsoncons::stream_source<CharT>,jsoncons::stream_source<CharT>>(
+        detail::is_csv_record_sequence<T>(), aset, is, options);
 }
 
 template <typename T, typename... Args>
@@ -23,6 +23,7 @@
 #include <map>
 
 #include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/utility/read_number.hpp>
 #include <jsoncons/json_decoder.hpp>
 #include <jsoncons/json_reader.hpp>
@@ -3414,6 +3415,7 @@ namespace detail {
 
             Json evaluate(reference doc, std::error_code& ec) const
             {
+                JSONCONS_INSTRUMENT_TIMER(query);
                 if (output_stack_.empty())
                 {
                     return Json::null();
@@ -3427,6 +3429,7 @@ namespace detail {
                 const std::map<string_type,Json>& params,
                 std::error_code& ec) const
             {
+                JSONCONS_INSTRUMENT_TIMER(query);
                 if (output_stack_.empty())
                 {
                     return Json::null();
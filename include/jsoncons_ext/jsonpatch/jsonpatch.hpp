@@ -9,12 +9,16 @@
 
 #include <algorithm> // std::min
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <system_error>
+#include <unordered_map>
 #include <utility> // std::move
 #include <vector> 
 
 #include <jsoncons/json_type.hpp>
+#include <jsoncons/utility/hash.hpp>
 
 #include <jsoncons_ext/jsonpatch/jsonpatch_error.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
@@ -22,6 +26,10 @@
 namespace jsoncons { 
 namespace jsonpatch {
 
+    enum class diff_options {none, lcs = 1};
+
+    enum class patch_options {none, no_undo = 1};
+
 namespace detail {
 
     template <typename CharT>
@@ -84,47 +92,11 @@ namespace detail {
         }
     };
 
-    template <typename Json>
-    jsonpointer::basic_json_pointer<typename Json::char_type> definite_path(const Json& root, jsonpointer::basic_json_pointer<typename Json::char_type>& location)
-    {
-        using char_type = typename Json::char_type;
-        using string_type = std::basic_string<char_type>;
-
-        auto rit = location.rbegin();
-        if (rit == location.rend())
-        {
-            return location;
-        }
-
-        if (*rit != jsonpatch_names<char_type>::dash_name())
-        {
-            return location;
-        }
-
-        std::vector<string_type> tokens;
-        for (auto it = location.begin(); it != location.rbegin().base()-1; ++it)
-        {
-            tokens.push_back(*it);
-        }
-        jsonpointer::basic_json_pointer<char_type> pointer(tokens);
-
-        std::error_code ec;
-
-        Json val = jsonpointer::get(root, pointer, ec);
-        if (ec || !val.is_array())
-        {
-            return location;
-        }
-        string_type last_token;
-        jsoncons::utility::from_integer(val.size(), last_token);
-        tokens.emplace_back(std::move(last_token));
-
-        return jsonpointer::basic_json_pointer<char_type>(std::move(tokens));
-    }
-
-    enum class op_type {add,remove,replace};
+    enum class op_type {add,remove,replace,move};
     enum class state_type {begin,abort,commit};
 
+    // Undo log for apply_patch. Values displaced by an operation are moved into the log rather 
+    // than copied, and the log is replayed in reverse if a later operation fails.
     template <typename Json>
     struct operation_unwinder
     {
@@ -132,14 +104,30 @@ namespace detail {
         using string_type = std::basic_string<char_type>;
         using json_pointer_type = jsonpointer::basic_json_pointer<char_type>;
 
+        // add:     insert value at path
+        // remove:  remove the value at path
+        // replace: assign value at path
+        // move:    move the value at path back to from, restoring value at path if has_value
         struct entry
         {
             op_type op;
             json_pointer_type path;
             Json value;
+            json_pointer_type from;
+            bool has_value;
 
             entry(op_type Op, const json_pointer_type& Path, const Json& Value)
-                : op(Op), path(Path), value(Value)
+                : op(Op), path(Path), value(Value), has_value(true)
+            {
+            }
+
+            entry(op_type Op, json_pointer_type&& Path, Json&& Value)
+                : op(Op), path(std::move(Path)), value(std::move(Value)), has_value(true)
+            {
+            }
+
+            entry(json_pointer_type&& Path, json_pointer_type&& From, Json&& Value, bool HasValue)
+                : op(op_type::move), path(std::move(Path)), value(std::move(Value)), from(std::move(From)), has_value(HasValue)
             {
             }
 
@@ -170,7 +158,7 @@ namespace detail {
                 {
                     if ((*it).op == op_type::add)
                     {
-                        jsonpointer::add(target,(*it).path,(*it).value,ec);
+                        jsonpointer::add(target,(*it).path,std::move((*it).value),ec);
                         if (JSONCONS_UNLIKELY(ec))
                         {
                             //std::cout << "add: " << (*it).path << '\n';
@@ -188,28 +176,215 @@ namespace detail {
                     }
                     else if ((*it).op == op_type::replace)
                     {
-                        jsonpointer::replace(target,(*it).path,(*it).value,ec);
+                        jsonpointer::replace(target,(*it).path,std::move((*it).value),ec);
                         if (JSONCONS_UNLIKELY(ec))
                         {
                             //std::cout << "replace: " << (*it).path << '\n';
                             break;
                         }
                     }
+                    else if ((*it).op == op_type::move)
+                    {
+                        Json& current = jsonpointer::get(target,(*it).path,false,ec);
+                        if (JSONCONS_UNLIKELY(ec))
+                        {
+                            break;
+                        }
+                        Json val = std::move(current);
+                        if ((*it).has_value)
+                        {
+                            current = std::move((*it).value);
+                        }
+                        else
+                        {
+                            jsonpointer::remove(target,(*it).path,ec);
+                            if (JSONCONS_UNLIKELY(ec))
+                            {
+                                break;
+                            }
+                        }
+                        jsonpointer::add(target,(*it).from,std::move(val),ec);
+                        if (JSONCONS_UNLIKELY(ec))
+                        {
+                            break;
+                        }
+                    }
                 }
             }
         }
     };
 
+    // Resolves all but the last token of a non-empty location, so that an operation 
+    // can find, add or erase the child without walking the path again
     template <typename Json>
-    Json from_diff(const Json& source, const Json& target, const typename Json::string_view_type& path)
+    Json* resolve_parent(Json& root, const jsonpointer::basic_json_pointer<typename Json::char_type>& location, std::error_code& ec)
     {
-        using char_type = typename Json::char_type;
+        Json* current = std::addressof(root);
+        auto last = location.end() - 1;
+        for (auto it = location.begin(); it != last; ++it)
+        {
+            current = jsonpointer::detail::resolve(current, *it, false, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                return nullptr;
+            }
+        }
+        return current;
+    }
 
-        Json result = typename Json::array();
+    // Adds value to parent under token, inserting into an array or adding or replacing
+    // an object member. On success value is moved from, index is set for an array, and 
+    // if a member was replaced its previous value is moved to displaced and true is returned. 
+    // On failure value is left unchanged.
+    template <typename Json>
+    bool add_child(Json& parent, const typename Json::string_view_type& token, Json& value, 
+        std::size_t& index, Json& displaced, std::error_code& ec)
+    {
+        if (parent.is_array())
+        {
+            if (token.size() == 1 && token[0] == '-')
+            {
+                index = parent.size();
+            }
+            else
+            {
+                auto result = jsoncons::utility::dec_to_integer(token.data(), token.length(), index);
+                if (!result)
+                {
+                    ec = jsonpointer::jsonpointer_errc::invalid_index;
+                    return false;
+                }
+                if (index > parent.size())
+                {
+                    ec = jsonpointer::jsonpointer_errc::index_exceeds_array_size;
+                    return false;
+                }
+            }
+            parent.insert(parent.array_range().begin()+index, std::move(value));
+            return false;
+        }
+        else if (parent.is_object())
+        {
+            auto it = parent.find(token);
+            if (it != parent.object_range().end())
+            {
+                displaced = std::move((*it).value());
+                (*it).value() = std::move(value);
+                return true;
+            }
+            parent.try_emplace(token, std::move(value));
+            return false;
+        }
+        else
+        {
+            ec = jsonpointer::jsonpointer_errc::expected_object_or_array;
+            return false;
+        }
+    }
+
+    // Moves the child of parent under token to removed and erases it
+    template <typename Json>
+    void erase_child(Json& parent, const typename Json::string_view_type& token, Json& removed, std::error_code& ec)
+    {
+        if (parent.is_array())
+        {
+            if (token.size() == 1 && token[0] == '-')
+            {
+                ec = jsonpointer::jsonpointer_errc::index_exceeds_array_size;
+                return;
+            }
+            std::size_t index{0};
+            auto result = jsoncons::utility::dec_to_integer(token.data(), token.length(), index);
+            if (!result)
+            {
+                ec = jsonpointer::jsonpointer_errc::invalid_index;
+                return;
+            }
+            if (index >= parent.size())
+            {
+                ec = jsonpointer::jsonpointer_errc::index_exceeds_array_size;
+                return;
+            }
+            removed = std::move(parent[index]);
+            parent.erase(parent.array_range().begin()+index);
+        }
+        else if (parent.is_object())
+        {
+            auto it = parent.find(token);
+            if (it == parent.object_range().end())
+            {
+                ec = jsonpointer::jsonpointer_errc::key_not_found;
+                return;
+            }
+            removed = std::move((*it).value());
+            parent.erase(it);
+        }
+        else
+        {
+            ec = jsonpointer::jsonpointer_errc::expected_object_or_array;
+        }
+    }
+
+    // The location of an added array element, with "-" replaced by its index
+    template <typename CharT>
+    jsonpointer::basic_json_pointer<CharT> element_location(const jsonpointer::basic_json_pointer<CharT>& location, std::size_t index)
+    {
+        std::vector<std::basic_string<CharT>> tokens(location.begin(), location.end() - 1);
+        std::basic_string<CharT> last_token;
+        jsoncons::utility::from_integer(index, last_token);
+        tokens.emplace_back(std::move(last_token));
+        return jsonpointer::basic_json_pointer<CharT>(std::move(tokens));
+    }
+
+    template <typename Json>
+    struct added_value
+    {
+        jsonpointer::basic_json_pointer<typename Json::char_type> path;
+        Json displaced;
+        bool has_displaced{false};
+    };
+
+    // Adds value at location in target, the JSON Patch "add". On success value is moved from, 
+    // and result describes what is needed to undo it. On failure value is left unchanged.
+    template <typename Json>
+    void add_value(Json& target, const jsonpointer::basic_json_pointer<typename Json::char_type>& location, 
+        Json& value, bool undo, added_value<Json>& result, std::error_code& ec)
+    {
+        if (location.empty())
+        {
+            if (undo)
+            {
+                result.displaced = std::move(target);
+                result.has_displaced = true;
+            }
+            target = std::move(value);
+            return;
+        }
+        Json* parent = resolve_parent(target, location, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return;
+        }
+        std::size_t index = 0;
+        result.has_displaced = add_child(*parent, *location.rbegin(), value, index, result.displaced, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return;
+        }
+        if (undo)
+        {
+            result.path = parent->is_array() ? element_location(location, index) : location;
+        }
+    }
+
+    template <typename Json>
+    void from_diff(const Json& source, const Json& target, const typename Json::string_view_type& path, Json& result)
+    {
+        using char_type = typename Json::char_type;
 
         if (source == target)
         {
-            return result;
+            return;
         }
 
         if (source.is_array() && target.is_array())
@@ -220,8 +395,7 @@ namespace detail {
                 std::basic_string<char_type> ss(path); 
                 ss.push_back('/');
                 jsoncons::utility::from_integer(i,ss);
-                auto temp_diff = from_diff(source[i],target[i],ss);
-                result.insert(result.array_range().end(),temp_diff.array_range().begin(),temp_diff.array_range().end());
+                from_diff(source[i],target[i],ss,result);
             }
             // Element in source, not in target - remove
             for (std::size_t i = source.size(); i-- > target.size();)
@@ -259,8 +433,7 @@ namespace detail {
                 auto it = target.find(a.key());
                 if (it != target.object_range().end())
                 {
-                    auto temp_diff = from_diff(a.value(),(*it).value(),ss);
-                    result.insert(result.array_range().end(),temp_diff.array_range().begin(),temp_diff.array_range().end());
+                    from_diff(a.value(),(*it).value(),ss,result);
                 }
                 else
                 {
@@ -294,14 +467,682 @@ namespace detail {
             val.insert_or_assign(jsonpatch_names<char_type>::value_name(), target);
             result.push_back(std::move(val));
         }
+    }
 
+    template <typename Json>
+    Json from_diff(const Json& source, const Json& target, const typename Json::string_view_type& path)
+    {
+        Json result = typename Json::array();
+        from_diff(source, target, path, result);
         return result;
     }
 
+    // Hashes of every array and object subtree of a document, computed once, bottom up.
+    // The children of a node are stored contiguously, in array or member order.
+    template <typename Json>
+    class diff_hash_tree
+    {
+    public:
+        struct node
+        {
+            uint64_t hash;
+            std::size_t first_child;
+        };
+    private:
+        std::vector<node> nodes_;
+    public:
+        explicit diff_hash_tree(const Json& root)
+        {
+            nodes_.push_back(node{0,0});
+            build(0, root);
+        }
+
+        const node& operator[](std::size_t index) const
+        {
+            return nodes_[index];
+        }
+    private:
+        // Gives each node the value of Json::structural_hash
+        void build(std::size_t index, const Json& val)
+        {
+            if (val.is_array())
+            {
+                std::size_t first = nodes_.size();
+                nodes_.resize(first + val.size(), node{0,0});
+                utility::array_hasher hasher;
+                std::size_t i = first;
+                for (const auto& item : val.array_range())
+                {
+                    build(i, item);
+                    hasher.add(nodes_[i].hash);
+                    ++i;
+                }
+                nodes_[index] = node{hasher.hash(), first};
+            }
+            else if (val.is_object())
+            {
+                std::size_t first = nodes_.size();
+                nodes_.resize(first + val.size(), node{0,0});
+                utility::object_hasher hasher;
+                std::size_t i = first;
+                for (const auto& member : val.object_range())
+                {
+                    build(i, member.value());
+                    hasher.add(member.key().data(), member.key().size(), nodes_[i].hash);
+                    ++i;
+                }
+                nodes_[index] = node{hasher.hash(), first};
+            }
+            else
+            {
+                nodes_[index] = node{static_cast<uint64_t>(val.hash()), 0};
+            }
+        }
+    };
+
+    enum class edit_kind {keep, remove, insert};
+
+    struct edit_step
+    {
+        edit_kind kind;
+        std::size_t source_index;
+        std::size_t target_index;
+    };
+
+    // Finds a point (x,y) on an optimal path from (0,0) to (n,m), where Myers' forward
+    // and reverse searches first overlap. vf and vb hold the furthest reaching x of each 
+    // diagonal, vb counted back from (n,m), so only O(d) memory is needed. Returns false 
+    // if more than max_distance edits turn a[0,n) into b[0,m).
+    inline bool middle_point(const uint64_t* a, std::ptrdiff_t n, const uint64_t* b, std::ptrdiff_t m, 
+        std::ptrdiff_t max_distance, std::vector<std::ptrdiff_t>& vf, std::vector<std::ptrdiff_t>& vb,
+        std::ptrdiff_t& x, std::ptrdiff_t& y)
+    {
+        const std::ptrdiff_t max_d = ((std::min)(n + m, max_distance) + 1) / 2;
+        vf.assign(2*static_cast<std::size_t>(max_d) + 2, -1);
+        vb.assign(2*static_cast<std::size_t>(max_d) + 2, -1);
+        // Indexed by diagonal k = x - y, from -max_d to max_d + 1
+        std::ptrdiff_t* f = vf.data() + max_d;
+        std::ptrdiff_t* r = vb.data() + max_d;
+        f[1] = 0;
+        r[1] = 0;
+        const std::ptrdiff_t delta = n - m;
+        const bool odd = (delta % 2) != 0;
+        // Diagonals that leave the grid are not extended again
+        std::ptrdiff_t f_start = 0;
+        std::ptrdiff_t f_end = 0;
+        std::ptrdiff_t r_start = 0;
+        std::ptrdiff_t r_end = 0;
+
+        for (std::ptrdiff_t d = 0; d <= max_d; ++d)
+        {
+            for (std::ptrdiff_t k = -d + f_start; k <= d - f_end; k += 2)
+            {
+                std::ptrdiff_t fx = (k == -d || (k != d && f[k-1] < f[k+1])) ? f[k+1] : f[k-1] + 1;
+                std::ptrdiff_t fy = fx - k;
+                while (fx < n && fy < m && a[fx] == b[fy])
+                {
+                    ++fx;
+                    ++fy;
+                }
+                f[k] = fx;
+                if (fx > n)
+                {
+                    f_end += 2;
+                }
+                else if (fy > m)
+                {
+                    f_start += 2;
+                }
+                else if (odd)
+                {
+                    const std::ptrdiff_t rk = delta - k;
+                    if (rk >= -max_d && rk <= max_d + 1 && r[rk] != -1 && fx >= n - r[rk])
+                    {
+                        if (2*d - 1 > max_distance)
+                        {
+                            return false;
+                        }
+                        x = fx;
+                        y = fy;
+                        return true;
+                    }
+                }
+            }
+            for (std::ptrdiff_t k = -d + r_start; k <= d - r_end; k += 2)
+            {
+                std::ptrdiff_t rx = (k == -d || (k != d && r[k-1] < r[k+1])) ? r[k+1] : r[k-1] + 1;
+                std::ptrdiff_t ry = rx - k;
+                while (rx < n && ry < m && a[n-rx-1] == b[m-ry-1])
+                {
+                    ++rx;
+                    ++ry;
+                }
+                r[k] = rx;
+                if (rx > n)
+                {
+                    r_end += 2;
+                }
+                else if (ry > m)
+                {
+                    r_start += 2;
+                }
+                else if (!odd)
+                {
+                    const std::ptrdiff_t fk = delta - k;
+                    if (fk >= -max_d && fk <= max_d + 1 && f[fk] != -1 && f[fk] >= n - rx)
+                    {
+                        if (2*d > max_distance)
+                        {
+                            return false;
+                        }
+                        x = f[fk];
+                        y = x - fk;
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // Appends the steps that turn a[0,n) into b[0,m) to steps, dividing at the middle
+    // point until what is left is only kept, removed or inserted
+    inline bool append_edit_steps(const uint64_t* a, std::ptrdiff_t n, const uint64_t* b, std::ptrdiff_t m, 
+        std::size_t a_offset, std::size_t b_offset, std::ptrdiff_t max_distance, 
+        std::vector<std::ptrdiff_t>& vf, std::vector<std::ptrdiff_t>& vb, std::vector<edit_step>& steps)
+    {
+        std::ptrdiff_t prefix = 0;
+        while (prefix < n && prefix < m && a[prefix] == b[prefix])
+        {
+            steps.push_back(edit_step{edit_kind::keep, a_offset + static_cast<std::size_t>(prefix), b_offset + static_cast<std::size_t>(prefix)});
+            ++prefix;
+        }
+        std::ptrdiff_t suffix = 0;
+        while (suffix < n - prefix && suffix < m - prefix && a[n-1-suffix] == b[m-1-suffix])
+        {
+            ++suffix;
+        }
+        const std::ptrdiff_t middle_n = n - prefix - suffix;
+        const std::ptrdiff_t middle_m = m - prefix - suffix;
+        const std::size_t first_a = a_offset + static_cast<std::size_t>(prefix);
+        const std::size_t first_b = b_offset + static_cast<std::size_t>(prefix);
+
+        if (middle_n == 0 || middle_m == 0)
+        {
+            if (middle_n + middle_m > max_distance)
+            {
+                return false;
+            }
+            for (std::ptrdiff_t i = 0; i < middle_n; ++i)
+            {
+                steps.push_back(edit_step{edit_kind::remove, first_a + static_cast<std::size_t>(i), 0});
+            }
+            for (std::ptrdiff_t j = 0; j < middle_m; ++j)
+            {
+                steps.push_back(edit_step{edit_kind::insert, 0, first_b + static_cast<std::size_t>(j)});
+            }
+        }
+        else
+        {
+            std::ptrdiff_t x = 0;
+            std::ptrdiff_t y = 0;
+            if (!middle_point(a + prefix, middle_n, b + prefix, middle_m, max_distance, vf, vb, x, y))
+            {
+                return false;
+            }
+            append_edit_steps(a + prefix, x, b + prefix, y, first_a, first_b, max_distance, vf, vb, steps);
+            append_edit_steps(a + prefix + x, middle_n - x, b + prefix + y, middle_m - y, 
+                first_a + static_cast<std::size_t>(x), first_b + static_cast<std::size_t>(y), max_distance, vf, vb, steps);
+        }
+        for (std::ptrdiff_t i = n - suffix; i < n; ++i)
+        {
+            steps.push_back(edit_step{edit_kind::keep, a_offset + static_cast<std::size_t>(i), b_offset + static_cast<std::size_t>(i - n + m)});
+        }
+        return true;
+    }
+
+    // Appends to script the shortest edit script that turns a[0,n) into b[0,m), using
+    // the linear space variant of Myers' O((n+m)d) algorithm. Returns false, leaving 
+    // script unchanged, if the edit distance exceeds max_distance.
+    inline bool shortest_edit_script(const uint64_t* a, std::size_t n, const uint64_t* b, std::size_t m, 
+        std::size_t a_offset, std::size_t b_offset, std::size_t max_distance, std::vector<edit_step>& script)
+    {
+        std::vector<std::ptrdiff_t> vf;
+        std::vector<std::ptrdiff_t> vb;
+        std::vector<edit_step> steps;
+        const std::ptrdiff_t max_d = static_cast<std::ptrdiff_t>((std::min)(n + m, max_distance));
+        if (!append_edit_steps(a, static_cast<std::ptrdiff_t>(n), b, static_cast<std::ptrdiff_t>(m), 
+            a_offset, b_offset, max_d, vf, vb, steps))
+        {
+            return false;
+        }
+        script.insert(script.end(), steps.begin(), steps.end());
+        return true;
+    }
+
+    // Counts the elements present before a position, as elements are removed and inserted
+    class presence_counter
+    {
+        std::vector<std::ptrdiff_t> tree_;
+    public:
+        explicit presence_counter(std::size_t n)
+            : tree_(n + 1, 0)
+        {
+        }
+
+        void update(std::size_t pos, std::ptrdiff_t delta)
+        {
+            for (std::size_t i = pos + 1; i < tree_.size(); i += i & (~i + 1))
+            {
+                tree_[i] += delta;
+            }
+        }
+
+        // Number of present elements at positions [0,pos)
+        std::size_t count_before(std::size_t pos) const
+        {
+            std::ptrdiff_t sum = 0;
+            for (std::size_t i = pos; i > 0; i -= i & (~i + 1))
+            {
+                sum += tree_[i];
+            }
+            return static_cast<std::size_t>(sum);
+        }
+    };
+
+    template <typename Json>
+    class lcs_differ
+    {
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename Json::string_view_type;
+
+        enum class slot_kind {keep, pair, remove, move_from, add, copy, move_to};
+
+        struct slot
+        {
+            slot_kind kind;
+            std::size_t source_index;
+            std::size_t target_index;
+            std::size_t other; // source slot of a move, kept slot of a copy
+        };
+
+        // Arrays whose middle section needs more edits than this are diffed by position
+        static constexpr std::size_t max_edit_distance = 1024;
+
+        diff_hash_tree<Json> source_tree_;
+        diff_hash_tree<Json> target_tree_;
+        Json& result_;
+    public:
+        lcs_differ(const Json& source, const Json& target, Json& result)
+            : source_tree_(source), target_tree_(target), result_(result)
+        {
+        }
+
+        void diff(const Json& source, std::size_t source_node, const Json& target, std::size_t target_node, 
+            const string_view_type& path)
+        {
+            // Equal values have equal hashes, so a deep compare is only needed when the hashes match
+            if (source_tree_[source_node].hash == target_tree_[target_node].hash && source == target)
+            {
+                return;
+            }
+
+            if (source.is_array() && target.is_array())
+            {
+                diff_arrays(source, source_node, target, target_node, path);
+            }
+            else if (source.is_object() && target.is_object())
+            {
+                std::size_t first_source = source_tree_[source_node].first_child;
+                std::size_t first_target = target_tree_[target_node].first_child;
+                auto target_begin = target.object_range().begin();
+
+                std::size_t i = 0;
+                for (const auto& a : source.object_range())
+                {
+                    string_type ss(path);
+                    ss.push_back('/'); 
+                    jsonpointer::escape(a.key(),ss);
+                    auto it = target.find(a.key());
+                    if (it != target.object_range().end())
+                    {
+                        std::size_t j = static_cast<std::size_t>(it - target_begin);
+                        diff(a.value(), first_source + i, (*it).value(), first_target + j, ss);
+                    }
+                    else
+                    {
+                        result_.push_back(make_op(jsonpatch_names<char_type>::remove_name(), ss));
+                    }
+                    ++i;
+                }
+                for (const auto& a : target.object_range())
+                {
+                    if (!source.contains(a.key()))
+                    {
+                        string_type ss(path); 
+                        ss.push_back('/');
+                        jsonpointer::escape(a.key(),ss);
+                        Json val = make_op(jsonpatch_names<char_type>::add_name(), ss);
+                        val.insert_or_assign(jsonpatch_names<char_type>::value_name(), a.value());
+                        result_.push_back(std::move(val));
+                    }
+                }
+            }
+            else
+            {
+                Json val = make_op(jsonpatch_names<char_type>::replace_name(), path);
+                val.insert_or_assign(jsonpatch_names<char_type>::value_name(), target);
+                result_.push_back(std::move(val));
+            }
+        }
+
+    private:
+        static Json make_op(const string_type& op, const string_view_type& path)
+        {
+            Json val(json_object_arg);
+            val.insert_or_assign(jsonpatch_names<char_type>::op_name(), op);
+            val.insert_or_assign(jsonpatch_names<char_type>::path_name(), path);
+            return val;
+        }
+
+        static string_type element_path(const string_view_type& path, std::size_t index)
+        {
+            string_type ss(path);
+            ss.push_back('/');
+            jsoncons::utility::from_integer(index, ss);
+            return ss;
+        }
+
+        void diff_arrays(const Json& source, std::size_t source_node, const Json& target, std::size_t target_node, 
+            const string_view_type& path)
+        {
+            const std::size_t n = source.size();
+            const std::size_t m = target.size();
+            const std::size_t first_source = source_tree_[source_node].first_child;
+            const std::size_t first_target = target_tree_[target_node].first_child;
+
+            std::vector<uint64_t> a(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                a[i] = source_tree_[first_source + i].hash;
+            }
+            std::vector<uint64_t> b(m);
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                b[j] = target_tree_[first_target + j].hash;
+            }
+
+            // Common prefix and suffix
+            std::size_t prefix = 0;
+            while (prefix < n && prefix < m && a[prefix] == b[prefix])
+            {
+                ++prefix;
+            }
+            std::size_t suffix = 0;
+            while (suffix < n - prefix && suffix < m - prefix && a[n-1-suffix] == b[m-1-suffix])
+            {
+                ++suffix;
+            }
+
+            std::vector<edit_step> script;
+            for (std::size_t i = 0; i < prefix; ++i)
+            {
+                script.push_back(edit_step{edit_kind::keep, i, i});
+            }
+            const std::size_t middle_n = n - prefix - suffix;
+            const std::size_t middle_m = m - prefix - suffix;
+            if (!shortest_edit_script(a.data() + prefix, middle_n, b.data() + prefix, middle_m, 
+                prefix, prefix, max_edit_distance, script))
+            {
+                for (std::size_t i = 0; i < middle_n; ++i)
+                {
+                    script.push_back(edit_step{edit_kind::remove, prefix + i, 0});
+                }
+                for (std::size_t j = 0; j < middle_m; ++j)
+                {
+                    script.push_back(edit_step{edit_kind::insert, 0, prefix + j});
+                }
+            }
+            for (std::size_t i = 0; i < suffix; ++i)
+            {
+                script.push_back(edit_step{edit_kind::keep, n - suffix + i, m - suffix + i});
+            }
+
+            // An element removed in one place and inserted in another becomes a move
+            const std::size_t none = (std::numeric_limits<std::size_t>::max)();
+            std::vector<std::size_t> move_source(script.size(), none);
+            std::vector<bool> is_move_source(script.size(), false);
+            {
+                std::unordered_multimap<uint64_t,std::size_t> removed;
+                for (std::size_t i = 0; i < script.size(); ++i)
+                {
+                    if (script[i].kind == edit_kind::remove)
+                    {
+                        removed.emplace(a[script[i].source_index], i);
+                    }
+                }
+                if (!removed.empty())
+                {
+                    for (std::size_t i = 0; i < script.size(); ++i)
+                    {
+                        if (script[i].kind != edit_kind::insert)
+                        {
+                            continue;
+                        }
+                        auto range = removed.equal_range(b[script[i].target_index]);
+                        for (auto it = range.first; it != range.second; ++it)
+                        {
+                            if (source[script[it->second].source_index] == target[script[i].target_index])
+                            {
+                                move_source[i] = it->second;
+                                is_move_source[it->second] = true;
+                                removed.erase(it);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Lay out slots in an order that is source order for the elements initially present, 
+            // and target order for the elements finally present. Within a run of changes, 
+            // removed elements are paired with inserted elements and diffed in place. 
+            std::vector<slot> slots;
+            slots.reserve(script.size());
+            std::vector<std::size_t> script_slot(script.size(), none);
+            std::size_t pos = 0;
+            while (pos < script.size())
+            {
+                if (script[pos].kind == edit_kind::keep)
+                {
+                    script_slot[pos] = slots.size();
+                    slots.push_back(slot{slot_kind::keep, script[pos].source_index, script[pos].target_index, none});
+                    ++pos;
+                    continue;
+                }
+                std::size_t end = pos;
+                while (end < script.size() && script[end].kind != edit_kind::keep)
+                {
+                    ++end;
+                }
+
+                std::vector<std::size_t> pair_targets;
+                std::size_t removable = 0;
+                for (std::size_t i = pos; i < end; ++i)
+                {
+                    if (script[i].kind == edit_kind::remove && !is_move_source[i])
+                    {
+                        ++removable;
+                    }
+                }
+                for (std::size_t i = pos; i < end && pair_targets.size() < removable; ++i)
+                {
+                    if (script[i].kind == edit_kind::insert)
+                    {
+                        if (move_source[i] != none)
+                        {
+                            break;
+                        }
+                        pair_targets.push_back(i);
+                    }
+                }
+
+                std::size_t paired = 0;
+                for (std::size_t i = pos; i < end; ++i)
+                {
+                    if (script[i].kind != edit_kind::remove)
+                    {
+                        continue;
+                    }
+                    script_slot[i] = slots.size();
+                    if (is_move_source[i])
+                    {
+                        slots.push_back(slot{slot_kind::move_from, script[i].source_index, 0, none});
+                    }
+                    else if (paired < pair_targets.size())
+                    {
+                        slots.push_back(slot{slot_kind::pair, script[i].source_index, script[pair_targets[paired]].target_index, none});
+                        ++paired;
+                    }
+                    else
+                    {
+                        slots.push_back(slot{slot_kind::remove, script[i].source_index, 0, none});
+                    }
+                }
+                for (std::size_t i = pos; i < end; ++i)
+                {
+                    if (script[i].kind != edit_kind::insert)
+                    {
+                        continue;
+                    }
+                    if (std::find(pair_targets.begin(), pair_targets.end(), i) != pair_targets.end())
+                    {
+                        continue;
+                    }
+                    script_slot[i] = slots.size();
+                    if (move_source[i] != none)
+                    {
+                        slots.push_back(slot{slot_kind::move_to, 0, script[i].target_index, move_source[i]});
+                    }
+                    else
+                    {
+                        slots.push_back(slot{slot_kind::add, 0, script[i].target_index, none});
+                    }
+                }
+                pos = end;
+            }
+
+            // An inserted array or object equal to a kept element becomes a copy
+            std::unordered_multimap<uint64_t,std::size_t> kept;
+            for (std::size_t k = 0; k < slots.size(); ++k)
+            {
+                auto& s = slots[k];
+                if (s.kind == slot_kind::move_to)
+                {
+                    s.other = script_slot[s.other];
+                }
+                else if (s.kind == slot_kind::add && (target[s.target_index].is_array() || target[s.target_index].is_object()) && !target[s.target_index].empty())
+                {
+                    if (kept.empty())
+                    {
+                        for (std::size_t i = 0; i < slots.size(); ++i)
+                        {
+                            if (slots[i].kind == slot_kind::keep)
+                            {
+                                kept.emplace(b[slots[i].target_index], i);
+                            }
+                        }
+                    }
+                    auto range = kept.equal_range(b[s.target_index]);
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        if (target[slots[it->second].target_index] == target[s.target_index])
+                        {
+                            s.kind = slot_kind::copy;
+                            s.other = it->second;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            presence_counter present(slots.size());
+            for (std::size_t k = 0; k < slots.size(); ++k)
+            {
+                switch (slots[k].kind)
+                {
+                    case slot_kind::keep:
+                    case slot_kind::pair:
+                    case slot_kind::remove:
+                    case slot_kind::move_from:
+                        present.update(k, 1);
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            for (std::size_t k = 0; k < slots.size(); ++k)
+            {
+                const auto& s = slots[k];
+                switch (s.kind)
+                {
+                    case slot_kind::keep:
+                    case slot_kind::pair:
+                        diff(source[s.source_index], first_source + s.source_index, 
+                             target[s.target_index], first_target + s.target_index, 
+                             element_path(path, present.count_before(k)));
+                        break;
+                    case slot_kind::remove:
+                        result_.push_back(make_op(jsonpatch_names<char_type>::remove_name(), element_path(path, present.count_before(k))));
+                        present.update(k, -1);
+                        break;
+                    case slot_kind::move_from:
+                        break;
+                    case slot_kind::add:
+                    {
+                        Json val = make_op(jsonpatch_names<char_type>::add_name(), element_path(path, present.count_before(k)));
+                        val.insert_or_assign(jsonpatch_names<char_type>::value_name(), target[s.target_index]);
+                        result_.push_back(std::move(val));
+                        present.update(k, 1);
+                        break;
+                    }
+                    case slot_kind::copy:
+                    {
+                        Json val = make_op(jsonpatch_names<char_type>::copy_name(), element_path(path, present.count_before(k)));
+                        val.insert_or_assign(jsonpatch_names<char_type>::from_name(), element_path(path, present.count_before(s.other)));
+                        result_.push_back(std::move(val));
+                        present.update(k, 1);
+                        break;
+                    }
+                    case slot_kind::move_to:
+                    {
+                        // The from location is removed before the path location is evaluated
+                        std::size_t from = present.count_before(s.other);
+                        present.update(s.other, -1);
+                        std::size_t to = present.count_before(k);
+                        present.update(k, 1);
+                        if (from != to)
+                        {
+                            Json val = make_op(jsonpatch_names<char_type>::move_name(), element_path(path, to));
+                            val.insert_or_assign(jsonpatch_names<char_type>::from_name(), element_path(path, from));
+                            result_.push_back(std::move(val));
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    template <typename Json>
+    constexpr std::size_t lcs_differ<Json>::max_edit_distance;
+
 } // namespace detail
 
 template <typename Json>
-void apply_patch(Json& target, const Json& patch, std::error_code& ec)
+void apply_patch(Json& target, const Json& patch, patch_options options, std::error_code& ec)
 {
     if (!patch.is_array())
     {
@@ -313,8 +1154,9 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
     using string_type = std::basic_string<char_type>;
     using json_pointer_type = jsonpointer::basic_json_pointer<char_type>;
 
-   jsoncons::jsonpatch::detail::operation_unwinder<Json> unwinder(target);
-   std::error_code local_ec;
+    const bool undo = options != patch_options::no_undo;
+    jsoncons::jsonpatch::detail::operation_unwinder<Json> unwinder(target);
+    std::error_code local_ec;
 
     // Validate  
      
@@ -349,7 +1191,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
 
         if (op ==jsoncons::jsonpatch::detail::jsonpatch_names<char_type>::test_name())
         {
-            Json val = jsonpointer::get(target,location,local_ec);
+            const Json& val = jsonpointer::get(static_cast<const Json&>(target),location,local_ec);
             if (local_ec)
             {
                 ec = jsonpatch_errc::test_failed;
@@ -380,56 +1222,54 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
                 return;
             }
             Json val = it_value->value();
-            auto npath = jsonpatch::detail::definite_path(target,location);
-
-            std::error_code insert_ec;
-            jsonpointer::add_if_absent(target,npath,val,insert_ec); // try insert without replace
-            if (insert_ec) // try a replace
+            detail::added_value<Json> added;
+            detail::add_value(target, location, val, undo, added, local_ec);
+            if (local_ec)
             {
-                std::error_code select_ec;
-                Json orig_val = jsonpointer::get(target,npath,select_ec);
-                if (select_ec) // shouldn't happen
+                ec = jsonpatch_errc::add_failed;
+                unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                return;
+            }
+            if (undo)
+            {
+                if (added.has_displaced)
                 {
-                    ec = jsonpatch_errc::add_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                    return;
+                    unwinder.stack.emplace_back(detail::op_type::replace,std::move(added.path),std::move(added.displaced));
                 }
-                std::error_code replace_ec;
-                jsonpointer::replace(target,npath,val,replace_ec);
-                if (replace_ec)
+                else
                 {
-                    ec = jsonpatch_errc::add_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                    return;
+                    unwinder.stack.emplace_back(detail::op_type::remove,std::move(added.path),Json::null());
                 }
-                unwinder.stack.emplace_back(detail::op_type::replace,npath,orig_val);
-            }
-            else // insert without replace succeeded
-            {
-                unwinder.stack.emplace_back(detail::op_type::remove,npath,Json::null());
             }
         }
         else if (op ==jsoncons::jsonpatch::detail::jsonpatch_names<char_type>::remove_name())
         {
-            Json val = jsonpointer::get(target,location,local_ec);
-            if (local_ec)
+            if (location.empty())
             {
                 ec = jsonpatch_errc::remove_failed;
                 unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
                 return;
             }
-            jsonpointer::remove(target,location,local_ec);
+            Json* parent = detail::resolve_parent(target, location, local_ec);
+            Json val;
+            if (!local_ec)
+            {
+                detail::erase_child(*parent, *location.rbegin(), val, local_ec);
+            }
             if (local_ec)
             {
                 ec = jsonpatch_errc::remove_failed;
                 unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
                 return;
             }
-            unwinder.stack.emplace_back(detail::op_type::add, location, val);
+            if (undo)
+            {
+                unwinder.stack.emplace_back(detail::op_type::add, std::move(location), std::move(val));
+            }
         }
         else if (op ==jsoncons::jsonpatch::detail::jsonpatch_names<char_type>::replace_name())
         {
-            Json val = jsonpointer::get(target,location,local_ec);
+            Json& current = jsonpointer::get(target,location,false,local_ec);
             if (local_ec)
             {
                 ec = jsonpatch_errc::replace_failed;
@@ -443,14 +1283,11 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
                 unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
                 return;
             }
-            jsonpointer::replace(target, location, it_value->value(), local_ec);
-            if (local_ec)
+            if (undo)
             {
-                ec = jsonpatch_errc::replace_failed;
-                unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                return;
+                unwinder.stack.emplace_back(detail::op_type::replace,std::move(location),std::move(current));
             }
-            unwinder.stack.emplace_back(detail::op_type::replace,location,val);
+            current = it_value->value();
         }
         else if (op ==jsoncons::jsonpatch::detail::jsonpatch_names<char_type>::move_name())
         {
@@ -469,49 +1306,41 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
                 unwinder.state = jsoncons::jsonpatch::detail::state_type::abort;
                 return;
             }
-
-            Json val = jsonpointer::get(target, from_pointer, local_ec);
-            if (local_ec)
+            if (from_pointer.empty())
             {
                 ec = jsonpatch_errc::move_failed;
                 unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
                 return;
             }
-            jsonpointer::remove(target, from_pointer, local_ec);
+
+            Json* from_parent = detail::resolve_parent(target, from_pointer, local_ec);
+            Json val;
+            if (!local_ec)
+            {
+                detail::erase_child(*from_parent, *from_pointer.rbegin(), val, local_ec);
+            }
             if (local_ec)
             {
                 ec = jsonpatch_errc::move_failed;
                 unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
                 return;
             }
-            unwinder.stack.emplace_back(detail::op_type::add, from_pointer, val);
             // add
-            std::error_code insert_ec;
-            auto npath = jsonpatch::detail::definite_path(target,location);
-            jsonpointer::add_if_absent(target,npath,val,insert_ec); // try insert without replace
-            if (insert_ec) // try a replace
+            detail::added_value<Json> added;
+            detail::add_value(target, location, val, undo, added, local_ec);
+            if (local_ec)
             {
-                std::error_code select_ec;
-                Json orig_val = jsonpointer::get(target,npath,select_ec);
-                if (select_ec) // shouldn't happen
+                if (undo)
                 {
-                    ec = jsonpatch_errc::copy_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                    return;
+                    unwinder.stack.emplace_back(detail::op_type::add, std::move(from_pointer), std::move(val));
                 }
-                std::error_code replace_ec;
-                jsonpointer::replace(target, npath, val, replace_ec);
-                if (replace_ec)
-                {
-                    ec = jsonpatch_errc::copy_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                    return;
-                }
-                unwinder.stack.emplace_back(jsoncons::jsonpatch::detail::op_type::replace,npath,orig_val);
+                ec = jsonpatch_errc::copy_failed;
+                unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                return;
             }
-            else
+            if (undo)
             {
-                unwinder.stack.emplace_back(detail::op_type::remove,npath,Json::null());
+                unwinder.stack.emplace_back(std::move(added.path), std::move(from_pointer), std::move(added.displaced), added.has_displaced);
             }
         }
         else if (op ==jsoncons::jsonpatch::detail::jsonpatch_names<char_type>::copy_name())
@@ -524,7 +1353,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
                 return;
             }
             string_type from = it_from->value().as_string();
-            Json val = jsonpointer::get(target,from,local_ec);
+            Json val = jsonpointer::get(static_cast<const Json&>(target),from,local_ec);
             if (local_ec)
             {
                 ec = jsonpatch_errc::copy_failed;
@@ -532,32 +1361,24 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
                 return;
             }
             // add
-            auto npath = jsonpatch::detail::definite_path(target,location);
-            std::error_code insert_ec;
-            jsonpointer::add_if_absent(target,npath,val,insert_ec); // try insert without replace
-            if (insert_ec) // Failed, try a replace
+            detail::added_value<Json> added;
+            detail::add_value(target, location, val, undo, added, local_ec);
+            if (local_ec)
             {
-                std::error_code select_ec;
-                Json orig_val = jsonpointer::get(target,npath, select_ec);
-                if (select_ec) // shouldn't happen
+                ec = jsonpatch_errc::copy_failed;
+                unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                return;
+            }
+            if (undo)
+            {
+                if (added.has_displaced)
                 {
-                    ec = jsonpatch_errc::copy_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                    return;
+                    unwinder.stack.emplace_back(detail::op_type::replace,std::move(added.path),std::move(added.displaced));
                 }
-                std::error_code replace_ec;
-                jsonpointer::replace(target, npath, val,replace_ec);
-                if (replace_ec)
+                else
                 {
-                    ec = jsonpatch_errc::copy_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                    return;
+                    unwinder.stack.emplace_back(detail::op_type::remove,std::move(added.path),Json::null());
                 }
-                unwinder.stack.emplace_back(jsoncons::jsonpatch::detail::op_type::replace,npath,orig_val);
-            }
-            else
-            {
-                unwinder.stack.emplace_back(detail::op_type::remove,npath,Json::null());
             }
         }
     }
@@ -567,6 +1388,12 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
     }
 }
 
+template <typename Json>
+void apply_patch(Json& target, const Json& patch, std::error_code& ec)
+{
+    apply_patch(target, patch, patch_options::none, ec);
+}
+
 template <typename Json>
 Json from_diff(const Json& source, const Json& target)
 {
@@ -574,6 +1401,21 @@ Json from_diff(const Json& source, const Json& target)
     return jsoncons::jsonpatch::detail::from_diff(source, target, path);
 }
 
+template <typename Json>
+Json from_diff(const Json& source, const Json& target, diff_options options)
+{
+    if (options == diff_options::none)
+    {
+        return from_diff(source, target);
+    }
+
+    std::basic_string<typename Json::char_type> path;
+    Json result = typename Json::array();
+    jsoncons::jsonpatch::detail::lcs_differ<Json> differ(source, target, result);
+    differ.diff(source, 0, target, 0, path);
+    return result;
+}
+
 template <typename Json>
 void apply_patch(Json& target, const Json& patch)
 {
@@ -585,6 +1427,17 @@ void apply_patch(Json& target, const Json& patch)
     }
 }
 
+template <typename Json>
+void apply_patch(Json& target, const Json& patch, patch_options options)
+{
+    std::error_code ec;
+    apply_patch(target, patch, options, ec);
+    if (JSONCONS_UNLIKELY(ec))
+    {
+        JSONCONS_THROW(jsonpatch_error(ec));
+    }
+}
+
 } // namespace jsonpatch
 } // namespace jsoncons
 
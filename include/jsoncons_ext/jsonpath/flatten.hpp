@@ -10,11 +10,14 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <system_error>
+#include <vector>
 
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/utility/read_number.hpp>
 #include <jsoncons/utility/write_number.hpp>
 #include <jsoncons/json_type.hpp>
+#include <jsoncons/json_visitor.hpp>
 #include <jsoncons/semantic_tag.hpp>
 
 #include <jsoncons_ext/jsonpath/jsonpath_error.hpp>
@@ -92,6 +95,248 @@ namespace jsonpath {
         return result;
     }
 
+    // basic_flatten_visitor
+
+    // Turns the events of each document into the events of its flattened form, as 
+    // computed by flatten: an object with a member for each leaf value, keyed by the 
+    // normalized path to that value. Empty arrays and objects are leaves.
+    template <typename CharT>
+    class basic_flatten_visitor : public basic_json_visitor<CharT>
+    {
+    public:
+        using typename basic_json_visitor<CharT>::char_type;
+        using typename basic_json_visitor<CharT>::string_view_type;
+        using string_type = std::basic_string<char_type>;
+    private:
+        struct frame
+        {
+            std::size_t path_length; // length of the pointer to the container
+            std::size_t count;       // number of values seen
+            bool is_object;
+            semantic_tag tag;
+
+            frame(std::size_t path_length, bool is_object, semantic_tag tag)
+                : path_length(path_length), count(0), is_object(is_object), tag(tag)
+            {
+            }
+        };
+
+        basic_json_visitor<char_type>* destination_;
+        string_type path_;
+        std::vector<frame> stack_;
+    public:
+        explicit basic_flatten_visitor(basic_json_visitor<char_type>& destination)
+            : destination_(std::addressof(destination))
+        {
+        }
+
+        basic_json_visitor<char_type>& destination()
+        {
+            return *destination_;
+        }
+
+        void reset()
+        {
+            path_.clear();
+            stack_.clear();
+        }
+
+    private:
+        // Sets path_ to the location of the next value
+        void next_value()
+        {
+            if (stack_.empty())
+            {
+                path_.assign(1, '$');
+                return;
+            }
+            frame& f = stack_.back();
+            if (!f.is_object)
+            {
+                path_.resize(f.path_length);
+                path_.push_back('[');
+                jsoncons::utility::from_integer(f.count, path_);
+                path_.push_back(']');
+            }
+            ++f.count;
+        }
+
+        void begin_leaf(const ser_context& context, std::error_code& ec)
+        {
+            bool top = stack_.empty();
+            next_value();
+            if (top)
+            {
+                destination_->begin_object(semantic_tag::none, context, ec);
+            }
+            destination_->key(path_, context, ec);
+        }
+
+        void end_leaf(const ser_context& context, std::error_code& ec)
+        {
+            if (stack_.empty())
+            {
+                destination_->end_object(context, ec);
+            }
+        }
+
+        void begin_container(bool is_object, semantic_tag tag, const ser_context& context, std::error_code& ec)
+        {
+            bool top = stack_.empty();
+            next_value();
+            if (top)
+            {
+                destination_->begin_object(semantic_tag::none, context, ec);
+            }
+            stack_.emplace_back(path_.size(), is_object, tag);
+        }
+
+        void end_container(const ser_context& context, std::error_code& ec)
+        {
+            JSONCONS_ASSERT(!stack_.empty());
+            frame f = stack_.back();
+            stack_.pop_back();
+            if (f.count == 0)
+            {
+                path_.resize(f.path_length);
+                destination_->key(path_, context, ec);
+                if (f.is_object)
+                {
+                    destination_->begin_object(f.tag, context, ec);
+                    destination_->end_object(context, ec);
+                }
+                else
+                {
+                    destination_->begin_array(f.tag, context, ec);
+                    destination_->end_array(context, ec);
+                }
+            }
+            if (stack_.empty())
+            {
+                destination_->end_object(context, ec);
+            }
+        }
+
+        void visit_flush() override
+        {
+            destination_->flush();
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_container(true, tag, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context& context, std::error_code& ec) override
+        {
+            end_container(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_container(false, tag, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context& context, std::error_code& ec) override
+        {
+            end_container(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            JSONCONS_ASSERT(!stack_.empty());
+            path_.resize(stack_.back().path_length);
+            path_.push_back('[');
+            path_.push_back('\'');
+            escape_string(name.data(), name.length(), path_);
+            path_.push_back('\'');
+            path_.push_back(']');
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->null_value(tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->bool_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->string_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value, semantic_tag tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->byte_string_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value, uint64_t ext_tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->byte_string_value(value, ext_tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->uint64_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->int64_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_half(uint16_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->half_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->double_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+    using flatten_visitor = basic_flatten_visitor<char>;
+    using wflatten_visitor = basic_flatten_visitor<wchar_t>;
+
     enum class unflatten_state 
     {
         start,
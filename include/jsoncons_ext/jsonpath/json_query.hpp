@@ -10,6 +10,7 @@
 #include <type_traits>
 
 #include <jsoncons/allocator_set.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/reflect/json_conv_traits.hpp>
 #include <jsoncons/semantic_tag.hpp>
@@ -102,6 +103,7 @@ namespace jsonpath {
         evaluator_type evaluator;
         path_expression_type expr = evaluator.compile(*resources, path);
 
+        JSONCONS_INSTRUMENT_TIMER(query);
         jsoncons::jsonpath::detail::eval_context<Json,reference> context;
         auto callback = [&new_value](const path_node_type&, reference v)
         {
@@ -130,6 +132,7 @@ namespace jsonpath {
         evaluator_type evaluator{aset.get_allocator()};
         path_expression_type expr = evaluator.compile(*resources, path);
 
+        JSONCONS_INSTRUMENT_TIMER(query);
         jsoncons::jsonpath::detail::eval_context<Json,reference> context{aset.get_allocator()};
         auto callback = [&new_value](const path_node_type&, reference v)
         {
@@ -156,6 +159,7 @@ namespace jsonpath {
         evaluator_type evaluator;
         path_expression_type expr = evaluator.compile(*resources, path);
 
+        JSONCONS_INSTRUMENT_TIMER(query);
         jsoncons::jsonpath::detail::eval_context<Json,reference> context;
 
         auto f = [&callback](const path_node_type& path, reference val)
@@ -184,6 +188,7 @@ namespace jsonpath {
         evaluator_type evaluator{aset.get_allocator()};
         path_expression_type expr = evaluator.compile(*resources, path);
 
+        JSONCONS_INSTRUMENT_TIMER(query);
         jsoncons::jsonpath::detail::eval_context<Json,reference> context{aset.get_allocator()};
 
         auto f = [&callback](const path_node_type& path, reference val)
@@ -211,6 +216,7 @@ namespace jsonpath {
         evaluator_type evaluator;
         path_expression_type expr = evaluator.compile(*resources, path);
 
+        JSONCONS_INSTRUMENT_TIMER(query);
         jsoncons::jsonpath::detail::eval_context<Json,reference> context;
         auto f = [callback](const path_node_type&, reference v)
         {
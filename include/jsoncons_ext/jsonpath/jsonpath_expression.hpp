@@ -17,6 +17,7 @@
 
 #include <jsoncons/allocator_set.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/semantic_tag.hpp>
 #include <jsoncons/utility/more_type_traits.hpp>
@@ -75,6 +76,7 @@ namespace jsonpath {
         typename std::enable_if<ext_traits::is_binary_function_object<BinaryCallback,const string_type&,const_reference>::value,void>::type
         evaluate(const_reference root, BinaryCallback callback, result_options options = result_options()) const
         {
+            JSONCONS_INSTRUMENT_TIMER(query);
             jsoncons::jsonpath::detail::eval_context<Json,const_reference> context{alloc_};
             auto f = [&callback](const path_node_type& path, const_reference val)
             {
@@ -85,6 +87,7 @@ namespace jsonpath {
 
         value_type evaluate(const_reference root, result_options options = result_options()) const
         {
+            JSONCONS_INSTRUMENT_TIMER(query);
             if ((options & result_options::path) == result_options::path)
             {
                 jsoncons::jsonpath::detail::eval_context<value_type, const_reference> context{ alloc_ };
@@ -103,6 +106,7 @@ namespace jsonpath {
 
         value_type select(const_reference root, result_options options = result_options()) const
         {
+            JSONCONS_INSTRUMENT_TIMER(query);
             if ((options & result_options::path) == result_options::path)
             {
                 jsoncons::jsonpath::detail::eval_context<value_type, const_reference> context{ alloc_ };
@@ -123,6 +127,7 @@ namespace jsonpath {
         typename std::enable_if<ext_traits::is_binary_function_object<BinaryCallback,const path_node_type&,const_reference>::value,void>::type
         select(const_reference root, BinaryCallback callback, result_options options = result_options()) const
         {
+            JSONCONS_INSTRUMENT_TIMER(query);
             jsoncons::jsonpath::detail::eval_context<value_type,const_reference> context{alloc_};
             const_expr_.evaluate(context, root, path_node_type{}, root, callback, options | result_options::path);
         }
@@ -131,6 +136,7 @@ namespace jsonpath {
         typename std::enable_if<ext_traits::is_binary_function_object<BinaryCallback,const path_node_type&,value_type&>::value,void>::type
         update(reference root, BinaryCallback callback) const
         {
+            JSONCONS_INSTRUMENT_TIMER(query);
             jsoncons::jsonpath::detail::eval_context<value_type,reference> context{alloc_};
 
             result_options options = result_options::nodups | result_options::path | result_options::sort_descending;
@@ -140,6 +146,7 @@ namespace jsonpath {
         std::vector<basic_json_location<char_type>> select_paths(const_reference root, 
             result_options options = result_options::nodups | result_options::sort) const
         {
+            JSONCONS_INSTRUMENT_TIMER(query);
             std::vector<basic_json_location<char_type>> result;
 
             options = options | result_options::path;
@@ -7,17 +7,27 @@
 #ifndef JSONCONS_EXT_JSONPOINTER_JSONPOINTER_HPP
 #define JSONCONS_EXT_JSONPOINTER_JSONPOINTER_HPP
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <system_error> // system_error
 #include <type_traits> // std::enable_if, std::true_type
+#include <unordered_map>
 #include <utility> // std::move
 #include <vector>
 
+#include <jsoncons/utility/hash.hpp>
+#include <jsoncons/utility/read_number.hpp>
 #include <jsoncons/utility/write_number.hpp>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_filter.hpp>
 #include <jsoncons/json_type.hpp>
+#include <jsoncons/json_visitor.hpp>
 #include <jsoncons/utility/more_type_traits.hpp>
 
 #include <jsoncons_ext/jsonpointer/jsonpointer_error.hpp>
@@ -35,6 +45,53 @@ namespace jsonpointer {
         part
     };
 
+    // A reference token, with its value as an array index when it has one
+    template <typename CharT>
+    class pointer_token
+    {
+    public:
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+    private:
+        string_view_type name_;
+        std::size_t index_{0};
+        bool has_index_{false};
+    public:
+        pointer_token() = default;
+
+        explicit pointer_token(const string_view_type& name)
+            : name_(name)
+        {
+            auto result = jsoncons::utility::dec_to_integer(name_.data(), name_.length(), index_);
+            has_index_ = result ? true : false;
+        }
+
+        pointer_token(const string_view_type& name, std::size_t index, bool has_index)
+            : name_(name), index_(index), has_index_(has_index)
+        {
+        }
+
+        string_view_type name() const
+        {
+            return name_;
+        }
+
+        bool has_index() const
+        {
+            return has_index_;
+        }
+
+        std::size_t index() const
+        {
+            return index_;
+        }
+
+        // The "-" token, which refers past the last array element
+        bool is_past_end() const
+        {
+            return name_.size() == 1 && name_[0] == '-';
+        }
+    };
+
     } // namespace detail
 
     template <typename CharT,typename Allocator=std::allocator<CharT>>
@@ -392,40 +449,295 @@ namespace jsonpointer {
         return ptr.to_string();
     }
 
+    // A JSON Pointer that has been parsed once for repeated evaluation. The source text 
+    // and the unescaped text of any tokens that contain escapes share one buffer, 
+    // and array indices are parsed up front.
+    template <typename CharT>
+    class basic_compiled_json_pointer
+    {
+    public:
+        // Member types
+        using char_type = CharT;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+        using value_type = jsonpointer::detail::pointer_token<char_type>;
+
+        class const_iterator
+        {
+            const basic_compiled_json_pointer* ptr_;
+            std::size_t pos_;
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = jsonpointer::detail::pointer_token<char_type>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = value_type;
+
+            const_iterator()
+                : ptr_(nullptr), pos_(0)
+            {
+            }
+
+            const_iterator(const basic_compiled_json_pointer* ptr, std::size_t pos)
+                : ptr_(ptr), pos_(pos)
+            {
+            }
+
+            reference operator*() const
+            {
+                return (*ptr_)[pos_];
+            }
+
+            const_iterator& operator++()
+            {
+                ++pos_;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator temp(*this);
+                ++pos_;
+                return temp;
+            }
+
+            friend bool operator==(const const_iterator& lhs, const const_iterator& rhs)
+            {
+                return lhs.ptr_ == rhs.ptr_ && lhs.pos_ == rhs.pos_;
+            }
+
+            friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs)
+            {
+                return !(lhs == rhs);
+            }
+        };
+        using iterator = const_iterator;
+    private:
+        struct token_entry
+        {
+            std::size_t source_offset; // offset of the token's leading '/' in the source
+            std::size_t offset;        // offset of the unescaped token in buffer_
+            std::size_t length;
+            std::size_t index;
+            bool has_index;
+        };
+
+        string_type buffer_;
+        std::size_t source_length_{0};
+        std::vector<token_entry> tokens_;
+        uint64_t parent_hash_{0};
+    public:
+        // Constructors
+        basic_compiled_json_pointer() = default;
+
+        explicit basic_compiled_json_pointer(const string_view_type& s)
+        {
+            std::error_code ec;
+            *this = parse(s, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(jsonpointer_error(ec));
+            }
+        }
+
+        explicit basic_compiled_json_pointer(const string_view_type& s, std::error_code& ec)
+        {
+            *this = parse(s, ec);
+        }
+
+        explicit basic_compiled_json_pointer(const basic_json_pointer<char_type>& location)
+            : basic_compiled_json_pointer(string_view_type(location.to_string()))
+        {
+        }
+
+        basic_compiled_json_pointer(const basic_compiled_json_pointer&) = default;
+
+        basic_compiled_json_pointer(basic_compiled_json_pointer&&) = default;
+
+        static basic_compiled_json_pointer parse(const string_view_type& input, std::error_code& ec)
+        {
+            basic_compiled_json_pointer result;
+            if (input.empty())
+            {
+                return result;
+            }
+            if (input[0] != '/')
+            {
+                ec = jsonpointer_errc::expected_slash;
+                return result;
+            }
+
+            // An unescaped token is never longer than its source
+            result.buffer_.reserve(2*input.size());
+            result.buffer_.append(input.data(), input.size());
+            result.source_length_ = input.size();
+            result.tokens_.reserve(static_cast<std::size_t>(std::count(input.begin(), input.end(), '/')));
+
+            const std::size_t length = input.size();
+            std::size_t pos = 0;
+            while (pos < length)
+            {
+                std::size_t start = pos + 1;
+                std::size_t end = start;
+                bool escaped = false;
+                while (end < length && input[end] != '/')
+                {
+                    if (input[end] == '~')
+                    {
+                        if (end + 1 == length || (input[end+1] != '0' && input[end+1] != '1'))
+                        {
+                            ec = jsonpointer_errc::expected_0_or_1;
+                            return basic_compiled_json_pointer();
+                        }
+                        escaped = true;
+                        ++end;
+                    }
+                    ++end;
+                }
+
+                token_entry entry;
+                entry.source_offset = pos;
+                if (escaped)
+                {
+                    entry.offset = result.buffer_.size();
+                    for (std::size_t i = start; i < end; ++i)
+                    {
+                        if (input[i] == '~')
+                        {
+                            ++i;
+                            result.buffer_.push_back(input[i] == '0' ? '~' : '/');
+                        }
+                        else
+                        {
+                            result.buffer_.push_back(input[i]);
+                        }
+                    }
+                    entry.length = result.buffer_.size() - entry.offset;
+                }
+                else
+                {
+                    entry.offset = start;
+                    entry.length = end - start;
+                }
+                entry.index = 0;
+                auto r = jsoncons::utility::dec_to_integer(result.buffer_.data() + entry.offset, entry.length, entry.index);
+                entry.has_index = r ? true : false;
+                result.tokens_.push_back(entry);
+                pos = end;
+            }
+            result.parent_hash_ = jsoncons::utility::hash_chars(result.buffer_.data(), result.tokens_.back().source_offset);
+            return result;
+        }
+
+        // operator=
+        basic_compiled_json_pointer& operator=(const basic_compiled_json_pointer&) = default;
+
+        basic_compiled_json_pointer& operator=(basic_compiled_json_pointer&&) = default;
+
+        // Accessors
+        bool empty() const
+        {
+            return tokens_.empty();
+        }
+
+        std::size_t size() const
+        {
+            return tokens_.size();
+        }
+
+        value_type operator[](std::size_t i) const
+        {
+            const token_entry& entry = tokens_[i];
+            return value_type(string_view_type(buffer_.data() + entry.offset, entry.length), entry.index, entry.has_index);
+        }
+
+        // The source text of the pointer to the parent, empty for the root and its children
+        string_view_type parent() const
+        {
+            return tokens_.empty() ? string_view_type() : string_view_type(buffer_.data(), tokens_.back().source_offset);
+        }
+
+        uint64_t parent_hash() const
+        {
+            return parent_hash_;
+        }
+
+        string_type string() const
+        {
+            return to_string();
+        }
+
+        string_type to_string() const
+        {
+            return string_type(buffer_.data(), source_length_);
+        }
+
+        // Iterators
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, tokens_.size());
+        }
+
+        // Non-member functions
+        friend bool operator==(const basic_compiled_json_pointer& lhs, const basic_compiled_json_pointer& rhs)
+        {
+            return string_view_type(lhs.buffer_.data(), lhs.source_length_) == string_view_type(rhs.buffer_.data(), rhs.source_length_);
+        }
+
+        friend bool operator!=(const basic_compiled_json_pointer& lhs, const basic_compiled_json_pointer& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend std::basic_ostream<CharT>&
+        operator<<(std::basic_ostream<CharT>& os, const basic_compiled_json_pointer& p)
+        {
+            os << string_view_type(p.buffer_.data(), p.source_length_);
+            return os;
+        }
+    };
+
+    using compiled_json_pointer = basic_compiled_json_pointer<char>;
+    using wcompiled_json_pointer = basic_compiled_json_pointer<wchar_t>;
+
     namespace detail {
 
     template <typename Json>
-    const Json* resolve(const Json* current, const typename Json::string_view_type& buffer, std::error_code& ec)
+    const Json* resolve(const Json* current, const pointer_token<typename Json::char_type>& token, std::error_code& ec)
     {
         if (current->is_array())
         {
-            if (buffer.size() == 1 && buffer[0] == '-')
+            if (token.is_past_end())
             {
                 ec = jsonpointer_errc::index_exceeds_array_size;
                 return current;
             }
-            std::size_t index{0};
-            auto result = jsoncons::utility::dec_to_integer(buffer.data(), buffer.length(), index);
-            if (!result)
+            if (!token.has_index())
             {
                 ec = jsonpointer_errc::invalid_index;
                 return current;
             }
-            if (index >= current->size())
+            if (token.index() >= current->size())
             {
                 ec = jsonpointer_errc::index_exceeds_array_size;
                 return current;
             }
-            current = std::addressof(current->at(index));
+            current = std::addressof(current->at(token.index()));
         }
         else if (current->is_object())
         {
-            if (!current->contains(buffer))
+            auto it = current->find(token.name());
+            if (it == current->object_range().end())
             {
                 ec = jsonpointer_errc::key_not_found;
                 return current;
             }
-            current = std::addressof(current->at(buffer));
+            current = std::addressof(it->value());
         }
         else
         {
@@ -436,36 +748,35 @@ namespace jsonpointer {
     }
 
     template <typename Json>
-    Json* resolve(Json* current, const typename Json::string_view_type& buffer, bool create_if_missing, std::error_code& ec)
+    Json* resolve(Json* current, const pointer_token<typename Json::char_type>& token, bool create_if_missing, std::error_code& ec)
     {
         if (current->is_array())
         {
-            if (buffer.size() == 1 && buffer[0] == '-')
+            if (token.is_past_end())
             {
                 ec = jsonpointer_errc::index_exceeds_array_size;
                 return current;
             }
-            std::size_t index{0};
-            auto result = jsoncons::utility::dec_to_integer(buffer.data(), buffer.length(), index);
-            if (!result)
+            if (!token.has_index())
             {
                 ec = jsonpointer_errc::invalid_index;
                 return current;
             }
-            if (index >= current->size())
+            if (token.index() >= current->size())
             {
                 ec = jsonpointer_errc::index_exceeds_array_size;
                 return current;
             }
-            current = std::addressof(current->at(index));
+            current = std::addressof(current->at(token.index()));
         }
         else if (current->is_object())
         {
-            if (!current->contains(buffer))
+            auto it = current->find(token.name());
+            if (it == current->object_range().end())
             {
                 if (create_if_missing)
                 {
-                    auto r = current->try_emplace(buffer, Json());
+                    auto r = current->try_emplace(token.name(), Json());
                     current = std::addressof(r.first->value());
                 }
                 else
@@ -476,7 +787,7 @@ namespace jsonpointer {
             }
             else
             {
-                current = std::addressof(current->at(buffer));
+                current = std::addressof(it->value());
             }
         }
         else
@@ -487,102 +798,334 @@ namespace jsonpointer {
         return current;
     }
 
-    } // namespace detail
-
-    // get
+    template <typename Json>
+    const Json* resolve(const Json* current, const typename Json::string_view_type& buffer, std::error_code& ec)
+    {
+        return resolve(current, pointer_token<typename Json::char_type>(buffer), ec);
+    }
 
     template <typename Json>
-    Json& get(Json& root, 
-              const basic_json_pointer<typename Json::char_type>& location, 
-              bool create_if_missing,
-              std::error_code& ec)
+    Json* resolve(Json* current, const typename Json::string_view_type& buffer, bool create_if_missing, std::error_code& ec)
     {
-        if (location.empty())
-        {
-            return root;
-        }
+        return resolve(current, pointer_token<typename Json::char_type>(buffer), create_if_missing, ec);
+    }
 
-        Json* current = std::addressof(root);
+    // Resolves all but the last token of a non-empty location, and sets last to the last token
+    template <typename Json,typename Pointer>
+    Json* resolve_parent(Json* current, const Pointer& location, bool create_if_missing, 
+                         pointer_token<typename Json::char_type>& last, std::error_code& ec)
+    {
         auto it = location.begin();
         auto end = location.end();
-        while (it != end)
+        auto next = it;
+        ++next;
+        while (next != end)
         {
-            current = jsoncons::jsonpointer::detail::resolve(current, *it, create_if_missing, ec);
+            current = resolve(current, *it, create_if_missing, ec);
             if (JSONCONS_UNLIKELY(ec))
-                return *current;
-            ++it;
+                return current;
+            it = next;
+            ++next;
         }
-        return *current;
+        last = pointer_token<typename Json::char_type>(*it);
+        return current;
     }
 
-    template <typename Json,typename StringSource>
-    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,Json&>::type
-    get(Json& root, 
-        const StringSource& location_str, 
-        bool create_if_missing,
-        std::error_code& ec)
+    template <typename Json,typename T>
+    void add_child(Json* parent, const pointer_token<typename Json::char_type>& token, T&& value, std::error_code& ec)
     {
-        auto jsonptr = basic_json_pointer<typename Json::char_type>::parse(location_str, ec);
-        if (JSONCONS_UNLIKELY(ec))
+        if (parent->is_array())
         {
-            return root;
+            if (token.is_past_end())
+            {
+                parent->emplace_back(std::forward<T>(value));
+            }
+            else if (!token.has_index())
+            {
+                ec = jsonpointer_errc::invalid_index;
+            }
+            else if (token.index() > parent->size())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+            }
+            else if (token.index() == parent->size())
+            {
+                parent->emplace_back(std::forward<T>(value));
+            }
+            else
+            {
+                parent->insert(parent->array_range().begin()+token.index(),std::forward<T>(value));
+            }
         }
-        return get(root, jsonptr, create_if_missing, ec);
-    }
-
-    template <typename Json>
-    const Json& get(const Json& root, 
-                    const basic_json_pointer<typename Json::char_type>& location, 
-                    std::error_code& ec)
-    {
-        if (location.empty())
+        else if (parent->is_object())
         {
-            return root;
+            parent->insert_or_assign(token.name(),std::forward<T>(value));
         }
-
-        const Json* current = std::addressof(root);
-        auto it = location.begin();
-        auto end = location.end();
-        while (it != end)
+        else
         {
-            current = jsoncons::jsonpointer::detail::resolve(current, *it, ec);
-            if (JSONCONS_UNLIKELY(ec))
-                return *current;
-            ++it;
+            ec = jsonpointer_errc::expected_object_or_array;
         }
-        return *current;
     }
 
-    template <typename Json,typename StringSource>
-    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,const Json&>::type
-    get(const Json& root, 
-        const StringSource& location_str, 
-        std::error_code& ec)
+    template <typename Json,typename T>
+    void add_child_if_absent(Json* parent, const pointer_token<typename Json::char_type>& token, T&& value, std::error_code& ec)
     {
-        auto jsonptr = basic_json_pointer<typename Json::char_type>::parse(location_str, ec);
-        if (JSONCONS_UNLIKELY(ec))
+        if (parent->is_object())
         {
-            return root;
+            if (parent->contains(token.name()))
+            {
+                ec = jsonpointer_errc::key_already_exists;
+            }
+            else
+            {
+                parent->try_emplace(token.name(),std::forward<T>(value));
+            }
+        }
+        else
+        {
+            add_child(parent, token, std::forward<T>(value), ec);
         }
-        return get(root, jsonptr, ec);
     }
 
     template <typename Json>
-    Json& get(Json& root, 
-              const basic_json_pointer<typename Json::char_type>& location, 
-              std::error_code& ec)
-    {
-        return get(root, location, false, ec);
-    }
-
-    template <typename Json,typename StringSource>
-    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,Json&>::type
-    get(Json& root, 
-        const StringSource& location_str, 
-        std::error_code& ec)
+    void remove_child(Json* parent, const pointer_token<typename Json::char_type>& token, std::error_code& ec)
     {
-        return get(root, location_str, false, ec);
-    }
+        if (parent->is_array())
+        {
+            if (token.is_past_end())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+            }
+            else if (!token.has_index())
+            {
+                ec = jsonpointer_errc::invalid_index;
+            }
+            else if (token.index() >= parent->size())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+            }
+            else
+            {
+                parent->erase(parent->array_range().begin()+token.index());
+            }
+        }
+        else if (parent->is_object())
+        {
+            auto it = parent->find(token.name());
+            if (it == parent->object_range().end())
+            {
+                ec = jsonpointer_errc::key_not_found;
+            }
+            else
+            {
+                parent->erase(it);
+            }
+        }
+        else
+        {
+            ec = jsonpointer_errc::expected_object_or_array;
+        }
+    }
+
+    template <typename Json,typename T>
+    void replace_child(Json* parent, const pointer_token<typename Json::char_type>& token, T&& value, 
+                       bool create_if_missing, std::error_code& ec)
+    {
+        if (parent->is_array())
+        {
+            if (token.is_past_end())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+            }
+            else if (!token.has_index())
+            {
+                ec = jsonpointer_errc::invalid_index;
+            }
+            else if (token.index() >= parent->size())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+            }
+            else
+            {
+                parent->at(token.index()) = std::forward<T>(value);
+            }
+        }
+        else if (parent->is_object())
+        {
+            auto it = parent->find(token.name());
+            if (it != parent->object_range().end())
+            {
+                it->value() = std::forward<T>(value);
+            }
+            else if (create_if_missing)
+            {
+                parent->try_emplace(token.name(),std::forward<T>(value));
+            }
+            else
+            {
+                ec = jsonpointer_errc::key_not_found;
+            }
+        }
+        else
+        {
+            ec = jsonpointer_errc::expected_object_or_array;
+        }
+    }
+
+    // The algorithms below take either a basic_json_pointer or a basic_compiled_json_pointer
+
+    template <typename Json,typename Pointer>
+    Json& get_value(Json& root, const Pointer& location, bool create_if_missing, std::error_code& ec)
+    {
+        Json* current = std::addressof(root);
+        for (auto it = location.begin(); it != location.end(); ++it)
+        {
+            current = resolve(current, *it, create_if_missing, ec);
+            if (JSONCONS_UNLIKELY(ec))
+                return *current;
+        }
+        return *current;
+    }
+
+    template <typename Json,typename Pointer>
+    const Json& get_value(const Json& root, const Pointer& location, std::error_code& ec)
+    {
+        const Json* current = std::addressof(root);
+        for (auto it = location.begin(); it != location.end(); ++it)
+        {
+            current = resolve(current, *it, ec);
+            if (JSONCONS_UNLIKELY(ec))
+                return *current;
+        }
+        return *current;
+    }
+
+    template <typename Json,typename Pointer,typename T>
+    void add_value(Json& root, const Pointer& location, T&& value, bool create_if_missing, std::error_code& ec)
+    {
+        if (location.empty())
+        {
+            root = std::forward<T>(value);
+            return;
+        }
+        pointer_token<typename Json::char_type> last;
+        Json* parent = resolve_parent(std::addressof(root), location, create_if_missing, last, ec);
+        if (JSONCONS_UNLIKELY(ec))
+            return;
+        add_child(parent, last, std::forward<T>(value), ec);
+    }
+
+    template <typename Json,typename Pointer,typename T>
+    void add_value_if_absent(Json& root, const Pointer& location, T&& value, bool create_if_missing, std::error_code& ec)
+    {
+        if (location.empty())
+        {
+            root = std::forward<T>(value);
+            return;
+        }
+        pointer_token<typename Json::char_type> last;
+        Json* parent = resolve_parent(std::addressof(root), location, create_if_missing, last, ec);
+        if (JSONCONS_UNLIKELY(ec))
+            return;
+        add_child_if_absent(parent, last, std::forward<T>(value), ec);
+    }
+
+    template <typename Json,typename Pointer>
+    void remove_value(Json& root, const Pointer& location, std::error_code& ec)
+    {
+        if (location.empty())
+        {
+            ec = jsonpointer_errc::cannot_remove_root;
+            return;
+        }
+        pointer_token<typename Json::char_type> last;
+        Json* parent = resolve_parent(std::addressof(root), location, false, last, ec);
+        if (JSONCONS_UNLIKELY(ec))
+            return;
+        remove_child(parent, last, ec);
+    }
+
+    template <typename Json,typename Pointer,typename T>
+    void replace_value(Json& root, const Pointer& location, T&& value, bool create_if_missing, std::error_code& ec)
+    {
+        if (location.empty())
+        {
+            root = std::forward<T>(value);
+            return;
+        }
+        pointer_token<typename Json::char_type> last;
+        Json* parent = resolve_parent(std::addressof(root), location, create_if_missing, last, ec);
+        if (JSONCONS_UNLIKELY(ec))
+            return;
+        replace_child(parent, last, std::forward<T>(value), create_if_missing, ec);
+    }
+
+    } // namespace detail
+
+    // get
+
+    template <typename Json>
+    Json& get(Json& root, 
+              const basic_json_pointer<typename Json::char_type>& location, 
+              bool create_if_missing,
+              std::error_code& ec)
+    {
+        return jsoncons::jsonpointer::detail::get_value(root, location, create_if_missing, ec);
+    }
+
+    template <typename Json,typename StringSource>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,Json&>::type
+    get(Json& root, 
+        const StringSource& location_str, 
+        bool create_if_missing,
+        std::error_code& ec)
+    {
+        auto jsonptr = basic_compiled_json_pointer<typename Json::char_type>::parse(location_str, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return root;
+        }
+        return get(root, jsonptr, create_if_missing, ec);
+    }
+
+    template <typename Json>
+    const Json& get(const Json& root, 
+                    const basic_json_pointer<typename Json::char_type>& location, 
+                    std::error_code& ec)
+    {
+        return jsoncons::jsonpointer::detail::get_value(root, location, ec);
+    }
+
+    template <typename Json,typename StringSource>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,const Json&>::type
+    get(const Json& root, 
+        const StringSource& location_str, 
+        std::error_code& ec)
+    {
+        auto jsonptr = basic_compiled_json_pointer<typename Json::char_type>::parse(location_str, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return root;
+        }
+        return get(root, jsonptr, ec);
+    }
+
+    template <typename Json>
+    Json& get(Json& root, 
+              const basic_json_pointer<typename Json::char_type>& location, 
+              std::error_code& ec)
+    {
+        return get(root, location, false, ec);
+    }
+
+    template <typename Json,typename StringSource>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,Json&>::type
+    get(Json& root, 
+        const StringSource& location_str, 
+        std::error_code& ec)
+    {
+        return get(root, location_str, false, ec);
+    }
 
     template <typename Json>
     Json& get(Json& root, 
@@ -638,6 +1181,57 @@ namespace jsonpointer {
         return j;
     }
 
+    template <typename Json>
+    Json& get(Json& root, 
+              const basic_compiled_json_pointer<typename Json::char_type>& location, 
+              bool create_if_missing,
+              std::error_code& ec)
+    {
+        return jsoncons::jsonpointer::detail::get_value(root, location, create_if_missing, ec);
+    }
+
+    template <typename Json>
+    const Json& get(const Json& root, 
+                    const basic_compiled_json_pointer<typename Json::char_type>& location, 
+                    std::error_code& ec)
+    {
+        return jsoncons::jsonpointer::detail::get_value(root, location, ec);
+    }
+
+    template <typename Json>
+    Json& get(Json& root, 
+              const basic_compiled_json_pointer<typename Json::char_type>& location, 
+              std::error_code& ec)
+    {
+        return get(root, location, false, ec);
+    }
+
+    template <typename Json>
+    Json& get(Json& root, 
+              const basic_compiled_json_pointer<typename Json::char_type>& location,
+              bool create_if_missing = false)
+    {
+        std::error_code ec;
+        Json& j = get(root, location, create_if_missing, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+        return j;
+    }
+
+    template <typename Json>
+    const Json& get(const Json& root, const basic_compiled_json_pointer<typename Json::char_type>& location)
+    {
+        std::error_code ec;
+        const Json& j = get(root, location, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+        return j;
+    }
+
     // contains
 
     template <typename Json>
@@ -657,6 +1251,14 @@ namespace jsonpointer {
         return !ec ? true : false;
     }
 
+    template <typename Json>
+    bool contains(const Json& root, const basic_compiled_json_pointer<typename Json::char_type>& location)
+    {
+        std::error_code ec;
+        get(root, location, ec);
+        return !ec ? true : false;
+    }
+
     template <typename Json,typename T>
     void add(Json& root, 
              const basic_json_pointer<typename Json::char_type>& location, 
@@ -664,89 +1266,25 @@ namespace jsonpointer {
              bool create_if_missing,
              std::error_code& ec)
     {
-        if (location.empty())
+        jsoncons::jsonpointer::detail::add_value(root, location, std::forward<T>(value), create_if_missing, ec);
+    }
+
+    // add
+    template <typename Json,typename StringSource,typename T>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
+    add(Json& root, 
+             const StringSource& location_str, 
+             T&& value, 
+             bool create_if_missing,
+             std::error_code& ec)
+    {
+        auto jsonptr = basic_compiled_json_pointer<typename Json::char_type>::parse(location_str, ec);
+        if (JSONCONS_UNLIKELY(ec))
         {
-            root = std::forward<T>(value);
             return;
         }
-
-        Json* current = std::addressof(root);
-
-        std::basic_string<typename Json::char_type> buffer;
-        auto it = location.begin();
-        auto end = location.end();
-        while (it != end)
-        {
-            buffer = *it;
-            ++it;
-            if (it != end)
-            {
-                current = jsoncons::jsonpointer::detail::resolve(current, buffer, create_if_missing, ec);
-                if (JSONCONS_UNLIKELY(ec))
-                    return;
-            }
-        }
-        if (current->is_array())
-        {
-            if (buffer.size() == 1 && buffer[0] == '-')
-            {
-                current->emplace_back(std::forward<T>(value));
-                current = std::addressof(current->at(current->size()-1));
-            }
-            else
-            {
-                std::size_t index{0};
-                auto result = jsoncons::utility::dec_to_integer(buffer.data(), buffer.length(), index);
-                if (!result)
-                {
-                    ec = jsonpointer_errc::invalid_index;
-                    return;
-                }
-                if (index > current->size())
-                {
-                    ec = jsonpointer_errc::index_exceeds_array_size;
-                    return;
-                }
-                if (index == current->size())
-                {
-                    current->emplace_back(std::forward<T>(value));
-                    current = std::addressof(current->at(current->size()-1));
-                }
-                else
-                {
-                    auto it2 = current->insert(current->array_range().begin()+index,std::forward<T>(value));
-                    current = std::addressof(*it2);
-                }
-            }
-        }
-        else if (current->is_object())
-        {
-            auto r = current->insert_or_assign(buffer,std::forward<T>(value));
-            current = std::addressof(r.first->value());
-        }
-        else
-        {
-            ec = jsonpointer_errc::expected_object_or_array;
-            return;
-        }
-    }
-
-    // add
-    template <typename Json,typename StringSource,typename T>
-    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
-    add(Json& root, 
-             const StringSource& location_str, 
-             T&& value, 
-             bool create_if_missing,
-             std::error_code& ec)
-    {
-        auto jsonptr = basic_json_pointer<typename Json::char_type>::parse(location_str, ec);
-        if (JSONCONS_UNLIKELY(ec))
-        {
-            return;
-        }
-        add(root, jsonptr, std::forward<T>(value), create_if_missing, ec);
-    }
+        add(root, jsonptr, std::forward<T>(value), create_if_missing, ec);
+    }
 
     template <typename Json,typename T>
     void add(Json& root, 
@@ -796,6 +1334,39 @@ namespace jsonpointer {
         }
     }
 
+    template <typename Json,typename T>
+    void add(Json& root, 
+             const basic_compiled_json_pointer<typename Json::char_type>& location, 
+             T&& value, 
+             bool create_if_missing,
+             std::error_code& ec)
+    {
+        jsoncons::jsonpointer::detail::add_value(root, location, std::forward<T>(value), create_if_missing, ec);
+    }
+
+    template <typename Json,typename T>
+    void add(Json& root, 
+             const basic_compiled_json_pointer<typename Json::char_type>& location, 
+             T&& value, 
+             std::error_code& ec)
+    {
+        add(root, location, std::forward<T>(value), false, ec);
+    }
+
+    template <typename Json,typename T>
+    void add(Json& root, 
+             const basic_compiled_json_pointer<typename Json::char_type>& location, 
+             T&& value,
+             bool create_if_missing = false)
+    {
+        std::error_code ec;
+        add(root, location, std::forward<T>(value), create_if_missing, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+    }
+
     // add_if_absent
 
     template <typename Json,typename T>
@@ -805,79 +1376,7 @@ namespace jsonpointer {
                        bool create_if_missing,
                        std::error_code& ec)
     {
-        if (location.empty())
-        {
-            root = std::forward<T>(value);
-            return;
-        }
-        Json* current = std::addressof(root);
-
-        std::basic_string<typename Json::char_type> buffer;
-        auto it = location.begin();
-        auto end = location.end();
-
-        while (it != end)
-        {
-            buffer = *it;
-            ++it;
-            if (it != end)
-            {
-                current = jsoncons::jsonpointer::detail::resolve(current, buffer, create_if_missing, ec);
-                if (JSONCONS_UNLIKELY(ec))
-                    return;
-            }
-        }
-        if (current->is_array())
-        {
-            if (buffer.size() == 1 && buffer[0] == '-')
-            {
-                current->emplace_back(std::forward<T>(value));
-                current = std::addressof(current->at(current->size()-1));
-            }
-            else
-            {
-                std::size_t index{0};
-                auto result = jsoncons::utility::dec_to_integer(buffer.data(), buffer.length(), index);
-                if (!result)
-                {
-                    ec = jsonpointer_errc::invalid_index;
-                    return;
-                }
-                if (index > current->size())
-                {
-                    ec = jsonpointer_errc::index_exceeds_array_size;
-                    return;
-                }
-                if (index == current->size())
-                {
-                    current->emplace_back(std::forward<T>(value));
-                    current = std::addressof(current->at(current->size()-1));
-                }
-                else
-                {
-                    auto it2 = current->insert(current->array_range().begin()+index,std::forward<T>(value));
-                    current = std::addressof(*it2);
-                }
-            }
-        }
-        else if (current->is_object())
-        {
-            if (current->contains(buffer))
-            {
-                ec = jsonpointer_errc::key_already_exists;
-                return;
-            }
-            else
-            {
-                auto r = current->try_emplace(buffer,std::forward<T>(value));
-                current = std::addressof(r.first->value());
-            }
-        }
-        else
-        {
-            ec = jsonpointer_errc::expected_object_or_array;
-            return;
-        }
+        jsoncons::jsonpointer::detail::add_value_if_absent(root, location, std::forward<T>(value), create_if_missing, ec);
     }
 
     template <typename Json,typename StringSource,typename T>
@@ -888,7 +1387,7 @@ namespace jsonpointer {
                        bool create_if_missing,
                        std::error_code& ec)
     {
-        auto jsonptr = basic_json_pointer<typename Json::char_type>::parse(location_str, ec);
+        auto jsonptr = basic_compiled_json_pointer<typename Json::char_type>::parse(location_str, ec);
         if (JSONCONS_UNLIKELY(ec))
         {
             return;
@@ -944,82 +1443,52 @@ namespace jsonpointer {
         }
     }
 
-    // remove
+    template <typename Json,typename T>
+    void add_if_absent(Json& root, 
+                       const basic_compiled_json_pointer<typename Json::char_type>& location, 
+                       T&& value, 
+                       bool create_if_missing,
+                       std::error_code& ec)
+    {
+        jsoncons::jsonpointer::detail::add_value_if_absent(root, location, std::forward<T>(value), create_if_missing, ec);
+    }
 
-    template <typename Json>
-    void remove(Json& root, const basic_json_pointer<typename Json::char_type>& location, std::error_code& ec)
+    template <typename Json,typename T>
+    void add_if_absent(Json& root, 
+                       const basic_compiled_json_pointer<typename Json::char_type>& location, 
+                       T&& value, 
+                       std::error_code& ec)
     {
-        if (location.empty())
+        add_if_absent(root, location, std::forward<T>(value), false, ec);
+    }
+
+    template <typename Json,typename T>
+    void add_if_absent(Json& root, 
+                const basic_compiled_json_pointer<typename Json::char_type>& location, 
+                T&& value,
+                bool create_if_missing = false)
+    {
+        std::error_code ec;
+        add_if_absent(root, location, std::forward<T>(value), create_if_missing, ec);
+        if (JSONCONS_UNLIKELY(ec))
         {
-            ec = jsonpointer_errc::cannot_remove_root;
-            return;
+            JSONCONS_THROW(jsonpointer_error(ec));
         }
+    }
 
-        Json* current = std::addressof(root);
-
-        std::basic_string<typename Json::char_type> buffer;
-        auto it = location.begin();
-        auto end = location.end();
+    // remove
 
-        while (it != end)
-        {
-            buffer = *it;
-            ++it;
-            if (it != end)
-            {
-                current = jsoncons::jsonpointer::detail::resolve(current, buffer, false, ec);
-                if (JSONCONS_UNLIKELY(ec))
-                    return;
-            }
-        }
-        if (current->is_array())
-        {
-            if (buffer.size() == 1 && buffer[0] == '-')
-            {
-                ec = jsonpointer_errc::index_exceeds_array_size;
-                return;
-            }
-            else
-            {
-                std::size_t index{0};
-                auto result = jsoncons::utility::dec_to_integer(buffer.data(), buffer.length(), index);
-                if (!result)
-                {
-                    ec = jsonpointer_errc::invalid_index;
-                    return;
-                }
-                if (index >= current->size())
-                {
-                    ec = jsonpointer_errc::index_exceeds_array_size;
-                    return;
-                }
-                current->erase(current->array_range().begin()+index);
-            }
-        }
-        else if (current->is_object())
-        {
-            if (!current->contains(buffer))
-            {
-                ec = jsonpointer_errc::key_not_found;
-                return;
-            }
-            else
-            {
-                current->erase(buffer);
-            }
-        }
-        else
-        {
-            ec = jsonpointer_errc::expected_object_or_array;
-            return;
-        }
+    template <typename Json>
+    void remove(Json& root, const basic_json_pointer<typename Json::char_type>& location, std::error_code& ec)
+    {
+        jsoncons::jsonpointer::detail::remove_value(root, location, ec);
     }
 
     template <typename Json,typename StringSource>
     typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
     remove(Json& root, const StringSource& location_str, std::error_code& ec)
     {
-        auto jsonptr = basic_json_pointer<typename Json::char_type>::parse(location_str, ec);
+        auto jsonptr = basic_compiled_json_pointer<typename Json::char_type>::parse(location_str, ec);
         if (JSONCONS_UNLIKELY(ec))
         {
             return;
@@ -1050,6 +1519,23 @@ namespace jsonpointer {
         }
     }
 
+    template <typename Json>
+    void remove(Json& root, const basic_compiled_json_pointer<typename Json::char_type>& location, std::error_code& ec)
+    {
+        jsoncons::jsonpointer::detail::remove_value(root, location, ec);
+    }
+
+    template <typename Json>
+    void remove(Json& root, const basic_compiled_json_pointer<typename Json::char_type>& location)
+    {
+        std::error_code ec;
+        remove(root, location, ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+    }
+
     // replace
 
     template <typename Json,typename T>
@@ -1059,114 +1545,67 @@ namespace jsonpointer {
                  bool create_if_missing,
                  std::error_code& ec)
     {
-        if (location.empty())
+        jsoncons::jsonpointer::detail::replace_value(root, location, std::forward<T>(value), create_if_missing, ec);
+    }
+
+    template <typename Json,typename StringSource,typename T>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
+    replace(Json& root, 
+                 const StringSource& location_str, 
+                 T&& value, 
+                 bool create_if_missing,
+                 std::error_code& ec)
+    {
+        auto jsonptr = basic_compiled_json_pointer<typename Json::char_type>::parse(location_str, ec);
+        if (JSONCONS_UNLIKELY(ec))
         {
-            root = std::forward<T>(value);
             return;
         }
-        Json* current = std::addressof(root);
+        replace(root, jsonptr, std::forward<T>(value), create_if_missing, ec);
+    }
 
-        std::basic_string<typename Json::char_type> buffer;
-        auto it = location.begin();
-        auto end = location.end();
+    template <typename Json,typename StringSource,typename T>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
+    replace(Json& root, 
+                 const StringSource& location_str, 
+                 T&& value, 
+                 std::error_code& ec)
+    {
+        replace(root, location_str, std::forward<T>(value), false, ec);
+    }
 
-        while (it != end)
+    template <typename Json,typename StringSource,typename T>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
+    replace(Json& root, 
+                 const StringSource& location_str, 
+                 T&& value, 
+                 bool create_if_missing = false)
+    {
+        std::error_code ec;
+        replace(root, location_str, std::forward<T>(value), create_if_missing, ec);
+        if (JSONCONS_UNLIKELY(ec))
         {
-            buffer = *it;
-            ++it;
-            if (it != end)
-            {
-                current = jsoncons::jsonpointer::detail::resolve(current, buffer, create_if_missing, ec);
-                if (JSONCONS_UNLIKELY(ec))
-                    return;
-            }
-        }
-        if (current->is_array())
-        {
-            if (buffer.size() == 1 && buffer[0] == '-')
-            {
-                ec = jsonpointer_errc::index_exceeds_array_size;
-                return;
-            }
-            else
-            {
-                std::size_t index{};
-                auto result = jsoncons::utility::dec_to_integer(buffer.data(), buffer.length(), index);
-                if (!result)
-                {
-                    ec = jsonpointer_errc::invalid_index;
-                    return;
-                }
-                if (index >= current->size())
-                {
-                    ec = jsonpointer_errc::index_exceeds_array_size;
-                    return;
-                }
-                current->at(index) = std::forward<T>(value);
-            }
-        }
-        else if (current->is_object())
-        {
-            if (!current->contains(buffer))
-            {
-                if (create_if_missing)
-                {
-                    current->try_emplace(buffer,std::forward<T>(value));
-                }
-                else
-                {
-                    ec = jsonpointer_errc::key_not_found;
-                    return;
-                }
-            }
-            else
-            {
-                auto r = current->insert_or_assign(buffer,std::forward<T>(value));
-                current = std::addressof(r.first->value());
-            }
-        }
-        else
-        {
-            ec = jsonpointer_errc::expected_object_or_array;
-            return;
-        }
-    }
-
-    template <typename Json,typename StringSource,typename T>
-    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
-    replace(Json& root, 
-                 const StringSource& location_str, 
-                 T&& value, 
-                 bool create_if_missing,
-                 std::error_code& ec)
-    {
-        auto jsonptr = basic_json_pointer<typename Json::char_type>::parse(location_str, ec);
-        if (JSONCONS_UNLIKELY(ec))
-        {
-            return;
+            JSONCONS_THROW(jsonpointer_error(ec));
         }
-        replace(root, jsonptr, std::forward<T>(value), create_if_missing, ec);
     }
 
-    template <typename Json,typename StringSource,typename T>
-    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
-    replace(Json& root, 
-                 const StringSource& location_str, 
+    template <typename Json,typename T>
+    void replace(Json& root, 
+                 const basic_json_pointer<typename Json::char_type>& location, 
                  T&& value, 
                  std::error_code& ec)
     {
-        replace(root, location_str, std::forward<T>(value), false, ec);
+        replace(root, location, std::forward<T>(value), false, ec);
     }
 
-    template <typename Json,typename StringSource,typename T>
-    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<typename Json::char_type>>::value,void>::type
-    replace(Json& root, 
-                 const StringSource& location_str, 
+    template <typename Json,typename T>
+    void replace(Json& root, 
+                 const basic_json_pointer<typename Json::char_type>& location, 
                  T&& value, 
                  bool create_if_missing = false)
     {
         std::error_code ec;
-        replace(root, location_str, std::forward<T>(value), create_if_missing, ec);
+        replace(root, location, std::forward<T>(value), create_if_missing, ec);
         if (JSONCONS_UNLIKELY(ec))
         {
             JSONCONS_THROW(jsonpointer_error(ec));
@@ -1175,7 +1614,17 @@ namespace jsonpointer {
 
     template <typename Json,typename T>
     void replace(Json& root, 
-                 const basic_json_pointer<typename Json::char_type>& location, 
+                 const basic_compiled_json_pointer<typename Json::char_type>& location, 
+                 T&& value, 
+                 bool create_if_missing,
+                 std::error_code& ec)
+    {
+        jsoncons::jsonpointer::detail::replace_value(root, location, std::forward<T>(value), create_if_missing, ec);
+    }
+
+    template <typename Json,typename T>
+    void replace(Json& root, 
+                 const basic_compiled_json_pointer<typename Json::char_type>& location, 
                  T&& value, 
                  std::error_code& ec)
     {
@@ -1184,7 +1633,7 @@ namespace jsonpointer {
 
     template <typename Json,typename T>
     void replace(Json& root, 
-                 const basic_json_pointer<typename Json::char_type>& location, 
+                 const basic_compiled_json_pointer<typename Json::char_type>& location, 
                  T&& value, 
                  bool create_if_missing = false)
     {
@@ -1196,6 +1645,253 @@ namespace jsonpointer {
         }
     }
 
+    // json_pointer_resolver
+
+    // Evaluates compiled JSON Pointers against one document, caching the value that 
+    // each pointer's parent resolves to. Modifications made through the resolver
+    // discard the cached values they may move or destroy. After modifying the document 
+    // in any other way, call invalidate().
+    template <typename Json>
+    class json_pointer_resolver
+    {
+    public:
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename Json::string_view_type;
+        using pointer_type = basic_compiled_json_pointer<char_type>;
+    private:
+        struct cache_entry
+        {
+            string_type parent;
+            Json* value{nullptr};
+            uint64_t generation{0};
+        };
+
+        Json* root_;
+        uint64_t generation_{0};
+        std::unordered_map<uint64_t,cache_entry> cache_;
+    public:
+        explicit json_pointer_resolver(Json& root)
+            : root_(std::addressof(root))
+        {
+        }
+
+        json_pointer_resolver(const json_pointer_resolver&) = default;
+        json_pointer_resolver(json_pointer_resolver&&) = default;
+        json_pointer_resolver& operator=(const json_pointer_resolver&) = default;
+        json_pointer_resolver& operator=(json_pointer_resolver&&) = default;
+
+        Json& root() const noexcept
+        {
+            return *root_;
+        }
+
+        uint64_t generation() const noexcept
+        {
+            return generation_;
+        }
+
+        // Discards all cached values without releasing the cache's memory
+        void invalidate() noexcept
+        {
+            ++generation_;
+        }
+
+        Json& get(const pointer_type& location, std::error_code& ec)
+        {
+            if (location.empty())
+            {
+                return *root_;
+            }
+            Json* parent = resolve_parent(location, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                return *parent;
+            }
+            return *jsoncons::jsonpointer::detail::resolve(parent, location[location.size()-1], false, ec);
+        }
+
+        Json& get(const pointer_type& location)
+        {
+            std::error_code ec;
+            Json& j = get(location, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(jsonpointer_error(ec));
+            }
+            return j;
+        }
+
+        bool contains(const pointer_type& location)
+        {
+            std::error_code ec;
+            get(location, ec);
+            return !ec ? true : false;
+        }
+
+        template <typename T>
+        void add(const pointer_type& location, T&& value, std::error_code& ec)
+        {
+            if (location.empty())
+            {
+                *root_ = std::forward<T>(value);
+                invalidate();
+                return;
+            }
+            Json* parent = resolve_parent(location, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                return;
+            }
+            jsoncons::jsonpointer::detail::add_child(parent, location[location.size()-1], std::forward<T>(value), ec);
+            discard_descendants(location.parent());
+        }
+
+        template <typename T>
+        void add(const pointer_type& location, T&& value)
+        {
+            std::error_code ec;
+            add(location, std::forward<T>(value), ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(jsonpointer_error(ec));
+            }
+        }
+
+        template <typename T>
+        void add_if_absent(const pointer_type& location, T&& value, std::error_code& ec)
+        {
+            if (location.empty())
+            {
+                *root_ = std::forward<T>(value);
+                invalidate();
+                return;
+            }
+            Json* parent = resolve_parent(location, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                return;
+            }
+            jsoncons::jsonpointer::detail::add_child_if_absent(parent, location[location.size()-1], std::forward<T>(value), ec);
+            discard_descendants(location.parent());
+        }
+
+        template <typename T>
+        void add_if_absent(const pointer_type& location, T&& value)
+        {
+            std::error_code ec;
+            add_if_absent(location, std::forward<T>(value), ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(jsonpointer_error(ec));
+            }
+        }
+
+        void remove(const pointer_type& location, std::error_code& ec)
+        {
+            if (location.empty())
+            {
+                ec = jsonpointer_errc::cannot_remove_root;
+                return;
+            }
+            Json* parent = resolve_parent(location, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                return;
+            }
+            jsoncons::jsonpointer::detail::remove_child(parent, location[location.size()-1], ec);
+            discard_descendants(location.parent());
+        }
+
+        void remove(const pointer_type& location)
+        {
+            std::error_code ec;
+            remove(location, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(jsonpointer_error(ec));
+            }
+        }
+
+        template <typename T>
+        void replace(const pointer_type& location, T&& value, std::error_code& ec)
+        {
+            if (location.empty())
+            {
+                *root_ = std::forward<T>(value);
+                invalidate();
+                return;
+            }
+            Json* parent = resolve_parent(location, ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                return;
+            }
+            jsoncons::jsonpointer::detail::replace_child(parent, location[location.size()-1], std::forward<T>(value), false, ec);
+            discard_descendants(location.parent());
+        }
+
+        template <typename T>
+        void replace(const pointer_type& location, T&& value)
+        {
+            std::error_code ec;
+            replace(location, std::forward<T>(value), ec);
+            if (JSONCONS_UNLIKELY(ec))
+            {
+                JSONCONS_THROW(jsonpointer_error(ec));
+            }
+        }
+
+    private:
+        Json* resolve_parent(const pointer_type& location, std::error_code& ec)
+        {
+            if (location.size() == 1)
+            {
+                return root_;
+            }
+            string_view_type parent = location.parent();
+            auto it = cache_.find(location.parent_hash());
+            if (it != cache_.end() && it->second.generation == generation_ && string_view_type(it->second.parent) == parent)
+            {
+                return it->second.value;
+            }
+
+            Json* current = root_;
+            for (std::size_t i = 0; i+1 < location.size(); ++i)
+            {
+                current = jsoncons::jsonpointer::detail::resolve(current, location[i], false, ec);
+                if (JSONCONS_UNLIKELY(ec))
+                {
+                    return current;
+                }
+            }
+            cache_entry& entry = cache_[location.parent_hash()];
+            entry.parent.assign(parent.data(), parent.size());
+            entry.value = current;
+            entry.generation = generation_;
+            return current;
+        }
+
+        // Changing the children of a value may move or destroy everything below it
+        void discard_descendants(const string_view_type& parent)
+        {
+            auto it = cache_.begin();
+            while (it != cache_.end())
+            {
+                const string_type& key = it->second.parent;
+                if (key.size() > parent.size() && key[parent.size()] == '/' && 
+                    key.compare(0, parent.size(), parent.data(), parent.size()) == 0)
+                {
+                    it = cache_.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    };
+
     template <typename String,typename Result>
     typename std::enable_if<std::is_convertible<typename String::value_type,typename Result::value_type>::value>::type
     escape(const String& s, Result& result)
@@ -1462,6 +2158,766 @@ namespace jsonpointer {
         }
     }
 
+    // basic_flatten_visitor
+
+    // Turns the events of each document into the events of its flattened form, as 
+    // computed by flatten: an object with a member for each leaf value, keyed by the 
+    // JSON Pointer to that value. Empty arrays and objects are leaves.
+    template <typename CharT>
+    class basic_flatten_visitor : public basic_json_visitor<CharT>
+    {
+    public:
+        using typename basic_json_visitor<CharT>::char_type;
+        using typename basic_json_visitor<CharT>::string_view_type;
+        using string_type = std::basic_string<char_type>;
+    private:
+        struct frame
+        {
+            std::size_t path_length; // length of the pointer to the container
+            std::size_t count;       // number of values seen
+            bool is_object;
+            semantic_tag tag;
+
+            frame(std::size_t path_length, bool is_object, semantic_tag tag)
+                : path_length(path_length), count(0), is_object(is_object), tag(tag)
+            {
+            }
+        };
+
+        basic_json_visitor<char_type>* destination_;
+        string_type path_;
+        std::vector<frame> stack_;
+    public:
+        explicit basic_flatten_visitor(basic_json_visitor<char_type>& destination)
+            : destination_(std::addressof(destination))
+        {
+        }
+
+        basic_json_visitor<char_type>& destination()
+        {
+            return *destination_;
+        }
+
+        void reset()
+        {
+            path_.clear();
+            stack_.clear();
+        }
+
+    private:
+        // Sets path_ to the location of the next value
+        void next_value()
+        {
+            if (stack_.empty())
+            {
+                path_.clear();
+                return;
+            }
+            frame& f = stack_.back();
+            if (!f.is_object)
+            {
+                path_.resize(f.path_length);
+                path_.push_back('/');
+                jsoncons::utility::from_integer(f.count, path_);
+            }
+            ++f.count;
+        }
+
+        void begin_leaf(const ser_context& context, std::error_code& ec)
+        {
+            bool top = stack_.empty();
+            next_value();
+            if (top)
+            {
+                destination_->begin_object(semantic_tag::none, context, ec);
+            }
+            destination_->key(path_, context, ec);
+        }
+
+        void end_leaf(const ser_context& context, std::error_code& ec)
+        {
+            if (stack_.empty())
+            {
+                destination_->end_object(context, ec);
+            }
+        }
+
+        void begin_container(bool is_object, semantic_tag tag, const ser_context& context, std::error_code& ec)
+        {
+            bool top = stack_.empty();
+            next_value();
+            if (top)
+            {
+                destination_->begin_object(semantic_tag::none, context, ec);
+            }
+            stack_.emplace_back(path_.size(), is_object, tag);
+        }
+
+        void end_container(const ser_context& context, std::error_code& ec)
+        {
+            JSONCONS_ASSERT(!stack_.empty());
+            frame f = stack_.back();
+            stack_.pop_back();
+            if (f.count == 0)
+            {
+                path_.resize(f.path_length);
+                destination_->key(path_, context, ec);
+                if (f.is_object)
+                {
+                    destination_->begin_object(f.tag, context, ec);
+                    destination_->end_object(context, ec);
+                }
+                else
+                {
+                    destination_->begin_array(f.tag, context, ec);
+                    destination_->end_array(context, ec);
+                }
+            }
+            if (stack_.empty())
+            {
+                destination_->end_object(context, ec);
+            }
+        }
+
+        void visit_flush() override
+        {
+            destination_->flush();
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_container(true, tag, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context& context, std::error_code& ec) override
+        {
+            end_container(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_container(false, tag, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context& context, std::error_code& ec) override
+        {
+            end_container(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            JSONCONS_ASSERT(!stack_.empty());
+            path_.resize(stack_.back().path_length);
+            path_.push_back('/');
+            escape(name, path_);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->null_value(tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->bool_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->string_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value, semantic_tag tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->byte_string_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value, uint64_t ext_tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->byte_string_value(value, ext_tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->uint64_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->int64_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_half(uint16_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->half_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            begin_leaf(context, ec);
+            destination_->double_value(value, tag, context, ec);
+            end_leaf(context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+    using flatten_visitor = basic_flatten_visitor<char>;
+    using wflatten_visitor = basic_flatten_visitor<wchar_t>;
+
+    // basic_unflatten_visitor
+
+    enum class unflatten_order {document, any};
+
+    // Rebuilds nested documents from the events of flattened documents, objects whose 
+    // keys are JSON Pointers. With unflatten_order::document, the keys must arrive in 
+    // document order, as flatten and basic_flatten_visitor produce them, and each 
+    // document is rebuilt as its members arrive. With unflatten_order::any, the members
+    // of each flattened document are held until its end, then sorted into document order. 
+    template <typename CharT>
+    class basic_unflatten_visitor : public basic_json_visitor<CharT>
+    {
+    public:
+        using typename basic_json_visitor<CharT>::char_type;
+        using typename basic_json_visitor<CharT>::string_view_type;
+        using string_type = std::basic_string<char_type>;
+        using pointer_type = basic_compiled_json_pointer<char_type>;
+    private:
+        using json_type = basic_json<char_type>;
+        using token_type = typename pointer_type::value_type;
+
+        struct frame
+        {
+            string_type token; // the container's token in its parent
+            std::size_t next_index;
+            bool is_array;
+
+            frame(const string_view_type& token, bool is_array)
+                : token(token.data(), token.size()), next_index(0), is_array(is_array)
+            {
+            }
+        };
+
+        struct member
+        {
+            pointer_type location;
+            json_type value;
+
+            member(pointer_type&& location, json_type&& value)
+                : location(std::move(location)), value(std::move(value))
+            {
+            }
+        };
+
+        // Passes values replayed from members to the destination without flushing it
+        class replay_filter : public basic_json_filter<char_type>
+        {
+        public:
+            using basic_json_filter<char_type>::basic_json_filter;
+        private:
+            void visit_flush() override
+            {
+            }
+        };
+
+        basic_json_visitor<char_type>* destination_;
+        unflatten_options options_;
+        unflatten_order order_;
+        std::size_t level_{0};        // nesting level of the incoming events
+        bool root_is_value_{false};   // the document was given by the pointer ""
+        pointer_type location_;
+        std::vector<frame> stack_;    // the open containers of the output, starting with the root
+
+        // unflatten_order::any
+        json_decoder<json_type> decoder_;
+        std::vector<member> members_;
+        const member* first_{nullptr}; // the members not yet replayed
+        const member* last_{nullptr};
+    public:
+        explicit basic_unflatten_visitor(basic_json_visitor<char_type>& destination,
+            unflatten_options options = unflatten_options::none,
+            unflatten_order order = unflatten_order::document)
+            : destination_(std::addressof(destination)), options_(options), order_(order)
+        {
+        }
+
+        basic_json_visitor<char_type>& destination()
+        {
+            return *destination_;
+        }
+
+        void reset()
+        {
+            level_ = 0;
+            root_is_value_ = false;
+            stack_.clear();
+            members_.clear();
+            decoder_.reset();
+        }
+
+    private:
+        basic_json_visitor<char_type>& target()
+        {
+            return order_ == unflatten_order::document ? *destination_ : static_cast<basic_json_visitor<char_type>&>(decoder_);
+        }
+
+        static bool is_array_start(const token_type& token)
+        {
+            return token.has_index() && token.index() == 0;
+        }
+
+        // Whether the container at the first depth tokens of location is an array
+        bool is_array_at(const pointer_type& location, std::size_t depth) const
+        {
+            if (options_ == unflatten_options::assume_object)
+            {
+                return false;
+            }
+            if (order_ == unflatten_order::document)
+            {
+                return is_array_start(location[depth]);
+            }
+            // The remaining members are sorted, so the container's children follow. 
+            // It is an array if their tokens are 0, 1, 2, ...
+            std::size_t expected = 0;
+            for (const member* p = first_; p != last_; ++p)
+            {
+                if (p->location.size() <= depth || !has_prefix(p->location, location, depth))
+                {
+                    break;
+                }
+                token_type token = p->location[depth];
+                if (!token.has_index() || (token.index() != expected && token.index()+1 != expected))
+                {
+                    return false;
+                }
+                if (token.index() == expected)
+                {
+                    ++expected;
+                }
+            }
+            return true;
+        }
+
+        static bool has_prefix(const pointer_type& location, const pointer_type& prefix, std::size_t length)
+        {
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                if (location[i].name() != prefix[i].name())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool token_less(const token_type& lhs, const token_type& rhs)
+        {
+            if (lhs.has_index() && rhs.has_index())
+            {
+                return lhs.index() < rhs.index();
+            }
+            if (lhs.has_index() != rhs.has_index())
+            {
+                return lhs.has_index();
+            }
+            return lhs.name() < rhs.name();
+        }
+
+        static bool document_order_less(const member& lhs, const member& rhs)
+        {
+            std::size_t length = (std::min)(lhs.location.size(), rhs.location.size());
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                token_type a = lhs.location[i];
+                token_type b = rhs.location[i];
+                if (token_less(a, b))
+                {
+                    return true;
+                }
+                if (token_less(b, a))
+                {
+                    return false;
+                }
+            }
+            return lhs.location.size() < rhs.location.size();
+        }
+
+        // Writes a member's key to the container at the top of the stack
+        void write_key(const token_type& token, const ser_context& context, std::error_code& ec)
+        {
+            frame& parent = stack_.back();
+            if (parent.is_array)
+            {
+                if (!token.has_index() || token.index() != parent.next_index)
+                {
+                    ec = jsonpointer_errc::flattened_key_out_of_order;
+                    return;
+                }
+                ++parent.next_index;
+            }
+            else
+            {
+                destination_->key(token.name(), context, ec);
+            }
+        }
+
+        void close_containers(std::size_t size, const ser_context& context, std::error_code& ec)
+        {
+            while (stack_.size() > size)
+            {
+                if (stack_.back().is_array)
+                {
+                    destination_->end_array(context, ec);
+                }
+                else
+                {
+                    destination_->end_object(context, ec);
+                }
+                stack_.pop_back();
+            }
+        }
+
+        // Closes the containers the previous location opened that don't contain location, 
+        // opens the ones it needs, and writes its key
+        void open_location(const pointer_type& location, const ser_context& context, std::error_code& ec)
+        {
+            if (root_is_value_ || (location.empty() && !stack_.empty()))
+            {
+                ec = jsonpointer_errc::invalid_flattened_key;
+                return;
+            }
+            if (location.empty())
+            {
+                root_is_value_ = true;
+                return;
+            }
+            if (stack_.empty())
+            {
+                bool is_array = is_array_at(location, 0);
+                stack_.emplace_back(string_view_type(), is_array);
+                if (is_array)
+                {
+                    destination_->begin_array(semantic_tag::none, context, ec);
+                }
+                else
+                {
+                    destination_->begin_object(semantic_tag::none, context, ec);
+                }
+            }
+
+            // stack_[i] is the container at the first i tokens of location
+            const std::size_t n = location.size();
+            std::size_t common = 1;
+            while (common < stack_.size() && common < n && 
+                   string_view_type(stack_[common].token) == location[common-1].name())
+            {
+                ++common;
+            }
+            close_containers(common, context, ec);
+
+            for (std::size_t depth = common; depth < n; ++depth)
+            {
+                token_type token = location[depth-1];
+                write_key(token, context, ec);
+                if (JSONCONS_UNLIKELY(ec))
+                {
+                    return;
+                }
+                bool is_array = is_array_at(location, depth);
+                stack_.emplace_back(token.name(), is_array);
+                if (is_array)
+                {
+                    destination_->begin_array(semantic_tag::none, context, ec);
+                }
+                else
+                {
+                    destination_->begin_object(semantic_tag::none, context, ec);
+                }
+            }
+            write_key(location[n-1], context, ec);
+        }
+
+        void end_document(const ser_context& context, std::error_code& ec)
+        {
+            if (order_ == unflatten_order::any)
+            {
+                std::stable_sort(members_.begin(), members_.end(), document_order_less);
+                replay_filter filter(*destination_);
+                first_ = members_.data();
+                last_ = members_.data() + members_.size();
+                while (first_ != last_ && !ec)
+                {
+                    open_location(first_->location, context, ec);
+                    if (!ec)
+                    {
+                        first_->value.dump(filter, ec);
+                    }
+                    ++first_;
+                }
+                members_.clear();
+            }
+            if (stack_.empty() && !root_is_value_)
+            {
+                destination_->begin_object(semantic_tag::none, context, ec);
+                destination_->end_object(context, ec);
+            }
+            close_containers(0, context, ec);
+            root_is_value_ = false;
+        }
+
+        // Called after each complete value of a member
+        void end_value()
+        {
+            if (order_ == unflatten_order::any)
+            {
+                members_.emplace_back(std::move(location_), decoder_.get_result());
+            }
+        }
+
+        bool at_document_level(std::error_code& ec)
+        {
+            if (level_ == 0)
+            {
+                ec = jsonpointer_errc::argument_to_unflatten_invalid;
+                return true;
+            }
+            return false;
+        }
+
+        void visit_flush() override
+        {
+            destination_->flush();
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_object(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (level_++ > 0)
+            {
+                target().begin_object(tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_object(const ser_context& context, std::error_code& ec) override
+        {
+            JSONCONS_ASSERT(level_ > 0);
+            if (--level_ == 0)
+            {
+                end_document(context, ec);
+            }
+            else
+            {
+                target().end_object(context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_begin_array(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                ++level_;
+                target().begin_array(tag, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_end_array(const ser_context& context, std::error_code& ec) override
+        {
+            if (level_ <= 1) // an array at document level, already reported
+            {
+                JSONCONS_VISITOR_RETURN;
+            }
+            target().end_array(context, ec);
+            if (--level_ == 1)
+            {
+                end_value();
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_key(const string_view_type& name, const ser_context& context, std::error_code& ec) override
+        {
+            if (level_ > 1)
+            {
+                target().key(name, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            std::error_code parse_ec;
+            location_ = pointer_type::parse(name, parse_ec);
+            if (JSONCONS_UNLIKELY(parse_ec))
+            {
+                ec = jsonpointer_errc::invalid_flattened_key;
+                JSONCONS_VISITOR_RETURN;
+            }
+            if (order_ == unflatten_order::document)
+            {
+                open_location(location_, context, ec);
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_null(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().null_value(tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().bool_value(value, tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_string(const string_view_type& value, semantic_tag tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().string_value(value, tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value, semantic_tag tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().byte_string_value(value, tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& value, uint64_t ext_tag, 
+            const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().byte_string_value(value, ext_tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_uint64(uint64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().uint64_value(value, tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_int64(int64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().int64_value(value, tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_half(uint16_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().half_value(value, tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_double(double value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (!at_document_level(ec))
+            {
+                target().double_value(value, tag, context, ec);
+                if (level_ == 1)
+                {
+                    end_value();
+                }
+            }
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+    using unflatten_visitor = basic_unflatten_visitor<char>;
+    using wunflatten_visitor = basic_unflatten_visitor<wchar_t>;
+
+
 } // namespace jsonpointer
 } // namespace jsoncons
 
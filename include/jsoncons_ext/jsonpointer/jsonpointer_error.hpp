@@ -56,7 +56,8 @@ enum class jsonpointer_errc
     argument_to_unflatten_invalid,
     invalid_flattened_key,
     invalid_uri_escaped_data,
-    cannot_remove_root
+    cannot_remove_root,
+    flattened_key_out_of_order
 };
 
 class jsonpointer_error_category_impl
@@ -95,6 +96,8 @@ public:
                 return "Flattened key is invalid";
             case jsonpointer_errc::cannot_remove_root:
                 return "Cannot remove root of target document";
+            case jsonpointer_errc::flattened_key_out_of_order:
+                return "Flattened key is not in document order";
             default:
                 return "Unknown jsonpointer error";
         }
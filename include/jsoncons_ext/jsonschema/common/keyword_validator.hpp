@@ -8,9 +8,11 @@
 #ifndef JSONCONS_EXT_JSONSCHEMA_COMMON_KEYWORD_VALIDATOR_HPP
 #define JSONCONS_EXT_JSONSCHEMA_COMMON_KEYWORD_VALIDATOR_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <system_error>
@@ -1100,11 +1102,26 @@ namespace jsonschema {
 
         static bool array_has_unique_items(const Json& a) 
         {
-            for (auto it = a.array_range().begin(); it != a.array_range().end(); ++it) 
+            if (a.size() < 2)
             {
-                for (auto jt = it+1; jt != a.array_range().end(); ++jt) 
+                return true;
+            }
+
+            // Equal items have equal hashes, so only items with the same hash need comparing
+            std::vector<std::pair<std::size_t,const Json*>> items;
+            items.reserve(a.size());
+            for (const auto& item : a.array_range())
+            {
+                items.emplace_back(item.hash(), std::addressof(item));
+            }
+            std::sort(items.begin(), items.end(), 
+                [](const std::pair<std::size_t,const Json*>& lhs, const std::pair<std::size_t,const Json*>& rhs){return lhs.first < rhs.first;});
+
+            for (auto it = items.begin(); it != items.end(); ++it) 
+            {
+                for (auto jt = it+1; jt != items.end() && jt->first == it->first; ++jt) 
                 {
-                    if (*it == *jt) 
+                    if (*(it->second) == *(jt->second)) 
                     {
                         return false; // contains duplicates 
                     }
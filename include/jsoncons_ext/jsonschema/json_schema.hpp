@@ -11,6 +11,7 @@
 
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/instrumentation.hpp>
 
 #include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
 #include <jsoncons_ext/jsonschema/common/schema_validator.hpp>
@@ -133,6 +134,7 @@ namespace jsonschema {
             jsonpointer::json_pointer instance_location{};
             Json patch(json_array_arg);
 
+            JSONCONS_INSTRUMENT_TIMER(validate);
             eval_context<Json> context;
             evaluation_results results;
             root_->validate(context, instance, instance_location, results, reporter, patch);
@@ -146,6 +148,7 @@ namespace jsonschema {
             jsonpointer::json_pointer instance_location{};
             Json patch(json_array_arg);
 
+            JSONCONS_INSTRUMENT_TIMER(validate);
             eval_context<Json> context;
             evaluation_results results;
             root_->validate(context, instance, instance_location, results, reporter, patch);
@@ -161,6 +164,7 @@ namespace jsonschema {
             Json patch(json_array_arg);
 
             error_reporter_adaptor adaptor(reporter);
+            JSONCONS_INSTRUMENT_TIMER(validate);
             eval_context<Json> context;
             evaluation_results results;
             root_->validate(context, instance, instance_location, results, adaptor, patch);
@@ -175,6 +179,7 @@ namespace jsonschema {
             patch = Json(json_array_arg);
 
             error_reporter_adaptor adaptor(std::forward<MsgReporter>(reporter));
+            JSONCONS_INSTRUMENT_TIMER(validate);
             eval_context<Json> context;
             evaluation_results results;
             root_->validate(context, instance, instance_location, results, adaptor, patch);
@@ -187,6 +192,7 @@ namespace jsonschema {
             patch = Json(json_array_arg);
 
             fail_early_reporter reporter;
+            JSONCONS_INSTRUMENT_TIMER(validate);
             eval_context<Json> context;
             evaluation_results results;
             root_->validate(context, instance, instance_location, results, reporter, patch);
@@ -200,6 +206,7 @@ namespace jsonschema {
             Json patch{json_array_arg};
 
             validation_message_to_json_events adaptor{ visitor };
+            JSONCONS_INSTRUMENT_TIMER(validate);
             eval_context<Json> context;
             evaluation_results results;
             error_reporter_adaptor reporter(adaptor);
@@ -213,6 +220,7 @@ namespace jsonschema {
         {
             jsonpointer::json_pointer instance_location{};
 
+            JSONCONS_INSTRUMENT_TIMER(validate);
             root_->walk(eval_context<Json>{}, instance, instance_location, reporter);
         }
         
@@ -223,6 +231,7 @@ namespace jsonschema {
             jsonpointer::json_pointer instance_location{};
             patch = Json(json_array_arg);
 
+            JSONCONS_INSTRUMENT_TIMER(validate);
             eval_context<Json> context;
             evaluation_results results;
             root_->validate(context, instance, instance_location, results, reporter, patch);
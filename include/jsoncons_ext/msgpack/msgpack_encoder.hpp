@@ -13,6 +13,7 @@
 #include <limits> // std::numeric_limits
 #include <memory>
 #include <system_error>
+#include <type_traits>
 #include <utility> // std::move
 #include <vector>
 
@@ -410,10 +411,7 @@ namespace msgpack {
                 binary::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
             }
 
-            for (auto c : sv)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::append_bytes(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
         }
 
         JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& b, 
@@ -442,10 +440,7 @@ namespace msgpack {
                 binary::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
             }
 
-            for (auto c : b)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::append_bytes(sink_, b.data(), b.size());
 
             end_value();
             JSONCONS_VISITOR_RETURN;
@@ -456,60 +451,284 @@ namespace msgpack {
             const ser_context&,
             std::error_code&) final
         {
-            const std::size_t length = b.size();
+            write_ext_header(b.size(), static_cast<uint8_t>(ext_tag));
+
+            jsoncons::detail::append_bytes(sink_, b.data(), b.size());
+
+            end_value();
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        void write_ext_header(std::size_t length, uint8_t ext_type)
+        {
             switch (length)
             {
                 case 1:
                     sink_.push_back(jsoncons::msgpack::msgpack_type::fixext1_type);
-                    sink_.push_back(static_cast<uint8_t>(ext_tag));
+                    sink_.push_back(ext_type);
                     break;
                 case 2:
                     sink_.push_back(jsoncons::msgpack::msgpack_type::fixext2_type);
-                    sink_.push_back(static_cast<uint8_t>(ext_tag));
+                    sink_.push_back(ext_type);
                     break;
                 case 4:
                     sink_.push_back(jsoncons::msgpack::msgpack_type::fixext4_type);
-                    sink_.push_back(static_cast<uint8_t>(ext_tag));
+                    sink_.push_back(ext_type);
                     break;
                 case 8:
                     sink_.push_back(jsoncons::msgpack::msgpack_type::fixext8_type);
-                    sink_.push_back(static_cast<uint8_t>(ext_tag));
+                    sink_.push_back(ext_type);
                     break;
                 case 16:
                     sink_.push_back(jsoncons::msgpack::msgpack_type::fixext16_type);
-                    sink_.push_back(static_cast<uint8_t>(ext_tag));
+                    sink_.push_back(ext_type);
                     break;
                 default:
                     if (length <= (std::numeric_limits<uint8_t>::max)())
                     {
                         sink_.push_back(jsoncons::msgpack::msgpack_type::ext8_type);
                         sink_.push_back(static_cast<uint8_t>(length));
-                        sink_.push_back(static_cast<uint8_t>(ext_tag));
+                        sink_.push_back(ext_type);
                     }
                     else if (length <= (std::numeric_limits<uint16_t>::max)())
                     {
                         sink_.push_back(jsoncons::msgpack::msgpack_type::ext16_type);
                         binary::native_to_big(static_cast<uint16_t>(length), std::back_inserter(sink_));
-                        sink_.push_back(static_cast<uint8_t>(ext_tag));
+                        sink_.push_back(ext_type);
                     }
                     else if (length <= (std::numeric_limits<uint32_t>::max)())
                     {
                         sink_.push_back(jsoncons::msgpack::msgpack_type::ext32_type);
                         binary::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
-                        sink_.push_back(static_cast<uint8_t>(ext_tag));
+                        sink_.push_back(ext_type);
                     }
                     break;
             }
+        }
 
-            for (auto c : b)
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const uint8_t>& data, 
+            semantic_tag tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
             {
-                sink_.push_back(c);
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
             }
+            write_typed_array(tag == semantic_tag::clamped ? msgpack_typed_array_type::uint8_clamped_array : msgpack_typed_array_type::uint8_array,
+                data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
 
-            end_value();
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const uint16_t>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::uint16_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const uint32_t>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::uint32_array, data.data(), data.size(), ec);
             JSONCONS_VISITOR_RETURN;
         }
 
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const uint64_t>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::uint64_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const int8_t>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::int8_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const int16_t>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::int16_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const int32_t>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::int32_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const int64_t>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::int64_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(half_arg_t, 
+            const jsoncons::span<const uint16_t>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_half_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::half_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const float>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::float_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const double>& data, 
+            semantic_tag,
+            const ser_context& context, 
+            std::error_code& ec) final
+        {
+            if (!options_.use_typed_arrays())
+            {
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+            write_typed_array(msgpack_typed_array_type::double_array, data.data(), data.size(), ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        // Element by element fallback, an array of numbers 
+        template <typename T>
+        void write_untyped_array(const jsoncons::span<const T>& data, const ser_context& context, std::error_code& ec)
+        {
+            this->begin_array(data.size(), semantic_tag::none, context, ec);
+            if (JSONCONS_UNLIKELY(ec)) {return;}
+            for (auto p = data.begin(); p != data.end(); ++p)
+            {
+                write_untyped_element(*p, context, ec);
+                if (JSONCONS_UNLIKELY(ec)) {return;}
+            }
+            this->end_array(context, ec);
+        }
+
+        void write_untyped_half_array(const jsoncons::span<const uint16_t>& data, const ser_context& context, std::error_code& ec)
+        {
+            this->begin_array(data.size(), semantic_tag::none, context, ec);
+            if (JSONCONS_UNLIKELY(ec)) {return;}
+            for (auto p = data.begin(); p != data.end(); ++p)
+            {
+                this->half_value(*p, semantic_tag::none, context, ec);
+                if (JSONCONS_UNLIKELY(ec)) {return;}
+            }
+            this->end_array(context, ec);
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+        write_untyped_element(T val, const ser_context& context, std::error_code& ec)
+        {
+            this->int64_value(val, semantic_tag::none, context, ec);
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+        write_untyped_element(T val, const ser_context& context, std::error_code& ec)
+        {
+            this->uint64_value(val, semantic_tag::none, context, ec);
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type
+        write_untyped_element(T val, const ser_context& context, std::error_code& ec)
+        {
+            this->double_value(val, semantic_tag::none, context, ec);
+        }
+
+        // Writes the elements in native byte order as an ext payload, prefixed with the element type
+        template <typename T>
+        void write_typed_array(uint8_t array_type, const T* data, std::size_t size, std::error_code& ec)
+        {
+            const std::size_t length = size*sizeof(T);
+            if (length >= (std::numeric_limits<uint32_t>::max)())
+            {
+                ec = msgpack_errc::too_many_items;
+                return;
+            }
+            if (sizeof(T) > 1 && jsoncons::endian::native == jsoncons::endian::little)
+            {
+                array_type |= msgpack_typed_array_type::little_endian_flag;
+            }
+            write_ext_header(length + 1, static_cast<uint8_t>(options_.typed_array_ext_type()));
+            sink_.push_back(array_type);
+            jsoncons::detail::append_bytes(sink_, reinterpret_cast<const uint8_t*>(data), length);
+            end_value();
+        }
+
         JSONCONS_VISITOR_RETURN_TYPE visit_double(double val, 
             semantic_tag,
             const ser_context&,
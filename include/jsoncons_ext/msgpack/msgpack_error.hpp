@@ -27,7 +27,8 @@ enum class msgpack_errc
     max_nesting_depth_exceeded,
     length_is_negative,
     invalid_timestamp,
-    unknown_type
+    unknown_type,
+    invalid_typed_array
 };
 
 class msgpack_error_category_impl
@@ -64,6 +65,8 @@ public:
                 return "Invalid timestamp";
             case msgpack_errc::unknown_type:
                 return "An unknown type was found in the stream";
+            case msgpack_errc::invalid_typed_array:
+                return "Invalid typed array ext payload";
             default:
                 return "Unknown MessagePack parser error";
         }
@@ -7,6 +7,7 @@
 #ifndef JSONCONS_EXT_MSGPACK_MSGPACK_OPTIONS_HPP
 #define JSONCONS_EXT_MSGPACK_MSGPACK_OPTIONS_HPP
 
+#include <cstdint>
 #include <cwchar>
 
 namespace jsoncons { 
@@ -19,6 +20,8 @@ class msgpack_options_common
     friend class msgpack_options;
 
     int max_nesting_depth_;
+    bool use_typed_arrays_{false};
+    int8_t typed_array_ext_type_{0x40};
 protected:
     virtual ~msgpack_options_common() = default;
 
@@ -36,6 +39,16 @@ public:
     {
         return max_nesting_depth_;
     }
+
+    bool use_typed_arrays() const 
+    {
+        return use_typed_arrays_;
+    }
+
+    int8_t typed_array_ext_type() const 
+    {
+        return typed_array_ext_type_;
+    }
 };
 
 class msgpack_decode_options : public virtual msgpack_options_common
@@ -60,12 +73,26 @@ class msgpack_options final : public msgpack_decode_options, public msgpack_enco
 {
 public:
     using msgpack_options_common::max_nesting_depth;
+    using msgpack_options_common::use_typed_arrays;
+    using msgpack_options_common::typed_array_ext_type;
 
     msgpack_options& max_nesting_depth(int value)
     {
         this->max_nesting_depth_ = value;
         return *this;
     }
+
+    msgpack_options& use_typed_arrays(bool value)
+    {
+        this->use_typed_arrays_ = value;
+        return *this;
+    }
+
+    msgpack_options& typed_array_ext_type(int8_t value)
+    {
+        this->typed_array_ext_type_ = value;
+        return *this;
+    }
 };
 
 } // namespace msgpack
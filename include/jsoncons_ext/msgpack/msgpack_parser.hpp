@@ -626,6 +626,10 @@ private:
                         more_ = !cursor_mode_;
                         if (!more_) return;
                     }
+                    else if (options_.use_typed_arrays() && ext_type == options_.typed_array_ext_type() && len > 0)
+                    {
+                        read_typed_array(visitor, static_cast<std::size_t>(len), ec);
+                    }
                     else
                     {
                         bytes_buffer_.clear();
@@ -669,6 +673,106 @@ private:
         }
     }
 
+    // Reads a typed array ext payload, an element type byte followed by the elements
+    void read_typed_array(item_event_visitor& visitor, std::size_t len, std::error_code& ec)
+    {
+        uint8_t array_type;
+        if (source_.read(&array_type, 1) == 0)
+        {
+            ec = msgpack_errc::unexpected_eof;
+            more_ = false;
+            return;
+        }
+        bytes_buffer_.clear();
+        if (source_reader<Source>::read(source_,bytes_buffer_,len-1) != len-1)
+        {
+            ec = msgpack_errc::unexpected_eof;
+            more_ = false;
+            return;
+        }
+
+        const bool is_float = (array_type & 0x10) != 0;
+        const std::size_t bytes_per_elem = std::size_t(1) << ((is_float ? 1 : 0) + (array_type & 0x03));
+        if (bytes_buffer_.size() % bytes_per_elem != 0)
+        {
+            ec = msgpack_errc::invalid_typed_array;
+            more_ = false;
+            return;
+        }
+        const jsoncons::endian e = (bytes_per_elem > 1 && (array_type & msgpack_typed_array_type::little_endian_flag) != 0) 
+            ? jsoncons::endian::little : jsoncons::endian::big;
+        const std::size_t size = bytes_buffer_.size()/bytes_per_elem;
+        uint8_t* data = bytes_buffer_.data();
+
+        switch (array_type)
+        {
+            case msgpack_typed_array_type::uint8_array:
+                visitor.typed_array(jsoncons::span<const uint8_t>(data, size), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::uint8_clamped_array:
+                visitor.typed_array(jsoncons::span<const uint8_t>(data, size), semantic_tag::clamped, *this, ec);
+                break;
+            case msgpack_typed_array_type::int8_array:
+                visitor.typed_array(jsoncons::span<const int8_t>(reinterpret_cast<const int8_t*>(data), size), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::uint16_array:
+            case msgpack_typed_array_type::uint16_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(to_native_span<uint16_t>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::uint32_array:
+            case msgpack_typed_array_type::uint32_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(to_native_span<uint32_t>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::uint64_array:
+            case msgpack_typed_array_type::uint64_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(to_native_span<uint64_t>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::int16_array:
+            case msgpack_typed_array_type::int16_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(to_native_span<int16_t>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::int32_array:
+            case msgpack_typed_array_type::int32_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(to_native_span<int32_t>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::int64_array:
+            case msgpack_typed_array_type::int64_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(to_native_span<int64_t>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::half_array:
+            case msgpack_typed_array_type::half_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(half_arg, to_native_span<uint16_t>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::float_array:
+            case msgpack_typed_array_type::float_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(to_native_span<float>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            case msgpack_typed_array_type::double_array:
+            case msgpack_typed_array_type::double_array | msgpack_typed_array_type::little_endian_flag:
+                visitor.typed_array(to_native_span<double>(data, size, e), semantic_tag::none, *this, ec);
+                break;
+            default:
+                ec = msgpack_errc::invalid_typed_array;
+                more_ = false;
+                return;
+        }
+        more_ = !cursor_mode_;
+    }
+
+    template <typename T>
+    static jsoncons::span<const T> to_native_span(uint8_t* data, std::size_t size, jsoncons::endian e)
+    {
+        T* p = reinterpret_cast<T*>(data);
+        if (e != jsoncons::endian::native)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                p[i] = binary::byte_swap<T>(p[i]);
+            }
+        }
+        return jsoncons::span<const T>(p, size);
+    }
+
     void begin_array(item_event_visitor& visitor, uint8_t type, std::error_code& ec)
     {
         if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
@@ -55,6 +55,27 @@ namespace msgpack {
         JSONCONS_INLINE_CONSTEXPR uint8_t map32_type = 0xdf;
         JSONCONS_INLINE_CONSTEXPR uint8_t negative_fixint_base_type = 0xe0;
     }
+
+    // Element type of a typed array ext payload, stored in the first byte of the payload.
+    // The codes follow the RFC 8746 CBOR typed array tags, 0b010_f_s_e_ll, where e 
+    // is set for little endian elements.
+    namespace msgpack_typed_array_type
+    {
+        JSONCONS_INLINE_CONSTEXPR uint8_t uint8_array = 0x40;
+        JSONCONS_INLINE_CONSTEXPR uint8_t uint16_array = 0x41;
+        JSONCONS_INLINE_CONSTEXPR uint8_t uint32_array = 0x42;
+        JSONCONS_INLINE_CONSTEXPR uint8_t uint64_array = 0x43;
+        JSONCONS_INLINE_CONSTEXPR uint8_t uint8_clamped_array = 0x44;
+        JSONCONS_INLINE_CONSTEXPR uint8_t int8_array = 0x48;
+        JSONCONS_INLINE_CONSTEXPR uint8_t int16_array = 0x49;
+        JSONCONS_INLINE_CONSTEXPR uint8_t int32_array = 0x4a;
+        JSONCONS_INLINE_CONSTEXPR uint8_t int64_array = 0x4b;
+        JSONCONS_INLINE_CONSTEXPR uint8_t half_array = 0x50;
+        JSONCONS_INLINE_CONSTEXPR uint8_t float_array = 0x51;
+        JSONCONS_INLINE_CONSTEXPR uint8_t double_array = 0x52;
+
+        JSONCONS_INLINE_CONSTEXPR uint8_t little_endian_flag = 0x04;
+    }
  
 } // namespace msgpack
 } // namespace jsoncons
@@ -0,0 +1,768 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_EXT_MSGPACK_TRANSCODE_MSGPACK_HPP
+#define JSONCONS_EXT_MSGPACK_TRANSCODE_MSGPACK_HPP
+
+#include <algorithm> // std::min
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <iterator> // std::back_inserter
+#include <limits> // std::numeric_limits
+#include <system_error>
+#include <type_traits>
+#include <utility> // std::forward
+#include <vector>
+
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/ser_util.hpp>
+#include <jsoncons/sink.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/utility/binary.hpp>
+#include <jsoncons/utility/more_type_traits.hpp>
+#include <jsoncons/utility/unicode_traits.hpp>
+
+#include <jsoncons_ext/cbor/cbor_encoder.hpp>
+#include <jsoncons_ext/cbor/cbor_options.hpp>
+#include <jsoncons_ext/cbor/cbor_reader.hpp>
+#include <jsoncons_ext/msgpack/msgpack_encoder.hpp>
+#include <jsoncons_ext/msgpack/msgpack_options.hpp>
+#include <jsoncons_ext/msgpack/msgpack_reader.hpp>
+#include <jsoncons_ext/msgpack/msgpack_type.hpp>
+
+namespace jsoncons {
+namespace msgpack {
+namespace detail {
+
+    // The transcoders below translate headers directly from one format to the other
+    // and copy string contents in bulk, in a single loop without going through the
+    // visitor interface. They produce the same output as a reader driving an encoder,
+    // and return false for input they do not handle, such as tags, ext types,
+    // indefinite lengths, non-string keys, and malformed or truncated data.
+
+    struct transcode_frame
+    {
+        std::size_t remaining; // items, or keys and values, left in the container
+        bool is_object;
+    };
+
+    template <typename ByteContainer>
+    class cbor_to_msgpack_transcoder
+    {
+        const uint8_t* p_;
+        const uint8_t* end_;
+        jsoncons::bytes_sink<ByteContainer> sink_;
+        std::size_t max_nesting_depth_;
+        std::vector<transcode_frame> stack_;
+    public:
+        cbor_to_msgpack_transcoder(const uint8_t* data, std::size_t length,
+            ByteContainer& cont, int max_nesting_depth)
+            : p_(data), end_(data + length), sink_(cont),
+              max_nesting_depth_(max_nesting_depth > 0 ? static_cast<std::size_t>(max_nesting_depth) : 0)
+        {
+        }
+
+        bool transcode()
+        {
+            do
+            {
+                bool is_key = false;
+                if (!stack_.empty())
+                {
+                    is_key = stack_.back().is_object && stack_.back().remaining % 2 == 0;
+                    --stack_.back().remaining;
+                }
+                if (!transcode_item(is_key))
+                {
+                    return false;
+                }
+                while (!stack_.empty() && stack_.back().remaining == 0)
+                {
+                    stack_.pop_back();
+                }
+            }
+            while (!stack_.empty());
+            return true;
+        }
+    private:
+        bool transcode_item(bool is_key)
+        {
+            if (p_ == end_)
+            {
+                return false;
+            }
+            const uint8_t b = *p_++;
+            const uint8_t major_type = b >> 5;
+            const uint8_t info = b & 0x1f;
+            if (is_key && major_type != 3)
+            {
+                return false;
+            }
+            uint64_t val;
+            if (!read_argument(info, val))
+            {
+                return false;
+            }
+
+            switch (major_type)
+            {
+                case 0: // unsigned integer
+                    write_uint64(val);
+                    break;
+                case 1: // negative integer
+                    if (val > static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+                    {
+                        return false;
+                    }
+                    write_negative_int64(-1 - static_cast<int64_t>(val));
+                    break;
+                case 2: // byte string
+                case 3: // text string
+                {
+                    if (val > static_cast<uint64_t>(end_ - p_) || val > (std::numeric_limits<uint32_t>::max)())
+                    {
+                        return false;
+                    }
+                    const std::size_t length = static_cast<std::size_t>(val);
+                    if (major_type == 3)
+                    {
+                        auto result = unicode_traits::validate(reinterpret_cast<const char*>(p_), length);
+                        if (result.ec != unicode_traits::conv_errc())
+                        {
+                            return false;
+                        }
+                        write_str_header(length);
+                    }
+                    else
+                    {
+                        write_bin_header(length);
+                    }
+                    jsoncons::detail::append_bytes(sink_, p_, length);
+                    p_ += length;
+                    break;
+                }
+                case 4: // array
+                case 5: // map
+                {
+                    if (val > (std::numeric_limits<uint32_t>::max)() || stack_.size() >= max_nesting_depth_)
+                    {
+                        return false;
+                    }
+                    const std::size_t length = static_cast<std::size_t>(val);
+                    if (major_type == 4)
+                    {
+                        write_container_header(length, msgpack_type::fixarray_base_type, msgpack_type::array16_type, msgpack_type::array32_type);
+                        stack_.push_back(transcode_frame{length, false});
+                    }
+                    else
+                    {
+                        write_container_header(length, msgpack_type::fixmap_base_type, msgpack_type::map16_type, msgpack_type::map32_type);
+                        stack_.push_back(transcode_frame{length*2, true});
+                    }
+                    break;
+                }
+                case 7: // simple values and floating point
+                    switch (info)
+                    {
+                        case 0x14:
+                            sink_.push_back(msgpack_type::false_type);
+                            break;
+                        case 0x15:
+                            sink_.push_back(msgpack_type::true_type);
+                            break;
+                        case 0x16: // null
+                        case 0x17: // undefined
+                            sink_.push_back(msgpack_type::nil_type);
+                            break;
+                        case 0x19:
+                            write_double(binary::decode_half(static_cast<uint16_t>(val)));
+                            break;
+                        case 0x1a:
+                        {
+                            float f;
+                            uint32_t bits = static_cast<uint32_t>(val);
+                            std::memcpy(&f, &bits, sizeof(f));
+                            write_double(f);
+                            break;
+                        }
+                        case 0x1b:
+                        {
+                            double d;
+                            std::memcpy(&d, &val, sizeof(d));
+                            write_double(d);
+                            break;
+                        }
+                        default:
+                            return false;
+                    }
+                    break;
+                default: // tags
+                    return false;
+            }
+            return true;
+        }
+
+        bool read_argument(uint8_t info, uint64_t& val)
+        {
+            if (info < 24)
+            {
+                val = info;
+                return true;
+            }
+            std::size_t n;
+            switch (info)
+            {
+                case 24: n = 1; break;
+                case 25: n = 2; break;
+                case 26: n = 4; break;
+                case 27: n = 8; break;
+                default: return false; // reserved, or indefinite length
+            }
+            if (static_cast<std::size_t>(end_ - p_) < n)
+            {
+                return false;
+            }
+            val = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                val = (val << 8) | *p_++;
+            }
+            return true;
+        }
+
+        void write_uint64(uint64_t val)
+        {
+            if (val <= 0x7f)
+            {
+                sink_.push_back(static_cast<uint8_t>(val));
+            }
+            else if (val <= (std::numeric_limits<uint8_t>::max)())
+            {
+                sink_.push_back(msgpack_type::uint8_type);
+                sink_.push_back(static_cast<uint8_t>(val));
+            }
+            else if (val <= (std::numeric_limits<uint16_t>::max)())
+            {
+                sink_.push_back(msgpack_type::uint16_type);
+                binary::native_to_big(static_cast<uint16_t>(val), std::back_inserter(sink_));
+            }
+            else if (val <= (std::numeric_limits<uint32_t>::max)())
+            {
+                sink_.push_back(msgpack_type::uint32_type);
+                binary::native_to_big(static_cast<uint32_t>(val), std::back_inserter(sink_));
+            }
+            else
+            {
+                sink_.push_back(msgpack_type::uint64_type);
+                binary::native_to_big(val, std::back_inserter(sink_));
+            }
+        }
+
+        void write_negative_int64(int64_t val)
+        {
+            if (val >= -32)
+            {
+                binary::native_to_big(static_cast<int8_t>(val), std::back_inserter(sink_));
+            }
+            else if (val >= (std::numeric_limits<int8_t>::lowest)())
+            {
+                sink_.push_back(msgpack_type::int8_type);
+                binary::native_to_big(static_cast<int8_t>(val), std::back_inserter(sink_));
+            }
+            else if (val >= (std::numeric_limits<int16_t>::lowest)())
+            {
+                sink_.push_back(msgpack_type::int16_type);
+                binary::native_to_big(static_cast<int16_t>(val), std::back_inserter(sink_));
+            }
+            else if (val >= (std::numeric_limits<int32_t>::lowest)())
+            {
+                sink_.push_back(msgpack_type::int32_type);
+                binary::native_to_big(static_cast<int32_t>(val), std::back_inserter(sink_));
+            }
+            else
+            {
+                sink_.push_back(msgpack_type::int64_type);
+                binary::native_to_big(val, std::back_inserter(sink_));
+            }
+        }
+
+        void write_double(double val)
+        {
+            float valf = (float)val;
+            if ((double)valf == val)
+            {
+                sink_.push_back(msgpack_type::float32_type);
+                binary::native_to_big(valf, std::back_inserter(sink_));
+            }
+            else
+            {
+                sink_.push_back(msgpack_type::float64_type);
+                binary::native_to_big(val, std::back_inserter(sink_));
+            }
+        }
+
+        void write_str_header(std::size_t length)
+        {
+            if (length <= 31)
+            {
+                sink_.push_back(msgpack_type::fixstr_base_type | static_cast<uint8_t>(length));
+            }
+            else if (length <= (std::numeric_limits<uint8_t>::max)())
+            {
+                sink_.push_back(msgpack_type::str8_type);
+                sink_.push_back(static_cast<uint8_t>(length));
+            }
+            else if (length <= (std::numeric_limits<uint16_t>::max)())
+            {
+                sink_.push_back(msgpack_type::str16_type);
+                binary::native_to_big(static_cast<uint16_t>(length), std::back_inserter(sink_));
+            }
+            else
+            {
+                sink_.push_back(msgpack_type::str32_type);
+                binary::native_to_big(static_cast<uint32_t>(length), std::back_inserter(sink_));
+            }
+        }
+
+        void write_bin_header(std::size_t length)
+        {
+            if (length <= (std::numeric_limits<uint8_t>::max)())
+            {
+                sink_.push_back(msgpack_type::bin8_type);
+                sink_.push_back(static_cast<uint8_t>(length));
+            }
+            else if (length <= (std::numeric_limits<uint16_t>::max)())
+            {
+                sink_.push_back(msgpack_type::bin16_type);
+                binary::native_to_big(static_cast<uint16_t>(length), std::back_inserter(sink_));
+            }
+            else
+            {
+                sink_.push_back(msgpack_type::bin32_type);
+                binary::native_to_big(static_cast<uint32_t>(length), std::back_inserter(sink_));
+            }
+        }
+
+        void write_container_header(std::size_t length, uint8_t fix_base_type, uint8_t type16, uint8_t type32)
+        {
+            if (length <= 15)
+            {
+                sink_.push_back(fix_base_type | static_cast<uint8_t>(length));
+            }
+            else if (length <= (std::numeric_limits<uint16_t>::max)())
+            {
+                sink_.push_back(type16);
+                binary::native_to_big(static_cast<uint16_t>(length), std::back_inserter(sink_));
+            }
+            else
+            {
+                sink_.push_back(type32);
+                binary::native_to_big(static_cast<uint32_t>(length), std::back_inserter(sink_));
+            }
+        }
+    };
+
+    template <typename ByteContainer>
+    class msgpack_to_cbor_transcoder
+    {
+        const uint8_t* p_;
+        const uint8_t* end_;
+        jsoncons::bytes_sink<ByteContainer> sink_;
+        std::size_t max_nesting_depth_;
+        std::vector<transcode_frame> stack_;
+    public:
+        msgpack_to_cbor_transcoder(const uint8_t* data, std::size_t length,
+            ByteContainer& cont, int max_nesting_depth)
+            : p_(data), end_(data + length), sink_(cont),
+              max_nesting_depth_(max_nesting_depth > 0 ? static_cast<std::size_t>(max_nesting_depth) : 0)
+        {
+        }
+
+        bool transcode()
+        {
+            do
+            {
+                bool is_key = false;
+                if (!stack_.empty())
+                {
+                    is_key = stack_.back().is_object && stack_.back().remaining % 2 == 0;
+                    --stack_.back().remaining;
+                }
+                if (!transcode_item(is_key))
+                {
+                    return false;
+                }
+                while (!stack_.empty() && stack_.back().remaining == 0)
+                {
+                    stack_.pop_back();
+                }
+            }
+            while (!stack_.empty());
+            return true;
+        }
+    private:
+        bool transcode_item(bool is_key)
+        {
+            if (p_ == end_)
+            {
+                return false;
+            }
+            const uint8_t type = *p_++;
+
+            if (type >= msgpack_type::fixstr_base_type && type <= 0xbf)
+            {
+                return transcode_string(type & 0x1f);
+            }
+            if (is_key && type != msgpack_type::str8_type && type != msgpack_type::str16_type && type != msgpack_type::str32_type)
+            {
+                return false;
+            }
+            if (type <= 0x7f)
+            {
+                write_header(0, type);
+                return true;
+            }
+            if (type >= msgpack_type::negative_fixint_base_type)
+            {
+                write_int64(static_cast<int8_t>(type));
+                return true;
+            }
+            if (type <= 0x8f)
+            {
+                return begin_container(type & 0x0f, true);
+            }
+            if (type <= 0x9f)
+            {
+                return begin_container(type & 0x0f, false);
+            }
+
+            switch (type)
+            {
+                case msgpack_type::nil_type:
+                    sink_.push_back(0xf6);
+                    return true;
+                case msgpack_type::false_type:
+                    sink_.push_back(0xf4);
+                    return true;
+                case msgpack_type::true_type:
+                    sink_.push_back(0xf5);
+                    return true;
+                case msgpack_type::float32_type:
+                {
+                    uint32_t bits;
+                    if (!read(bits))
+                    {
+                        return false;
+                    }
+                    float f;
+                    std::memcpy(&f, &bits, sizeof(f));
+                    write_double(f);
+                    return true;
+                }
+                case msgpack_type::float64_type:
+                {
+                    uint64_t bits;
+                    if (!read(bits))
+                    {
+                        return false;
+                    }
+                    double d;
+                    std::memcpy(&d, &bits, sizeof(d));
+                    write_double(d);
+                    return true;
+                }
+                case msgpack_type::uint8_type:
+                    return transcode_uint<uint8_t>();
+                case msgpack_type::uint16_type:
+                    return transcode_uint<uint16_t>();
+                case msgpack_type::uint32_type:
+                    return transcode_uint<uint32_t>();
+                case msgpack_type::uint64_type:
+                    return transcode_uint<uint64_t>();
+                case msgpack_type::int8_type:
+                    return transcode_int<uint8_t,int8_t>();
+                case msgpack_type::int16_type:
+                    return transcode_int<uint16_t,int16_t>();
+                case msgpack_type::int32_type:
+                    return transcode_int<uint32_t,int32_t>();
+                case msgpack_type::int64_type:
+                    return transcode_int<uint64_t,int64_t>();
+                case msgpack_type::str8_type:
+                case msgpack_type::bin8_type:
+                {
+                    uint8_t length;
+                    return read(length) && transcode_bytes(type, length);
+                }
+                case msgpack_type::str16_type:
+                case msgpack_type::bin16_type:
+                {
+                    uint16_t length;
+                    return read(length) && transcode_bytes(type, length);
+                }
+                case msgpack_type::str32_type:
+                case msgpack_type::bin32_type:
+                {
+                    uint32_t length;
+                    return read(length) && transcode_bytes(type, length);
+                }
+                case msgpack_type::array16_type:
+                {
+                    uint16_t length;
+                    return read(length) && begin_container(length, false);
+                }
+                case msgpack_type::array32_type:
+                {
+                    uint32_t length;
+                    return read(length) && begin_container(length, false);
+                }
+                case msgpack_type::map16_type:
+                {
+                    uint16_t length;
+                    return read(length) && begin_container(length, true);
+                }
+                case msgpack_type::map32_type:
+                {
+                    uint32_t length;
+                    return read(length) && begin_container(length, true);
+                }
+                default: // ext types and the unused type 0xc1
+                    return false;
+            }
+        }
+
+        template <typename T>
+        bool read(T& val)
+        {
+            if (static_cast<std::size_t>(end_ - p_) < sizeof(T))
+            {
+                return false;
+            }
+            val = binary::big_to_native<T>(p_, sizeof(T));
+            p_ += sizeof(T);
+            return true;
+        }
+
+        template <typename T>
+        bool transcode_uint()
+        {
+            T val;
+            if (!read(val))
+            {
+                return false;
+            }
+            write_header(0, val);
+            return true;
+        }
+
+        template <typename U,typename T>
+        bool transcode_int()
+        {
+            U bits;
+            if (!read(bits))
+            {
+                return false;
+            }
+            write_int64(static_cast<T>(bits));
+            return true;
+        }
+
+        bool transcode_bytes(uint8_t type, std::size_t length)
+        {
+            if (type == msgpack_type::bin8_type || type == msgpack_type::bin16_type || type == msgpack_type::bin32_type)
+            {
+                if (length > static_cast<std::size_t>(end_ - p_))
+                {
+                    return false;
+                }
+                write_header(2, length);
+                jsoncons::detail::append_bytes(sink_, p_, length);
+                p_ += length;
+                return true;
+            }
+            return transcode_string(length);
+        }
+
+        bool transcode_string(std::size_t length)
+        {
+            if (length > static_cast<std::size_t>(end_ - p_))
+            {
+                return false;
+            }
+            auto result = unicode_traits::validate(reinterpret_cast<const char*>(p_), length);
+            if (result.ec != unicode_traits::conv_errc())
+            {
+                return false;
+            }
+            write_header(3, length);
+            jsoncons::detail::append_bytes(sink_, p_, length);
+            p_ += length;
+            return true;
+        }
+
+        bool begin_container(std::size_t length, bool is_object)
+        {
+            if (stack_.size() >= max_nesting_depth_)
+            {
+                return false;
+            }
+            write_header(is_object ? 5 : 4, length);
+            stack_.push_back(transcode_frame{is_object ? length*2 : length, is_object});
+            return true;
+        }
+
+        // Writes a major type and argument in the shortest form
+        void write_header(uint8_t major_type, uint64_t val)
+        {
+            const uint8_t base = static_cast<uint8_t>(major_type << 5);
+            if (val <= 0x17)
+            {
+                sink_.push_back(static_cast<uint8_t>(base + val));
+            }
+            else if (val <= (std::numeric_limits<uint8_t>::max)())
+            {
+                sink_.push_back(static_cast<uint8_t>(base + 0x18));
+                sink_.push_back(static_cast<uint8_t>(val));
+            }
+            else if (val <= (std::numeric_limits<uint16_t>::max)())
+            {
+                sink_.push_back(static_cast<uint8_t>(base + 0x19));
+                binary::native_to_big(static_cast<uint16_t>(val), std::back_inserter(sink_));
+            }
+            else if (val <= (std::numeric_limits<uint32_t>::max)())
+            {
+                sink_.push_back(static_cast<uint8_t>(base + 0x1a));
+                binary::native_to_big(static_cast<uint32_t>(val), std::back_inserter(sink_));
+            }
+            else
+            {
+                sink_.push_back(static_cast<uint8_t>(base + 0x1b));
+                binary::native_to_big(val, std::back_inserter(sink_));
+            }
+        }
+
+        void write_int64(int64_t val)
+        {
+            if (val >= 0)
+            {
+                write_header(0, static_cast<uint64_t>(val));
+            }
+            else
+            {
+                write_header(1, static_cast<uint64_t>(-1 - val));
+            }
+        }
+
+        void write_double(double val)
+        {
+            float valf = (float)val;
+            if ((double)valf == val)
+            {
+                sink_.push_back(0xfa);
+                binary::native_to_big(valf, std::back_inserter(sink_));
+            }
+            else
+            {
+                sink_.push_back(0xfb);
+                binary::native_to_big(val, std::back_inserter(sink_));
+            }
+        }
+    };
+
+} // namespace detail
+
+    // Transcodes one CBOR data item to MessagePack. Items the direct path does not handle,
+    // such as tags and indefinite lengths, are transcoded through a basic_cbor_reader
+    // driving a basic_msgpack_encoder.
+
+    template <typename BytesLike,typename ByteContainer>
+    typename std::enable_if<ext_traits::is_byte_sequence<BytesLike>::value &&
+                            ext_traits::is_back_insertable_byte_container<ByteContainer>::value,write_result>::type
+    try_cbor_to_msgpack(const BytesLike& source,
+        ByteContainer& cont,
+        const cbor::cbor_decode_options& decode_options = cbor::cbor_decode_options(),
+        const msgpack_encode_options& encode_options = msgpack_encode_options())
+    {
+        const std::size_t initial_size = cont.size();
+        detail::cbor_to_msgpack_transcoder<ByteContainer> transcoder(reinterpret_cast<const uint8_t*>(source.data()), source.size(),
+            cont, (std::min)(decode_options.max_nesting_depth(), encode_options.max_nesting_depth()));
+        if (transcoder.transcode())
+        {
+            return write_result{};
+        }
+
+        cont.resize(initial_size);
+        std::error_code ec;
+        basic_msgpack_encoder<jsoncons::bytes_sink<ByteContainer>> encoder(cont, encode_options);
+        cbor::basic_cbor_reader<jsoncons::bytes_source> reader(source, encoder, decode_options);
+        reader.read(ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return write_result{unexpect, ec};
+        }
+        return write_result{};
+    }
+
+    // Transcodes one MessagePack value to CBOR. Values the direct path does not handle,
+    // such as ext types, and encode options that change the output, such as pack_strings,
+    // are transcoded through a basic_msgpack_reader driving a basic_cbor_encoder.
+
+    template <typename BytesLike,typename ByteContainer>
+    typename std::enable_if<ext_traits::is_byte_sequence<BytesLike>::value &&
+                            ext_traits::is_back_insertable_byte_container<ByteContainer>::value,write_result>::type
+    try_msgpack_to_cbor(const BytesLike& source,
+        ByteContainer& cont,
+        const msgpack_decode_options& decode_options = msgpack_decode_options(),
+        const cbor::cbor_encode_options& encode_options = cbor::cbor_encode_options())
+    {
+        const std::size_t initial_size = cont.size();
+        if (!encode_options.pack_strings())
+        {
+            detail::msgpack_to_cbor_transcoder<ByteContainer> transcoder(reinterpret_cast<const uint8_t*>(source.data()), source.size(),
+                cont, (std::min)(decode_options.max_nesting_depth(), encode_options.max_nesting_depth()));
+            if (transcoder.transcode())
+            {
+                return write_result{};
+            }
+            cont.resize(initial_size);
+        }
+
+        std::error_code ec;
+        cbor::basic_cbor_encoder<jsoncons::bytes_sink<ByteContainer>> encoder(cont, encode_options);
+        basic_msgpack_reader<jsoncons::bytes_source> reader(source, encoder, decode_options);
+        reader.read(ec);
+        if (JSONCONS_UNLIKELY(ec))
+        {
+            return write_result{unexpect, ec};
+        }
+        return write_result{};
+    }
+
+    template <typename... Args>
+    void cbor_to_msgpack(Args&& ... args)
+    {
+        auto r = try_cbor_to_msgpack(std::forward<Args>(args)...);
+        if (!r)
+        {
+            JSONCONS_THROW(ser_error(r.error()));
+        }
+    }
+
+    template <typename... Args>
+    void msgpack_to_cbor(Args&& ... args)
+    {
+        auto r = try_msgpack_to_cbor(std::forward<Args>(args)...);
+        if (!r)
+        {
+            JSONCONS_THROW(ser_error(r.error()));
+        }
+    }
+
+} // namespace msgpack
+} // namespace jsoncons
+
+#endif // JSONCONS_EXT_MSGPACK_TRANSCODE_MSGPACK_HPP
@@ -8,10 +8,12 @@
 #define JSONCONS_EXT_UBJSON_UBJSON_ENCODER_HPP
 
 #include <cstddef>
+#include <algorithm> // std::min
 #include <cstdint>
 #include <limits> // std::numeric_limits
 #include <memory>
 #include <system_error>
+#include <type_traits>
 #include <utility> // std::move
 #include <vector>
 
@@ -88,6 +90,8 @@ private:
 
     std::vector<stack_item> stack_;
     int nesting_depth_{0};
+
+    static constexpr std::size_t typed_array_block_size = 1024;
 public:
 
     // Noncopyable and nonmoveable
@@ -364,6 +368,295 @@ private:
         JSONCONS_VISITOR_RETURN;
     }
 
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const uint8_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        write_typed_array_header(ubjson_type::uint8_type, data.size());
+        jsoncons::detail::append_bytes(sink_, data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const uint16_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        // UBJSON has no unsigned 16 bit type, widen to int32
+        write_typed_array_header(ubjson_type::int32_type, data.size());
+        write_typed_array_elements<int32_t>(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const uint32_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        // UBJSON has no unsigned 32 bit type, widen to int64
+        write_typed_array_header(ubjson_type::int64_type, data.size());
+        write_typed_array_elements<int64_t>(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const uint64_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        for (auto val : data)
+        {
+            if (val > static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+            {
+                // Not representable as a UBJSON int64, write element by element
+                write_untyped_array(data, context, ec);
+                JSONCONS_VISITOR_RETURN;
+            }
+        }
+        write_typed_array_header(ubjson_type::int64_type, data.size());
+        write_typed_array_elements<int64_t>(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const int8_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        write_typed_array_header(ubjson_type::int8_type, data.size());
+        jsoncons::detail::append_bytes(sink_, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const int16_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        write_typed_array_header(ubjson_type::int16_type, data.size());
+        write_typed_array_elements<int16_t>(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const int32_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        write_typed_array_header(ubjson_type::int32_type, data.size());
+        write_typed_array_elements<int32_t>(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const int64_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        write_typed_array_header(ubjson_type::int64_type, data.size());
+        write_typed_array_elements<int64_t>(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(half_arg_t, 
+        const jsoncons::span<const uint16_t>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_half_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        // UBJSON has no half precision type, widen to float32
+        write_typed_array_header(ubjson_type::float32_type, data.size());
+        write_half_array_elements(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const float>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        write_typed_array_header(ubjson_type::float32_type, data.size());
+        write_typed_array_elements<float>(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const jsoncons::span<const double>& data, 
+        semantic_tag,
+        const ser_context& context, 
+        std::error_code& ec) override
+    {
+        if (!options_.use_typed_arrays())
+        {
+            write_untyped_array(data, context, ec);
+            JSONCONS_VISITOR_RETURN;
+        }
+        write_typed_array_header(ubjson_type::float64_type, data.size());
+        write_typed_array_elements<double>(data.data(), data.size());
+        end_value();
+        JSONCONS_VISITOR_RETURN;
+    }
+
+    // Element by element fallback, an array of numbers 
+    template <typename T>
+    void write_untyped_array(const jsoncons::span<const T>& data, const ser_context& context, std::error_code& ec)
+    {
+        this->begin_array(data.size(), semantic_tag::none, context, ec);
+        if (JSONCONS_UNLIKELY(ec)) {return;}
+        for (auto p = data.begin(); p != data.end(); ++p)
+        {
+            write_untyped_element(*p, context, ec);
+            if (JSONCONS_UNLIKELY(ec)) {return;}
+        }
+        this->end_array(context, ec);
+    }
+
+    void write_untyped_half_array(const jsoncons::span<const uint16_t>& data, const ser_context& context, std::error_code& ec)
+    {
+        this->begin_array(data.size(), semantic_tag::none, context, ec);
+        if (JSONCONS_UNLIKELY(ec)) {return;}
+        for (auto p = data.begin(); p != data.end(); ++p)
+        {
+            this->half_value(*p, semantic_tag::none, context, ec);
+            if (JSONCONS_UNLIKELY(ec)) {return;}
+        }
+        this->end_array(context, ec);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    write_untyped_element(T val, const ser_context& context, std::error_code& ec)
+    {
+        this->int64_value(val, semantic_tag::none, context, ec);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    write_untyped_element(T val, const ser_context& context, std::error_code& ec)
+    {
+        this->uint64_value(val, semantic_tag::none, context, ec);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+    write_untyped_element(T val, const ser_context& context, std::error_code& ec)
+    {
+        this->double_value(val, semantic_tag::none, context, ec);
+    }
+
+    // Strongly typed array, [$<type>#<count> followed by count elements without markers
+    void write_typed_array_header(uint8_t type, std::size_t length)
+    {
+        sink_.push_back(jsoncons::ubjson::ubjson_type::start_array_marker);
+        sink_.push_back(jsoncons::ubjson::ubjson_type::type_marker);
+        sink_.push_back(type);
+        sink_.push_back(jsoncons::ubjson::ubjson_type::count_marker);
+        put_length(length);
+    }
+
+    // Converts elements to big endian a block at a time, so that the sink sees
+    // a few large appends rather than a push_back per byte
+    template <typename To,typename From>
+    void write_typed_array_elements(const From* data, std::size_t length)
+    {
+        uint8_t buf[typed_array_block_size];
+        const std::size_t elements_per_block = sizeof(buf)/sizeof(To);
+
+        std::size_t i = 0;
+        while (i < length)
+        {
+            const std::size_t n = (std::min)(elements_per_block, length - i);
+            uint8_t* p = buf;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                binary::native_to_big(static_cast<To>(data[i+j]), p);
+                p += sizeof(To);
+            }
+            jsoncons::detail::append_bytes(sink_, buf, n*sizeof(To));
+            i += n;
+        }
+    }
+
+    void write_half_array_elements(const uint16_t* data, std::size_t length)
+    {
+        uint8_t buf[typed_array_block_size];
+        const std::size_t elements_per_block = sizeof(buf)/sizeof(float);
+
+        std::size_t i = 0;
+        while (i < length)
+        {
+            const std::size_t n = (std::min)(elements_per_block, length - i);
+            uint8_t* p = buf;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                binary::native_to_big(static_cast<float>(binary::decode_half(data[i+j])), p);
+                p += sizeof(float);
+            }
+            jsoncons::detail::append_bytes(sink_, buf, n*sizeof(float));
+            i += n;
+        }
+    }
+
     JSONCONS_VISITOR_RETURN_TYPE visit_double(double val, 
                          semantic_tag,
                          const ser_context&,
@@ -14,6 +14,7 @@
 
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/instrumentation.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/source.hpp>
 #include <jsoncons_ext/ubjson/ubjson_error.hpp>
@@ -62,6 +63,7 @@ public:
 
     void read(std::error_code& ec)
     {
+        JSONCONS_INSTRUMENT_TIMER(parse);
         parser_.reset();
         parser_.parse(visitor_, ec);
         if (JSONCONS_UNLIKELY(ec))
@@ -416,6 +416,134 @@ TEST_CASE("encode stringref")
     CHECK(j2 == j);
 }
 
+TEST_CASE("cbor encode with packed strings")
+{
+    SECTION("many repeated strings")
+    {
+        json j(json_array_arg);
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            j.push_back("string " + std::to_string(i % 300));
+        }
+
+        auto options = cbor::cbor_options{}
+            .pack_strings(true);
+        std::vector<uint8_t> buf;
+        cbor::encode_cbor(j, buf, options);
+
+        std::vector<uint8_t> unpacked;
+        cbor::encode_cbor(j, unpacked);
+        CHECK(buf.size() < unpacked.size());
+
+        json j2 = cbor::decode_cbor<json>(buf);
+        CHECK(j2 == j);
+    }
+    SECTION("text and byte strings with the same bytes")
+    {
+        json j(json_array_arg);
+        j.push_back("abcdef");
+        j.emplace_back(byte_string_arg, std::vector<uint8_t>{'a','b','c','d','e','f'});
+        j.push_back("abcdef");
+        j.emplace_back(byte_string_arg, std::vector<uint8_t>{'a','b','c','d','e','f'});
+
+        auto options = cbor::cbor_options{}
+            .pack_strings(true);
+        std::vector<uint8_t> buf;
+        cbor::encode_cbor(j, buf, options);
+
+        std::vector<uint8_t> expected = {0xd9,0x01,0x00, // tag(256)
+            0x84, 
+            0x66,'a','b','c','d','e','f', 
+            0x46,'a','b','c','d','e','f', 
+            0xd8,0x19,0x00, // tag(25), 0
+            0xd8,0x19,0x01}; // tag(25), 1
+        CHECK(buf == expected);
+
+        json j2 = cbor::decode_cbor<json>(buf);
+        CHECK(j2 == j);
+    }
+}
+
+TEST_CASE("cbor encode with preset stringrefs")
+{
+    ojson j = ojson::parse(R"(
+[
+    {"name" : "John", "department" : "sales"},
+    {"name" : "Jane", "department" : "marketing"}
+]
+    )");
+
+    std::vector<std::string> presets = {"name","department","sales"};
+    auto options = cbor::cbor_options{}
+        .pack_strings(true)
+        .preset_stringrefs(presets);
+
+    std::vector<uint8_t> buf;
+    cbor::encode_cbor(j, buf, options);
+
+    std::vector<uint8_t> expected = {0xd9,0x01,0x00, // tag(256)
+        0x82, 
+        0xa2, 
+        0xd8,0x19,0x00, // "name"
+        0x64,'J','o','h','n', 
+        0xd8,0x19,0x01, // "department" 
+        0xd8,0x19,0x02, // "sales"
+        0xa2, 
+        0xd8,0x19,0x00, // "name"
+        0x64,'J','a','n','e', 
+        0xd8,0x19,0x01, // "department"
+        0x69,'m','a','r','k','e','t','i','n','g'};
+    CHECK(buf == expected);
+
+    ojson j2 = cbor::decode_cbor<ojson>(buf, options);
+    CHECK(j2 == j);
+
+    // Without the presets the references are out of range
+    REQUIRE_THROWS(cbor::decode_cbor<ojson>(buf));
+}
+
+TEST_CASE("cbor encode top level string with preset stringrefs")
+{
+    std::vector<std::string> presets = {"status","value"};
+    auto options = cbor::cbor_options{}
+        .pack_strings(true)
+        .preset_stringrefs(presets);
+
+    SECTION("preset string")
+    {
+        std::vector<uint8_t> buf;
+        cbor::encode_cbor(json("value"), buf, options);
+
+        std::vector<uint8_t> expected = {0xd9,0x01,0x00, // tag(256)
+            0xd8,0x19,0x01}; // "value"
+        CHECK(buf == expected);
+
+        json j = cbor::decode_cbor<json>(buf, options);
+        CHECK(j == json("value"));
+    }
+
+    SECTION("other scalars")
+    {
+        std::vector<json> values = {json("other"), json(""), json(10), json(-1.5), json::null(), 
+            json(byte_string_arg, std::vector<uint8_t>{'v','a','l','u','e'})};
+        for (const auto& val : values)
+        {
+            std::vector<uint8_t> buf;
+            cbor::encode_cbor(val, buf, options);
+            CHECK(cbor::decode_cbor<json>(buf, options) == val);
+        }
+    }
+
+    SECTION("preset string in a tagged item inside an array")
+    {
+        std::vector<uint8_t> buf = {0x82,
+            0xd9,0x01,0x00, 0xd8,0x19,0x00, // tag(256) "status"
+            0x66,'s','t','a','t','u','s'};
+        json j = cbor::decode_cbor<json>(buf, options);
+        CHECK(j == json::parse(R"(["status","status"])"));
+    }
+}
+
 TEST_CASE("cbor encode with semantic_tags")
 {
     SECTION("string")
@@ -822,3 +822,137 @@ TEST_CASE("cbor typed array tests")
     }
 } 
 
+
+namespace {
+
+    struct cbor_view_visitor : public default_json_visitor
+    {
+        const uint8_t* bytes_data{nullptr};
+        std::size_t bytes_size{0};
+        const float* float_data{nullptr};
+        std::vector<float> floats;
+    private:
+        JSONCONS_VISITOR_RETURN_TYPE visit_byte_string(const byte_string_view& b,  
+            semantic_tag,
+            const ser_context&,
+            std::error_code&) override
+        {
+            bytes_data = b.data();
+            bytes_size = b.size();
+            JSONCONS_VISITOR_RETURN;
+        }
+
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const span<const float>& data,  
+            semantic_tag,
+            const ser_context&,
+            std::error_code&) override
+        {
+            float_data = data.data();
+            floats = std::vector<float>(data.begin(),data.end());
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+    bool points_into(const void* p, const std::vector<uint8_t>& input)
+    {
+        auto q = static_cast<const uint8_t*>(p);
+        return q >= input.data() && q < input.data() + input.size();
+    }
+
+} // namespace
+
+TEST_CASE("cbor zero copy views of contiguous input")
+{
+    SECTION("byte string")
+    {
+        const std::vector<uint8_t> input = {0x43,'a','b','c'};
+
+        cbor_view_visitor visitor;
+        cbor::cbor_bytes_reader reader(input, visitor);
+        reader.read();
+        CHECK(visitor.bytes_size == 3);
+        CHECK(visitor.bytes_data == input.data() + 1);
+    }
+
+    SECTION("indefinite length byte string is copied")
+    {
+        const std::vector<uint8_t> input = {0x5f,0x42,'a','b',0x41,'c',0xff};
+
+        cbor_view_visitor visitor;
+        cbor::cbor_bytes_reader reader(input, visitor);
+        reader.read();
+        REQUIRE(visitor.bytes_size == 3);
+        CHECK_FALSE(points_into(visitor.bytes_data, input));
+        CHECK(std::string(visitor.bytes_data, visitor.bytes_data+3) == "abc");
+    }
+
+    SECTION("aligned native typed array")
+    {
+        std::vector<float> u = {1.0f, 2.5f, -3.0f};
+
+        std::vector<uint8_t> buf;
+        auto options = cbor::cbor_options{}
+            .use_typed_arrays(true);
+        cbor::encode_cbor(u, buf, options);
+        REQUIRE(buf.size() == 3 + u.size()*sizeof(float));
+
+        // one byte of padding puts the 3 byte header at offset 1, the elements at offset 4 
+        std::vector<uint8_t> input(buf.size() + 1);
+        std::copy(buf.begin(), buf.end(), input.begin() + 1);
+        jsoncons::span<const uint8_t> s(input.data() + 1, buf.size());
+
+        cbor_view_visitor visitor;
+        cbor::cbor_bytes_reader reader(s, visitor);
+        reader.read();
+        CHECK(visitor.floats == u);
+        if (reinterpret_cast<std::uintptr_t>(input.data() + 4) % alignof(float) == 0)
+        {
+            CHECK(points_into(visitor.float_data, input));
+        }
+    }
+
+    SECTION("misaligned typed array is copied")
+    {
+        std::vector<float> u = {1.0f, 2.5f, -3.0f};
+
+        std::vector<uint8_t> input;
+        auto options = cbor::cbor_options{}
+            .use_typed_arrays(true);
+        cbor::encode_cbor(u, input, options);
+
+        cbor_view_visitor visitor;
+        cbor::cbor_bytes_reader reader(input, visitor);
+        reader.read();
+        CHECK(visitor.floats == u);
+        CHECK(reinterpret_cast<std::uintptr_t>(visitor.float_data) % alignof(float) == 0);
+    }
+
+    SECTION("foreign endian typed array is swapped")
+    {
+        const std::vector<uint8_t> big = {0xd8,0x51,0x48, 0x3f,0x80,0x00,0x00, 0xc0,0x40,0x00,0x00};
+        const std::vector<uint8_t> little = {0xd8,0x55,0x48, 0x00,0x00,0x80,0x3f, 0x00,0x00,0x40,0xc0};
+
+        cbor_view_visitor visitor1;
+        cbor::cbor_bytes_reader reader1(big, visitor1);
+        reader1.read();
+        CHECK(visitor1.floats == std::vector<float>{1.0f, -3.0f});
+
+        cbor_view_visitor visitor2;
+        cbor::cbor_bytes_reader reader2(little, visitor2);
+        reader2.read();
+        CHECK(visitor2.floats == std::vector<float>{1.0f, -3.0f});
+    }
+
+    SECTION("cursor")
+    {
+        const std::vector<uint8_t> input = {0x82,0x43,'a','b','c',0x41,'d'};
+
+        cbor::cbor_bytes_cursor cursor(input);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::byte_string_value);
+        auto b = cursor.current().get<byte_string_view>();
+        CHECK(b.data() == input.data() + 2);
+        CHECK(b.size() == 3);
+    }
+}
@@ -781,3 +781,64 @@ TEST_CASE("encode decode cbor source")
     }
 }
 
+
+TEST_CASE("decode cbor definite length arrays")
+{
+    SECTION("nested arrays and objects")
+    {
+        json expected = json::parse(R"(
+        [[1,2,[3,"a long string value that is not short"]],{"a":[true,null],"b":{"c":[]}},[],1.5,[{"d":[4]}]]
+        )");
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+
+        json j = cbor::decode_cbor<json>(data);
+        CHECK(expected == j);
+        CHECK(j.capacity() == 5);
+        CHECK(j[0].capacity() == 3);
+        CHECK(j[1]["a"].capacity() == 2);
+
+        ojson oj = cbor::decode_cbor<ojson>(data);
+        CHECK(oj == ojson::parse(expected.to_string()));
+    }
+
+    SECTION("large array")
+    {
+        json expected(json_array_arg);
+        for (std::size_t i = 0; i < 10000; ++i)
+        {
+            expected.emplace_back(i);
+        }
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+
+        json j = cbor::decode_cbor<json>(data);
+        CHECK(expected == j);
+        CHECK(j.capacity() == 10000);
+    }
+
+    SECTION("length larger than the input")
+    {
+        // array of 2^32 items followed by one item
+        std::vector<uint8_t> data = {0x9b,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x01};
+        std::error_code ec;
+        json_decoder<json> decoder;
+        cbor::cbor_bytes_reader reader(data, decoder);
+        reader.read(ec);
+        CHECK(ec);
+        CHECK_FALSE(decoder.is_valid());
+    }
+
+    SECTION("element count differs from length")
+    {
+        json_decoder<json> decoder;
+        decoder.begin_array(1);
+        decoder.uint64_value(1);
+        decoder.uint64_value(2);
+        decoder.begin_array(3);
+        decoder.uint64_value(3);
+        decoder.end_array();
+        decoder.end_array();
+        CHECK(decoder.get_result() == json::parse("[1,2,[3]]"));
+    }
+}
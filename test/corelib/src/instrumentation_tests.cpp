@@ -0,0 +1,150 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/instrumentation.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+namespace instr = jsoncons::instrumentation;
+
+namespace {
+
+    // Statistics are only recorded when JSONCONS_INSTRUMENTATION is defined
+    uint64_t if_enabled(uint64_t n)
+    {
+        return instr::enabled ? n : 0;
+    }
+
+} // namespace
+
+TEST_CASE("instrumentation statistics tests")
+{
+    SECTION("add and subtract")
+    {
+        instr::statistics a;
+        a.add(instr::counter::escapes, 3);
+        a.add(instr::counter::escapes, 2);
+        a.add(instr::timer::parse, 100);
+        a.add(instr::timer::parse, 50);
+
+        CHECK(a.get(instr::counter::escapes) == 5);
+        CHECK(a.get(instr::counter::allocations) == 0);
+        CHECK(a.get(instr::timer::parse).count == 2);
+        CHECK(a.get(instr::timer::parse).nanoseconds == 150);
+
+        instr::statistics b;
+        b.add(instr::counter::escapes, 1);
+        b.add(instr::timer::parse, 50);
+
+        instr::statistics c = a - b;
+        CHECK(c.get(instr::counter::escapes) == 4);
+        CHECK(c.get(instr::timer::parse).count == 1);
+        CHECK(c.get(instr::timer::parse).nanoseconds == 100);
+        CHECK((c + b).get(instr::counter::escapes) == 5);
+
+        a.reset();
+        CHECK(a.get(instr::counter::escapes) == 0);
+        CHECK(a.get(instr::timer::parse).count == 0);
+    }
+
+    SECTION("statistics are per thread")
+    {
+        instr::operation_scope op;
+        uint64_t other = 0;
+        std::thread t([&other]()
+        {
+            instr::thread_statistics().add(instr::counter::escapes, 7);
+            other = instr::thread_statistics().get(instr::counter::escapes);
+        });
+        t.join();
+
+        CHECK(other == 7);
+        CHECK(op.current().get(instr::counter::escapes) == 0);
+    }
+}
+
+TEST_CASE("instrumentation json parser and encoder tests")
+{
+    SECTION("parse")
+    {
+        instr::operation_scope op;
+        json j = json::parse(R"({"a":"x\ny\u00e9","b":[1,-2,3.5],"c":"\ud834\udd1e"})");
+        instr::statistics stats = op.current();
+
+        CHECK(j.at("b").size() == 3);
+        CHECK(stats.get(instr::counter::escapes) == if_enabled(4));
+        CHECK(stats.get(instr::counter::number_conversions) == if_enabled(3));
+        CHECK(stats.get(instr::counter::buffer_refills) == 0);
+        CHECK(stats.get(instr::timer::parse).count == if_enabled(1));
+    }
+
+    SECTION("parse from stream")
+    {
+        std::string s = "[";
+        for (int i = 0; i < 10000; ++i)
+        {
+            s.append(i == 0 ? "" : ",").append(std::to_string(i));
+        }
+        s.push_back(']');
+        std::istringstream is(s);
+
+        instr::operation_scope op;
+        json j = json::parse(is);
+        instr::statistics stats = op.current();
+
+        CHECK(j.size() == 10000);
+        CHECK(stats.get(instr::counter::number_conversions) == if_enabled(10000));
+        if (instr::enabled)
+        {
+            CHECK(stats.get(instr::counter::buffer_refills) > 1);
+        }
+        else
+        {
+            CHECK(stats.get(instr::counter::buffer_refills) == 0);
+        }
+    }
+
+    SECTION("encode")
+    {
+        json j = json::parse(R"({"a":"x\"y\tz","b":[1,-2,3.5]})");
+
+        instr::operation_scope op;
+        std::string s;
+        j.dump(s);
+        instr::statistics stats = op.current();
+
+        CHECK(s == R"({"a":"x\"y\tz","b":[1,-2,3.5]})");
+        CHECK(stats.get(instr::counter::escapes) == if_enabled(2));
+        CHECK(stats.get(instr::counter::number_conversions) == if_enabled(3));
+        CHECK(stats.get(instr::timer::encode).count == if_enabled(1));
+        CHECK(stats.get(instr::timer::parse).count == 0);
+    }
+}
+
+TEST_CASE("instrumented_allocator tests")
+{
+    using instrumented_json = basic_json<char,sorted_policy,instrumented_allocator<char>>;
+
+    instr::operation_scope op;
+    {
+        auto j = instrumented_json::parse(R"({"name":"a string that is too long for short string storage","values":[1,2,3]})");
+        CHECK(j.at("values").size() == 3);
+
+        instr::statistics stats = op.current();
+        if (instr::enabled)
+        {
+            CHECK(stats.get(instr::counter::allocations) > 0);
+            CHECK(stats.get(instr::counter::allocated_bytes) > 0);
+        }
+        else
+        {
+            CHECK(stats.get(instr::counter::allocations) == 0);
+        }
+    }
+    instr::statistics stats = op.current();
+    CHECK(stats.get(instr::counter::deallocations) == stats.get(instr::counter::allocations));
+}
@@ -0,0 +1,207 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/interned_key.hpp>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+
+namespace {
+
+    using interned_json = basic_json<char,interned_key_policy<sorted_policy>>;
+    using interned_ojson = basic_json<char,interned_key_policy<order_preserving_policy>>;
+
+} // namespace
+
+TEST_CASE("interned_key tests")
+{
+    SECTION("equal text shares storage")
+    {
+        interned_key a("customer_identifier");
+        interned_key b(std::string("customer_identifier"));
+        interned_key c("customer_address");
+
+        CHECK(a.data() == b.data());
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(c < a);
+        CHECK(a.size() == 19);
+        CHECK(a == "customer_identifier");
+        CHECK(a == std::string("customer_identifier"));
+        CHECK(std::string(a) == "customer_identifier");
+        CHECK(std::hash<interned_key>()(a) == std::hash<interned_key>()(b));
+    }
+
+    SECTION("empty key")
+    {
+        interned_key a;
+        interned_key b("");
+        CHECK(a.empty());
+        CHECK(b.empty());
+        CHECK(a == b);
+        CHECK(*a.c_str() == 0);
+        CHECK(a < interned_key("a"));
+    }
+
+    SECTION("copy and move")
+    {
+        interned_key a("a key");
+        interned_key b(a);
+        interned_key c(std::move(b));
+        CHECK(c.data() == a.data());
+        CHECK(c == "a key");
+
+        interned_key d("another key");
+        d = a;
+        CHECK(d.data() == a.data());
+    }
+
+    SECTION("unused strings are purged")
+    {
+        key_pool& pool = key_pool::thread_instance();
+        pool.purge();
+        std::size_t n = pool.size();
+        {
+            interned_key a("a key that is only used here");
+            interned_key b("a key that is only used here");
+            CHECK(pool.size() == n + 1);
+        }
+        CHECK(pool.size() == n + 1);
+        pool.purge();
+        CHECK(pool.size() == n);
+    }
+
+    SECTION("pool grows unless a purge frees a quarter of the slots")
+    {
+        key_pool pool;
+        std::vector<key_pool::pointer> kept;
+        for (std::size_t i = 0; i < 45; ++i)
+        {
+            std::string s = "kept " + std::to_string(i);
+            kept.push_back(pool.intern(s.data(), s.size()));
+        }
+        CHECK(pool.capacity() == 64);
+
+        // A few unused strings are dropped, but too few to stay at this capacity
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            std::string s = "temporary " + std::to_string(i);
+            key_pool::release(pool.intern(s.data(), s.size()));
+        }
+        CHECK(pool.capacity() == 128);
+        CHECK(pool.size() == 46);
+
+        // Many unused strings are dropped, and the capacity stays the same
+        for (std::size_t i = 0; i < 51; ++i)
+        {
+            std::string s = "dropped " + std::to_string(i);
+            key_pool::release(pool.intern(s.data(), s.size()));
+        }
+        CHECK(pool.capacity() == 128);
+        CHECK(pool.size() == 46);
+
+        for (auto p : kept)
+        {
+            key_pool::release(p);
+        }
+    }
+
+    SECTION("many keys")
+    {
+        std::vector<interned_key> keys;
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            keys.emplace_back(std::to_string(i));
+        }
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            interned_key key(std::to_string(i));
+            CHECK(key.data() == keys[i].data());
+        }
+        std::unordered_set<interned_key> set(keys.begin(), keys.end());
+        CHECK(set.size() == 1000);
+        CHECK(set.count(interned_key("999")) == 1);
+    }
+}
+
+TEMPLATE_TEST_CASE("interned key policy tests", "", interned_json, interned_ojson)
+{
+    using json_type = TestType;
+
+    std::string input = R"(
+[
+    {"name": "a", "value": 1, "tags": ["x"]},
+    {"name": "b", "value": 2, "tags": []},
+    {"name": "c", "value": 3, "tags": ["y","z"]}
+]
+    )";
+
+    SECTION("parse")
+    {
+        json_type doc = json_type::parse(input);
+        REQUIRE(doc.size() == 3);
+
+        auto first = doc[0].object_range().begin();
+        auto last = doc[2].object_range().begin();
+        CHECK(first->key().data() == last->key().data());
+
+        CHECK(doc[1].at("value").template as<int>() == 2);
+        CHECK(doc[2].contains("tags"));
+        CHECK_FALSE(doc[2].contains("other"));
+        CHECK(doc[2]["name"].as_string() == "c");
+        CHECK(bool(doc[0].find("name") != doc[0].object_range().end()));
+        CHECK(bool(doc[0].find("other") == doc[0].object_range().end()));
+
+        CHECK(doc == json_type::parse(input));
+        CHECK(json::parse(doc.to_string()) == json::parse(input));
+    }
+
+    SECTION("modify")
+    {
+        json_type doc = json_type::parse(input);
+        json_type& record = doc[0];
+
+        record.erase("tags");
+        CHECK_FALSE(record.contains("tags"));
+        record.insert_or_assign("extra", 10);
+        CHECK(record.at("extra").template as<int>() == 10);
+
+        json_type other = record;
+        CHECK(other == record);
+        other["value"] = 5;
+        CHECK(other != record);
+
+        json_type patch(json_object_arg, {{"name", "d"}, {"more", true}});
+        record.merge_or_update(patch);
+        CHECK(record.at("name").as_string() == "d");
+        CHECK(record.at("more").as_bool());
+    }
+
+    SECTION("keys on other threads")
+    {
+        json_type doc = json_type::parse(input);
+        std::vector<json_type> copies;
+
+        std::thread t([&]()
+        {
+            for (std::size_t i = 0; i < 100; ++i)
+            {
+                json_type copy = doc;
+                copy[0].insert_or_assign("thread", true);
+                copies.push_back(std::move(copy));
+            }
+        });
+        t.join();
+
+        CHECK(copies.size() == 100);
+        CHECK(copies.back()[0].at("thread").as_bool());
+        copies.clear();
+        CHECK(doc[0].at("name").as_string() == "a");
+    }
+}
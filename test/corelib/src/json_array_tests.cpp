@@ -2,6 +2,7 @@
 // Distributed under Boost license
 
 #include <ctime>
+#include <deque>
 #include <list>
 #include <sstream>
 #include <utility>
@@ -514,3 +515,210 @@ TEST_CASE("test json_array erase with iterator")
         CHECK(doc[0] == "c");
     }
 }
+
+namespace {
+
+    // A json::array that keeps up to capacity elements inline, as basic_json allocates it
+    class inline_array
+    {
+        using allocator_type = std::allocator<json::array>;
+        allocator_type alloc_;
+        std::size_t n_;
+        json::array* ptr_;
+    public:
+        inline_array(std::size_t capacity, std::initializer_list<json> init)
+            : n_(json::array::allocation_size(capacity)), ptr_(alloc_.allocate(n_))
+        {
+            ::new(ptr_) json::array(detail::inline_capacity_arg, capacity, init.begin(), init.end());
+        }
+        inline_array(const inline_array&) = delete;
+        inline_array& operator=(const inline_array&) = delete;
+        ~inline_array()
+        {
+            ptr_->~json_array();
+            alloc_.deallocate(ptr_, n_);
+        }
+        json::array* operator->() {return ptr_;}
+        json::array& operator*() {return *ptr_;}
+    };
+
+} // namespace
+
+TEST_CASE("json array storage")
+{
+    SECTION("empty array doesn't allocate")
+    {
+        json doc(json_array_arg);
+
+        CHECK(doc.storage_kind() == json_storage_kind::empty_array);
+        CHECK(doc.type() == json_type::array_value);
+        CHECK(doc.is_array());
+        CHECK(doc.empty());
+        CHECK(0 == doc.size());
+        CHECK(bool(doc.array_range().begin() == doc.array_range().end()));
+        CHECK_THROWS_AS(doc.at(0), std::out_of_range);
+        CHECK(doc.to_string() == "[]");
+    }
+
+    SECTION("empty array compares equal to allocated empty array")
+    {
+        json a(json_array_arg);
+        json b(json_array_arg);
+        b.push_back(1);
+        b.erase(b.array_range().begin());
+
+        CHECK(a.storage_kind() == json_storage_kind::empty_array);
+        CHECK(b.storage_kind() == json_storage_kind::array);
+        CHECK(a == b);
+        CHECK_FALSE(a < b);
+        CHECK_FALSE(b < a);
+        CHECK(a.hash() == b.hash());
+
+        json c = json::parse("[[],[1]]");
+        json d(json_array_arg);
+        d.push_back(json(json_array_arg));
+        d.push_back(json(json_array_arg, {1}));
+        CHECK(c == d);
+        CHECK(d[0] < d[1]);
+    }
+
+    SECTION("push_back on empty array")
+    {
+        json doc(json_array_arg);
+        doc.push_back(1);
+        doc.emplace_back("two");
+
+        CHECK(doc.storage_kind() == json_storage_kind::array);
+        REQUIRE(2 == doc.size());
+        CHECK(doc[0] == 1);
+        CHECK(doc[1] == "two");
+    }
+
+    SECTION("reserve, grow past capacity, shrink_to_fit")
+    {
+        json doc(json_array_arg);
+        doc.reserve(3);
+        CHECK(doc.capacity() >= 3);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            doc.push_back(i);
+        }
+        doc.insert(doc.array_range().begin(), -1);
+        REQUIRE(11 == doc.size());
+        CHECK(doc[0] == -1);
+        CHECK(doc[10] == 9);
+
+        doc.erase(doc.array_range().begin() + 3, doc.array_range().end());
+        doc.shrink_to_fit();
+        CHECK(3 == doc.size());
+        CHECK(doc == json::parse("[-1,0,1]"));
+        CHECK(doc.capacity() >= 3);
+
+        doc.push_back(json::parse(R"({"a":[1,2,3]})"));
+        CHECK(doc == json::parse(R"([-1,0,1,{"a":[1,2,3]}])"));
+    }
+
+    SECTION("parsed array copy")
+    {
+        json doc = json::parse("[1,[2,3],{\"a\":[]}]");
+        json copy(doc);
+        CHECK(copy == doc);
+        CHECK(copy[1].capacity() == 2);
+
+        json moved(std::move(copy));
+        CHECK(moved == doc);
+    }
+
+    SECTION("iterators are the container's")
+    {
+        CHECK((std::is_same<json::array_iterator,std::vector<json>::iterator>::value));
+        CHECK((std::is_same<json::const_array_iterator,std::vector<json>::const_iterator>::value));
+        CHECK(noexcept(std::declval<json::array&>().swap(std::declval<json::array&>())));
+        CHECK(std::is_nothrow_move_constructible<json::array>::value);
+    }
+
+    SECTION("swap arrays that keep their elements inline")
+    {
+        inline_array a(3, {1,2,3});
+        inline_array b(3, {4,5,6});
+        inline_array c(2, {7,8});
+
+        a->swap(*b);
+        CHECK(json(json_array_arg, a->begin(), a->end()) == json::parse("[4,5,6]"));
+        CHECK(json(json_array_arg, b->begin(), b->end()) == json::parse("[1,2,3]"));
+        CHECK(3 == a->capacity());
+        CHECK(3 == b->capacity());
+
+        a->swap(*c);
+        CHECK(json(json_array_arg, a->begin(), a->end()) == json::parse("[7,8]"));
+        CHECK(json(json_array_arg, c->begin(), c->end()) == json::parse("[4,5,6]"));
+        CHECK(3 == a->capacity());
+
+        c->swap(*a);
+        CHECK(json(json_array_arg, a->begin(), a->end()) == json::parse("[4,5,6]"));
+        CHECK(json(json_array_arg, c->begin(), c->end()) == json::parse("[7,8]"));
+        CHECK(3 == a->capacity());
+        CHECK(2 == c->capacity());
+
+        b->push_back(json(4));
+        b->swap(*c);
+        CHECK(json(json_array_arg, b->begin(), b->end()) == json::parse("[7,8]"));
+        CHECK(json(json_array_arg, c->begin(), c->end()) == json::parse("[1,2,3,4]"));
+        CHECK(3 == b->capacity());
+
+        json::array d{json(9)};
+        d.swap(*b);
+        CHECK(json(json_array_arg, b->begin(), b->end()) == json::parse("[9]"));
+        CHECK(json(json_array_arg, d.begin(), d.end()) == json::parse("[7,8]"));
+
+        a->swap(*a);
+        CHECK(json(json_array_arg, a->begin(), a->end()) == json::parse("[4,5,6]"));
+
+        json::array moved(std::move(*a));
+        CHECK(json(json_array_arg, moved.begin(), moved.end()) == json::parse("[4,5,6]"));
+        CHECK(a->empty());
+    }
+}
+
+namespace {
+
+    // A SequenceContainer without data(), so arrays can't keep their elements inline
+    template <typename T,typename Alloc>
+    struct deque_container : std::deque<T,Alloc>
+    {
+        using std::deque<T,Alloc>::deque;
+        deque_container() = default;
+        void reserve(std::size_t) {}
+        std::size_t capacity() const {return this->size();}
+    };
+
+    struct deque_policy : sorted_policy
+    {
+        template <typename Json>
+        using array = json_array<Json,deque_container>;
+    };
+
+} // namespace
+
+TEST_CASE("json array with a non-contiguous container")
+{
+    using deque_json = basic_json<char,deque_policy>;
+
+    deque_json doc = deque_json::parse(R"([1,2,[3,4],{"a":[5]}])");
+    CHECK((std::is_same<deque_json::array_iterator,std::deque<deque_json>::iterator>::value));
+
+    deque_json copy(doc);
+    copy.push_back(6);
+    copy.insert(copy.array_range().begin(), 0);
+    copy.erase(copy.array_range().begin());
+    CHECK(copy.size() == 5);
+    CHECK(copy[4] == 6);
+
+    deque_json other(json_array_arg);
+    other.emplace_back(1);
+    other.swap(copy);
+    CHECK(other.to_string() == R"([1,2,[3,4],{"a":[5]},6])");
+    CHECK(copy.to_string() == "[1]");
+    CHECK(doc.to_string() == R"([1,2,[3,4],{"a":[5]}])");
+}
@@ -0,0 +1,107 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("basic_json hash of equal values")
+{
+    SECTION("numbers")
+    {
+        CHECK(json(1).hash() == json(1u).hash());
+        CHECK(json(1).hash() == json(1.0).hash());
+        CHECK(json(0.0).hash() == json(-0.0).hash());
+        CHECK(json(-5).hash() == json(-5.0).hash());
+        CHECK(json(half_arg, 0x3c00).hash() == json(1).hash()); // 1.0
+        CHECK(json("1.5", semantic_tag::bigdec).hash() == json(1.5).hash());
+        CHECK(json(1).hash() != json(2).hash());
+    }
+
+    SECTION("kinds with the same bits")
+    {
+        CHECK(json::null().hash() != json(false).hash());
+        CHECK(json(false).hash() != json(0).hash());
+        CHECK(json("").hash() != json(json_array_arg).hash());
+        CHECK(json(json_array_arg).hash() != json(json_object_arg).hash());
+        CHECK(json("1").hash() != json(1).hash());
+
+        std::vector<uint8_t> bytes = {'a','b','c'};
+        CHECK(json(byte_string_arg, bytes).hash() != json("abc").hash());
+    }
+
+    SECTION("strings")
+    {
+        CHECK(json("short").hash() == json(std::string("short")).hash());
+        std::string s(100, 'x');
+        CHECK(json(s).hash() == json(s).hash());
+        CHECK(json(s).hash() != json(s + "y").hash());
+    }
+
+    SECTION("arrays depend on order")
+    {
+        CHECK(json::parse("[1,2,3]").hash() == json::parse("[1.0,2,3]").hash());
+        CHECK(json::parse("[1,2,3]").hash() != json::parse("[3,2,1]").hash());
+        CHECK(json::parse("[[1],2]").hash() != json::parse("[1,[2]]").hash());
+    }
+
+    SECTION("objects do not depend on member order")
+    {
+        auto a = ojson::parse(R"({"a":1,"b":[true,null],"c":{"d":"e"}})");
+        auto b = ojson::parse(R"({"c":{"d":"e"},"b":[true,null],"a":1})");
+        CHECK(a.hash() == b.hash());
+        CHECK(json::parse(R"({"a":1,"b":2})").hash() == ojson::parse(R"({"b":2,"a":1})").hash());
+        CHECK(json::parse(R"({"a":1,"b":2})").hash() != json::parse(R"({"a":2,"b":1})").hash());
+        CHECK(json(json_object_arg).hash() == json().hash()); // empty object
+    }
+
+    SECTION("references")
+    {
+        json j = json::parse(R"({"a":[1,2,3]})");
+        CHECK(json(json_const_pointer_arg, &j).hash() == j.hash());
+        CHECK(json(json_pointer_arg, &j).hash() == j.hash());
+    }
+
+    SECTION("stable values")
+    {
+        CHECK(json::parse(R"({"a":[1,"x",null]})").hash() == json::parse(R"({"a":[1,"x",null]})").hash());
+        CHECK(wjson(L"abc").hash() == wjson(L"abc").hash());
+    }
+}
+
+TEST_CASE("std::hash<basic_json>")
+{
+    std::unordered_set<json> set;
+    set.insert(json(1));
+    set.insert(json(1.0));
+    set.insert(json("a"));
+    set.insert(json::parse(R"({"x":1,"y":2})"));
+    set.insert(json::parse(R"({"y":2,"x":1})"));
+    CHECK(3 == set.size());
+    CHECK(set.count(json(1u)) == 1);
+
+    std::unordered_map<ojson,int> map;
+    map[ojson::parse("[1,2]")] = 1;
+    map[ojson::parse("[1,2]")] += 1;
+    CHECK(2 == map[ojson::parse("[1.0,2.0]")]);
+}
+
+TEST_CASE("hashed_json")
+{
+    hashed_json<json> a(json::parse(R"({"a":[1,2,3],"b":"x"})"));
+    hashed_json<json> b(json::parse(R"({"b":"x","a":[1,2,3]})"));
+    hashed_json<json> c(json::parse(R"({"b":"y","a":[1,2,3]})"));
+
+    CHECK(a.hash() == a.value().hash());
+    CHECK((a == b));
+    CHECK((a != c));
+
+    std::unordered_set<hashed_json<json>> set{a, b, c};
+    CHECK(2 == set.size());
+}
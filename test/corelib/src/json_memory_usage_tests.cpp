@@ -0,0 +1,190 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <catch/catch.hpp>
+
+#if defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR) && JSONCONS_HAS_POLYMORPHIC_ALLOCATOR == 1
+#include <memory_resource>
+#endif
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::string long_string = "String too long for short string storage";
+    const std::string long_name = "A member name that is too long for short string storage";
+
+    const char* const document = R"(
+{
+    "customer_identifier": "A string that is too long for short string storage",
+    "orders": [
+        {"order_number": 1, "items": ["first item of the first order", "second item of the first order"]},
+        {"order_number": 2, "items": [1, 2.5, null, true]}
+    ],
+    "empty": [],
+    "id": "short"
+}
+    )";
+
+} // namespace
+
+TEMPLATE_TEST_CASE("json memory_usage tests", "", json, ojson)
+{
+    using json_type = TestType;
+
+    SECTION("values without heap storage")
+    {
+        CHECK(json_type().memory_usage().total() == 0);
+        CHECK(json_type(10).memory_usage().total() == 0);
+        CHECK(json_type(10.5).memory_usage().total() == 0);
+        CHECK(json_type("short").memory_usage().total() == 0);
+        CHECK(json_type(json_array_arg).memory_usage().total() == 0);
+
+        json_memory_usage usage = json_type(json_object_arg).memory_usage();
+        CHECK(usage.objects > 0);
+        CHECK(usage.total() == usage.objects);
+    }
+
+    SECTION("strings")
+    {
+        json_type j(long_string);
+        json_memory_usage usage = j.memory_usage();
+        CHECK(usage.strings > long_string.size());
+        CHECK(usage.total() == usage.strings);
+
+        std::vector<uint8_t> bytes(100, 'a');
+        json_type b(byte_string_arg, bytes);
+        CHECK(b.memory_usage().byte_strings > bytes.size());
+        CHECK(b.memory_usage().total() == b.memory_usage().byte_strings);
+    }
+
+    SECTION("array slack")
+    {
+        json_type j(json_array_arg);
+        j.reserve(100);
+        j.push_back(1);
+        j.push_back(long_string);
+
+        json_memory_usage usage = j.memory_usage();
+        CHECK(usage.slack == 98*sizeof(json_type));
+        CHECK(usage.arrays >= 2*sizeof(json_type));
+        CHECK(usage.strings == json_type(long_string).memory_usage().strings);
+
+        j.repack();
+        CHECK(j.memory_usage().slack == 0);
+        CHECK(j.memory_usage().arrays < usage.arrays + usage.slack);
+        CHECK(j.memory_usage().strings == usage.strings);
+        CHECK(j[0] == 1);
+        CHECK(j[1] == long_string);
+    }
+
+    SECTION("object members and names")
+    {
+        json_type j(json_object_arg);
+        j.reserve(10);
+        j.try_emplace("a", 1);
+        j.try_emplace(long_name, 2);
+
+        json_memory_usage usage = j.memory_usage();
+        CHECK(usage.objects > 0);
+        CHECK(usage.strings == long_name.size() + 1);
+        CHECK(usage.slack > 0);
+
+        j.repack();
+        CHECK(j.memory_usage().slack == 0);
+        CHECK(j.memory_usage().objects == usage.objects);
+        CHECK(j.memory_usage().strings == usage.strings);
+        CHECK(j.size() == 2);
+        CHECK(j.at("a") == 1);
+    }
+
+    SECTION("repack document")
+    {
+        json_type expected = json_type::parse(document);
+        json_type j = json_type::parse(document);
+        for (auto& order : j["orders"].array_range())
+        {
+            order["items"].reserve(50);
+        }
+        CHECK(j.memory_usage().slack > 0);
+
+        j.repack();
+        CHECK(j == expected);
+        CHECK(j.memory_usage().slack == 0);
+        CHECK(j.memory_usage().total() <= expected.memory_usage().total());
+    }
+
+    SECTION("references and shared values are not owned")
+    {
+        json_type j(long_string);
+        json_type r(json_const_pointer_arg, &j);
+        CHECK(r.memory_usage().total() == 0);
+    }
+}
+
+#if defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR) && JSONCONS_HAS_POLYMORPHIC_ALLOCATOR == 1
+
+TEST_CASE("json repack into a buffer")
+{
+    using pmr_json = jsoncons::pmr::json;
+
+    pmr_json source = pmr_json::parse(document);
+    json_memory_usage usage = source.memory_usage();
+
+    std::vector<char> buffer(2*usage.total());
+    std::pmr::monotonic_buffer_resource pool{buffer.data(), buffer.size()};
+    std::pmr::polymorphic_allocator<char> alloc(&pool);
+
+    pmr_json j = source;
+    j.repack(alloc);
+    CHECK(j == source);
+    CHECK(j.memory_usage().slack == 0);
+
+    // The strings and array elements are laid out depth first
+    std::vector<const char*> addresses;
+    std::function<void(const pmr_json&)> visit = [&](const pmr_json& val)
+    {
+        if (val.storage_kind() == json_storage_kind::long_str)
+        {
+            addresses.push_back(val.template as<jsoncons::string_view>().data());
+        }
+        else if (val.is_array())
+        {
+            if (!val.empty())
+            {
+                addresses.push_back(reinterpret_cast<const char*>(&val[0]));
+            }
+            for (const auto& item : val.array_range())
+            {
+                visit(item);
+            }
+        }
+        else if (val.is_object())
+        {
+            for (const auto& member : val.object_range())
+            {
+                visit(member.value());
+            }
+        }
+    };
+    visit(j);
+
+    REQUIRE(addresses.size() == 6);
+    std::less<const char*> less;
+    for (std::size_t i = 0; i < addresses.size(); ++i)
+    {
+        CHECK_FALSE(less(addresses[i], buffer.data()));
+        CHECK(less(addresses[i], buffer.data() + buffer.size()));
+        if (i > 0)
+        {
+            CHECK(less(addresses[i-1], addresses[i]));
+        }
+    }
+}
+
+#endif
@@ -1183,3 +1183,31 @@ TEST_CASE("test_json_merge_or_update_move")
     }
 }
 
+
+TEST_CASE("json object find")
+{
+    for (std::size_t n : {0, 1, 5, 16, 17, 40})
+    {
+        json j(json_object_arg);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            j.try_emplace("key" + std::to_string(i), i);
+        }
+        j.try_emplace("", -1);
+        CAPTURE(n);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::string name = "key" + std::to_string(i);
+            auto it = j.find(name);
+            REQUIRE(bool(it != j.object_range().end()));
+            CHECK(it->key() == name);
+            CHECK(it->value().as<std::size_t>() == i);
+        }
+        CHECK(j.at("").as<int>() == -1);
+        CHECK(bool(j.find("key") == j.object_range().end()));
+        CHECK(bool(j.find("kez0") == j.object_range().end()));
+        CHECK(bool(j.find("key" + std::to_string(n)) == j.object_range().end()));
+        CHECK(bool(j.find("key00") == j.object_range().end()));
+    }
+}
@@ -0,0 +1,252 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_parallel_parse_context.hpp>
+#include <string>
+#include <system_error>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+
+namespace {
+
+    // A pretty printed array of n objects, large enough to be divided
+    std::string make_array_text(std::size_t n)
+    {
+        json a(json_array_arg);
+        a.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            json item(json_object_arg);
+            item.try_emplace("id", i);
+            item.try_emplace("name", "item " + std::to_string(i));
+            item.try_emplace("values", json(json_array_arg, {json(i % 7), json(1.5), json(null_type())}));
+            a.push_back(std::move(item));
+        }
+        std::string s;
+        a.dump_pretty(s);
+        return s;
+    }
+
+    struct parse_outcome
+    {
+        std::error_code ec;
+        std::size_t line;
+        std::size_t column;
+    };
+
+    parse_outcome parse_serially(const std::string& text, const json_options& options = json_options())
+    {
+        json_parse_context<json> context(options);
+        parse_outcome outcome;
+        context.parse(text, outcome.ec);
+        outcome.line = context.line();
+        outcome.column = context.column();
+        return outcome;
+    }
+
+    parse_outcome parse_in_parallel(const std::string& text, const std::string& pointer = "",
+        const json_options& options = json_options())
+    {
+        json_parallel_parse_context<json> context(4, options);
+        parse_outcome outcome;
+        context.parse(text, pointer, outcome.ec);
+        outcome.line = context.line();
+        outcome.column = context.column();
+        CHECK(context.chunk_count() > 1);
+        return outcome;
+    }
+
+    void check_same_error(const std::string& text, const std::string& pointer = "",
+        const json_options& options = json_options())
+    {
+        parse_outcome serial = parse_serially(text, options);
+        parse_outcome parallel = parse_in_parallel(text, pointer, options);
+        REQUIRE(serial.ec);
+        CHECK(parallel.ec == serial.ec);
+        CHECK(parallel.line == serial.line);
+        CHECK(parallel.column == serial.column);
+    }
+
+} // namespace
+
+TEST_CASE("json_parallel_parse_context root array tests")
+{
+    std::string text = make_array_text(20000);
+    json expected = json::parse(text);
+
+    SECTION("divided")
+    {
+        json_parallel_parse_context<json> context(4);
+        json j = context.parse(text);
+        CHECK(context.chunk_count() > 4);
+        CHECK(j.size() == 20000);
+        CHECK(j == expected);
+    }
+
+    SECTION("reused")
+    {
+        json_parallel_parse_context<json> context(3);
+        CHECK(context.parse(text) == expected);
+        CHECK(context.parse(text) == expected);
+        CHECK(context.parse("[1,2,3]") == json::parse("[1,2,3]"));
+        CHECK(context.chunk_count() == 1);
+    }
+
+    SECTION("one thread")
+    {
+        json_parallel_parse_context<json> context(1);
+        CHECK(context.parse(text) == expected);
+        CHECK(context.chunk_count() == 1);
+    }
+
+    SECTION("root not an array")
+    {
+        std::string s = R"({"a":)" + text + "}";
+        json_parallel_parse_context<json> context(4);
+        CHECK(context.parse(s).at("a") == expected);
+        CHECK(context.chunk_count() == 1);
+    }
+
+    SECTION("comments and trailing comma")
+    {
+        std::string s = text;
+        std::size_t pos = s.find("},", s.size()/2);
+        REQUIRE(pos != std::string::npos);
+        s.insert(pos + 2, "/* a comment, with [brackets] and \"quotes\" */ // another, ]\n");
+        s.insert(s.rfind(']'), ",");
+
+        json_options options;
+        options.allow_trailing_comma(true);
+        json_parallel_parse_context<json> context(4, options);
+        CHECK(context.parse(s) == expected);
+        CHECK(context.chunk_count() > 1);
+    }
+
+    SECTION("ojson")
+    {
+        json_parallel_parse_context<ojson> context(4);
+        CHECK(context.parse(text) == ojson::parse(text));
+    }
+}
+
+TEST_CASE("json_parallel_parse_context pointer tests")
+{
+    std::string items = make_array_text(20000);
+
+    SECTION("nested array")
+    {
+        std::string text = R"({"count": 20000, "a/b": {"skip": [1, {"x": "]"}], "items": )" + items + R"(, "after": true}, "z": [1,2]})";
+        json expected = json::parse(text);
+
+        json_parallel_parse_context<json> context(4);
+        json j = context.parse(text, "/a~1b/items");
+        CHECK(context.chunk_count() > 1);
+        CHECK(j == expected);
+    }
+
+    SECTION("array element")
+    {
+        std::string text = "[[1,2], " + items + ", 3]";
+        json_parallel_parse_context<json> context(4);
+        CHECK(context.parse(text, "/1") == json::parse(text));
+        CHECK(context.chunk_count() > 1);
+    }
+
+    SECTION("escaped member name")
+    {
+        std::string text = R"({"it\u0065m": [], "it\u0065ms": )" + items + "}";
+        json_parallel_parse_context<json> context(4);
+        CHECK(context.parse(text, "/items") == json::parse(text));
+        CHECK(context.chunk_count() > 1);
+    }
+
+    SECTION("not found")
+    {
+        std::string text = R"({"items": )" + items + "}";
+        json_parallel_parse_context<json> context(4);
+        CHECK(context.parse(text, "/other") == json::parse(text));
+        CHECK(context.chunk_count() == 1);
+        CHECK(context.parse(text, "items") == json::parse(text));
+        CHECK(context.chunk_count() == 1);
+    }
+}
+
+TEST_CASE("json_parallel_parse_context error tests")
+{
+    std::string text = make_array_text(20000);
+
+    SECTION("error in a later chunk")
+    {
+        std::string s = text;
+        std::size_t pos = s.find("1.5", s.size()*3/4);
+        s.replace(pos, 3, "1.x");
+        check_same_error(s);
+    }
+
+    SECTION("error in the first chunk")
+    {
+        std::string s = text;
+        std::size_t pos = s.find("null", 100);
+        s.replace(pos, 4, "nul!");
+        check_same_error(s);
+    }
+
+    SECTION("error at the start of a chunk")
+    {
+        std::string s = text;
+        std::size_t pos = s.find("},", s.size()/2);
+        s.insert(pos + 2, "\n  }");
+        check_same_error(s);
+    }
+
+    SECTION("errors in a chunk and after the array")
+    {
+        std::string s = text;
+        std::size_t pos = s.find("\"name\"", s.size()/2);
+        s.replace(pos, 6, "\"name\t\"");
+        s.append("\n extra");
+        check_same_error(s);
+    }
+
+    SECTION("error after the array")
+    {
+        std::string s = text;
+        s.append("\r\n\r\n  x");
+        check_same_error(s);
+
+        std::string t = R"({"items": )" + text + R"(, "b" 1})";
+        check_same_error(t, "/items");
+    }
+
+    SECTION("error before the array")
+    {
+        std::string s = R"({"a": tru, "items": )" + text + "}";
+        check_same_error(s, "/items");
+    }
+
+    SECTION("trailing comma")
+    {
+        std::string s = text;
+        s.insert(s.rfind(']'), ",");
+        check_same_error(s);
+    }
+
+    SECTION("unexpected end")
+    {
+        std::string s = text.substr(0, text.size() - 1);
+        json_parallel_parse_context<json> context(4);
+        std::error_code ec;
+        context.parse(s, ec);
+        CHECK(ec == parse_serially(s).ec);
+    }
+
+    SECTION("exception")
+    {
+        std::string s = text;
+        s.append(",");
+        json_parallel_parse_context<json> context(4);
+        REQUIRE_THROWS_AS(context.parse(s), ser_error);
+    }
+}
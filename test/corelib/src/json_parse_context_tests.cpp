@@ -0,0 +1,80 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <string>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+
+TEST_CASE("json_parse_context tests")
+{
+    std::vector<std::string> messages = {
+        R"({"id":1,"path":"/orders","tags":["a","b"],"headers":{"accept":"application/json"}})",
+        R"([1,2.5,"a string that is too long for short string storage",null,true,{"a":[]}])",
+        R"("text")",
+        R"(10)",
+        R"({})"
+    };
+
+    SECTION("parse")
+    {
+        json_parse_context<json> context;
+        for (int i = 0; i < 3; ++i)
+        {
+            for (const auto& s : messages)
+            {
+                CHECK(json::parse(context, s) == json::parse(s));
+            }
+        }
+        CHECK(json::parse(context, "[1,2]") == json::parse("[1,2]"));
+    }
+
+    SECTION("reuse after an error")
+    {
+        json_parse_context<json> context;
+        REQUIRE_THROWS_AS(json::parse(context, std::string("{\"a\":[1,2")), ser_error);
+        REQUIRE_THROWS_AS(json::parse(context, std::string("[1] [2]")), ser_error);
+        CHECK(json::parse(context, messages[0]) == json::parse(messages[0]));
+
+        try
+        {
+            json::parse(context, std::string("{\n\"a\" 1}"));
+            CHECK(false);
+        }
+        catch (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::expected_colon);
+            CHECK(e.line() == 2);
+            CHECK(e.column() == 5);
+        }
+        CHECK(json::parse(context, messages[1]) == json::parse(messages[1]));
+    }
+
+    SECTION("decode_json")
+    {
+        json_parse_context<ojson> context;
+        for (const auto& s : messages)
+        {
+            CHECK(decode_json<ojson>(context, s) == ojson::parse(s));
+        }
+
+        auto result = try_decode_json<ojson>(context, std::string("[1,"));
+        REQUIRE_FALSE(result);
+        CHECK(result.error().code() == json_errc::unexpected_eof);
+
+        result = try_decode_json<ojson>(context, messages[0]);
+        REQUIRE(result);
+        CHECK(*result == ojson::parse(messages[0]));
+    }
+
+    SECTION("options")
+    {
+        auto options = json_options{}
+            .allow_trailing_comma(true);
+        json_parse_context<json> context(options);
+        CHECK(json::parse(context, "[1,2,]") == json::parse("[1,2]"));
+        CHECK(json::parse(context, "{\"a\":1,}") == json::parse("{\"a\":1}"));
+    }
+}
@@ -0,0 +1,304 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+
+TEST_CASE("json_shared_arg tests")
+{
+    json j = json::parse(R"({"a":[1,2,{"b":"a string that is too long for short string storage"}],"c":{"d":true}})");
+
+    SECTION("copies share the value")
+    {
+        json v(json_shared_arg, j);
+        CHECK(v.storage_kind() == json_storage_kind::shared);
+        CHECK(v.type() == json_type::object_value);
+        CHECK(v.is_object());
+        CHECK(2 == v.size());
+        CHECK(v == j);
+        CHECK(v.hash() == j.hash());
+
+        json w(v);
+        CHECK(w.storage_kind() == json_storage_kind::shared);
+        CHECK(w == v);
+
+        json x;
+        x = v;
+        CHECK(x.storage_kind() == json_storage_kind::shared);
+        CHECK(x == v);
+    }
+
+    SECTION("copy on write")
+    {
+        json v(json_shared_arg, j);
+        json w = v;
+        w["c"]["d"] = false;
+        w.at("a").push_back(3);
+
+        CHECK(v == j);
+        CHECK(w.at("c").at("d") == false);
+        CHECK(4 == w.at("a").size());
+        CHECK(3 == v.at("a").size());
+    }
+
+    SECTION("const reads do not copy")
+    {
+        json v(json_shared_arg, j);
+        json w = v;
+        const json& cv = v;
+        const json& cw = w;
+
+        CHECK(w.size() == 2);
+        CHECK(w.contains("a"));
+        CHECK(cw.at("a").at(2).at("b").as<std::string>() == cv.at("a").at(2).at("b").as<std::string>());
+        for (const auto& member : cw.object_range())
+        {
+            CHECK(member.value() == cv.at(member.key()));
+        }
+        CHECK(w.to_string() == v.to_string());
+        CHECK(&cw.at("a") == &cv.at("a"));
+        CHECK(&cw.at("c") == &cv.at("c"));
+    }
+
+    SECTION("a copy of a copied node copies one level")
+    {
+        json v(json_shared_arg, j);
+        json w = v;
+        const json& cw = w;
+
+        // Gives w a node of its own, whose arrays and objects have nodes of their own
+        CHECK(w["c"].storage_kind() == json_storage_kind::shared);
+        CHECK(w.at("a").storage_kind() == json_storage_kind::shared);
+
+        json x = w;
+        const json& cx = x;
+        CHECK(&cx.at("a") != &cw.at("a"));
+        CHECK(&cx.at("a").at(2) == &cw.at("a").at(2));
+        CHECK(&cx.at("c").at("d") == &cw.at("c").at("d"));
+
+        x["c"]["d"] = false;
+        CHECK(&cx.at("a").at(2) == &cw.at("a").at(2));
+        CHECK(cx.at("c").at("d") == false);
+        CHECK(cw.at("c").at("d") == true);
+        CHECK(v == j);
+    }
+
+    SECTION("copies made after non-const access don't share the node")
+    {
+        json a(json_shared_arg, json::parse(R"({"x":1,"y":[1,2]})"));
+        json& x = a["x"];
+        json b = a;
+        json c;
+        c = a;
+        x = 5;
+
+        CHECK(a.at("x") == 5);
+        CHECK(b.at("x") == 1);
+        CHECK(c.at("x") == 1);
+        CHECK(b == json::parse(R"({"x":1,"y":[1,2]})"));
+
+        json& y0 = a["y"][0];
+        json d = a;
+        y0 = 10;
+        CHECK(a.at("y").at(0) == 10);
+        CHECK(d.at("y").at(0) == 1);
+        CHECK(b.at("y").at(0) == 1);
+    }
+
+    SECTION("mutate sole owner")
+    {
+        json v(json_shared_arg, j);
+        v.erase("c");
+        CHECK(v.storage_kind() == json_storage_kind::shared);
+        CHECK(1 == v.size());
+        CHECK(2 == j.size());
+    }
+
+    SECTION("shared subtree in many documents")
+    {
+        json config(json_shared_arg, std::move(j));
+
+        std::vector<json> docs;
+        for (int i = 0; i < 10; ++i)
+        {
+            json doc(json_object_arg);
+            doc.try_emplace("id", i);
+            doc.try_emplace("config", config);
+            docs.push_back(std::move(doc));
+        }
+        docs[3]["config"]["c"]["d"] = false;
+
+        CHECK(docs[3].at("config").at("c").at("d") == false);
+        CHECK(docs[4].at("config").at("c").at("d") == true);
+        CHECK(config.at("c").at("d") == true);
+        CHECK(docs[4].at("config").storage_kind() == json_storage_kind::shared);
+    }
+
+    SECTION("values that don't allocate are copied")
+    {
+        json v(json_shared_arg, json(10));
+        CHECK(v.storage_kind() == json_storage_kind::int64);
+        CHECK(v == 10);
+    }
+
+    SECTION("share a referenced value")
+    {
+        json ref(json_const_pointer_arg, &j);
+        json v(json_shared_arg, ref);
+        CHECK(v.storage_kind() == json_storage_kind::shared);
+        CHECK(v == j);
+    }
+
+    SECTION("deep_copy")
+    {
+        json v(json_shared_arg, j);
+        json w = deep_copy(v);
+        CHECK(w.storage_kind() == json_storage_kind::object);
+        CHECK(w == v);
+    }
+
+    SECTION("swap and move")
+    {
+        json v(json_shared_arg, j);
+        json w(json_array_arg, {1,2,3});
+        swap(v, w);
+        CHECK(w.storage_kind() == json_storage_kind::shared);
+        CHECK(v.storage_kind() == json_storage_kind::array);
+
+        json x(std::move(w));
+        CHECK(x.storage_kind() == json_storage_kind::shared);
+        CHECK(x == j);
+    }
+
+    SECTION("dump")
+    {
+        json v(json_shared_arg, j);
+        CHECK(v.to_string() == j.to_string());
+    }
+}
+
+TEST_CASE("json_shared_arg deeply nested tests")
+{
+    const std::size_t depth = 200000;
+
+    SECTION("share a deeply nested array")
+    {
+        json deep(json_array_arg);
+        for (std::size_t i = 0; i < depth; ++i)
+        {
+            json outer(json_array_arg);
+            outer.push_back(std::move(deep));
+            deep = std::move(outer);
+        }
+        json s(json_shared_arg, std::move(deep));
+        json t = s;
+        CHECK(t.storage_kind() == json_storage_kind::shared);
+        CHECK(1 == t.size());
+    }
+
+    SECTION("deeply nested shared nodes")
+    {
+        json deep(json_object_arg);
+        for (std::size_t i = 0; i < depth; ++i)
+        {
+            json outer(json_array_arg);
+            outer.push_back(json(json_shared_arg, std::move(deep)));
+            deep = std::move(outer);
+        }
+        json s(json_shared_arg, std::move(deep));
+        CHECK(s[0].storage_kind() == json_storage_kind::shared);
+    }
+}
+
+TEST_CASE("json_shared_arg string tests")
+{
+    std::string s = "a string that is too long for short string storage";
+    json v(json_shared_arg, json(s));
+    json w = v;
+
+    CHECK(w.storage_kind() == json_storage_kind::shared);
+    CHECK(w.is_string());
+    CHECK(w.as<std::string>() == s);
+    CHECK(w == json(s));
+}
+
+TEST_CASE("json_shared_arg thread tests")
+{
+    json v(json_shared_arg, json::parse(R"({"a":[1,2,3],"b":{"c":"d"}})"));
+
+    std::vector<std::thread> threads;
+    std::vector<std::size_t> counts(4, 0);
+    for (std::size_t t = 0; t < counts.size(); ++t)
+    {
+        threads.emplace_back([&v,&counts,t]()
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                json local = v;
+                local["b"]["c"] = i;
+                counts[t] += static_cast<const json&>(local).at("a").size();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto count : counts)
+    {
+        CHECK(3000 == count);
+    }
+    CHECK(v.at("b").at("c") == "d");
+}
+
+#if defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR) && JSONCONS_HAS_POLYMORPHIC_ALLOCATOR == 1
+#include <memory_resource> 
+
+TEST_CASE("json_shared_arg polymorphic allocator tests")
+{
+    std::pmr::monotonic_buffer_resource pool1;
+    std::pmr::polymorphic_allocator<char> alloc1(&pool1);
+    std::pmr::monotonic_buffer_resource pool2;
+    std::pmr::polymorphic_allocator<char> alloc2(&pool2);
+
+    pmr::json j(json_array_arg, alloc1);
+    j.push_back("a string that is too long for short string storage");
+    j.push_back(10);
+
+    pmr::json v(json_shared_arg, std::move(j));
+    CHECK(v.storage_kind() == json_storage_kind::shared);
+    CHECK(v.get_allocator() == alloc1);
+
+    SECTION("copy with equal allocator shares")
+    {
+        pmr::json w(v, alloc1);
+        CHECK(w.storage_kind() == json_storage_kind::shared);
+        CHECK(w == v);
+    }
+
+    SECTION("copy with other allocator doesn't share")
+    {
+        pmr::json w(v, alloc2);
+        CHECK(w.storage_kind() == json_storage_kind::array);
+        CHECK(w.get_allocator() == alloc2);
+        CHECK(w == v);
+    }
+
+    SECTION("copy on write keeps the allocator")
+    {
+        pmr::json w(v);
+        w.push_back(true);
+        CHECK(w.get_allocator() == alloc1);
+        CHECK(3 == w.size());
+        CHECK(2 == v.size());
+    }
+}
+
+#endif
@@ -20,12 +20,14 @@ TEST_CASE("test json_storage_kind")
         CHECK(is_trivial_storage(json_storage_kind::half_float));
         CHECK(is_trivial_storage(json_storage_kind::short_str));
         CHECK(is_trivial_storage(json_storage_kind::empty_object));
+        CHECK(is_trivial_storage(json_storage_kind::empty_array));
         CHECK(is_trivial_storage(json_storage_kind::json_const_ref));
         CHECK(is_trivial_storage(json_storage_kind::json_ref));
         CHECK_FALSE(is_trivial_storage(json_storage_kind::long_str));
         CHECK_FALSE(is_trivial_storage(json_storage_kind::byte_str));
         CHECK_FALSE(is_trivial_storage(json_storage_kind::array));
         CHECK_FALSE(is_trivial_storage(json_storage_kind::object));
+        CHECK_FALSE(is_trivial_storage(json_storage_kind::shared));
     }
     SECTION("is_string_storage")
     {
@@ -36,12 +38,14 @@ TEST_CASE("test json_storage_kind")
         CHECK_FALSE(is_string_storage(json_storage_kind::half_float));
         CHECK(is_string_storage(json_storage_kind::short_str));
         CHECK_FALSE(is_string_storage(json_storage_kind::empty_object));
+        CHECK_FALSE(is_string_storage(json_storage_kind::empty_array));
         CHECK_FALSE(is_string_storage(json_storage_kind::json_const_ref));
         CHECK_FALSE(is_string_storage(json_storage_kind::json_ref));
         CHECK(is_string_storage(json_storage_kind::long_str));
         CHECK_FALSE(is_string_storage(json_storage_kind::byte_str));
         CHECK_FALSE(is_string_storage(json_storage_kind::array));
         CHECK_FALSE(is_string_storage(json_storage_kind::object));
+        CHECK_FALSE(is_string_storage(json_storage_kind::shared));
     }
 }
 
@@ -0,0 +1,275 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons_ext/csv/csv.hpp>
+#include <jsoncons/json.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+namespace csv = jsoncons::csv;
+
+TEST_CASE("csv_batch_reader inferred types")
+{
+    const std::string s = R"(id,price,flag,label
+1,1.5,true,a
+2,,false,"b,c"
+3,2,true,
+)";
+
+    auto options = csv::csv_options{}
+        .assume_header(true);
+
+    std::vector<csv::csv_record_batch> batches;
+    csv::csv_string_batch_reader reader(s, options, 2);
+    reader.read([&](const csv::csv_record_batch& batch){batches.push_back(batch);});
+
+    REQUIRE(2 == batches.size());
+    CHECK(0 == batches[0].first_row());
+    CHECK(2 == batches[0].row_count());
+    CHECK(2 == batches[1].first_row());
+    CHECK(1 == batches[1].row_count());
+
+    const auto& batch = batches[0];
+    REQUIRE(4 == batch.column_count());
+
+    const auto& id = batch.column(0);
+    CHECK("id" == id.name());
+    CHECK(csv::csv_column_type::integer_t == id.type());
+    CHECK(id.int64_values() == std::vector<int64_t>{1, 2});
+    CHECK(0 == id.null_count());
+
+    const auto& price = batch.column(1);
+    CHECK(csv::csv_column_type::float_t == price.type());
+    REQUIRE(2 == price.size());
+    CHECK(1.5 == price.double_values()[0]);
+    CHECK_FALSE(price.is_null(0));
+    CHECK(price.is_null(1));
+    CHECK(1 == price.null_count());
+    CHECK(1 == price.validity().size());
+    CHECK(0x01 == price.validity()[0]);
+
+    const auto& flag = batch.column(2);
+    CHECK(csv::csv_column_type::boolean_t == flag.type());
+    CHECK(flag.bool_values() == std::vector<uint8_t>{1, 0});
+
+    const auto& label = batch.column(3);
+    CHECK(csv::csv_column_type::string_t == label.type());
+    CHECK(label.offsets() == std::vector<std::size_t>{0, 1, 4});
+    CHECK("ab,c" == label.string_data());
+    CHECK("b,c" == label.string_value(1));
+
+    // The column types carry over to the next batch
+    const auto& last = batches[1];
+    CHECK(csv::csv_column_type::float_t == last.column(1).type());
+    CHECK(2.0 == last.column(1).double_values()[0]);
+    CHECK(last.column(3).is_null(0));
+    CHECK(last.column(3).offsets() == std::vector<std::size_t>{0, 0});
+}
+
+TEST_CASE("csv_batch_reader column_types")
+{
+    SECTION("declared types")
+    {
+        const std::string s = R"(a,b,c,d
+7,2,1,10
+x,3.25,0,20
+)";
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .column_types("integer,float,boolean,string");
+
+        csv::csv_record_batch result;
+        csv::csv_string_batch_reader reader(s, options);
+        reader.read([&](const csv::csv_record_batch& batch){result = batch;});
+
+        REQUIRE(2 == result.row_count());
+        CHECK(csv::csv_column_type::integer_t == result.column(0).type());
+        CHECK(7 == result.column(0).int64_values()[0]);
+        CHECK(result.column(0).is_null(1));
+        CHECK(csv::csv_column_type::float_t == result.column(1).type());
+        CHECK(result.column(1).double_values() == std::vector<double>{2.0, 3.25});
+        CHECK(result.column(2).bool_values() == std::vector<uint8_t>{1, 0});
+        CHECK(csv::csv_column_type::string_t == result.column(3).type());
+        CHECK("1020" == result.column(3).string_data());
+    }
+
+    SECTION("repeated type")
+    {
+        const std::string s = "x,1,2,3\ny,4,5\n";
+        auto options = csv::csv_options{}
+            .column_types("string,float*")
+            .column_names("name,v1,v2,v3");
+
+        csv::csv_record_batch result;
+        csv::csv_string_batch_reader reader(s, options);
+        reader.read([&](const csv::csv_record_batch& batch){result = batch;});
+
+        REQUIRE(4 == result.column_count());
+        CHECK("v3" == result.column(3).name());
+        for (std::size_t i = 1; i < 4; ++i)
+        {
+            CHECK(csv::csv_column_type::float_t == result.column(i).type());
+        }
+        CHECK(3.0 == result.column(3).double_values()[0]);
+        CHECK(result.column(3).is_null(1));
+    }
+
+    SECTION("nested columns")
+    {
+        const std::string s = "1;2,3\n";
+        auto options = csv::csv_options{}
+            .subfield_delimiter(';');
+
+        csv::csv_string_batch_reader reader(s, options);
+        std::error_code ec;
+        reader.read([](const csv::csv_record_batch&){}, ec);
+        CHECK(ec == csv::csv_errc::nested_column_value);
+    }
+}
+
+TEST_CASE("csv_batch_reader widening")
+{
+    const std::string s = "1,1,true\n2.5,abc,1\n3,2,\n";
+
+    csv::csv_record_batch result;
+    csv::csv_string_batch_reader reader(s, csv::csv_options{});
+    reader.read([&](const csv::csv_record_batch& batch){result = batch;});
+
+    REQUIRE(3 == result.row_count());
+    REQUIRE(3 == result.column_count());
+    CHECK(result.column(0).name().empty());
+
+    CHECK(csv::csv_column_type::float_t == result.column(0).type());
+    CHECK(result.column(0).double_values() == std::vector<double>{1.0, 2.5, 3.0});
+
+    CHECK(csv::csv_column_type::string_t == result.column(1).type());
+    CHECK("1" == result.column(1).string_value(0));
+    CHECK("abc" == result.column(1).string_value(1));
+    CHECK("2" == result.column(1).string_value(2));
+
+    CHECK(csv::csv_column_type::string_t == result.column(2).type());
+    CHECK("true" == result.column(2).string_value(0));
+    CHECK("1" == result.column(2).string_value(1));
+    CHECK(result.column(2).is_null(2));
+}
+
+TEST_CASE("csv_batch_reader nulls before the first value")
+{
+    SECTION("leading empty cell")
+    {
+        csv::csv_record_batch result;
+        csv::csv_string_batch_reader reader("a,b\n,x\n1,y\n2,z\n", csv::csv_options{}.assume_header(true));
+        reader.read([&](const csv::csv_record_batch& batch){result = batch;});
+
+        const auto& a = result.column(0);
+        CHECK(csv::csv_column_type::integer_t == a.type());
+        REQUIRE(3 == a.size());
+        CHECK(a.int64_values() == std::vector<int64_t>{0, 1, 2});
+        CHECK(a.is_null(0));
+        CHECK(1 == a.null_count());
+        CHECK(1 == a.offsets().size());
+    }
+
+    SECTION("leading empty cells then text")
+    {
+        csv::csv_record_batch result;
+        csv::csv_string_batch_reader reader("0,\n1,1\n2,abc\n", csv::csv_options{});
+        reader.read([&](const csv::csv_record_batch& batch){result = batch;});
+
+        const auto& column = result.column(1);
+        CHECK(csv::csv_column_type::string_t == column.type());
+        REQUIRE(3 == column.size());
+        CHECK(column.is_null(0));
+        CHECK("1" == column.string_value(1));
+        CHECK("abc" == column.string_value(2));
+    }
+
+    SECTION("late created column")
+    {
+        csv::csv_record_batch result;
+        csv::csv_string_batch_reader reader("1\n2\n3,4.5\n4,5\n", csv::csv_options{});
+        reader.read([&](const csv::csv_record_batch& batch){result = batch;});
+
+        REQUIRE(2 == result.column_count());
+        const auto& column = result.column(1);
+        CHECK(csv::csv_column_type::float_t == column.type());
+        REQUIRE(4 == column.size());
+        CHECK(column.double_values() == std::vector<double>{0.0, 0.0, 4.5, 5.0});
+        CHECK(2 == column.null_count());
+        CHECK(column.is_null(1));
+        CHECK_FALSE(column.is_null(2));
+    }
+
+    SECTION("late created column widened to text")
+    {
+        csv::csv_record_batch result;
+        csv::csv_string_batch_reader reader("1\n2,3\n4,x\n", csv::csv_options{});
+        reader.read([&](const csv::csv_record_batch& batch){result = batch;});
+
+        const auto& column = result.column(1);
+        CHECK(csv::csv_column_type::string_t == column.type());
+        REQUIRE(3 == column.size());
+        CHECK(column.is_null(0));
+        CHECK("3" == column.string_value(1));
+        CHECK("x" == column.string_value(2));
+    }
+
+    SECTION("type carries over to later batches")
+    {
+        std::vector<csv::csv_column_type> types;
+        csv::csv_string_batch_reader reader("1\n2.5\n3\n", csv::csv_options{}, 1);
+        reader.read([&](const csv::csv_record_batch& batch){types.push_back(batch.column(0).type());});
+
+        CHECK(types == std::vector<csv::csv_column_type>{csv::csv_column_type::integer_t,
+            csv::csv_column_type::float_t, csv::csv_column_type::float_t});
+    }
+}
+
+TEST_CASE("csv_batch_reader same values as decode_csv")
+{
+    std::string s = "a,b,c\n";
+    for (int i = 0; i < 1000; ++i)
+    {
+        s += std::to_string(i) + "," + std::to_string(i * 0.5) + ",\"text " + std::to_string(i) + "\"\n";
+    }
+    auto options = csv::csv_options{}
+        .assume_header(true)
+        .mapping_kind(csv::csv_mapping_kind::n_rows);
+    json expected = csv::decode_csv<json>(s, options);
+
+    std::size_t batch_count = 0;
+    csv::csv_string_batch_reader reader(s, options, 300);
+    reader.read([&](const csv::csv_record_batch& batch)
+    {
+        ++batch_count;
+        for (std::size_t i = 0; i < batch.row_count(); ++i)
+        {
+            const json& row = expected[batch.first_row() + i + 1];
+            CHECK(row[0].as<int64_t>() == batch.column(0).int64_values()[i]);
+            CHECK(row[1].as<double>() == batch.column(1).double_values()[i]);
+            CHECK(row[2].as_string_view() == batch.column(2).string_value(i));
+        }
+    });
+    CHECK(4 == batch_count);
+}
+
+TEST_CASE("wcsv_batch_reader")
+{
+    const std::wstring s = L"name,qty\nfoo,3\nbar,\n";
+    auto options = csv::wcsv_options{}
+        .assume_header(true);
+
+    csv::wcsv_record_batch result;
+    csv::wcsv_string_batch_reader reader(s, options);
+    reader.read([&](const csv::wcsv_record_batch& batch){result = batch;});
+
+    REQUIRE(2 == result.row_count());
+    CHECK(L"qty" == result.column(1).name());
+    CHECK(L"bar" == result.column(0).string_value(1));
+    CHECK(3 == result.column(1).int64_values()[0]);
+    CHECK(result.column(1).is_null(1));
+}
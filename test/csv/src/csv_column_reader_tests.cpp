@@ -0,0 +1,189 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons_ext/csv/csv_column_reader.hpp>
+#include <jsoncons_ext/csv/csv_reader.hpp>
+#include <jsoncons/json.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+namespace csv = jsoncons::csv;
+
+namespace {
+
+    ojson read_m_columns(const std::string& input, const csv::csv_options& options)
+    {
+        json_decoder<ojson> decoder;
+        csv::csv_string_reader reader(input, decoder, options);
+        reader.read();
+        return decoder.get_result();
+    }
+
+    ojson read_by_columns(const std::string& input, const csv::csv_options& options, std::size_t columns_per_pass)
+    {
+        json_decoder<ojson> decoder;
+        csv::csv_column_reader reader(input, options, columns_per_pass);
+        reader.read(decoder);
+        return decoder.get_result();
+    }
+
+} // namespace
+
+TEST_CASE("csv_column_reader same output as m_columns")
+{
+    const std::string bond_yields = R"(Date,ProductType,1Y,2Y,3Y,5Y
+2017-01-09,"Bond",0.0062,0.0075,0.0083,0.011
+2017-01-08,"Bond",0.0063,0.0076,,0.0112
+2017-01-08,"Bond",0.0063,0.0076,0.0084,
+)";
+
+    SECTION("default options")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .mapping_kind(csv::csv_mapping_kind::m_columns);
+
+        ojson expected = read_m_columns(bond_yields, options);
+        for (std::size_t columns_per_pass : {1, 2, 4, 6, 100})
+        {
+            CHECK(expected == read_by_columns(bond_yields, options, columns_per_pass));
+        }
+    }
+
+    SECTION("ignore_empty_values")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .ignore_empty_values(true)
+            .mapping_kind(csv::csv_mapping_kind::m_columns);
+
+        ojson expected = read_m_columns(bond_yields, options);
+        CHECK(2 == expected["3Y"].size());
+        for (std::size_t columns_per_pass : {1, 3})
+        {
+            CHECK(expected == read_by_columns(bond_yields, options, columns_per_pass));
+        }
+    }
+
+    SECTION("subfields")
+    {
+        const std::string s = R"(calculationPeriodCenters,paymentCenters,resetCenters
+NY;LON,TOR,LON
+NY,LON,TOR;LON
+"NY";"LON","TOR","LON"
+"NY","LON","TOR";"LON"
+)";
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .mapping_kind(csv::csv_mapping_kind::m_columns)
+            .subfield_delimiter(';');
+
+        ojson expected = read_m_columns(s, options);
+        for (std::size_t columns_per_pass : {1, 2})
+        {
+            CHECK(expected == read_by_columns(s, options, columns_per_pass));
+        }
+    }
+
+    SECTION("header only")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .mapping_kind(csv::csv_mapping_kind::m_columns);
+
+        const std::string s = "a,b\n";
+        ojson expected = read_m_columns(s, options);
+        CHECK(expected == read_by_columns(s, options, 1));
+    }
+
+    SECTION("not m_columns")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        json_decoder<ojson> decoder;
+        csv::csv_column_reader reader(bond_yields, options);
+        std::error_code ec;
+        reader.read(decoder, ec);
+        CHECK(ec == csv::csv_errc::m_columns_required);
+    }
+}
+
+TEST_CASE("csv_column_reader read_column")
+{
+    const std::string s = R"(id,price,label,qty
+1,1.5,"a",10
+2,,"b",-3
+3,2.25,"c",7
+)";
+
+    auto options = csv::csv_options{}
+        .assume_header(true)
+        .mapping_kind(csv::csv_mapping_kind::m_columns);
+
+    csv::csv_column_reader reader(s, options);
+
+    SECTION("integers")
+    {
+        std::vector<int64_t> ids;
+        reader.read_column(0, ids);
+        CHECK(ids == std::vector<int64_t>{1, 2, 3});
+        REQUIRE(4 == reader.column_count());
+        CHECK("id" == reader.column_name(0));
+        CHECK("qty" == reader.column_name(3));
+
+        std::vector<int32_t> qty;
+        reader.read_column(3, qty);
+        CHECK(qty == std::vector<int32_t>{10, -3, 7});
+    }
+
+    SECTION("doubles with an empty value")
+    {
+        std::vector<double> prices = {99.0};
+        reader.read_column(1, prices);
+        REQUIRE(3 == prices.size());
+        CHECK(1.5 == prices[0]);
+        CHECK(std::isnan(prices[1]));
+        CHECK(2.25 == prices[2]);
+    }
+
+    SECTION("errors")
+    {
+        std::vector<uint32_t> qty;
+        std::error_code ec;
+        reader.read_column(3, qty, ec);
+        CHECK(ec == conv_errc::not_integer);
+
+        std::vector<int64_t> prices;
+        reader.read_column(1, prices, ec);
+        CHECK(ec == conv_errc::not_integer);
+
+        std::vector<double> labels;
+        reader.read_column(2, labels, ec);
+        CHECK(ec == conv_errc::not_double);
+    }
+
+    SECTION("numeric text")
+    {
+        auto text_options = csv::csv_options{}
+            .assume_header(true)
+            .infer_types(false)
+            .mapping_kind(csv::csv_mapping_kind::m_columns);
+
+        csv::csv_column_reader text_reader(s, text_options);
+        std::vector<int64_t> qty;
+        text_reader.read_column(3, qty);
+        CHECK(qty == std::vector<int64_t>{10, -3, 7});
+    }
+
+    SECTION("no such column")
+    {
+        std::vector<double> values;
+        reader.read_column(10, values);
+        CHECK(values.empty());
+    }
+}
@@ -890,3 +890,83 @@ Chicago Sun-Times,1.27
     }    
 }
 
+
+TEST_CASE("test flat objects with changing keys to csv")
+{
+    SECTION("keys in a different order")
+    {
+        std::string expected = R"(a,b,c
+1,2,3
+4,5,6
+7,8,9
+)";
+
+        auto j = jsoncons::ojson::parse(R"(
+[
+    {"a" : 1, "b" : 2, "c" : 3},
+    {"c" : 6, "a" : 4, "b" : 5},
+    {"a" : 7, "b" : 8, "c" : 9}
+]
+        )");
+
+        std::string buf;
+        csv::encode_csv(j, buf);
+        CHECK(expected == buf);
+    }
+
+    SECTION("missing and new keys")
+    {
+        std::string expected = R"(a,b,c
+1,2,3
+4,,6
+,8,
+10,11,12
+)";
+
+        auto j = jsoncons::ojson::parse(R"(
+[
+    {"a" : 1, "b" : 2, "c" : 3},
+    {"a" : 4, "c" : 6},
+    {"b" : 8, "d" : 0},
+    {"a" : 10, "b" : 11, "c" : 12}
+]
+        )");
+
+        std::string buf;
+        csv::encode_csv(j, buf);
+        CHECK(expected == buf);
+    }
+
+    SECTION("nan written as a string")
+    {
+        std::string expected = R"(a,b
+NaN,1
+2.0,NaN
+)";
+
+        jsoncons::json j(jsoncons::json_array_arg);
+        j.push_back(jsoncons::json(jsoncons::json_object_arg, {{"a", std::nan("")}, {"b", 1}}));
+        j.push_back(jsoncons::json(jsoncons::json_object_arg, {{"a", 2.0}, {"b", std::nan("")}}));
+
+        auto options = csv::csv_options{}
+            .nan_to_str("NaN");
+
+        std::string buf;
+        csv::encode_csv(j, buf, options);
+        CHECK(expected == buf);
+    }
+
+    SECTION("encoder reset between documents")
+    {
+        auto j1 = jsoncons::ojson::parse(R"([{"a" : 1, "b" : 2}])");
+        auto j2 = jsoncons::ojson::parse(R"([{"x" : 3, "a" : 4}])");
+
+        std::string buf;
+        csv::csv_string_encoder encoder(buf);
+        j1.dump(encoder);
+        encoder.reset();
+        j2.dump(encoder);
+        encoder.flush();
+        CHECK("a,b\n1,2\nx,a\n3,4\n" == buf);
+    }
+}
@@ -0,0 +1,241 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons_ext/csv/csv.hpp>
+#include <jsoncons/json.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+namespace csv = jsoncons::csv;
+
+namespace {
+namespace ns {
+
+    struct fruit
+    {
+        std::string name;
+        int64_t quantity;
+        double price;
+    };
+
+} // namespace ns
+
+    template <typename Json>
+    Json decode_with_json_decoder(const std::string& input, const csv::csv_options& options)
+    {
+        json_decoder<Json> decoder;
+        csv::csv_string_reader reader(input, decoder, options);
+        reader.read();
+        return decoder.get_result();
+    }
+
+    template <typename Json>
+    void check_same_as_json_decoder(const std::string& input, const csv::csv_options& options)
+    {
+        Json expected = decode_with_json_decoder<Json>(input, options);
+        Json j = csv::decode_csv<Json>(input, options);
+        CHECK(expected == j);
+
+        // Same member order
+        REQUIRE(expected.size() == j.size());
+        for (std::size_t i = 0; i < j.size(); ++i)
+        {
+            REQUIRE(expected[i].is_object());
+            REQUIRE(j[i].is_object());
+            REQUIRE(expected[i].size() == j[i].size());
+            auto it1 = expected[i].object_range().begin();
+            auto it2 = j[i].object_range().begin();
+            for (; it1 != expected[i].object_range().end(); ++it1, ++it2)
+            {
+                CHECK(it1->key() == it2->key());
+            }
+        }
+    }
+
+} // namespace
+
+JSONCONS_ALL_MEMBER_TRAITS(ns::fruit, name, quantity, price)
+
+TEST_CASE("csv n_objects decode with shared row layout")
+{
+    auto options = csv::csv_options{}
+        .assume_header(true);
+
+    SECTION("rows with the same columns")
+    {
+        std::string input = "name,quantity,price\napple,3,0.5\nbanana,12,0.25\ncherry,100,0.02\n";
+
+        check_same_as_json_decoder<json>(input, options);
+        check_same_as_json_decoder<ojson>(input, options);
+
+        ojson j = csv::decode_csv<ojson>(input, options);
+        REQUIRE(3 == j.size());
+        CHECK(j[1].object_range().begin()->key() == "name");
+        CHECK(12 == j[1].at("quantity").as<int>());
+    }
+
+    SECTION("duplicate column names")
+    {
+        std::string input = "b,a,b,c,a\n1,2,3,4,5\n6,7,8,9,10\n";
+
+        check_same_as_json_decoder<json>(input, options);
+
+        json j = csv::decode_csv<json>(input, options);
+        REQUIRE(2 == j.size());
+        CHECK(3 == j[0].size());
+        CHECK(1 == j[0].at("b").as<int>());
+        CHECK(7 == j[1].at("a").as<int>());
+
+        // The first of several equal keys is kept
+        ojson oj = csv::decode_csv<ojson>(input, options);
+        CHECK(ojson::parse(R"([{"b":1,"a":2,"c":4},{"b":6,"a":7,"c":9}])") == oj);
+        CHECK(oj[1].object_range().begin()->key() == "b");
+    }
+
+    SECTION("ignore empty values")
+    {
+        std::string input = "c,a,b\n1,,3\n,2,\n4,5,6\n,,\n7,,9\n";
+        auto options2 = csv::csv_options{}
+            .assume_header(true)
+            .ignore_empty_values(true);
+
+        check_same_as_json_decoder<json>(input, options2);
+        check_same_as_json_decoder<ojson>(input, options2);
+
+        json j = csv::decode_csv<json>(input, options2);
+        REQUIRE(5 == j.size());
+        CHECK(2 == j[0].size());
+        CHECK(1 == j[1].size());
+        CHECK(0 == j[3].size());
+        CHECK(9 == j[4].at("b").as<int>());
+    }
+
+    SECTION("missing and extra values")
+    {
+        std::string input = "x,y,z\n1,2\n3,4,5,6\n7\n8,9,10\n";
+
+        check_same_as_json_decoder<json>(input, options);
+        check_same_as_json_decoder<ojson>(input, options);
+    }
+
+    SECTION("subfields and column types")
+    {
+        std::string input = "id,score,tags\n1,1.5,a;b;c\n2,x,d\n3,2,\n";
+        auto options2 = csv::csv_options{}
+            .assume_header(true)
+            .subfield_delimiter(';')
+            .column_types("integer,float,[string*]");
+
+        check_same_as_json_decoder<json>(input, options2);
+        check_same_as_json_decoder<ojson>(input, options2);
+
+        json j = csv::decode_csv<json>(input, options2);
+        REQUIRE(3 == j.size());
+        CHECK(j[1].at("tags").is_array());
+        CHECK(j[1].at("score").is_null());
+    }
+
+    SECTION("column names given in the options")
+    {
+        std::string input = "1,2,3\n4,5,6\n";
+        auto options2 = csv::csv_options{}
+            .column_names("z,y,x");
+
+        check_same_as_json_decoder<json>(input, options2);
+        check_same_as_json_decoder<ojson>(input, options2);
+    }
+
+    SECTION("stream and iterator input")
+    {
+        std::string input = "name,quantity,price\napple,3,0.5\nbanana,12,0.25\n";
+        json expected = decode_with_json_decoder<json>(input, options);
+
+        std::istringstream is(input);
+        CHECK(expected == csv::decode_csv<json>(is, options));
+        CHECK(expected == csv::decode_csv<json>(input.begin(), input.end(), options));
+        CHECK(expected == csv::decode_csv<json>(make_alloc_set(), input, options));
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring input = L"b,a\n1,2\n3,4\n";
+        auto options2 = csv::wcsv_options{}
+            .assume_header(true);
+
+        wjson j = csv::decode_csv<wjson>(input, options2);
+        REQUIRE(2 == j.size());
+        CHECK(j[1].object_range().begin()->key() == L"a");
+        CHECK(3 == j[1].at(L"b").as<int>());
+    }
+}
+
+TEST_CASE("csv n_objects decode into a vector of structs")
+{
+    std::string input = "price,name,quantity\n0.5,apple,3\n0.25,banana,12\n";
+    auto options = csv::csv_options{}
+        .assume_header(true);
+
+    SECTION("string input")
+    {
+        auto fruits = csv::decode_csv<std::vector<ns::fruit>>(input, options);
+        REQUIRE(2 == fruits.size());
+        CHECK("banana" == fruits[1].name);
+        CHECK(12 == fruits[1].quantity);
+        CHECK(0.25 == fruits[1].price);
+    }
+
+    SECTION("stream and iterator input")
+    {
+        std::istringstream is(input);
+        auto fruits = csv::decode_csv<std::vector<ns::fruit>>(is, options);
+        REQUIRE(2 == fruits.size());
+        CHECK("apple" == fruits[0].name);
+
+        auto fruits2 = csv::decode_csv<std::vector<ns::fruit>>(input.begin(), input.end(), options);
+        REQUIRE(2 == fruits2.size());
+        CHECK(3 == fruits2[0].quantity);
+
+        auto fruits3 = csv::decode_csv<std::vector<ns::fruit>>(make_alloc_set(), input, options);
+        REQUIRE(2 == fruits3.size());
+        CHECK(0.5 == fruits3[0].price);
+    }
+
+    SECTION("missing member")
+    {
+        std::string input2 = "price,name\n0.5,apple\n";
+        auto result = csv::try_decode_csv<std::vector<ns::fruit>>(input2, options);
+        CHECK_FALSE(result);
+    }
+
+    SECTION("empty input")
+    {
+        auto result = csv::try_decode_csv<std::vector<ns::fruit>>(std::string("price,name,quantity\n"), options);
+        REQUIRE(result);
+        CHECK(result->empty());
+    }
+}
+
+TEST_CASE("json insert sorted unique range")
+{
+    SECTION("into an empty object")
+    {
+        std::vector<std::pair<std::string,json>> members = {{"a", json(1)}, {"b", json(2)}, {"c", json(3)}};
+
+        json j(json_object_arg);
+        j.insert(sorted_unique_range_tag(), members.begin(), members.end());
+        CHECK(json::parse(R"({"a":1,"b":2,"c":3})") == j);
+    }
+
+    SECTION("into an object with members")
+    {
+        std::vector<std::pair<std::string,json>> members = {{"a", json(1)}, {"c", json(3)}, {"e", json(5)}};
+
+        json j = json::parse(R"({"b":20,"c":30,"f":60})");
+        j.insert(sorted_unique_range_tag(), members.begin(), members.end());
+        CHECK(json::parse(R"({"a":1,"b":20,"c":30,"e":5,"f":60})") == j);
+    }
+}
@@ -0,0 +1,353 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons_ext/csv/csv_parallel_reader.hpp>
+#include <jsoncons_ext/csv/csv_reader.hpp>
+#include <jsoncons/json.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+namespace csv = jsoncons::csv;
+
+namespace {
+
+    ojson read_sequential(const std::string& input, const csv::csv_options& options)
+    {
+        json_decoder<ojson> decoder;
+        csv::csv_string_reader reader(input, decoder, options);
+        reader.read();
+        return decoder.get_result();
+    }
+
+    std::string make_input(std::size_t rows, const std::string& newline)
+    {
+        std::string input = "id,name,amount,note" + newline;
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            input += std::to_string(i) + ",\"name " + std::to_string(i) + "\"," + std::to_string(i*0.5) + ",";
+            if (i % 7 == 0)
+            {
+                input += "\"multi" + newline + "line, \"\"quoted\"\"\"";
+            }
+            else
+            {
+                input += "plain";
+            }
+            input += newline;
+        }
+        return input;
+    }
+
+    struct read_outcome
+    {
+        ojson result;
+        std::error_code ec;
+        std::size_t line;
+    };
+
+    read_outcome read_sequential_outcome(const std::string& input, const csv::csv_options& options)
+    {
+        json_decoder<ojson> decoder;
+        csv::csv_string_reader reader(input, decoder, options);
+        read_outcome outcome;
+        reader.read(outcome.ec);
+        outcome.line = reader.line();
+        if (!outcome.ec)
+        {
+            outcome.result = decoder.get_result();
+        }
+        return outcome;
+    }
+
+    read_outcome read_parallel_outcome(const std::string& input, const csv::csv_options& options,
+        std::size_t chunk_size)
+    {
+        csv::csv_parallel_reader reader(input, options, 4, chunk_size);
+        read_outcome outcome;
+        outcome.ec = csv::csv_errc::source_error;
+        reader.read(outcome.result, outcome.ec);
+        outcome.line = reader.line();
+        return outcome;
+    }
+
+    void check_same_outcome(const std::string& input, const csv::csv_options& options)
+    {
+        read_outcome sequential = read_sequential_outcome(input, options);
+        for (std::size_t chunk_size : {1, 7, 32})
+        {
+            read_outcome parallel = read_parallel_outcome(input, options, chunk_size);
+            CHECK(parallel.ec == sequential.ec);
+            if (sequential.ec)
+            {
+                CHECK(parallel.line == sequential.line);
+            }
+            else
+            {
+                CHECK(parallel.result == sequential.result);
+            }
+        }
+    }
+
+} // namespace
+
+TEST_CASE("csv_parallel_reader same output as sequential")
+{
+    SECTION("n_objects")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        for (const std::string newline : {"\n", "\r\n", "\r"})
+        {
+            std::string input = make_input(200, newline);
+            ojson expected = read_sequential(input, options);
+
+            csv::csv_parallel_reader reader(input, options, 4, 256);
+            CHECK(reader.chunk_count() > 10);
+            ojson j;
+            reader.read(j);
+            CHECK(expected == j);
+
+            json_decoder<ojson> decoder;
+            csv::csv_parallel_reader reader2(input, options, 3, 100);
+            reader2.read(decoder);
+            CHECK(expected == decoder.get_result());
+        }
+    }
+
+    SECTION("n_rows with header and comments")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .comment_starter('#')
+            .mapping_kind(csv::csv_mapping_kind::n_rows);
+
+        std::string input = "# a comment with a \" quote\na,b\n";
+        for (int i = 0; i < 100; ++i)
+        {
+            input += std::to_string(i) + ",\"x\ny\"\n";
+            if (i % 10 == 0)
+            {
+                input += "# another \" comment\n";
+            }
+        }
+        ojson expected = read_sequential(input, options);
+        csv::csv_parallel_reader reader(input, options, 2, 50);
+        CHECK(reader.chunk_count() > 10);
+        ojson j;
+        reader.read(j);
+        CHECK(expected == j);
+    }
+
+    SECTION("no header and subfields")
+    {
+        auto options = csv::csv_options{}
+            .subfield_delimiter(';');
+
+        std::string input;
+        for (int i = 0; i < 100; ++i)
+        {
+            input += "1;2;3,\"a\",b;c\n";
+        }
+        ojson expected = read_sequential(input, options);
+        csv::csv_parallel_reader reader(input, options, 4, 64);
+        CHECK(reader.chunk_count() > 10);
+        ojson j;
+        reader.read(j);
+        CHECK(expected == j);
+    }
+
+    SECTION("quote escape character")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .quote_escape_char('\\');
+
+        std::string input = "a,b\n";
+        for (int i = 0; i < 100; ++i)
+        {
+            input += "\"\\\"\n\",x\n";
+        }
+        ojson expected = read_sequential(input, options);
+        REQUIRE(100 == expected.size());
+        csv::csv_parallel_reader reader(input, options, 4, 20);
+        ojson j;
+        reader.read(j);
+        CHECK(expected == j);
+    }
+
+    SECTION("m_columns and max_lines are read sequentially")
+    {
+        std::string input = make_input(50, "\n");
+
+        auto options1 = csv::csv_options{}
+            .assume_header(true)
+            .mapping_kind(csv::csv_mapping_kind::m_columns);
+        csv::csv_parallel_reader reader1(input, options1, 4, 64);
+        CHECK(1 == reader1.chunk_count());
+        ojson j1;
+        reader1.read(j1);
+        CHECK(read_sequential(input, options1) == j1);
+
+        auto options2 = csv::csv_options{}
+            .assume_header(true)
+            .max_lines(10);
+        csv::csv_parallel_reader reader2(input, options2, 4, 64);
+        CHECK(1 == reader2.chunk_count());
+    }
+
+    SECTION("error line")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        std::string input = "a,b\n";
+        for (int i = 0; i < 100; ++i)
+        {
+            input += (i == 73) ? "\"x\"y,1\n" : "1,2\n";
+        }
+        csv::csv_parallel_reader reader(input, options, 4, 32);
+        ojson j;
+        std::error_code ec;
+        reader.read(j, ec);
+        CHECK(ec == csv::csv_errc::unexpected_char_between_fields);
+        CHECK(75 == reader.line());
+    }
+}
+
+TEST_CASE("csv_parallel_reader malformed input")
+{
+    std::string rows;
+    for (int i = 0; i < 20; ++i)
+    {
+        rows += std::to_string(i) + ",\"a\"\"b\",c\n";
+    }
+
+    SECTION("quote in the middle of an unquoted field")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        check_same_outcome("a,b,c\n" + rows + "1,x\"y\n2,3\",z\n" + rows, options);
+        check_same_outcome("a,b,c\n" + rows + "1,x\"y\n" + rows, options);
+    }
+
+    SECTION("quote after a closing quote")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        check_same_outcome("a,b,c\n" + rows + "1,\"x\" \"y\n2,3\n\",z\n" + rows, options);
+        check_same_outcome("a,b,c\n" + rows + "1,\"x\"\"y\n\"q,z\n" + rows, options);
+    }
+
+    SECTION("escape character not followed by a quote")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .quote_escape_char('\\');
+
+        check_same_outcome("a,b,c\n1,\"x\\\"y\",z\n" + rows + "1,\"x\\\n\"\n2,y\"\n" + rows, options);
+    }
+
+    SECTION("unterminated quote")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        check_same_outcome("a,b,c\n" + rows + "1,\"x\n" + rows, options);
+    }
+}
+
+TEST_CASE("csv_parallel_reader read_columns")
+{
+    SECTION("n_objects")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        std::string input = make_input(200, "\n");
+        csv::csv_parallel_reader reader(input, options, 4, 256);
+
+        std::vector<std::vector<double>> columns;
+        std::error_code ec;
+        reader.read_columns(columns, ec);
+        CHECK(ec == conv_errc::not_double); // name and note
+
+        std::string numbers = "id,amount\n";
+        for (int i = 0; i < 200; ++i)
+        {
+            numbers += std::to_string(i) + "," + ((i % 3 == 0) ? "" : std::to_string(i*0.25)) + "\n";
+        }
+        csv::csv_parallel_reader numeric_reader(numbers, options, 4, 128);
+        numeric_reader.read_columns(columns);
+        REQUIRE(2 == columns.size());
+        REQUIRE(2 == numeric_reader.column_count());
+        CHECK("amount" == numeric_reader.column_name(1));
+        REQUIRE(200 == columns[0].size());
+        REQUIRE(200 == columns[1].size());
+        for (std::size_t i = 0; i < 200; ++i)
+        {
+            CHECK(double(i) == columns[0][i]);
+            if (i % 3 == 0)
+            {
+                CHECK(std::isnan(columns[1][i]));
+            }
+            else
+            {
+                CHECK(i*0.25 == columns[1][i]);
+            }
+        }
+    }
+
+    SECTION("n_rows without header")
+    {
+        auto options = csv::csv_options{}
+            .mapping_kind(csv::csv_mapping_kind::n_rows);
+
+        std::string input;
+        for (int i = 0; i < 100; ++i)
+        {
+            input += std::to_string(i) + "," + std::to_string(-i) + "\n";
+        }
+        csv::csv_parallel_reader reader(input, options, 4, 64);
+        std::vector<std::vector<int64_t>> columns;
+        reader.read_columns(columns);
+        REQUIRE(2 == columns.size());
+        REQUIRE(100 == columns[1].size());
+        CHECK(-99 == columns[1][99]);
+    }
+
+    SECTION("m_columns")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .mapping_kind(csv::csv_mapping_kind::m_columns);
+
+        std::string input = "x,y\n1,2\n3,4\n";
+        csv::csv_parallel_reader reader(input, options);
+        std::vector<std::vector<int>> columns;
+        reader.read_columns(columns);
+        REQUIRE(2 == columns.size());
+        CHECK(columns[0] == std::vector<int>{1, 3});
+        CHECK(columns[1] == std::vector<int>{2, 4});
+    }
+
+    SECTION("missing integer")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .ignore_empty_values(true);
+
+        std::string input = "x,y\n1,2\n3,\n";
+        csv::csv_parallel_reader reader(input, options);
+        std::vector<std::vector<int>> columns;
+        std::error_code ec;
+        reader.read_columns(columns, ec);
+        CHECK(ec == conv_errc::not_integer);
+    }
+}
@@ -0,0 +1,215 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons_ext/csv/csv_scanner.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+#include <jsoncons/json.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+namespace csv = jsoncons::csv;
+
+namespace {
+
+    std::string random_text(std::mt19937& gen, std::size_t max_length, const std::string& alphabet)
+    {
+        std::uniform_int_distribution<std::size_t> length_dist(0, max_length);
+        std::uniform_int_distribution<std::size_t> char_dist(0, alphabet.size()-1);
+        std::size_t length = length_dist(gen);
+        std::string s;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            s.push_back(alphabet[char_dist(gen)]);
+        }
+        return s;
+    }
+
+    std::string quote(const std::string& s)
+    {
+        std::string quoted = "\"";
+        for (auto c : s)
+        {
+            if (c == '\"')
+            {
+                quoted.push_back('\"');
+            }
+            quoted.push_back(c);
+        }
+        quoted.push_back('\"');
+        return quoted;
+    }
+
+} // namespace
+
+TEST_CASE("csv char_scanner")
+{
+    SECTION("same result as a character loop")
+    {
+        csv::detail::char_scanner<char,5> scanner{'\n', '\r', ',', ';', '\"'};
+        const std::string stops = "\n\r,;\"";
+
+        for (std::size_t length = 0; length < 200; ++length)
+        {
+            for (std::size_t pos = 0; pos <= length; ++pos)
+            {
+                std::string s(length, 'x');
+                if (pos < length)
+                {
+                    s[pos] = stops[pos % stops.size()];
+                }
+                if (pos + 1 < length)
+                {
+                    s[length-1] = ',';
+                }
+                const char* first = s.data();
+                const char* last = s.data() + s.size();
+                const char* expected = first + std::min(s.find_first_of(stops), s.size());
+                CHECK(expected == scanner.find(first, last));
+            }
+        }
+    }
+
+    SECTION("repeated and null stops")
+    {
+        csv::detail::char_scanner<char,2> scanner{'\"', '\"'};
+        std::string s(100, 'a');
+        s[70] = '\"';
+        CHECK(s.data() + 70 == scanner.find(s.data(), s.data() + s.size()));
+        CHECK(s.data() + 100 == scanner.find(s.data() + 71, s.data() + s.size()));
+
+        csv::detail::char_scanner<char,2> null_scanner{'\0', '\n'};
+        std::string t(100, 'a');
+        t[40] = '\0';
+        CHECK(t.data() + 40 == null_scanner.find(t.data(), t.data() + t.size()));
+    }
+
+    SECTION("wide characters")
+    {
+        csv::detail::char_scanner<wchar_t,3> scanner{L'\n', L',', L'\"'};
+        std::wstring s(100, L'x');
+        s[2] = static_cast<wchar_t>(0x2C00 + L','); // not a comma
+        s[90] = L',';
+        CHECK(s.data() + 90 == scanner.find(s.data(), s.data() + s.size()));
+    }
+}
+
+TEST_CASE("csv_parser long fields")
+{
+    std::mt19937 gen(17);
+    const std::string plain = "abcdefgh xyz0123456789";
+    const std::string special = "ab, \"\n\r;";
+
+    SECTION("quoted and unquoted fields")
+    {
+        for (int trial = 0; trial < 20; ++trial)
+        {
+            std::string input;
+            json expected(json_array_arg);
+            for (int row = 0; row < 30; ++row)
+            {
+                json record(json_array_arg);
+                std::size_t fields = 1 + static_cast<std::size_t>(row % 5);
+                for (std::size_t i = 0; i < fields; ++i)
+                {
+                    if (i > 0)
+                    {
+                        input.push_back(',');
+                    }
+                    std::string value = "v" + random_text(gen, 150, (row + i) % 3 == 0 ? special : plain);
+                    if (value.find_first_of(",\"\n\r;") != std::string::npos || (row + i) % 4 == 0)
+                    {
+                        input += quote(value);
+                    }
+                    else
+                    {
+                        input += value;
+                    }
+                    record.push_back(value);
+                }
+                input += (row % 2 == 0) ? "\n" : "\r\n";
+                expected.push_back(std::move(record));
+            }
+
+            auto options = csv::csv_options{}
+                .infer_types(false)
+                .mapping_kind(csv::csv_mapping_kind::n_rows);
+            json j = csv::decode_csv<json>(input, options);
+            CHECK(expected == j);
+        }
+    }
+
+    SECTION("trim, subfields, comments and empty lines")
+    {
+        for (int trial = 0; trial < 20; ++trial)
+        {
+            std::string input;
+            json expected(json_array_arg);
+            for (int row = 0; row < 30; ++row)
+            {
+                if (row % 7 == 0)
+                {
+                    input += "#" + random_text(gen, 200, plain + ",;\"") + "\n";
+                }
+                if (row % 5 == 0)
+                {
+                    input += "\n";
+                }
+                json record(json_array_arg);
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    if (i > 0)
+                    {
+                        input.push_back(',');
+                    }
+                    if (i == 1)
+                    {
+                        json items(json_array_arg);
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            std::string item = "s" + random_text(gen, 80, plain) + "e";
+                            input += (k > 0 ? ";" : "") + std::string("  ") + item + " ";
+                            items.push_back(item);
+                        }
+                        record.push_back(std::move(items));
+                    }
+                    else
+                    {
+                        std::string value = "s" + random_text(gen, 120, plain) + "e";
+                        input += "   " + value + "  ";
+                        record.push_back(value);
+                    }
+                }
+                input += "\n";
+                expected.push_back(std::move(record));
+            }
+
+            auto options = csv::csv_options{}
+                .infer_types(false)
+                .trim(true)
+                .comment_starter('#')
+                .subfield_delimiter(';')
+                .mapping_kind(csv::csv_mapping_kind::n_rows);
+            json j = csv::decode_csv<json>(input, options);
+            CHECK(expected == j);
+        }
+    }
+
+    SECTION("line and column of an error after a long field")
+    {
+        std::string input = "a,b\n" + std::string(100, 'x') + ",\"" + std::string(70, 'y') + "\"z\n";
+
+        auto options = csv::csv_options{}
+            .assume_header(true);
+        json_decoder<json> decoder;
+        csv::csv_string_reader reader(input, decoder, options);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == csv::csv_errc::unexpected_char_between_fields);
+        CHECK(2 == reader.line());
+        CHECK(174 == reader.column());
+    }
+}
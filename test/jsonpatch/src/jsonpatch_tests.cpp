@@ -272,3 +272,193 @@ TEST_CASE("copy_root_to_child")
     )");
     check_patch(target, patch, std::error_code(), expected);
 }
+
+TEST_CASE("from diff with lcs option")
+{
+    SECTION("insert at front of array")
+    {
+        json source(jsoncons::json_array_arg);
+        for (int i = 0; i < 1000; ++i)
+        {
+            source.push_back(i);
+        }
+        json target = source;
+        target.insert(target.array_range().begin(), json("first"));
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        CHECK(json::parse(R"([{"op":"add","path":"/0","value":"first"}])") == patch);
+
+        // By position
+        CHECK(1000 < jsonpatch::from_diff(source, target).size());
+
+        check_patch(source,patch,std::error_code(),target);
+    }
+
+    SECTION("remove from middle of array")
+    {
+        json source = json::parse(R"({"names":["a","b","c","d","e"]})");
+        json target = json::parse(R"({"names":["a","b","d","e"]})");
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        CHECK(json::parse(R"([{"op":"remove","path":"/names/2"}])") == patch);
+        check_patch(source,patch,std::error_code(),target);
+    }
+
+    SECTION("move element")
+    {
+        json source = json::parse(R"([{"id":1},{"id":2},{"id":3},{"id":4}])");
+        json target = json::parse(R"([{"id":4},{"id":1},{"id":2},{"id":3}])");
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        CHECK(json::parse(R"([{"op":"move","from":"/3","path":"/0"}])") == patch);
+        check_patch(source,patch,std::error_code(),target);
+    }
+
+    SECTION("copy element")
+    {
+        json source = json::parse(R"([{"id":1,"tags":["x","y"]},2])");
+        json target = json::parse(R"([{"id":1,"tags":["x","y"]},2,{"id":1,"tags":["x","y"]}])");
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        CHECK(json::parse(R"([{"op":"copy","from":"/0","path":"/2"}])") == patch);
+        check_patch(source,patch,std::error_code(),target);
+    }
+
+    SECTION("changed element is diffed in place")
+    {
+        json source = json::parse(R"([{"id":1,"name":"a"},{"id":2,"name":"b"},{"id":3,"name":"c"}])");
+        json target = json::parse(R"([{"id":1,"name":"a"},{"id":2,"name":"x"},{"id":3,"name":"c"}])");
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        CHECK(json::parse(R"([{"op":"replace","path":"/1/name","value":"x"}])") == patch);
+        check_patch(source,patch,std::error_code(),target);
+    }
+
+    SECTION("nested changes")
+    {
+        json source = json::parse(R"(
+            {"a": [1, [2, 3], {"b": [4, 5, 6]}], "c": "d", "e": [7, 8]}
+        )");
+        json target = json::parse(R"(
+            {"a": [0, 1, {"b": [6, 4, 5, 5]}, [2, 3]], "c": 9, "f": [7, 8]}
+        )");
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        check_patch(source,patch,std::error_code(),target);
+    }
+
+    SECTION("equal documents")
+    {
+        json source = json::parse(R"({"a":[1,2,{"b":null}],"c":1.0})");
+        json target = json::parse(R"({"c":1,"a":[1,2,{"b":null}]})");
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        CHECK(patch.empty());
+    }
+
+    SECTION("arrays with no common elements")
+    {
+        json source(jsoncons::json_array_arg);
+        json target(jsoncons::json_array_arg);
+        for (int i = 0; i < 2000; ++i)
+        {
+            source.push_back(i);
+            target.push_back(-i);
+        }
+        target.push_back(1);
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        check_patch(source,patch,std::error_code(),target);
+    }
+
+    SECTION("many scattered removals")
+    {
+        json source(jsoncons::json_array_arg);
+        json target(jsoncons::json_array_arg);
+        for (int i = 0; i < 3000; ++i)
+        {
+            source.push_back(i);
+            if (i % 3 != 1)
+            {
+                target.push_back(i);
+            }
+        }
+
+        json patch = jsonpatch::from_diff(source, target, jsonpatch::diff_options::lcs);
+        CHECK(1000 == patch.size());
+        check_patch(source,patch,std::error_code(),target);
+    }
+}
+
+TEST_CASE("apply_patch undo")
+{
+    json source = json::parse(R"(
+        {"a": [1, 2, {"b": [3, 4]}], "c": {"d": "e"}, "f": "g"}
+    )");
+
+    SECTION("failed patch restores moved and replaced values")
+    {
+        json patch = json::parse(R"([
+            {"op": "replace", "path": "/c", "value": 1},
+            {"op": "move", "from": "/a/2", "path": "/a/0"},
+            {"op": "add", "path": "/a/-", "value": 5},
+            {"op": "remove", "path": "/f"},
+            {"op": "copy", "from": "/a", "path": "/h"},
+            {"op": "add", "path": "/c", "value": 2},
+            {"op": "move", "from": "/h", "path": "/a"},
+            {"op": "test", "path": "/x", "value": 1}
+        ])");
+
+        json target = source;
+        check_patch(target, patch, jsonpatch::jsonpatch_errc::test_failed, source);
+    }
+
+    SECTION("failed patch restores root")
+    {
+        json patch = json::parse(R"([
+            {"op": "add", "path": "", "value": [1, 2]},
+            {"op": "remove", "path": "/5"}
+        ])");
+
+        json target = source;
+        check_patch(target, patch, jsonpatch::jsonpatch_errc::remove_failed, source);
+    }
+
+    SECTION("failed move into own child restores source")
+    {
+        json patch = json::parse(R"([
+            {"op": "move", "from": "/c", "path": "/c/d/e"}
+        ])");
+
+        json target = source;
+        check_patch(target, patch, jsonpatch::jsonpatch_errc::copy_failed, source);
+    }
+
+    SECTION("no undo")
+    {
+        json patch = json::parse(R"([
+            {"op": "move", "from": "/a/2/b", "path": "/b"},
+            {"op": "replace", "path": "/f", "value": null}
+        ])");
+        json expected = json::parse(R"(
+            {"a": [1, 2, {}], "b": [3, 4], "c": {"d": "e"}, "f": null}
+        )");
+
+        json target = source;
+        std::error_code ec;
+        jsonpatch::apply_patch(target, patch, jsonpatch::patch_options::no_undo, ec);
+        CHECK_FALSE(ec);
+        CHECK(expected == target);
+
+        // Not restored on failure
+        json patch2 = json::parse(R"([
+            {"op": "remove", "path": "/f"},
+            {"op": "remove", "path": "/f"}
+        ])");
+        jsonpatch::apply_patch(target, patch2, jsonpatch::patch_options::no_undo, ec);
+        CHECK(ec == jsonpatch::jsonpatch_errc::remove_failed);
+        CHECK_FALSE(target.contains("f"));
+
+        REQUIRE_THROWS_AS(jsonpatch::apply_patch(target, patch2, jsonpatch::patch_options::no_undo), jsonpatch::jsonpatch_error);
+    }
+}
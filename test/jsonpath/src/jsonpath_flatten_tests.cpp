@@ -151,3 +151,24 @@ TEST_CASE("jsonpath flatten escape")
         compare_match(doc, path, value);
     }
 }
+
+TEST_CASE("jsonpath flatten_visitor")
+{
+    json input = json::parse(R"(
+    {
+        "books": [
+            {"title": "Sayings of the Century", "author": "Nigel Rees's", "tags": []},
+            {"title": "Moby Dick", "details": {}}
+        ]
+    }
+    )");
+
+    json_decoder<json> decoder;
+    jsonpath::flatten_visitor visitor(decoder);
+    input.dump(visitor);
+    json result = decoder.get_result();
+
+    CHECK(result == jsonpath::flatten(input));
+    CHECK(result["$['books'][0]['author']"] == json("Nigel Rees's"));
+    CHECK(jsonpath::unflatten(result) == input);
+}
@@ -185,3 +185,99 @@ TEST_CASE("jsonpointer flatten/unflatten empty array and empty object")
     }
 }
 
+TEST_CASE("jsonpointer flatten_visitor and unflatten_visitor")
+{
+    ojson input = ojson::parse(R"(
+    {
+        "application": "hiking",
+        "reputons": [
+            {"rater": "HikingAsylum", "assertion": "advanced", "rating": 0.90},
+            {"rater": "a/b~c", "assertion": "intermediate", "rating": 0.75, "tags" : [[], {}]}
+        ],
+        "empty": {}
+    }
+    )");
+
+    SECTION("flatten_visitor")
+    {
+        json_decoder<ojson> decoder;
+        jsonpointer::flatten_visitor visitor(decoder);
+        input.dump(visitor);
+        CHECK(decoder.get_result() == jsonpointer::flatten(input));
+    }
+
+    SECTION("flatten_visitor with scalar and empty documents")
+    {
+        json_decoder<ojson> decoder;
+        jsonpointer::flatten_visitor visitor(decoder);
+
+        ojson(10).dump(visitor);
+        CHECK(decoder.get_result() == ojson::parse(R"({"":10})"));
+
+        ojson(json_array_arg).dump(visitor);
+        CHECK(decoder.get_result() == ojson::parse(R"({"":[]})"));
+    }
+
+    SECTION("round trip in document order")
+    {
+        json_decoder<ojson> decoder;
+        jsonpointer::unflatten_visitor unflattener(decoder);
+        jsonpointer::flatten_visitor flattener(unflattener);
+        input.dump(flattener);
+        CHECK(decoder.get_result() == input);
+    }
+
+    SECTION("round trip in any order")
+    {
+        ojson flattened = jsonpointer::flatten(input);
+        ojson reversed(json_object_arg);
+        for (auto it = flattened.object_range().crbegin(); it != flattened.object_range().crend(); ++it)
+        {
+            reversed.try_emplace((*it).key(), (*it).value());
+        }
+
+        json_decoder<json> decoder;
+        jsonpointer::unflatten_visitor visitor(decoder, jsonpointer::unflatten_options::none, jsonpointer::unflatten_order::any);
+        reversed.dump(visitor);
+        CHECK(decoder.get_result() == json::parse(input.to_string()));
+    }
+
+    SECTION("assume_object")
+    {
+        json flattened = json::parse(R"({"/a/0":1,"/a/1":2})");
+        json_decoder<json> decoder;
+        jsonpointer::unflatten_visitor visitor(decoder, jsonpointer::unflatten_options::assume_object);
+        flattened.dump(visitor);
+        CHECK(decoder.get_result() == json::parse(R"({"a":{"0":1,"1":2}})"));
+    }
+
+    SECTION("array elements out of document order")
+    {
+        ojson flattened = ojson::parse(R"({"/a/0":0,"/a/2":2,"/a/1":1})");
+
+        json_decoder<ojson> decoder;
+        jsonpointer::unflatten_visitor visitor(decoder);
+        std::error_code ec;
+        flattened.dump(visitor, ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::flattened_key_out_of_order);
+
+        jsonpointer::unflatten_visitor any_order(decoder, jsonpointer::unflatten_options::none, jsonpointer::unflatten_order::any);
+        flattened.dump(any_order);
+        CHECK(decoder.get_result() == ojson::parse(R"({"a":[0,1,2]})"));
+    }
+
+    SECTION("invalid input")
+    {
+        json_decoder<json> decoder;
+        jsonpointer::unflatten_visitor visitor(decoder);
+        std::error_code ec;
+        json::parse(R"([1,2])").dump(visitor, ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::argument_to_unflatten_invalid);
+
+        visitor.reset();
+        ec.clear();
+        json::parse(R"({"a":1})").dump(visitor, ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::invalid_flattened_key);
+    }
+}
+
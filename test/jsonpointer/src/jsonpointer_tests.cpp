@@ -588,3 +588,129 @@ TEST_CASE("jsonpointer JSON Schema tests")
 }
 
 
+TEST_CASE("compiled json pointer")
+{
+    SECTION("tokens")
+    {
+        jsonpointer::compiled_json_pointer location("/a~1b/m~0n/3/-/");
+        REQUIRE(location.size() == 5);
+        CHECK(location[0].name() == "a/b");
+        CHECK(location[1].name() == "m~n");
+        CHECK(location[2].has_index());
+        CHECK(location[2].index() == 3);
+        CHECK_FALSE(location[3].has_index());
+        CHECK(location[3].is_past_end());
+        CHECK(location[4].name().empty());
+        CHECK(location.to_string() == "/a~1b/m~0n/3/-/");
+        CHECK(location.parent() == "/a~1b/m~0n/3/-");
+
+        std::vector<std::string> names;
+        for (const auto& token : location)
+        {
+            names.emplace_back(token.name().data(), token.name().size());
+        }
+        std::vector<std::string> expected = {"a/b", "m~n", "3", "-", ""};
+        CHECK(names == expected);
+
+        CHECK(jsonpointer::compiled_json_pointer(jsonpointer::json_pointer("/a~1b/m~0n/3/-/")) == location);
+    }
+
+    SECTION("parse errors")
+    {
+        std::error_code ec;
+        jsonpointer::compiled_json_pointer::parse("a/b", ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::expected_slash);
+
+        ec.clear();
+        jsonpointer::compiled_json_pointer::parse("/foo/bar~", ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::expected_0_or_1);
+
+        ec.clear();
+        jsonpointer::compiled_json_pointer::parse("/~2", ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::expected_0_or_1);
+
+        CHECK_THROWS_AS(jsonpointer::compiled_json_pointer("/~"), jsonpointer::jsonpointer_error);
+    }
+
+    SECTION("get, add, replace and remove")
+    {
+        json doc = json::parse(R"({"a":{"b":[1,2,{"c":3}]},"m~n":8})");
+
+        CHECK(jsonpointer::get(doc, jsonpointer::compiled_json_pointer("/a/b/2/c")) == json(3));
+        CHECK(jsonpointer::get(static_cast<const json&>(doc), jsonpointer::compiled_json_pointer("/m~0n")) == json(8));
+        CHECK(jsonpointer::contains(doc, jsonpointer::compiled_json_pointer("/a/b/1")));
+        CHECK_FALSE(jsonpointer::contains(doc, jsonpointer::compiled_json_pointer("/a/b/3")));
+
+        std::error_code ec;
+        jsonpointer::get(doc, jsonpointer::compiled_json_pointer("/a/b/x"), ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::invalid_index);
+
+        jsonpointer::add(doc, jsonpointer::compiled_json_pointer("/a/b/-"), 4);
+        jsonpointer::add(doc, jsonpointer::compiled_json_pointer("/a/b/0"), 0);
+        jsonpointer::replace(doc, jsonpointer::compiled_json_pointer("/a/b/3/c"), 30);
+        jsonpointer::remove(doc, jsonpointer::compiled_json_pointer("/m~0n"));
+        jsonpointer::add(doc, jsonpointer::compiled_json_pointer("/x/y"), "z", true);
+
+        ec.clear();
+        jsonpointer::add_if_absent(doc, jsonpointer::compiled_json_pointer("/a"), 1, ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::key_already_exists);
+
+        json expected = json::parse(R"({"a":{"b":[0,1,2,{"c":30},4]},"x":{"y":"z"}})");
+        CHECK(doc == expected);
+    }
+}
+
+TEST_CASE("json_pointer_resolver")
+{
+    json doc = json::parse(R"({"a":{"b":[{"c":1,"d":2},{"c":3,"d":4}]}})");
+
+    jsonpointer::compiled_json_pointer c0("/a/b/0/c");
+    jsonpointer::compiled_json_pointer d0("/a/b/0/d");
+    jsonpointer::compiled_json_pointer c1("/a/b/1/c");
+    jsonpointer::compiled_json_pointer b0("/a/b/0");
+
+    jsonpointer::json_pointer_resolver<json> resolver(doc);
+
+    SECTION("repeated lookups")
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            CHECK(resolver.get(c0) == json(1));
+            CHECK(resolver.get(d0) == json(2));
+            CHECK(resolver.get(c1) == json(3));
+        }
+        std::error_code ec;
+        resolver.get(jsonpointer::compiled_json_pointer("/a/b/0/e"), ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::key_not_found);
+        CHECK(resolver.contains(b0));
+    }
+
+    SECTION("modifications through the resolver")
+    {
+        CHECK(resolver.get(c1) == json(3));
+        // Moves the elements of /a/b, so the cached parent of /a/b/1/c must be dropped
+        resolver.add(b0, json::parse(R"({"c":0,"d":0})"));
+        CHECK(resolver.get(c1) == json(1));
+        CHECK(resolver.get(c0) == json(0));
+
+        resolver.replace(c1, 10);
+        resolver.remove(jsonpointer::compiled_json_pointer("/a/b/2"));
+        CHECK(resolver.get(c1) == json(10));
+        CHECK_THROWS_AS(resolver.get(jsonpointer::compiled_json_pointer("/a/b/2/c")), jsonpointer::jsonpointer_error);
+
+        json expected = json::parse(R"({"a":{"b":[{"c":0,"d":0},{"c":10,"d":2}]}})");
+        CHECK(doc == expected);
+    }
+
+    SECTION("invalidate after outside modification")
+    {
+        CHECK(resolver.get(c0) == json(1));
+        doc["a"]["b"] = json::parse(R"([{"c":5}])");
+        auto generation = resolver.generation();
+        resolver.invalidate();
+        CHECK(resolver.generation() != generation);
+        CHECK(resolver.get(c0) == json(5));
+        CHECK_FALSE(resolver.contains(d0));
+    }
+}
+
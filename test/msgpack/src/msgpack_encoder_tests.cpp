@@ -200,3 +200,90 @@ TEMPLATE_TEST_CASE("test_msgpack_encoder_reset", "",
     f.encoder.flush();
     CHECK(f.bytes2() == expected_full);
 }
+
+namespace {
+
+    struct msgpack_typed_array_visitor : public default_json_visitor
+    {
+        std::vector<float> v;
+    private:
+        JSONCONS_VISITOR_RETURN_TYPE visit_typed_array(const span<const float>& data,  
+            semantic_tag,
+            const ser_context&,
+            std::error_code&) override
+        {
+            v = std::vector<float>(data.begin(),data.end());
+            JSONCONS_VISITOR_RETURN;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("msgpack encode typed arrays")
+{
+    auto options = msgpack::msgpack_options{}
+        .use_typed_arrays(true)
+        .typed_array_ext_type(0x10);
+
+    SECTION("float")
+    {
+        std::vector<float> v = {1.5f, -2.0f, 3.25f};
+
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(v, data, options);
+
+        REQUIRE(data.size() == 3 + 1 + v.size()*sizeof(float));
+        CHECK(data[0] == msgpack::msgpack_type::ext8_type);
+        CHECK(data[1] == 1 + v.size()*sizeof(float));
+        CHECK(data[2] == 0x10);
+        CHECK((data[3] & ~msgpack::msgpack_typed_array_type::little_endian_flag) == msgpack::msgpack_typed_array_type::float_array);
+
+        CHECK(msgpack::decode_msgpack<std::vector<float>>(data, options) == v);
+
+        msgpack_typed_array_visitor visitor;
+        msgpack::msgpack_bytes_reader reader(data, visitor, options);
+        reader.read();
+        CHECK(visitor.v == v);
+
+        json j = msgpack::decode_msgpack<json>(data, options);
+        REQUIRE(j.size() == 3);
+        CHECK(j[2].as<double>() == 3.25);
+    }
+
+    SECTION("int64 and uint16")
+    {
+        std::vector<int64_t> u = {-1, 0, (std::numeric_limits<int64_t>::max)()};
+        std::vector<uint8_t> data1;
+        msgpack::encode_msgpack(u, data1, options);
+        CHECK(msgpack::decode_msgpack<std::vector<int64_t>>(data1, options) == u);
+
+        std::vector<uint16_t> w = {1, 2, 65535};
+        std::vector<uint8_t> data2;
+        msgpack::encode_msgpack(w, data2, options);
+        CHECK(msgpack::decode_msgpack<std::vector<uint16_t>>(data2, options) == w);
+    }
+
+    SECTION("decoded as ext byte string when typed arrays not enabled")
+    {
+        std::vector<double> v = {1.0, 2.0};
+
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(v, data, options);
+
+        json j = msgpack::decode_msgpack<json>(data);
+        CHECK(j.is_byte_string());
+        CHECK(j.tag() == semantic_tag::ext);
+        CHECK(j.ext_tag() == 0x10);
+    }
+
+    SECTION("invalid element type")
+    {
+        std::vector<uint8_t> data = {msgpack::msgpack_type::fixext2_type, 0x10, 0x7f, 0x00};
+
+        std::error_code ec;
+        json_decoder<json> decoder;
+        msgpack::msgpack_bytes_reader reader(data, decoder, options);
+        reader.read(ec);
+        CHECK(ec == msgpack::msgpack_errc::invalid_typed_array);
+    }
+}
@@ -0,0 +1,201 @@
+// Copyright 2013-2025 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+
+#include <jsoncons_ext/msgpack/transcode_msgpack.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons/json.hpp>
+
+#include <limits>
+#include <string>
+#include <vector>
+#include <catch/catch.hpp>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::vector<uint8_t> cbor_to_msgpack_through_visitor(const std::vector<uint8_t>& input)
+    {
+        std::vector<uint8_t> output;
+        msgpack::msgpack_bytes_encoder encoder(output);
+        cbor::cbor_bytes_reader reader(input, encoder);
+        reader.read();
+        return output;
+    }
+
+    std::vector<uint8_t> msgpack_to_cbor_through_visitor(const std::vector<uint8_t>& input)
+    {
+        std::vector<uint8_t> output;
+        cbor::cbor_bytes_encoder encoder(output);
+        msgpack::msgpack_bytes_reader reader(input, encoder);
+        reader.read();
+        return output;
+    }
+
+    ojson make_document()
+    {
+        ojson doc = ojson::parse(R"(
+{
+    "name" : "Jane",
+    "flags" : [true, false, null],
+    "numbers" : [0, 1, 23, 24, 127, 128, 255, 256, 65535, 65536, 4294967295, 4294967296, 18446744073709551615],
+    "negatives" : [-1, -24, -25, -32, -33, -128, -129, -32768, -32769, -2147483648, -2147483649, -9223372036854775808],
+    "doubles" : [0.0, 1.5, -2.25, 3.141592653589793, 1e300],
+    "nested" : {"a" : {"b" : {"c" : []}}, "d" : {}}
+}
+        )");
+        doc["long string"] = std::string(300, 'x');
+        doc["longer string"] = std::string(70000, 'y');
+        ojson many(json_array_arg);
+        for (int i = 0; i < 20; ++i)
+        {
+            many.push_back(i);
+        }
+        doc["many"] = many;
+        doc["bytes"] = ojson(byte_string_arg, std::vector<uint8_t>{1,2,3});
+        doc["more bytes"] = ojson(byte_string_arg, std::vector<uint8_t>(1000, 0xab));
+        return doc;
+    }
+
+} // namespace
+
+TEST_CASE("cbor_to_msgpack tests")
+{
+    SECTION("same output as a reader driving an encoder")
+    {
+        std::vector<uint8_t> input;
+        cbor::encode_cbor(make_document(), input);
+
+        std::vector<uint8_t> output;
+        msgpack::cbor_to_msgpack(input, output);
+        CHECK(output == cbor_to_msgpack_through_visitor(input));
+        CHECK(msgpack::decode_msgpack<ojson>(output) == make_document());
+    }
+
+    SECTION("half and single precision floats")
+    {
+        std::vector<uint8_t> input = {0x83,
+            0xf9,0x3c,0x00, // 1.0 half
+            0xfa,0x3f,0xc0,0x00,0x00, // 1.5 float
+            0xf7}; // undefined
+
+        std::vector<uint8_t> output;
+        msgpack::cbor_to_msgpack(input, output);
+        CHECK(output == cbor_to_msgpack_through_visitor(input));
+    }
+
+    SECTION("tags, indefinite lengths and integer keys")
+    {
+        std::vector<std::vector<uint8_t>> inputs = {
+            {0xc1,0x1a,0x5a,0x3f,0x7d,0x20}, // epoch time
+            {0xc2,0x49,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // bignum
+            {0x7f,0x61,0x61,0x61,0x62,0xff}, // indefinite length text string
+            {0xa1,0x01,0x02} // integer key
+        };
+        for (const auto& input : inputs)
+        {
+            std::vector<uint8_t> output;
+            msgpack::cbor_to_msgpack(input, output);
+            CHECK(output == cbor_to_msgpack_through_visitor(input));
+        }
+    }
+
+    SECTION("indefinite length array")
+    {
+        std::vector<uint8_t> input = {0x9f,0x01,0xff};
+        std::vector<uint8_t> output;
+        auto r = msgpack::try_cbor_to_msgpack(input, output);
+        REQUIRE_FALSE(r);
+        CHECK(r.error() == msgpack::msgpack_errc::array_length_required);
+    }
+
+    SECTION("truncated input")
+    {
+        std::vector<uint8_t> input = {0x82,0x01};
+        std::vector<uint8_t> output;
+        auto r = msgpack::try_cbor_to_msgpack(input, output);
+        REQUIRE_FALSE(r);
+        CHECK(r.error() == cbor::cbor_errc::unexpected_eof);
+    }
+
+    SECTION("appends to existing output")
+    {
+        std::vector<uint8_t> input = {0xa1,0x01,0x02}; // falls back
+        std::vector<uint8_t> output = {0xff};
+        msgpack::cbor_to_msgpack(input, output);
+        std::vector<uint8_t> expected = {0xff,0x81,0xa1,'1',0x02};
+        CHECK(output == expected);
+    }
+
+    SECTION("max nesting depth")
+    {
+        std::vector<uint8_t> input = {0x81,0x81,0x81,0x80};
+        std::vector<uint8_t> output;
+        auto r = msgpack::try_cbor_to_msgpack(input, output, cbor::cbor_options{}.max_nesting_depth(3));
+        REQUIRE_FALSE(r);
+        CHECK(r.error() == cbor::cbor_errc::max_nesting_depth_exceeded);
+    }
+}
+
+TEST_CASE("msgpack_to_cbor tests")
+{
+    SECTION("same output as a reader driving an encoder")
+    {
+        std::vector<uint8_t> input;
+        msgpack::encode_msgpack(make_document(), input);
+
+        std::vector<uint8_t> output;
+        msgpack::msgpack_to_cbor(input, output);
+        CHECK(output == msgpack_to_cbor_through_visitor(input));
+        CHECK(cbor::decode_cbor<ojson>(output) == make_document());
+    }
+
+    SECTION("signed integer types with positive values")
+    {
+        std::vector<uint8_t> input = {0x93,
+            0xd0,0x05, // int 8
+            0xd1,0x01,0x00, // int 16
+            0xd3,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01}; // int 64
+        std::vector<uint8_t> output;
+        msgpack::msgpack_to_cbor(input, output);
+        CHECK(output == msgpack_to_cbor_through_visitor(input));
+    }
+
+    SECTION("ext types and integer keys")
+    {
+        std::vector<std::vector<uint8_t>> inputs = {
+            {0xd6,0xff,0x5a,0x3f,0x7d,0x20}, // timestamp 32
+            {0xd4,0x01,0x02}, // fixext 1
+            {0x81,0x01,0x02} // integer key
+        };
+        for (const auto& input : inputs)
+        {
+            std::vector<uint8_t> output;
+            msgpack::msgpack_to_cbor(input, output);
+            CHECK(output == msgpack_to_cbor_through_visitor(input));
+        }
+    }
+
+    SECTION("pack_strings")
+    {
+        std::vector<uint8_t> input = {0x92,0xa3,'f','o','o',0xa3,'f','o','o'};
+        std::vector<uint8_t> output;
+        msgpack::msgpack_to_cbor(input, output, msgpack::msgpack_options{}, cbor::cbor_options{}.pack_strings(true));
+        std::vector<uint8_t> expected = {0xd9,0x01,0x00,0x82,0x63,'f','o','o',0xd8,0x19,0x00};
+        CHECK(output == expected);
+    }
+
+    SECTION("invalid utf8")
+    {
+        std::vector<uint8_t> input = {0xa1,0xff};
+        std::vector<uint8_t> output;
+        auto r = msgpack::try_msgpack_to_cbor(input, output);
+        REQUIRE_FALSE(r);
+        CHECK(r.error() == msgpack::msgpack_errc::invalid_utf8_text_string);
+    }
+}
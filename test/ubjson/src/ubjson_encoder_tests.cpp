@@ -228,3 +228,66 @@ TEMPLATE_TEST_CASE("test_ubjson_encoder_reset", "",
     f.encoder.flush();
     CHECK(f.bytes2() == expected_full);
 }
+
+TEST_CASE("ubjson encode typed arrays")
+{
+    auto options = ubjson::ubjson_options{}
+        .use_typed_arrays(true);
+
+    SECTION("float")
+    {
+        std::vector<float> v = {1.5f, -2.0f};
+
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(v, data, options);
+
+        std::vector<uint8_t> expected = {'[','$','d','#','U',2,
+                                         0x3f,0xc0,0x00,0x00,
+                                         0xc0,0x00,0x00,0x00};
+        CHECK(data == expected);
+        CHECK(ubjson::decode_ubjson<std::vector<float>>(data) == v);
+    }
+
+    SECTION("int32")
+    {
+        std::vector<int32_t> v = {1, -1, 65536};
+
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(v, data, options);
+
+        std::vector<uint8_t> expected = {'[','$','l','#','U',3,
+                                         0x00,0x00,0x00,0x01,
+                                         0xff,0xff,0xff,0xff,
+                                         0x00,0x01,0x00,0x00};
+        CHECK(data == expected);
+        CHECK(ubjson::decode_ubjson<std::vector<int32_t>>(data) == v);
+    }
+
+    SECTION("uint16 widened to int32")
+    {
+        std::vector<uint16_t> v = {1, 65535};
+
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(v, data, options);
+
+        std::vector<uint8_t> expected = {'[','$','l','#','U',2,
+                                         0x00,0x00,0x00,0x01,
+                                         0x00,0x00,0xff,0xff};
+        CHECK(data == expected);
+        CHECK(ubjson::decode_ubjson<std::vector<uint16_t>>(data) == v);
+    }
+
+    SECTION("double round trip")
+    {
+        std::vector<double> v(1000);
+        for (std::size_t i = 0; i < v.size(); ++i)
+        {
+            v[i] = static_cast<double>(i) / 3.0;
+        }
+
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(v, data, options);
+        CHECK(data.size() == 7 + v.size()*sizeof(double));
+        CHECK(ubjson::decode_ubjson<std::vector<double>>(data) == v);
+    }
+}